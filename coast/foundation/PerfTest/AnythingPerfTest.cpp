@@ -9,6 +9,7 @@
 #include "AnythingPerfTest.h"
 #include "TestSuite.h"
 #include "PoolAllocator.h"
+#include "AnySorter.h"
 
 AnythingPerfTest::AnythingPerfTest(TString tstrName)
 	: TestCaseType(tstrName)
@@ -136,6 +137,54 @@ void AnythingPerfTest::PrintOnTest()
 	DoFunctorTest(String("guguseli"), "String guguseli", &AnythingPerfTest::RunPrintOnPrettyLoop);
 }
 
+void AnythingPerfTest::ExportTest()
+{
+	StartTrace(AnythingPerfTest.ExportTest);
+	DoFunctorTest(1L, "long 1L", &AnythingPerfTest::RunExportLoop);
+	DoFunctorTest("guguseli", "char* guguseli", &AnythingPerfTest::RunExportLoop);
+}
+
+void AnythingPerfTest::ImportTest()
+{
+	StartTrace(AnythingPerfTest.ImportTest);
+	DoFunctorTest(1L, "long 1L", &AnythingPerfTest::RunImportLoop);
+	DoFunctorTest(4433.1234, "float 4433.1234", &AnythingPerfTest::RunImportLoop);
+	DoFunctorTest("guguseli", "char* guguseli", &AnythingPerfTest::RunImportLoop);
+}
+
+void AnythingPerfTest::SortTest()
+{
+	StartTrace(AnythingPerfTest.SortTest);
+	const long rows = 20000;
+	Anything keyed, table;
+	for (long i = 0; i < rows; ++i) {
+		long const lKey = (i * 7919L) % rows;
+		String strKey("row_");
+		strKey << lKey;
+		keyed[strKey] = i;
+		Anything row;
+		row["Name"] = strKey;
+		row["Number"] = lKey;
+		table.Append(row);
+	}
+	{
+		Anything work = keyed.DeepClone();
+		CatchTimeType aTimer(TString("SortByKey/") << rows, this, '/');
+		work.SortByKey();
+	}
+	{
+		Anything work = table.DeepClone();
+		CatchTimeType aTimer(TString("SortByKeyInArray/Name/asc/") << rows, this, '/');
+		AnySorter::SortByKeyInArray("Name", work, AnySorter::asc, false);
+	}
+	{
+		Anything work = table.DeepClone();
+		CatchTimeType aTimer(TString("SortByKeyInArray/Number/desc/") << rows, this, '/');
+		AnySorter::SortByKeyInArray("Number", work, AnySorter::desc, true);
+		assertEqual(rows - 1, work[0L]["Number"].AsLong());
+	}
+}
+
 template <typename T>
 void AnythingPerfTest::DoFunctorTest(T value, const char *pName, LoopFunctor pFunc)
 {
@@ -211,6 +260,31 @@ void AnythingPerfTest::RunPrintOnPrettyLoop(const char *pName, const Anything &a
 	}
 }
 
+void AnythingPerfTest::RunExportLoop(const char *pName, const Anything &a, const long iterations)
+{
+	CatchTimeType aTimer(TString("ExportLoop/[") << pName << "]/" << iterations, this, '/');
+	String strBuf;
+	OStringStream stream(&strBuf);
+	for (long i = 0; i < iterations; ++i) {
+		a.Export(stream);
+	}
+}
+
+void AnythingPerfTest::RunImportLoop(const char *pName, const Anything &a, const long iterations)
+{
+	String strBuf;
+	{
+		OStringStream stream(&strBuf);
+		a.Export(stream);
+	}
+	CatchTimeType aTimer(TString("ImportLoop/[") << pName << "]/" << iterations, this, '/');
+	Anything result;
+	for (long i = 0; i < iterations; ++i) {
+		IStringStream stream(&strBuf);
+		result.Import(stream);
+	}
+}
+
 // builds up a suite of testcases, add a line for each testmethod
 Test *AnythingPerfTest::suite ()
 {
@@ -220,6 +294,9 @@ Test *AnythingPerfTest::suite ()
 	ADD_CASE(testSuite, AnythingPerfTest, LookupTest);
 	ADD_CASE(testSuite, AnythingPerfTest, DeepCloneTest);
 	ADD_CASE(testSuite, AnythingPerfTest, PrintOnTest);
+	ADD_CASE(testSuite, AnythingPerfTest, ExportTest);
+	ADD_CASE(testSuite, AnythingPerfTest, ImportTest);
+	ADD_CASE(testSuite, AnythingPerfTest, SortTest);
 	ADD_CASE(testSuite, AnythingPerfTest, ExportCsvStatistics);
 
 	return testSuite;
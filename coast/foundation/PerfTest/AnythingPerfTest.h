@@ -32,6 +32,9 @@ public:
 	//!describe this testcase
 	void DeepCloneTest();
 	void PrintOnTest();
+	void ExportTest();
+	void ImportTest();
+	void SortTest();
 
 protected:
 	typedef void (AnythingPerfTest::* LoopFunctor)(const char *pName, const Anything &a, const long iterations);
@@ -45,6 +48,8 @@ protected:
 	void RunROLookupPathLoop(const char *key, const ROAnything &a, const long iterations);
 	void RunDeepCloneLoop(const char *pName, const Anything &a, const long iterations);
 	void RunPrintOnPrettyLoop(const char *pName, const Anything &a, const long iterations);
+	void RunExportLoop(const char *pName, const Anything &a, const long iterations);
+	void RunImportLoop(const char *pName, const Anything &a, const long iterations);
 };
 
 #endif
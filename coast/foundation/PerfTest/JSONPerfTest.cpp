@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "JSONPerfTest.h"
+#include "TestSuite.h"
+#include "JSONParser.h"
+#include "StringStream.h"
+
+namespace {
+	const long iterations = 2000L;
+
+	//! small request like record with a few members
+	Anything RecordPayload() {
+		Anything anyPayload;
+		anyPayload["user"] = "some.user@example.com";
+		anyPayload["role"] = "Customer";
+		anyPayload["id"] = 4711L;
+		anyPayload["balance"] = 1234.5;
+		anyPayload["remember"] = 1L;
+		anyPayload["lang"] = "D";
+		return anyPayload;
+	}
+
+	//! result set like list of records with longer text columns
+	Anything ListPayload() {
+		Anything anyPayload, anyRecord(RecordPayload());
+		anyRecord["text"] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.";
+		for (long i = 0; i < 200L; ++i) {
+			anyRecord["id"] = i;
+			anyPayload.Append(anyRecord.DeepClone());
+		}
+		return anyPayload;
+	}
+}
+
+void JSONPerfTest::RunParseLoop(const char *pPayloadName, const Anything &anyPayload, const long iterations)
+{
+	String strAny, strJSON;
+	{
+		OStringStream os(strAny);
+		anyPayload.PrintOn(os, false);
+	}
+	{
+		OStringStream os(strJSON);
+		JSONPrinter::PrintOn(os, anyPayload);
+	}
+	Anything anyResult;
+	{
+		CatchTimeType aTimer(TString("AnythingParser/") << pPayloadName << '/' << iterations, this, '/');
+		for (long i = 0; i < iterations; ++i) {
+			IStringStream is(strAny);
+			anyResult.Import(is);
+		}
+	}
+	{
+		CatchTimeType aTimer(TString("JSONParser/") << pPayloadName << '/' << iterations, this, '/');
+		for (long i = 0; i < iterations; ++i) {
+			JSONParser().Parse(strJSON, strJSON.Length(), anyResult);
+		}
+	}
+	assertAnyEqualm(anyPayload, anyResult, pPayloadName);
+}
+
+void JSONPerfTest::RunPrintLoop(const char *pPayloadName, const Anything &anyPayload, const long iterations)
+{
+	{
+		CatchTimeType aTimer(TString("AnythingPrintOn/") << pPayloadName << '/' << iterations, this, '/');
+		for (long i = 0; i < iterations; ++i) {
+			String strOut;
+			OStringStream os(strOut);
+			anyPayload.PrintOn(os, false);
+		}
+	}
+	{
+		CatchTimeType aTimer(TString("JSONPrinter/") << pPayloadName << '/' << iterations, this, '/');
+		for (long i = 0; i < iterations; ++i) {
+			String strOut;
+			OStringStream os(strOut);
+			JSONPrinter::PrintOn(os, anyPayload);
+		}
+	}
+}
+
+void JSONPerfTest::ParseTest()
+{
+	StartTrace(JSONPerfTest.ParseTest);
+	RunParseLoop("Record", RecordPayload(), iterations * 10L);
+	RunParseLoop("List", ListPayload(), iterations / 10L);
+}
+
+void JSONPerfTest::PrintTest()
+{
+	StartTrace(JSONPerfTest.PrintTest);
+	RunPrintLoop("Record", RecordPayload(), iterations * 10L);
+	RunPrintLoop("List", ListPayload(), iterations / 10L);
+	t_assertm(true, "dummy assertion to generate summary output");
+}
+
+// builds up a suite of testcases, add a line for each testmethod
+Test *JSONPerfTest::suite()
+{
+	StartTrace(JSONPerfTest.suite);
+	TestSuite *testSuite = new TestSuite;
+
+	ADD_CASE(testSuite, JSONPerfTest, ParseTest);
+	ADD_CASE(testSuite, JSONPerfTest, PrintTest);
+	ADD_CASE(testSuite, JSONPerfTest, ExportCsvStatistics);
+
+	return testSuite;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _JSONPerfTest_H
+#define _JSONPerfTest_H
+
+#include "FoundationTestTypes.h"//lint !e537
+
+//! compares reading and writing JSON with the .any text format for the same content
+class JSONPerfTest: public testframework::TestCaseWithStatistics {
+public:
+	JSONPerfTest(TString tstrName) :
+		TestCaseType(tstrName) {
+	}
+	static Test *suite();
+
+	//! AnythingParser versus JSONParser
+	void ParseTest();
+	//! Anything::PrintOn versus JSONPrinter
+	void PrintTest();
+
+protected:
+	void RunParseLoop(const char *pPayloadName, const Anything &anyPayload, const long iterations);
+	void RunPrintLoop(const char *pPayloadName, const Anything &anyPayload, const long iterations);
+};
+
+#endif
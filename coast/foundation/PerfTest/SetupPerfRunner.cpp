@@ -9,9 +9,13 @@
 #include "TestRunner.h"
 #include "AnythingPerfTest.h"
 #include "StringPerfTest.h"
+#include "URLUtilsPerfTest.h"
+#include "JSONPerfTest.h"
 
 void setupRunner(TestRunner &runner)
 {//lint !e14
 	ADD_SUITE(runner, StringPerfTest);
 	ADD_SUITE(runner, AnythingPerfTest);
+	ADD_SUITE(runner, URLUtilsPerfTest);
+	ADD_SUITE(runner, JSONPerfTest);
 }
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "URLUtilsPerfTest.h"
+#include "TestSuite.h"
+#include "URLUtils.h"
+
+namespace {
+	const long iterations = 20000L;
+
+	//! typical login/search form body as sent by browsers, few escapes
+	String FormPayload() {
+		return "fld_user=some.user%40example.com&fld_password=s3cr3t%21&action=Login&page=WelcomePage"
+				"&fld_search=coast+application+server&fld_lang=D&fld_remember=on&role=Customer";
+	}
+
+	//! free text field with a lot of escaped characters
+	String EscapedPayload() {
+		String strPayload;
+		for (long i = 0; i < 10L; ++i) {
+			strPayload << "Gr%C3%BCezi+mitenand%2C+%22quoted%22+%26+%3Cb%3Ebold%3C%2Fb%3E+100%25%0D%0A";
+		}
+		return strPayload;
+	}
+
+	//! large textarea submission with mostly plain text
+	String LargePayload() {
+		String strPayload(16384L);
+		strPayload << "fld_text=";
+		for (long i = 0; i < 100L; ++i) {
+			strPayload << "Lorem+ipsum+dolor+sit+amet%2C+consectetur+adipiscing+elit.+";
+		}
+		strPayload << "&action=Save";
+		return strPayload;
+	}
+
+	//! rendered output containing markup and entities
+	String HtmlPayload() {
+		String strPayload;
+		for (long i = 0; i < 20L; ++i) {
+			strPayload << "<td class=\"value\">Smith &amp; Sons &#228;&#246;&#252; &#x41;</td>";
+		}
+		return strPayload;
+	}
+
+	String UrlDecodePlus(const String &str) {
+		return coast::urlutils::urlDecode(str);
+	}
+	String ExhaustiveUrlDecodePlus(const String &str) {
+		return coast::urlutils::ExhaustiveUrlDecode(str);
+	}
+	String UrlEncode(const String &str) {
+		return coast::urlutils::urlEncode(str);
+	}
+	String CheckUrlEncoding(const String &str) {
+		return coast::urlutils::CheckUrlEncoding(str) ? "ok" : "nok";
+	}
+}
+
+void URLUtilsPerfTest::RunLoop(const char *pFuncName, StringFunc pFunc, const char *pPayloadName, const String &strPayload, const long iterations)
+{
+	String out;
+	CatchTimeType aTimer(TString(pFuncName) << '/' << pPayloadName << '/' << iterations, this, '/');
+	for (long i = 0; i < iterations; ++i) {
+		out = pFunc(strPayload);
+	}
+}
+
+void URLUtilsPerfTest::UrlDecodeTest()
+{
+	StartTrace(URLUtilsPerfTest.UrlDecodeTest);
+	RunLoop("urlDecode", UrlDecodePlus, "Form", FormPayload(), iterations);
+	RunLoop("urlDecode", UrlDecodePlus, "Escaped", EscapedPayload(), iterations);
+	RunLoop("urlDecode", UrlDecodePlus, "Large", LargePayload(), iterations / 10L);
+	RunLoop("ExhaustiveUrlDecode", ExhaustiveUrlDecodePlus, "Form", FormPayload(), iterations);
+	RunLoop("ExhaustiveUrlDecode", ExhaustiveUrlDecodePlus, "Escaped", EscapedPayload(), iterations);
+	RunLoop("ExhaustiveUrlDecode", ExhaustiveUrlDecodePlus, "Large", LargePayload(), iterations / 10L);
+	t_assertm(true, "dummy assertion to generate summary output");
+}
+
+void URLUtilsPerfTest::HtmlEscapeDecodeTest()
+{
+	StartTrace(URLUtilsPerfTest.HtmlEscapeDecodeTest);
+	RunLoop("HTMLEscape", coast::urlutils::HTMLEscape, "Form", FormPayload(), iterations);
+	RunLoop("HTMLEscape", coast::urlutils::HTMLEscape, "Html", HtmlPayload(), iterations);
+	RunLoop("HTMLDecode", coast::urlutils::HTMLDecode, "Html", HtmlPayload(), iterations);
+	RunLoop("HTMLDecode", coast::urlutils::HTMLDecode, "Large", LargePayload(), iterations / 10L);
+	t_assertm(true, "dummy assertion to generate summary output");
+}
+
+void URLUtilsPerfTest::UrlEncodeTest()
+{
+	StartTrace(URLUtilsPerfTest.UrlEncodeTest);
+	String strDecoded(coast::urlutils::urlDecode(EscapedPayload()));
+	RunLoop("urlEncode", UrlEncode, "Form", FormPayload(), iterations);
+	RunLoop("urlEncode", UrlEncode, "Decoded", strDecoded, iterations);
+	RunLoop("CheckUrlEncoding", CheckUrlEncoding, "Form", FormPayload(), iterations);
+	RunLoop("CheckUrlEncoding", CheckUrlEncoding, "Large", LargePayload(), iterations / 10L);
+	t_assertm(true, "dummy assertion to generate summary output");
+}
+
+// builds up a suite of testcases, add a line for each testmethod
+Test *URLUtilsPerfTest::suite()
+{
+	StartTrace(URLUtilsPerfTest.suite);
+	TestSuite *testSuite = new TestSuite;
+
+	ADD_CASE(testSuite, URLUtilsPerfTest, UrlDecodeTest);
+	ADD_CASE(testSuite, URLUtilsPerfTest, HtmlEscapeDecodeTest);
+	ADD_CASE(testSuite, URLUtilsPerfTest, UrlEncodeTest);
+	ADD_CASE(testSuite, URLUtilsPerfTest, ExportCsvStatistics);
+
+	return testSuite;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _URLUtilsPerfTest_H
+#define _URLUtilsPerfTest_H
+
+#include "FoundationTestTypes.h"//lint !e537
+
+//! measures the encoding and decoding functions of coast::urlutils on form like payloads
+class URLUtilsPerfTest: public testframework::TestCaseWithStatistics {
+public:
+	URLUtilsPerfTest(TString tstrName) :
+		TestCaseType(tstrName) {
+	}
+	static Test *suite();
+
+	//! urlDecode and ExhaustiveUrlDecode of query strings and form bodies
+	void UrlDecodeTest();
+	//! HTMLEscape and HTMLDecode of rendered field values
+	void HtmlEscapeDecodeTest();
+	//! urlEncode and CheckUrlEncoding of link targets
+	void UrlEncodeTest();
+
+protected:
+	typedef String (*StringFunc)(const String &);
+	void RunLoop(const char *pFuncName, StringFunc pFunc, const char *pPayloadName, const String &strPayload, const long iterations);
+};
+
+#endif
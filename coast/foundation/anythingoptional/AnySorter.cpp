@@ -8,6 +8,8 @@
 
 #include "AnySorter.h"
 #include "Tracer.h"
+#include <algorithm>
+#include <vector>
 
 //! shuffles anys where lookuppath is not defined towards the end, keeping their original sequence
 SpecialLookupComparer::SpecialLookupComparer(const char *lookuppath, const AnyComparer &theValueComparer)
@@ -30,30 +32,92 @@ int SpecialLookupComparer::Compare(const Anything &left, const Anything &right)
 	return ac.Compare(intleft, intright);
 }
 
-void AnySorter::SortByKeyInArray(const String &sortFieldName, Anything &toSort, EMode mode, bool sortCritIsNumber)
-{
-	StartTrace(AnySorter.SortByKeyInArray);
+namespace {
+	//! sort key of one array entry, looked up once before sorting
+	struct SortRow {
+		bool fFound;
+		long fNumber;
+		u_long fPrefix;
+		long fSlot;
+	};
 
-//	static AnyStringValueComparer asc;
-//	static AnyLongValueComparer asl;
-//	AnyComparer &cm = (sortCritIsNumber? (AnyComparer&)asl:(AnyComparer&)asc);
-	// this ugly code is for brain dead legacy gcc compiler...
-	// it doesn't seem to correctly initialize static instances, resp. their vtables
-	if (mode == AnySorter::asc) {
-		if (sortCritIsNumber) {
-			toSort.SortByAnyComparer(SpecialLookupComparer(sortFieldName, AnyLongValueComparer()));
-		} else {
-			toSort.SortByAnyComparer(SpecialLookupComparer(sortFieldName, AnyStringValueComparer()));
+	//! leading bytes of str packed big endian and zero padded, ordered like String::Compare orders the strings
+	u_long TextPrefix(const String &str)
+	{
+		long const lLength = str.Length();
+		const unsigned char *pStr = reinterpret_cast<const unsigned char *>(str.cstr());
+		u_long ulPrefix = 0UL;
+		for (long i = 0; i < static_cast<long>(sizeof(u_long)); ++i) {
+			ulPrefix <<= 8;
+			if (i < lLength) {
+				ulPrefix |= pStr[i];
+			}
 		}
-	} else {
-		if (sortCritIsNumber) {
-			toSort.SortByAnyComparer(SpecialLookupComparer(sortFieldName, AnyReverseComparer(AnyLongValueComparer())));
-		} else {
-			toSort.SortByAnyComparer(SpecialLookupComparer(sortFieldName, AnyReverseComparer(AnyStringValueComparer())));
+		return ulPrefix;
+	}
+
+	//! strict ordering for std::stable_sort, entries without sort key go to the end
+	class SortRowLess
+	{
+		const std::vector<String> &fTexts;
+		bool fNumeric;
+		bool fDescending;
+	public:
+		SortRowLess(const std::vector<String> &texts, bool bNumeric, bool bDescending)
+			: fTexts(texts), fNumeric(bNumeric), fDescending(bDescending) {}
+		bool operator()(const SortRow &left, const SortRow &right) const {
+			if (left.fFound != right.fFound) {
+				return left.fFound;
+			}
+			if (!left.fFound) {
+				return false;
+			}
+			int iCmp = 0;
+			if (fNumeric) {
+				iCmp = (left.fNumber < right.fNumber) ? -1 : ((left.fNumber > right.fNumber) ? 1 : 0);
+			} else if (left.fPrefix != right.fPrefix) {
+				iCmp = (left.fPrefix < right.fPrefix) ? -1 : 1;
+			} else {
+				iCmp = fTexts[left.fSlot].Compare(fTexts[right.fSlot]);
+			}
+			return fDescending ? (iCmp > 0) : (iCmp < 0);
 		}
+	};
+}
 
+void AnySorter::SortByKeyInArray(const String &sortFieldName, Anything &toSort, EMode mode, bool sortCritIsNumber)
+{
+	StartTrace(AnySorter.SortByKeyInArray);
+	// look up the sort keys once into a contiguous table instead of twice per comparison,
+	// the order computed on the table is applied to toSort in one step
+	long const lSize = toSort.GetSize();
+	if (toSort.GetType() != AnyArrayType || lSize < 2) {
+		TraceAny(toSort, "toSort");
+		return;
+	}
+	std::vector<SortRow> rows(lSize);
+	std::vector<String> texts(sortCritIsNumber ? 0L : lSize);
+	Anything value;
+	for (long i = 0; i < lSize; ++i) {
+		SortRow &row = rows[i];
+		row.fSlot = i;
+		row.fNumber = 0L;
+		row.fPrefix = 0UL;
+		row.fFound = toSort[i].LookupPath(value, sortFieldName);
+		if (row.fFound) {
+			if (sortCritIsNumber) {
+				row.fNumber = value.AsLong();
+			} else {
+				texts[i] = value.AsString();
+				row.fPrefix = TextPrefix(texts[i]);
+			}
+		}
+	}
+	std::stable_sort(rows.begin(), rows.end(), SortRowLess(texts, sortCritIsNumber, mode == AnySorter::desc));
+	std::vector<long> order(lSize);
+	for (long i = 0; i < lSize; ++i) {
+		order[i] = rows[i].fSlot;
 	}
-//	toSort.SortByAnyComparer(SpecialLookupComparer(sortFieldName,(const AnyComparer&)(() ?
-//	(sortCritIsNumber? asl:asc) : AnyReverseComparer(sortCritIsNumber? asl:asc))));
+	toSort.SortByOrder(&order[0]);
 	TraceAny(toSort, "toSort");
 }
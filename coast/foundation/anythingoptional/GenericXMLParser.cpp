@@ -23,6 +23,82 @@ Anything GenericXMLParser::Parse(std::istream &reader, const char *filename, lon
 	return fParseTree;
 }
 
+bool GenericXMLParser::ParseEvents(std::istream &reader, EventHandler &handler, const char *filename, long startline)
+{
+	StartTrace(GenericXMLParser.ParseEvents);
+	fReader = &reader;
+	fFileName = filename;
+	fLine = startline;
+	// only collects the errors
+	fParseTree = Anything();
+	Anything openTags;
+	String text;
+	int c, lookahead;
+	while ((c = Get()) != 0 && c != EOF) {
+		switch (c) {
+			case '<':
+				if (text.Length() > 0) {
+					handler.Characters(text);
+					text = "";
+				}
+				lookahead = Peek();
+				if ('!' == lookahead || '?' == lookahead) {
+					Anything node = ('!' == lookahead) ? ParseCommentCdataOrDtd() : ParseXmlOrProcessingInstruction();
+					if (!node.IsNull()) {
+						handler.Node(node);
+					}
+				} else if ('/' == lookahead) {
+					Get();
+					String tagname = ParseName();
+					long lOpen = openTags.GetSize();
+					c = Peek();
+					if ('>' == c && lOpen > 0 && tagname == openTags[lOpen - 1L].AsString()) {
+						Get();
+						openTags.Remove(lOpen - 1L);
+						handler.EndElement(tagname);
+					} else {
+						// a potential syntax error...
+						text.Append("</").Append(tagname);
+						String msg("Unexpected character <x");
+						msg.AppendAsHex((unsigned char)c).Append('>');
+						msg.Append(" or mismatched tag: ").Append(tagname);
+						msg.Append(" expected: ").Append(lOpen > 0 ? openTags[lOpen - 1L].AsString() : String());
+						Error(msg);
+					}
+				} else if (IsValidNameChar(lookahead)) {
+					String tagname;
+					Anything attrs;
+					bool hasbody = ParseTag(tagname, attrs);
+					handler.StartElement(tagname, attrs);
+					if (hasbody) {
+						openTags.Append(tagname);
+					} else {
+						handler.EndElement(tagname);
+					}
+				} else {
+					// it cannot be a tag, so just append the '<'
+					text << (char)c;
+				}
+				break;
+			case '\x0D':// normalize line feeds
+				if ('\x0A' == Peek()) {
+					Get();
+				}
+				c = '\x0A' ;
+				// Fall Through...
+			default:
+				text << ((char)c);
+		}
+	}
+	if (text.Length() > 0) {
+		handler.Characters(text);
+	}
+	for (long lOpen = openTags.GetSize(); lOpen > 0; --lOpen) {
+		handler.EndElement(openTags[lOpen - 1L].AsString());
+	}
+	return !fParseTree.IsDefined("Errors");
+}
+
 void GenericXMLParser::DoParse(String theTag, Anything &tag)
 {
 	StartTrace(GenericXMLParser.DoParse);
@@ -23,6 +23,21 @@ construct an anything representation of DOM parsing the XML
 class GenericXMLParser
 {
 public:
+	//! receives the constructs of a document parsed with ParseEvents() in document order
+	class EventHandler
+	{
+	public:
+		virtual ~EventHandler() {}
+		//! start tag of an element, an empty tag like <br/> is followed by EndElement() immediately
+		virtual void StartElement(const String &tag, Anything &attributes) = 0;
+		//! end tag of an element, elements still open at the end of the input are ended too
+		virtual void EndElement(const String &tag) = 0;
+		//! character data between two tags with normalized line feeds
+		virtual void Characters(const String &text) = 0;
+		//! comment, CDATA section, processing instruction or DTD in the form Parse() stores them, e.g. { /!-- "comment" }
+		virtual void Node(Anything &node) = 0;
+	};
+
 	virtual ~GenericXMLParser() {}//lint !e1401//lint !e1401
 	//! do the parsing,
 	//! \return the constructed Anything using the given Allocator
@@ -31,6 +46,14 @@ public:
 	//! \param startline the line number when starting the parsing for convenient error messages
 	//! \param a the allocator to use, provide coast::storage::Global() for config data
 	Anything Parse(std::istream &reader, const char *filename = "NO_FILE", long startline = 1L, Allocator *a = coast::storage::Current());
+	//! parse without building a tree, the constructs are passed to handler as soon as they are read
+	/*! memory used does not depend on the size of the document but on the largest text, tag or comment in it
+		\param reader the input source
+		\param handler receives the parsed constructs
+		\param filename for giving convenient error messages when reading from a real file
+		\param startline the line number when starting the parsing for convenient error messages
+		\return false if syntax errors were found, they are logged like with Parse() */
+	bool ParseEvents(std::istream &reader, EventHandler &handler, const char *filename = "NO_FILE", long startline = 1L);
 protected:
 	virtual void DoParse(String endTag, Anything &tag);
 	virtual Anything ParseComment();
@@ -0,0 +1,531 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "JSONParser.h"
+#include "AnyVisitor.h"
+#include "Tracer.h"
+#include "SystemLog.h"
+#include <limits>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+	//! characters a JSON string can contain without escaping, everything else ends a run of plain characters
+	class JSONCharClasses {
+		bool fPlain[256];
+	public:
+		JSONCharClasses() {
+			for (int c = 0; c < 256; ++c) {
+				fPlain[c] = ( c >= 0x20 && c != '"' && c != '\\' );
+			}
+		}
+		bool IsPlain(char c) const {
+			return fPlain[static_cast<unsigned char>(c)];
+		}
+	};
+	const JSONCharClasses gJSONChars;
+
+	//! end of the run of plain characters starting at pcPos
+	inline const char *SkipPlain(const char *pcPos, const char *pcEnd) {
+		while ( pcPos < pcEnd && gJSONChars.IsPlain(*pcPos) ) {
+			++pcPos;
+		}
+		return pcPos;
+	}
+
+	inline bool IsDigit(const char *pcPos, const char *pcEnd) {
+		return pcPos < pcEnd && *pcPos >= '0' && *pcPos <= '9';
+	}
+
+	void AppendUTF8(String &str, unsigned long ulCode) {
+		if ( ulCode < 0x80UL ) {
+			str.Append(static_cast<char>(ulCode));
+		} else if ( ulCode < 0x800UL ) {
+			str.Append(static_cast<char>(0xC0 | (ulCode >> 6)));
+			str.Append(static_cast<char>(0x80 | (ulCode & 0x3F)));
+		} else if ( ulCode < 0x10000UL ) {
+			str.Append(static_cast<char>(0xE0 | (ulCode >> 12)));
+			str.Append(static_cast<char>(0x80 | ((ulCode >> 6) & 0x3F)));
+			str.Append(static_cast<char>(0x80 | (ulCode & 0x3F)));
+		} else {
+			str.Append(static_cast<char>(0xF0 | (ulCode >> 18)));
+			str.Append(static_cast<char>(0x80 | ((ulCode >> 12) & 0x3F)));
+			str.Append(static_cast<char>(0x80 | ((ulCode >> 6) & 0x3F)));
+			str.Append(static_cast<char>(0x80 | (ulCode & 0x3F)));
+		}
+	}
+
+	class JSONAnyPrinter: public AnyVisitor {
+		std::ostream &fOs;
+		bool fPretty;
+		long fLevel;
+		void NewLine() {
+			if ( fPretty ) {
+				fOs.put('\n');
+				for (long i = 0; i < fLevel; ++i) {
+					fOs.put(' ').put(' ');
+				}
+			}
+		}
+	public:
+		JSONAnyPrinter(std::ostream &os, bool bPretty) :
+			fOs(os), fPretty(bPretty), fLevel(0L) {
+		}
+		virtual void VisitNull(long lIdx, const char *slotname) {
+			fOs << "null";
+		}
+		virtual void VisitCharPtr(const String &value, const AnyImpl *id, long lIdx, const char *slotname) {
+			JSONPrinter::PrintString(fOs, value.cstr(), value.Length());
+		}
+		virtual void VisitArray(const ROAnything value, const AnyImpl *id, long lIdx, const char *slotname) {
+			long sz = value.GetSize();
+			bool bObject = false;
+			for (long i = 0; i < sz && !bObject; ++i) {
+				bObject = ( value.SlotName(i) != 0 );
+			}
+			if ( sz == 0L ) {
+				fOs << "[]";
+				return;
+			}
+			fOs.put(bObject ? '{' : '[');
+			++fLevel;
+			for (long i = 0; i < sz; ++i) {
+				if ( i > 0L ) {
+					fOs.put(',');
+				}
+				NewLine();
+				const String &strKey = value.VisitSlotName(i);
+				if ( bObject ) {
+					if ( strKey.Length() > 0L ) {
+						JSONPrinter::PrintString(fOs, strKey.cstr(), strKey.Length());
+					} else {
+						fOs << '"' << i << '"';
+					}
+					fOs.put(':');
+					if ( fPretty ) {
+						fOs.put(' ');
+					}
+				}
+				value[i].Accept(*this, i, strKey);
+			}
+			--fLevel;
+			NewLine();
+			fOs.put(bObject ? '}' : ']');
+		}
+		virtual void VisitLong(long value, const AnyImpl *id, long lIdx, const char *slotname) {
+			fOs << value;
+		}
+		virtual void VisitDouble(double value, const AnyImpl *id, long lIdx, const char *slotname) {
+			// infinity and NaN have no JSON representation
+			if ( value - value != 0.0 ) {
+				fOs << "null";
+			} else {
+				String strBuf;
+				String::DoubleToString(value, strBuf);
+				fOs << strBuf;
+			}
+		}
+		virtual void VisitVoidBuf(const String &value, const AnyImpl *id, long lIdx, const char *slotname) {
+			JSONPrinter::PrintString(fOs, value.cstr(), value.Length());
+		}
+		virtual void VisitObject(IFAObject *value, const AnyImpl *id, long lIdx, const char *slotname) {
+			fOs << "null";
+		}
+	};
+}
+
+JSONParser::JSONParser(const char *filename)
+	: fFileName(filename)
+	, fBegin(0)
+	, fPos(0)
+	, fEnd(0)
+	, fAllocator(coast::storage::Current())
+{
+}
+
+bool JSONParser::Parse(std::istream &reader, Anything &result, Allocator *a)
+{
+	StartTrace(JSONParser.Parse);
+	const long cChunkSize = 16384L;
+	String strInput(cChunkSize);
+	while ( reader.good() ) {
+		strInput.Append(reader, cChunkSize);
+	}
+	return Parse(strInput.cstr(), strInput.Length(), result, a);
+}
+
+bool JSONParser::Parse(const char *pcText, long lLength, Anything &result, Allocator *a)
+{
+	StartTrace1(JSONParser.Parse, "length:" << lLength);
+	fBegin = fPos = pcText;
+	fEnd = pcText + ( pcText ? lLength : 0L );
+	fAllocator = a;
+	result = Anything();
+	result.SetAllocator(a);
+	if ( !ParseValue(result, 0L) ) {
+		return false;
+	}
+	SkipWhitespace();
+	if ( fPos < fEnd ) {
+		return Error("unexpected characters after value");
+	}
+	return true;
+}
+
+void JSONParser::SkipWhitespace()
+{
+	while ( fPos < fEnd && ( *fPos == ' ' || *fPos == '\n' || *fPos == '\r' || *fPos == '\t' ) ) {
+		++fPos;
+	}
+}
+
+bool JSONParser::ParseValue(Anything &value, long lDepth)
+{
+	SkipWhitespace();
+	if ( fPos >= fEnd ) {
+		return Error("unexpected end of input");
+	}
+	switch ( *fPos ) {
+		case '{':
+			return ParseObject(value, lDepth);
+		case '[':
+			return ParseArray(value, lDepth);
+		case '"': {
+			// strings without escapes are built directly from the input
+			const char *pcStart = fPos + 1;
+			const char *pcRunEnd = SkipPlain(pcStart, fEnd);
+			if ( pcRunEnd < fEnd && *pcRunEnd == '"' ) {
+				value = Anything(pcStart, pcRunEnd - pcStart, fAllocator);
+				fPos = pcRunEnd + 1;
+				return true;
+			}
+			String str(fAllocator);
+			if ( !ParseString(str) ) {
+				return false;
+			}
+			value = Anything(str, fAllocator);
+			return true;
+		}
+		case 't':
+			value = Anything(1L, fAllocator);
+			return ParseLiteral("true", 4L);
+		case 'f':
+			value = Anything(0L, fAllocator);
+			return ParseLiteral("false", 5L);
+		case 'n':
+			value = Anything(fAllocator);
+			return ParseLiteral("null", 4L);
+		default:
+			return ParseNumber(value);
+	}
+}
+
+bool JSONParser::ParseObject(Anything &value, long lDepth)
+{
+	if ( lDepth >= cMaxDepth ) {
+		return Error("objects and arrays nested too deep");
+	}
+	++fPos;
+	value = Anything(Anything::ArrayMarker(), fAllocator);
+	SkipWhitespace();
+	if ( fPos < fEnd && *fPos == '}' ) {
+		++fPos;
+		return true;
+	}
+	String strKey;
+	for (;;) {
+		SkipWhitespace();
+		if ( fPos >= fEnd || *fPos != '"' ) {
+			return Error("member name expected");
+		}
+		strKey.Trim(0L);
+		if ( !ParseString(strKey) ) {
+			return false;
+		}
+		SkipWhitespace();
+		if ( fPos >= fEnd || *fPos != ':' ) {
+			return Error("':' expected after member name");
+		}
+		++fPos;
+		Anything &member = ( strKey.Length() > 0L ) ? value[strKey.cstr()] : value[value.GetSize()];
+		if ( !ParseValue(member, lDepth + 1L) ) {
+			return false;
+		}
+		SkipWhitespace();
+		if ( fPos < fEnd && *fPos == ',' ) {
+			++fPos;
+		} else if ( fPos < fEnd && *fPos == '}' ) {
+			++fPos;
+			return true;
+		} else {
+			return Error("',' or '}' expected in object");
+		}
+	}
+}
+
+bool JSONParser::ParseArray(Anything &value, long lDepth)
+{
+	if ( lDepth >= cMaxDepth ) {
+		return Error("objects and arrays nested too deep");
+	}
+	++fPos;
+	value = Anything(Anything::ArrayMarker(), fAllocator);
+	SkipWhitespace();
+	if ( fPos < fEnd && *fPos == ']' ) {
+		++fPos;
+		return true;
+	}
+	for (;;) {
+		if ( !ParseValue(value[value.GetSize()], lDepth + 1L) ) {
+			return false;
+		}
+		SkipWhitespace();
+		if ( fPos < fEnd && *fPos == ',' ) {
+			++fPos;
+		} else if ( fPos < fEnd && *fPos == ']' ) {
+			++fPos;
+			return true;
+		} else {
+			return Error("',' or ']' expected in array");
+		}
+	}
+}
+
+bool JSONParser::ParseString(String &str)
+{
+	// skip the opening quote
+	++fPos;
+	for (;;) {
+		const char *pcRunEnd = SkipPlain(fPos, fEnd);
+		str.Append(fPos, pcRunEnd - fPos);
+		fPos = pcRunEnd;
+		if ( fPos >= fEnd ) {
+			return Error("unterminated string");
+		}
+		if ( *fPos == '"' ) {
+			++fPos;
+			return true;
+		}
+		if ( *fPos != '\\' ) {
+			return Error("control character in string");
+		}
+		if ( ++fPos >= fEnd ) {
+			return Error("unterminated string");
+		}
+		switch ( *fPos++ ) {
+			case '"':
+				str.Append('"');
+				break;
+			case '\\':
+				str.Append('\\');
+				break;
+			case '/':
+				str.Append('/');
+				break;
+			case 'b':
+				str.Append('\b');
+				break;
+			case 'f':
+				str.Append('\f');
+				break;
+			case 'n':
+				str.Append('\n');
+				break;
+			case 'r':
+				str.Append('\r');
+				break;
+			case 't':
+				str.Append('\t');
+				break;
+			case 'u':
+				if ( !ParseUnicodeEscape(str) ) {
+					return false;
+				}
+				break;
+			default:
+				--fPos;
+				return Error("invalid escape in string");
+		}
+	}
+}
+
+bool JSONParser::ParseHex4(unsigned long &ulCode)
+{
+	if ( fEnd - fPos < 4L ) {
+		return Error("incomplete \\u escape");
+	}
+	ulCode = 0UL;
+	for (const char *pcHexEnd = fPos + 4; fPos < pcHexEnd; ++fPos) {
+		char c = *fPos;
+		ulCode <<= 4;
+		if ( c >= '0' && c <= '9' ) {
+			ulCode |= static_cast<unsigned long>(c - '0');
+		} else if ( c >= 'a' && c <= 'f' ) {
+			ulCode |= static_cast<unsigned long>(c - 'a' + 10);
+		} else if ( c >= 'A' && c <= 'F' ) {
+			ulCode |= static_cast<unsigned long>(c - 'A' + 10);
+		} else {
+			return Error("invalid hex digit in \\u escape");
+		}
+	}
+	return true;
+}
+
+bool JSONParser::ParseUnicodeEscape(String &str)
+{
+	unsigned long ulCode = 0UL;
+	if ( !ParseHex4(ulCode) ) {
+		return false;
+	}
+	if ( ulCode >= 0xD800UL && ulCode <= 0xDBFFUL ) {
+		// a high surrogate has to be followed by the escaped low surrogate
+		unsigned long ulLow = 0UL;
+		if ( fEnd - fPos < 2L || fPos[0] != '\\' || fPos[1] != 'u' ) {
+			return Error("missing low surrogate after \\u escape");
+		}
+		fPos += 2;
+		if ( !ParseHex4(ulLow) ) {
+			return false;
+		}
+		if ( ulLow < 0xDC00UL || ulLow > 0xDFFFUL ) {
+			return Error("invalid low surrogate in \\u escape");
+		}
+		ulCode = 0x10000UL + ( ( ulCode - 0xD800UL ) << 10 ) + ( ulLow - 0xDC00UL );
+	} else if ( ulCode >= 0xDC00UL && ulCode <= 0xDFFFUL ) {
+		return Error("unexpected low surrogate in \\u escape");
+	}
+	AppendUTF8(str, ulCode);
+	return true;
+}
+
+bool JSONParser::ParseNumber(Anything &value)
+{
+	const char *pcStart = fPos;
+	bool bNegative = ( *fPos == '-' );
+	if ( bNegative ) {
+		++fPos;
+	}
+	const char *pcDigits = fPos;
+	if ( fPos < fEnd && *fPos == '0' ) {
+		++fPos;
+	} else if ( IsDigit(fPos, fEnd) ) {
+		while ( IsDigit(fPos, fEnd) ) {
+			++fPos;
+		}
+	} else {
+		fPos = pcStart;
+		return Error("unexpected character");
+	}
+	long lIntegralDigits = fPos - pcDigits;
+	bool bIntegral = true;
+	if ( fPos < fEnd && *fPos == '.' ) {
+		bIntegral = false;
+		if ( !IsDigit(++fPos, fEnd) ) {
+			return Error("digit expected after decimal point");
+		}
+		while ( IsDigit(fPos, fEnd) ) {
+			++fPos;
+		}
+	}
+	if ( fPos < fEnd && ( *fPos == 'e' || *fPos == 'E' ) ) {
+		bIntegral = false;
+		if ( ++fPos < fEnd && ( *fPos == '+' || *fPos == '-' ) ) {
+			++fPos;
+		}
+		if ( !IsDigit(fPos, fEnd) ) {
+			return Error("digit expected in exponent");
+		}
+		while ( IsDigit(fPos, fEnd) ) {
+			++fPos;
+		}
+	}
+	if ( bIntegral && lIntegralDigits <= std::numeric_limits<long>::digits10 ) {
+		long lValue = 0L;
+		for (const char *pcDigit = pcDigits; pcDigit < fPos; ++pcDigit) {
+			lValue = lValue * 10L + ( *pcDigit - '0' );
+		}
+		value = Anything(bNegative ? -lValue : lValue, fAllocator);
+	} else {
+		// strtod needs a terminated copy
+		String strNumber(pcStart, fPos - pcStart);
+		value = Anything(strtod(strNumber.cstr(), 0), fAllocator);
+	}
+	return true;
+}
+
+bool JSONParser::ParseLiteral(const char *pcLiteral, long lLength)
+{
+	if ( fEnd - fPos < lLength || strncmp(fPos, pcLiteral, lLength) != 0 ) {
+		return Error("unexpected character");
+	}
+	fPos += lLength;
+	return true;
+}
+
+bool JSONParser::Error(const char *msg)
+{
+	long lLine = 1L;
+	for (const char *pc = fBegin; pc < fPos; ++pc) {
+		if ( *pc == '\n' ) {
+			++lLine;
+		}
+	}
+	String m(fFileName);
+	m << ":" << lLine << " " << msg << " [" << String(fPos, ( fEnd - fPos < 20L ) ? fEnd - fPos : 20L) << "]";
+	SYSWARNING(m);
+	return false;
+}
+
+void JSONPrinter::PrintOn(std::ostream &os, const ROAnything &any, bool bPretty)
+{
+	StartTrace(JSONPrinter.PrintOn);
+	JSONAnyPrinter aPrinter(os, bPretty);
+	any.Accept(aPrinter);
+}
+
+void JSONPrinter::PrintString(std::ostream &os, const char *pcStr, long lLength)
+{
+	static const char cHex[] = "0123456789abcdef";
+	const char *pcEnd = pcStr + lLength;
+	os.put('"');
+	while ( pcStr < pcEnd ) {
+		const char *pcRunEnd = SkipPlain(pcStr, pcEnd);
+		os.write(pcStr, pcRunEnd - pcStr);
+		if ( pcRunEnd >= pcEnd ) {
+			break;
+		}
+		char c = *pcRunEnd;
+		switch ( c ) {
+			case '"':
+				os << "\\\"";
+				break;
+			case '\\':
+				os << "\\\\";
+				break;
+			case '\b':
+				os << "\\b";
+				break;
+			case '\f':
+				os << "\\f";
+				break;
+			case '\n':
+				os << "\\n";
+				break;
+			case '\r':
+				os << "\\r";
+				break;
+			case '\t':
+				os << "\\t";
+				break;
+			default:
+				os << "\\u00" << cHex[(c >> 4) & 0x0F] << cHex[c & 0x0F];
+		}
+		pcStr = pcRunEnd + 1;
+	}
+	os.put('"');
+}
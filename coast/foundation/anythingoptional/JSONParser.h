@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _JSONParser_H
+#define _JSONParser_H
+
+#include "Anything.h"
+
+//! construct an Anything from JSON text
+/*!
+Objects become Anythings with named slots, arrays Anythings with unnamed slots. Members with an empty name are
+appended without slot name. Strings are stored UTF-8 encoded with \\u escapes resolved, integral numbers fitting
+into a long as long and all other numbers as double. true and false become the longs 1 and 0, null becomes a
+null Anything. The whole input is read before parsing, the values are built directly with the given Allocator.
+*/
+class JSONParser
+{
+public:
+	//! \param filename used in error messages only
+	JSONParser(const char *filename = "NO_FILE");
+
+	//! read a JSON value from reader
+	//! \param reader the input source, read until EOF
+	//! \param result the parsed value, on errors it contains the values parsed before the error
+	//! \param a the allocator to use, provide coast::storage::Global() for config data
+	//! \return false if the input is not a single valid JSON value, the error is logged
+	bool Parse(std::istream &reader, Anything &result, Allocator *a = coast::storage::Current());
+
+	//! read a JSON value from a buffer
+	//! \param pcText the JSON text, does not need to be zero terminated
+	//! \param lLength number of characters in pcText
+	//! \param result the parsed value, on errors it contains the values parsed before the error
+	//! \param a the allocator to use
+	//! \return false if the input is not a single valid JSON value, the error is logged
+	bool Parse(const char *pcText, long lLength, Anything &result, Allocator *a = coast::storage::Current());
+
+	//! maximum nesting of arrays and objects accepted
+	static const long cMaxDepth = 512L;
+
+private:
+	bool ParseValue(Anything &value, long lDepth);
+	bool ParseObject(Anything &value, long lDepth);
+	bool ParseArray(Anything &value, long lDepth);
+	bool ParseString(String &str);
+	bool ParseNumber(Anything &value);
+	bool ParseLiteral(const char *pcLiteral, long lLength);
+	bool ParseUnicodeEscape(String &str);
+	bool ParseHex4(unsigned long &ulCode);
+	void SkipWhitespace();
+	bool Error(const char *msg);
+
+	String fFileName;
+	const char *fBegin;
+	const char *fPos;
+	const char *fEnd;
+	Allocator *fAllocator;
+};
+
+//! write Anythings as JSON
+/*!
+An Anything with at least one named slot is written as object, unnamed slots get their index as member name.
+Other arrays are written as JSON array. Strings and binary buffers are written as strings, only quotes, backslashes
+and control characters are escaped, so UTF-8 content is kept as is. Numbers that are not finite and object
+references are written as null.
+*/
+class JSONPrinter
+{
+public:
+	//! write any to os
+	//! \param os the stream to write to
+	//! \param any the value to write
+	//! \param bPretty if true, members and elements are written on lines of their own indented by two spaces per level
+	static void PrintOn(std::ostream &os, const ROAnything &any, bool bPretty = false);
+
+	//! write str as quoted JSON string
+	static void PrintString(std::ostream &os, const char *pcStr, long lLength);
+};
+
+#endif
@@ -207,6 +207,63 @@ void GenericXMLParserTest::simpleXMLError()
 	t_assert(result.IsDefined("Errors"));
 }
 
+namespace {
+	//! rebuilds the tree Parse() returns from the events
+	class TreeBuilder: public GenericXMLParser::EventHandler {
+		Anything fOpen;
+	public:
+		Anything fTree;
+		virtual void StartElement(const String &tag, Anything &attributes) {
+			Anything element;
+			element[tag] = attributes;
+			fOpen.Append(element);
+		}
+		virtual void EndElement(const String &tag) {
+			Anything element = fOpen[fOpen.GetSize() - 1L];
+			fOpen.Remove(fOpen.GetSize() - 1L);
+			Node(element);
+		}
+		virtual void Characters(const String &text) {
+			Anything anyText(text);
+			Node(anyText);
+		}
+		virtual void Node(Anything &node) {
+			( fOpen.GetSize() > 0L ? fOpen[fOpen.GetSize() - 1L] : fTree ).Append(node);
+		}
+	};
+}
+
+void GenericXMLParserTest::parseEventsTest()
+{
+	StartTrace(GenericXMLParserTest.parseEventsTest);
+	String input("<?xml version=\"1.0\"?>"
+				 "<!DOCTYPE note ["
+				 "<!ELEMENT note (to,from,body)>"
+				 "]>\r\n"
+				 "<note date='2005'>\r\n"
+				 "  <to>Tove</to><br/>"
+				 "  <!-- a comment -->"
+				 "  <from><![CDATA[<Jani>]]></from>"
+				 "  <body>Don't forget me < this weekend</body>"
+				 "</note>\n"
+				);
+	IStringStream is(input);
+	GenericXMLParser p;
+	Anything expected = p.Parse(is);
+	IStringStream is2(input);
+	TreeBuilder aBuilder;
+	t_assert(p.ParseEvents(is2, aBuilder));
+	TraceAny(aBuilder.fTree, "rebuilt tree");
+	assertAnyEqual(expected, aBuilder.fTree);
+
+	input = "<a><b>text</a>";
+	IStringStream is3(input);
+	TreeBuilder aErrorBuilder;
+	t_assert(!p.ParseEvents(is3, aErrorBuilder));
+	assertEqual("a", aErrorBuilder.fTree[0L].SlotName(0L));
+	assertEqual("b", aErrorBuilder.fTree[0L][1L].SlotName(0L));
+}
+
 void GenericXMLParserTest::configuredTests()
 {
 	StartTrace(GenericXMLParserTest.configuredTests);
@@ -248,6 +305,7 @@ Test *GenericXMLParserTest::suite ()
 	ADD_CASE(testSuite, GenericXMLParserTest, simpleDTDExampleXML);
 	ADD_CASE(testSuite, GenericXMLParserTest, simpleXMLError);
 	ADD_CASE(testSuite, GenericXMLParserTest, simpleParsePrint);
+	ADD_CASE(testSuite, GenericXMLParserTest, parseEventsTest);
 	ADD_CASE(testSuite, GenericXMLParserTest, configuredTests);
 	return testSuite;
 }
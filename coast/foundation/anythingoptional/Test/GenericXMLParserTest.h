@@ -40,6 +40,7 @@ public:
 	void simpleDTDExampleXML();
 	void simpleXMLError();
 	void simpleParsePrint();
+	void parseEventsTest();
 	void configuredTests();
 };
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "JSONParserTest.h"
+#include "TestSuite.h"
+#include "JSONParser.h"
+#include "AnyIterators.h"
+#include "PoolAllocator.h"
+
+JSONParserTest::JSONParserTest(TString tstrName)
+	: TestCaseType(tstrName)
+{
+	StartTrace(JSONParserTest.Ctor);
+}
+
+JSONParserTest::~JSONParserTest()
+{
+	StartTrace(JSONParserTest.Dtor);
+}
+
+void JSONParserTest::configuredTests()
+{
+	StartTrace(JSONParserTest.configuredTests);
+	ROAnything roaConfig;
+	AnyExtensions::Iterator<ROAnything, ROAnything, TString> aEntryIterator(GetTestCaseConfig());
+	while ( aEntryIterator.Next(roaConfig) ) {
+		TString strCase;
+		if ( !aEntryIterator.SlotName(strCase) ) {
+			strCase << "idx:" << aEntryIterator.Index();
+		}
+		String strInput = roaConfig["Input"].AsString();
+		IStringStream iss(strInput);
+		JSONParser p;
+		Anything result;
+		t_assertm(p.Parse(iss, result), TString("Failed at ") << strCase);
+		TraceAny(result, "result");
+		assertAnyEqualm(roaConfig["Expected"], result, TString("Failed at ") << strCase);
+	}
+}
+
+void JSONParserTest::invalidInputTest()
+{
+	StartTrace(JSONParserTest.invalidInputTest);
+	const char *inputs[] = { "", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "{a:1}", "[01]", "[1.]", "[-]", "[1e]", "tru", "nul",
+							 "\"open", "\"tab\there\"", "\"\\x\"", "\"\\u12\"", "\"\\ud800\"", "\"\\udc00\"", "[1] 2", "[1 2]"
+						   };
+	for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+		JSONParser p("invalidInputTest");
+		Anything result;
+		t_assertm(!p.Parse(inputs[i], strlen(inputs[i]), result), inputs[i]);
+	}
+	String strDeep;
+	for (long l = 0; l <= JSONParser::cMaxDepth; ++l) {
+		strDeep << '[';
+	}
+	JSONParser p("invalidInputTest");
+	Anything result;
+	t_assertm(!p.Parse(strDeep, strDeep.Length(), result), "nesting limit");
+}
+
+void JSONParserTest::allocatorTest()
+{
+	StartTrace(JSONParserTest.allocatorTest);
+	PoolAllocator pa(1, 1024, 16);
+	String strInput("{\"list\":[\"text\",\"esc\\naped\",1,2.5],\"key\":\"value\"}");
+	JSONParser p;
+	Anything result;
+	t_assert(p.Parse(strInput, strInput.Length(), result, &pa));
+	t_assert(result.GetAllocator() == &pa);
+	t_assert(result["list"].GetAllocator() == &pa);
+	t_assert(result["list"][1L].GetAllocator() == &pa);
+	assertCharPtrEqual("esc\naped", result["list"][1L].AsCharPtr());
+	assertCharPtrEqual("value", result["key"].AsCharPtr());
+	result = Anything();
+}
+
+void JSONParserTest::printTest()
+{
+	StartTrace(JSONParserTest.printTest);
+	Anything any;
+	any["name"] = "quote\" backslash\\ tab\t \x01";
+	any["list"].Append(1L);
+	any["list"].Append(2.5);
+	any["list"].Append(Anything());
+	any["list"].Append(Anything(Anything::ArrayMarker()));
+	any.Append("unnamed");
+	{
+		String strOut;
+		{
+			OStringStream os(strOut);
+			JSONPrinter::PrintOn(os, any);
+		}
+		assertCharPtrEqual("{\"name\":\"quote\\\" backslash\\\\ tab\\t \\u0001\",\"list\":[1,2.5,null,[]],\"2\":\"unnamed\"}", strOut);
+	}
+	{
+		String strOut;
+		{
+			OStringStream os(strOut);
+			JSONPrinter::PrintOn(os, any["list"], true);
+		}
+		assertCharPtrEqual("[\n  1,\n  2.5,\n  null,\n  []\n]", strOut);
+	}
+	{
+		String strOut;
+		{
+			OStringStream os(strOut);
+			JSONPrinter::PrintOn(os, Anything("\xC3\xA4"));
+		}
+		assertCharPtrEqual("\"\xC3\xA4\"", strOut);
+	}
+}
+
+void JSONParserTest::roundTripTest()
+{
+	StartTrace(JSONParserTest.roundTripTest);
+	Anything any;
+	any["string"] = "some \"text\"\nwith\\escapes";
+	any["long"] = -1234567L;
+	any["double"] = 0.125;
+	any["nested"]["list"].Append("a");
+	any["nested"]["list"].Append(Anything());
+	any["nested"]["list"].Append(42L);
+	any["nested"]["empty"] = Anything(Anything::ArrayMarker());
+	for (int iPretty = 0; iPretty < 2; ++iPretty) {
+		String strOut;
+		{
+			OStringStream os(strOut);
+			JSONPrinter::PrintOn(os, any, iPretty != 0);
+		}
+		Trace("printed: " << strOut);
+		JSONParser p;
+		Anything result;
+		t_assert(p.Parse(strOut, strOut.Length(), result));
+		assertAnyEqual(any, result);
+	}
+}
+
+// builds up a suite of testcases, add a line for each testmethod
+Test *JSONParserTest::suite ()
+{
+	StartTrace(JSONParserTest.suite);
+	TestSuite *testSuite = new TestSuite;
+	ADD_CASE(testSuite, JSONParserTest, configuredTests);
+	ADD_CASE(testSuite, JSONParserTest, invalidInputTest);
+	ADD_CASE(testSuite, JSONParserTest, allocatorTest);
+	ADD_CASE(testSuite, JSONParserTest, printTest);
+	ADD_CASE(testSuite, JSONParserTest, roundTripTest);
+	return testSuite;
+}
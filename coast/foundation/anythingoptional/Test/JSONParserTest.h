@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _JSONParserTest_H
+#define _JSONParserTest_H
+
+#include "FoundationTestTypes.h"//lint !e537
+
+//! tests JSONParser and JSONPrinter
+class JSONParserTest : public testframework::TestCaseWithConfig
+{
+public:
+	//! TestCase constructor
+	//! \param name name of the test
+	JSONParserTest(TString tstrName);
+
+	//! destroys the test case
+	~JSONParserTest();
+
+	//! builds up a suite of testcases for this test
+	static Test *suite ();
+
+	//! parse the /Input strings of the config and compare with /Expected
+	void configuredTests();
+	//! invalid JSON has to be rejected
+	void invalidInputTest();
+	//! the values have to be built with the allocator given
+	void allocatorTest();
+	//! print escapes and the structure of objects and arrays
+	void printTest();
+	//! printed Anythings parse to the same Anything
+	void roundTripTest();
+};
+
+#endif
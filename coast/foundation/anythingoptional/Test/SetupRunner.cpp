@@ -10,9 +10,11 @@
 #include "AnySorterTest.h"
 #include "AnyUtilsTest.h"
 #include "GenericXMLParserTest.h"
+#include "JSONParserTest.h"
 
 void setupRunner(TestRunner &runner) {//lint !e14
 	ADD_SUITE(runner, AnySorterTest);
 	ADD_SUITE(runner, AnyUtilsTest);
 	ADD_SUITE(runner, GenericXMLParserTest);
+	ADD_SUITE(runner, JSONParserTest);
 } // setupRunner
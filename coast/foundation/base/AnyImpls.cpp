@@ -13,6 +13,8 @@
 #include "SystemBase.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <vector>
 
 #if defined(COAST_TRACE)
 #define aimplStatTrace(trigger, msg, allocator) 	StatTrace(trigger, msg, allocator)
@@ -932,65 +934,139 @@ AnyImpl *AnyArrayImpl::DoDeepClone(AnyImpl *pObj, Allocator *a, Anything &xrefta
 	return pImpl;
 }
 
-void AnyArrayImpl::MergeByComparer(long lo, long hi, long m, const AnyIntCompare &comparer) {
-	if (hi < m + 1 || lo > m) {
-		return;    // nothing to merge
-	}
-	long i, j, k;
-	long const sz = m - lo + 1;
-	long a[sz];					// temporary array of lower half
-	for (k = 0, i = lo; i <= m && k < sz; ++i, ++k) {
-		a[k] = IntAt(i);
-	} Assert(k == sz); Assert(i > m);
-	j = m + 1;
-	k = 0;
-	i = lo;
-	while (k < sz && j <= hi) {
-		Assert(i < j);
-		if (comparer.Compare(*this, a[k], IntAt(j)) <= 0) {
-			fInd->SetIndex(i, a[k]);
-			++k;
-		} else {
-			fInd->SetIndex(i, IntAt(j));
-			++j;
+namespace {
+	//! slot to sort, the key prefix decides most key comparisons without touching the key buffers
+	struct SortEntry {
+		u_long fPrefix;
+		long fInt;
+		long fSlot;
+	};
+
+	//! leading bytes of key packed big endian and zero padded, ordered like String::Compare orders the keys
+	u_long KeyPrefix(const String &key) {
+		long const lLength = key.Length();
+		const unsigned char *pKey = reinterpret_cast<const unsigned char *>(key.cstr());
+		u_long ulPrefix = 0UL;
+		for (long i = 0; i < static_cast<long>(sizeof(u_long)); ++i) {
+			ulPrefix <<= 8;
+			if (i < lLength) {
+				ulPrefix |= pKey[i];
+			}
 		}
-		++i;
+		return ulPrefix;
 	}
-	// copy the remainder
-	while ( k < sz && i < j ) {
-		Assert(j > hi);
-		fInd->SetIndex(i, a[k]);
-		++i;
-		++k;
+
+	class KeyEntryCompare {
+		AnyArrayImpl const &fImpl;
+		int fSign;
+	public:
+		KeyEntryCompare(AnyArrayImpl const &impl, int iSign) :
+			fImpl(impl), fSign(iSign) {
+		}
+		int operator()(SortEntry const &left, SortEntry const &right) const {
+			if (left.fPrefix != right.fPrefix) {
+				return (left.fPrefix < right.fPrefix) ? -fSign : fSign;
+			}
+			return fSign * fImpl.IntKey(left.fInt).Compare(fImpl.IntKey(right.fInt));
+		}
+	};
+
+	class ValueEntryCompare {
+		AnyArrayImpl const &fImpl;
+		AnyComparer const &fComparer;
+	public:
+		ValueEntryCompare(AnyArrayImpl const &impl, AnyComparer const &comparer) :
+			fImpl(impl), fComparer(comparer) {
+		}
+		int operator()(SortEntry const &left, SortEntry const &right) const {
+			return fComparer.Compare(fImpl.IntValue(left.fInt), fImpl.IntValue(right.fInt));
+		}
+	};
+
+	//! runs up to this length are sorted by insertion
+	const long cInsertionSortRun = 8L;
+
+	//! stable merge sort of pEntries[lo, hi), pTmp needs room for half of the entries
+	/*! like the former index merge sort the left entry is taken when the comparer returns <= 0,
+		comparers that only order some of the values, eg. SpecialLookupComparer, keep their behaviour */
+	template <typename EntryCompare>
+	void MergeSortEntries(SortEntry *pEntries, SortEntry *pTmp, long lo, long hi, EntryCompare const &comparer) {
+		if (hi - lo <= cInsertionSortRun) {
+			for (long i = lo + 1; i < hi; ++i) {
+				SortEntry const entry = pEntries[i];
+				long j = i;
+				for (; j > lo && comparer(pEntries[j - 1], entry) > 0; --j) {
+					pEntries[j] = pEntries[j - 1];
+				}
+				pEntries[j] = entry;
+			}
+			return;
+		}
+		long const middle = lo + (hi - lo) / 2;
+		MergeSortEntries(pEntries, pTmp, lo, middle, comparer);
+		MergeSortEntries(pEntries, pTmp, middle, hi, comparer);
+		if (comparer(pEntries[middle - 1], pEntries[middle]) <= 0) {
+			return; // halves already in order
+		}
+		long const sz = middle - lo;
+		std::copy(pEntries + lo, pEntries + middle, pTmp);
+		long i = lo, j = middle, k = 0;
+		while (k < sz && j < hi) {
+			if (comparer(pTmp[k], pEntries[j]) <= 0) {
+				pEntries[i++] = pTmp[k++];
+			} else {
+				pEntries[i++] = pEntries[j++];
+			}
+		}
+		// copy the remainder of the lower half, the upper one is in place
+		std::copy(pTmp + k, pTmp + sz, pEntries + i);
 	}
-	Assert(i == j);
-	Assert(k == sz);
-}
 
-void AnyArrayImpl::MergeSortByComparer(long low, long high, const AnyIntCompare &comparer) {
-	if (low >= high) {
-		return;
+	//! sort the slots of impl on a contiguous table of entries, the index table is only rewritten at the end
+	template <typename EntryCompare>
+	void SortSlots(AnyArrayImpl &impl, bool bKeyPrefix, EntryCompare const &comparer) {
+		long const lSize = impl.GetSize();
+		if (lSize < 2) {
+			impl.RecreateKeyTable();
+			return;
+		}
+		std::vector<SortEntry> entries(lSize);
+		for (long i = 0; i < lSize; ++i) {
+			SortEntry &entry = entries[i];
+			entry.fInt = impl.IntAt(i);
+			entry.fSlot = i;
+			entry.fPrefix = bKeyPrefix ? KeyPrefix(impl.IntKey(entry.fInt)) : 0UL;
+		}
+		std::vector<SortEntry> tmp(lSize / 2 + 1);
+		MergeSortEntries(&entries[0], &tmp[0], 0L, lSize, comparer);
+		std::vector<long> order(lSize);
+		for (long i = 0; i < lSize; ++i) {
+			order[i] = entries[i].fSlot;
+		}
+		impl.SortByOrder(&order[0]);
 	}
-	long middle = (low + high) / 2;
-	MergeSortByComparer(low, middle, comparer);
-	MergeSortByComparer(middle + 1, high, comparer);
-	MergeByComparer(low, high, middle, comparer);
 }
 
 void AnyArrayImpl::SortByKey() {
-	//HeapSort();
-	//Qsort(0,GetSize()-1);
-	MergeSortByComparer(0, GetSize() - 1, theKeyComparer);
-	RecreateKeyTable();
+	SortSlots(*this, true, KeyEntryCompare(*this, 1));
 }
 
 void AnyArrayImpl::SortReverseByKey() {
-	MergeSortByComparer(0, GetSize() - 1, theReverseKeyComparer);
-	RecreateKeyTable();
+	SortSlots(*this, true, KeyEntryCompare(*this, -1));
 }
 
 void AnyArrayImpl::SortByAnyComparer(const AnyComparer &comparer) {
-	MergeSortByComparer(0, GetSize() - 1, AnyIntComparerCompare(comparer));
+	SortSlots(*this, false, ValueEntryCompare(*this, comparer));
+}
+
+void AnyArrayImpl::SortByOrder(const long *order) {
+	std::vector<long> ints(fSize);
+	for (long i = 0; i < fSize; ++i) {
+		ints[i] = IntAt(i);
+	}
+	for (long i = 0; i < fSize; ++i) {
+		fInd->SetIndex(i, ints[order[i]]);
+	}
 	RecreateKeyTable();
 }
 
@@ -1020,13 +1096,6 @@ void AnyArrayImpl::Accept(AnyVisitor &v, long lIdx, const char *slotname) const
 	v.VisitArray(wrapit, this, lIdx, slotname);
 }
 
-int AnyArrayImpl::AnyIntComparerCompare::Compare(AnyArrayImpl &that, long leftInt, long rightInt) const {
-	return ac.Compare(that.IntValue(leftInt), that.IntValue(rightInt));
-}
-
-AnyArrayImpl::AnyIntKeyCompare AnyArrayImpl::theKeyComparer;
-AnyArrayImpl::AnyIntReverseKeyCompare AnyArrayImpl::theReverseKeyComparer;
-
 #if 0
 void AnyArrayImpl::Qsort(long left, long right)
 {
@@ -462,6 +462,10 @@ public:
 	//!reorder Array using sort order defined by the AnyComparer
 	void SortByAnyComparer(const AnyComparer &comparer);
 
+	//!reorder Array so that the slot at index order[i] moves to index i, slot names move with their values
+	/*! \param order permutation of 0..GetSize()-1 */
+	void SortByOrder(const long *order);
+
 	//!rebuild hash map after sorting O(fSize)
 	void RecreateKeyTable();
 
@@ -474,19 +478,6 @@ public:
 	//!works with index into fContents
 	const String &IntKey(long at) const;
 
-	//!interface for internal comparing during sort
-	class AnyIntCompare
-	{
-	public:
-		virtual int Compare(AnyArrayImpl &that, long leftInt, long rightInt) const {
-			return 0;
-		}
-	};
-
-	void MergeSortByComparer(long left, long right, const AnyIntCompare &comparer);
-
-	void MergeByComparer(long left, long right, long middle, const AnyIntCompare &comparer);
-
 #if 0
 	void Qsort(long left, long right);
 	void BuildHeap();
@@ -505,29 +496,6 @@ public:
 		return ((cap + ARRAY_BUF_SIZE - 1) / ARRAY_BUF_SIZE) * ARRAY_BUF_SIZE; // make it a multiple of ARRAY_BUF_SIZE
 	}
 
-	static class AnyIntKeyCompare: public AnyIntCompare {
-	public:
-		virtual int Compare(AnyArrayImpl &that, long leftInt, long rightInt) const {
-			return that.IntKey(leftInt).Compare(that.IntKey(rightInt));
-		}
-	} theKeyComparer;
-
-	static class AnyIntReverseKeyCompare: public AnyIntCompare {
-	public:
-		virtual int Compare(AnyArrayImpl &that, long leftInt, long rightInt) const {
-			return -that.IntKey(leftInt).Compare(that.IntKey(rightInt));
-		}
-	} theReverseKeyComparer;
-
-	class AnyIntComparerCompare: public AnyIntCompare {
-		const AnyComparer &ac;
-	public:
-		AnyIntComparerCompare(const AnyComparer &theComparer) :
-			ac(theComparer) {
-		}
-		virtual int Compare(AnyArrayImpl &that, long leftInt, long rightInt) const;
-	};//lint !e1510
-
 private:
 	AnyImpl *DoDeepClone(AnyImpl *res, Allocator *a, Anything &xreftable) const;
 	void AllocBuffersFrom(long idx);
@@ -19,6 +19,7 @@ using namespace coast;
 
 #include <cstring>
 #include <algorithm>
+#include <vector>
 #if defined(COAST_TRACE)
 #define anyStatTrace(trigger, msg, allocator) 	StatTrace(trigger, msg, allocator)
 #define anyStartTrace(trigger)					StartTrace(trigger)
@@ -55,12 +56,18 @@ long IFAHash(const char *key, long &len, char stop1, char stop2)
 	return h;
 }
 
+//! source of characters for the AnythingParser
+/*!
+Characters are taken from the streambuf of the stream directly, the stream itself is only consulted for its state.
+No characters beyond the parsed Anything are consumed, so a stream can carry several Anythings.
+*/
 class InputContext
 {
 public:
 	// constructor
 	InputContext(std::istream &is, const char *fname = 0)
 		: fIs(is)
+		, fSb(is.rdbuf())
 		, fLine(1)
 		, fFileName(fname) { }
 
@@ -69,12 +76,32 @@ public:
 
 	// input
 	void SkipToEOL();    // for reading comments by parser
+	//! \return false and c set to 0 at eof or if the stream is not good, like std::istream::get the stream is set to eof and fail then
 	bool Get(char &c)				{
-		return (fIs.get(c).good()) || (c = 0);//lint !e506
+		if ( fIs.good() ) {
+			std::streambuf::int_type i = fSb->sbumpc();
+			if ( !std::streambuf::traits_type::eq_int_type(i, std::streambuf::traits_type::eof()) ) {
+				c = std::streambuf::traits_type::to_char_type(i);
+				return true;
+			}
+			fIs.setstate(std::ios::eofbit | std::ios::failbit);
+		}
+		c = 0;
+		return false;
+	}
+	//! like Get but leaves c unchanged if nothing could be read
+	void GetOrKeep(char &c) {
+		char d = 0;
+		if ( Get(d) ) {
+			c = d;
+		}
 	}
-	// the last assignment is a trick for sunCC weakness of storing EOF(-1) in c
 	void Putback(char c)			{
-		fIs.putback(c);
+		if ( !fIs.good() ) {
+			fIs.setstate(std::ios::failbit);
+		} else if ( std::streambuf::traits_type::eq_int_type(fSb->sputbackc(c), std::streambuf::traits_type::eof()) ) {
+			fIs.setstate(std::ios::badbit);
+		}
 	}
 	bool IsGood() 					{
 		return fIs.good();
@@ -92,10 +119,39 @@ public:
 
 private:
 	std::istream &fIs;
+	std::streambuf *fSb;
 	long fLine;
 	String fFileName;
 };
 
+namespace {
+	//! collects single characters and appends them to a String in blocks
+	class BufferedAppender {
+		String &fStr;
+		char fBuf[256];
+		long fLen;
+		BufferedAppender(const BufferedAppender &);
+		BufferedAppender &operator=(const BufferedAppender &);
+	public:
+		BufferedAppender(String &str) : fStr(str), fLen(0) {}
+		~BufferedAppender() {
+			Flush();
+		}
+		void Append(char c) {
+			if ( fLen == static_cast<long>(sizeof(fBuf)) ) {
+				Flush();
+			}
+			fBuf[fLen++] = c;
+		}
+		//! \return the String with all characters collected so far appended
+		String &Flush() {
+			fStr.Append(static_cast<const void *>(fBuf), fLen);
+			fLen = 0;
+			return fStr;
+		}
+	};
+}
+
 //---- the following class is used for lexical analysis of
 //---- any-files or input. It will represent the next
 //---- character or symbol read from the stream
@@ -128,6 +184,8 @@ private:
 	char    DoReadNumber(InputContext &context, char firstchar);
 	char    DoReadDigits(InputContext &context);
 	void    DoReadString(InputContext &context, char firstchar);
+	//! \return number of line breaks within the string, negated if it was terminated by an unmasked line break
+	long    DoReadQuoted(InputContext &context, const char quote);
 	char    DoReadName(InputContext &context, char firstchar);
 	void    DoReadBinBuf(InputContext &context);
 };
@@ -292,14 +350,12 @@ AnythingToken::AnythingToken(InputContext &context) : fToken(0)
 
 void AnythingToken::DoReadString(InputContext &context, char firstchar)
 {
-	if (firstchar) {
-		context.Putback(firstchar); // leave double quote on the stream
-	}
-	long linebreakswithinstring =  fText.IntReadFrom(context.StreamRef(), firstchar);
+	// firstchar is the opening quote, it was already consumed
+	long linebreakswithinstring =  DoReadQuoted(context, firstchar);
 	if (linebreakswithinstring < 0) {
 		// if someone puts "hello""
 		// in an any file the mismatched double quote opens a string only
-		// until the end of line. This is detected by IntReadFrom
+		// until the end of line. This is detected by DoReadQuoted
 		// post a separate error, because it might not be obvious
 		// what was the reason otherwise.
 		linebreakswithinstring = 0 - linebreakswithinstring;
@@ -312,6 +368,103 @@ void AnythingToken::DoReadString(InputContext &context, char firstchar)
 	context.LineRef() += linebreakswithinstring;
 }
 
+long AnythingToken::DoReadQuoted(InputContext &context, const char quote)
+{
+	// same unmasking as String::IntReadFrom but reading from the context directly
+	long newlinecounter = 0;
+	fText.Trim(0);
+	BufferedAppender text(fText);
+	char c = 0;
+	// now read up to quote character or EOF or EOL (PS)
+	// now behaves more nicely in case of \r\n combinations
+	// the combination \n\r is not treated as new-line
+	while ( context.IsGood() ) {
+		c = 0; // PS: post CR for additional safety at EOF, might duplicate c
+		context.GetOrKeep(c);
+		if (c == quote || !context.IsGood()) {
+			break;
+		}
+		if ( c == '\\') {
+			// special cases of masked characters
+			context.GetOrKeep(c);
+			if (c == '\\' || c == quote) {
+				// '\\' or '\"'
+				text.Append(c);
+			} else if (c == 'x') {
+				// hex char e.g. '\xAB?
+				char h[2] = { 0, 0 };
+				context.GetOrKeep(h[0]);
+				if (isxdigit( (unsigned char) h[0])) {
+					context.GetOrKeep(h[1]);
+					if (! isxdigit( (unsigned char) h[1])) {
+						// a single xdigit n pass 0n to it.
+						context.Putback(h[1]);
+						h[1] = h[0];
+						h[0] = '0';
+					}
+					text.Flush().AppendTwoHexAsChar(h);
+				} else {
+					// no hex char follows \x assume its a literal
+					text.Append('\\');
+					text.Append('x');
+					context.Putback(h[0]);
+				}
+			} else if (c >= '0' && c <= '7') {
+				// allow for octal read up to two more
+				char val = c - '0';
+				context.GetOrKeep(c);
+				if ( c >= '0' && c <= '7' ) {
+					val = val * 8 + (c - '0');
+					context.GetOrKeep(c);
+					if ( c >= '0' && c <= '7' ) {
+						val = val * 8 + (c - '0');
+					} else { // premature end of ocal code
+						context.Putback(c);
+					}
+				} else {
+					// premature end of ocal code
+					context.Putback(c);
+				}
+				text.Append(val);
+			} else if (c == 'n') {
+				text.Append('\n');
+			} else if (c == 'r') {
+				text.Append('\r');
+			} else if ('\r' == c) {
+				// need to check for masked \r\n sequences
+				++newlinecounter;
+				context.GetOrKeep(c);
+				if ('\n' != c) {
+					context.Putback(c);    // do not ignore it.
+				}
+			} else if (c == '\n') {
+				// a masked newline is ignored, take it as a continuation line
+				++newlinecounter;
+			} else {
+				// unknown stuff take it literally
+				text.Append('\\');
+				text.Append(c);
+			}
+		} else {
+			// unmasked newline characters terminate the string, see String::IntReadFrom
+			if ('\r' == c) {
+				// need to check for \r\n sequences
+				context.GetOrKeep(c);
+				if ('\n' != c) {
+					context.Putback(c);
+					c = '\n';
+				}
+			}
+			if (c == '\n') {
+				++newlinecounter;
+				return 0 - newlinecounter;
+			}
+			text.Append(c);
+		}
+	}
+	return newlinecounter;
+}
+
 void AnythingToken::DoReadBinBuf(InputContext &context)
 {
 	// context's line count is not adjusted in the case of binary buffers
@@ -358,13 +511,14 @@ char AnythingToken::DoReadName(InputContext &context, char firstchar)
 	// reads letters and digits of a name and collects them in fText
 	// returns 0 in case of eof or the delimiting character instead
 	char c = 0;
-	fText.Append(firstchar);
+	BufferedAppender text(fText);
+	text.Append(firstchar);
 	fToken = AnythingToken::eString;
 	while (context.Get(c)) {
 		//        if (isalnum( static_cast<unsigned char>(c)) || '_' == c || '-' == c) { // should we allow more? YES!
 		if (!isNameDelimiter(c)) {
 			// collect almost all printable chars except comments and nested anys
-			fText.Append(c);
+			text.Append(c);
 		} else {
 			return c; // we are done
 		}
@@ -380,9 +534,10 @@ char AnythingToken::DoReadDigits(InputContext &context)
 	// collects digits in fText
 	// returns 0 in case of eof
 	char c = 0;
+	BufferedAppender text(fText);
 	while (context.Get(c)) {
 		if (isdigit( static_cast<unsigned char>(c))) {
-			fText.Append(c);
+			text.Append(c);
 		} else {
 			return c; // we are done
 		}
@@ -647,19 +802,51 @@ public:
 	}
 };
 
-class PrinterXrefHandler: public AnyXrefHandler {
-	String ToId(long id) const {
-		return String().Append(id);
+//! remembers where impls referenced more than once were printed first
+/*!
+The current path is kept as pointers to the slot names of the visited arrays, it is only converted to its string
+form when a shared impl is encountered for the first time.
+*/
+class PrinterXrefHandler {
+	struct PathElement {
+		const String *fKey;
+		long fIdx;
+	};
+	std::vector<PathElement> fPath;
+	Anything fXrefs;
+	String ToId(const AnyImpl *id) const {
+		return String().Append(reinterpret_cast<long>(id));
+	}
+	String PathAsString() const {
+		String strPath;
+		for (std::vector<PathElement>::const_iterator it = fPath.begin(); it != fPath.end(); ++it) {
+			if ( it->fKey ) {
+				if ( strPath.Length() ) strPath.Append(fgPathDelim);
+				strPath.Append(std::for_each(it->fKey->cstr(), it->fKey->cstr() + it->fKey->Length(), escapeString()).result);
+			} else {
+				strPath.Append(fgIndexDelim).Append(it->fIdx);
+			}
+		}
+		return strPath;
 	}
 public:
-	bool IsDefined(long id) const {
-		return fXrefs.IsDefined(ToId(id));
-	}
-	void DefineBackRef(long id) {
-		fXrefs[ToId(id)] = ParseLevel();
+	void Push(long lIdx, const String &key) {
+		PathElement aElement = { ( key.Length() > 0 ) ? &key : 0, lIdx };
+		fPath.push_back(aElement);
 	}
-	String GetBackRef(long id) {
-		return std::for_each(fXrefs[ToId(id)].begin(), fXrefs[ToId(id)].end(), appendAnyLevelToString()).fStr;
+	void Pop() {
+		fPath.pop_back();
+	}
+	//! \return true and the path of the first occurrence in strRef if id was printed before, otherwise the current path gets remembered for id
+	bool GetOrDefineBackRef(const AnyImpl *id, String &strRef) {
+		String strId(ToId(id));
+		long lIdx = fXrefs.FindIndex(strId);
+		if ( lIdx >= 0 ) {
+			strRef = fXrefs[lIdx].AsString();
+			return true;
+		}
+		fXrefs[strId] = PathAsString();
+		return false;
 	}
 };
 //lint !e1509
@@ -726,17 +913,28 @@ class AnythingParser {
 	// really implement the grammar of Anythings
 	// needs to be friend of Anything to set Anything's internals
 public:
-	AnythingParser(InputContext &c) :
-			fContext(c) {
+	//! \param a allocator of the Anything to parse into, used for the results of included files too
+	AnythingParser(InputContext &c, Allocator *a = coast::storage::Current()) :
+			fContext(c), fIncludes(Anything::ArrayMarker(), a) {
+	}
+	//! parser for an included file, shares the already parsed includes with the including parser
+	AnythingParser(InputContext &c, Anything const &includes) :
+			fContext(c), fIncludes(includes) {
 	}
 	bool DoParse(Anything &a); // returns false if there was a syntax error
 	bool DoParseSequence(Anything &a, ParserXrefHandler &xrefs);
 	bool MakeSimpleAny(AnythingToken &tok, Anything &a);
+	//! log the failed import of the Anything read through context
+	static void ImportError(InputContext &context, const char *fname);
 
 private:
 	void ImportIncludeAny(Anything &element, const String &url);
+	//! parse the content of an included file or take a copy of the result if the same content was included before
+	bool ParseIncludeContent(Anything &element, const String &content, const String &fileName);
 	void Error(String const &msg, String const &toktext);
 	InputContext &fContext;
+	//! content hash -> { /Content /Any } of the files included so far within the top level import
+	Anything fIncludes;
 };
 
 Anything::Anything(Allocator *a) :
@@ -1183,15 +1381,65 @@ void Anything::SortByAnyComparer(const AnyComparer &ac)
 	}
 }
 
-class SimpleAnyPrinter: public AnyVisitor
+void Anything::SortByOrder(const long *order)
 {
-protected:
-	std::ostream &fOs;
-	void PrintKey(const String &s) { // no copy for efficiency
-		bool needquote = false;
+	if (IsArrayImpl(GetImpl())) {
+		ArrayImpl(GetImpl())->SortByOrder(order);
+	}
+}
 
-		fOs << '/';
+//! writes Anythings in the .any text format
+/*!
+The output is collected in a String and handed to the stream in blocks, numbers are copied from the preformatted
+buffers of their impls and strings are escaped in runs. Back references are only tracked when exporting and only for
+impls referenced more than once, no other impl can appear twice within the printed structure.
+*/
+class AnyPrinter: public AnyVisitor
+{
+	enum { eFlushSize = 8192 };
+	std::ostream &fOs;
+	String fBuf;
+	long fLevel;
+	bool fPretty;
+	bool fTrackXrefs;
+	PrinterXrefHandler fXref;
 
+	void Put(const char *pc, long lLength) {
+		fBuf.Append(static_cast<const void *>(pc), lLength);
+	}
+	void Tab() {
+		for (long i = 0; i < fLevel; ++i) {
+			Put("  ", 2L);
+		}
+	}
+	// same masking as String::IntPrintOn, unmasked runs are copied at once
+	void PutQuoted(const char *pc, long lLength) {
+		static const char *pcHex = "0123456789ABCDEF";
+		fBuf.Append('\"');
+		const char *pcRun = pc, *pcEnd = pc + lLength;
+		for (; pc != pcEnd; ++pc) {
+			unsigned char c = *pc;
+			bool bPrintable = isprint(c);
+			if ( bPrintable && c != '\"' && c != '\\' ) {
+				continue;
+			}
+			Put(pcRun, pc - pcRun);
+			pcRun = pc + 1;
+			fBuf.Append('\\');
+			if ( bPrintable ) {
+				fBuf.Append(static_cast<char>(c));
+			} else if ( c == '\n' ) {
+				fBuf.Append('n');
+			} else {
+				fBuf.Append('x').Append(pcHex[(c >> 4) & 0x0f]).Append(pcHex[c & 0x0f]);
+			}
+		}
+		Put(pcRun, pcEnd - pcRun);
+		fBuf.Append('\"');
+	}
+	void PutKey(const String &s) {
+		bool needquote = false;
+		fBuf.Append('/');
 		if (isdigit( static_cast<unsigned char>(s[0L]))) {
 			needquote = true;	// quote all numbers
 		} else {
@@ -1199,175 +1447,144 @@ protected:
 				needquote = AnythingToken::isNameDelimiter(s[i]);
 			}
 		}
-
 		if (needquote) {
-			s.IntPrintOn(fOs, '\"');
+			PutQuoted(s.cstr(), s.Length());
 		} else {
-			fOs << s ;
+			Put(s.cstr(), s.Length());
 		}
-		fOs << ' ';
+		fBuf.Append(' ');
+	}
+	bool PrintAsXref(const AnyImpl *id) {
+		String strRef;
+		if ( !fTrackXrefs || id->RefCount() <= 1L || !fXref.GetOrDefineBackRef(id, strRef) ) {
+			return false;
+		}
+		Put("%\"", 2L);
+		Put(strRef.cstr(), strRef.Length());
+		fBuf.Append('\"');
+		return true;
 	}
 	void ArrayBefore(const ROAnything , const AnyImpl *, long , const char *) {
-		fOs << '{';
+		fBuf.Append('{');
+		if ( fPretty ) {
+			fBuf.Append('\n');
+			++fLevel;
+		}
 	}
 	void ArrayBeforeElement(long lIdx, const String &key) {
+		if ( fPretty ) {
+			Tab();
+		}
 		if (key.Length() > 0) {
-			PrintKey(key);
+			PutKey(key);
 		}
-	}
-	//void ArrayAfterElement(long index, const String &key){}
-	void ArrayAfter(const ROAnything, const AnyImpl *, long , const char *) {
-		fOs << '}';
-	}
-
-public:
-	SimpleAnyPrinter(std::ostream &os): fOs(os) {}
-	virtual void	VisitNull(long lIdx, const char *slotname) {
-		fOs.put('*');
-	}
-	virtual void	VisitCharPtr(const String &value, const AnyImpl *id, long lIdx, const char *slotname) {
-		value.IntPrintOn(fOs);
-	}
-	virtual void	VisitLong(long value, const AnyImpl *id, long lIdx, const char *slotname) {
-		if ( id->GetType() == AnyLongType ) {
-			fOs << id->AsString("");
-		} else {
-			// this section is just for the impossible case where...
-			fOs << value;
+		if ( fTrackXrefs ) {
+			fXref.Push(lIdx, key);
 		}
 	}
-	virtual void	VisitDouble(double value, const AnyImpl *id, long lIdx, const char *slotname) {
-		if ( id->GetType() == AnyDoubleType ) {
-			fOs << id->AsString("");
-		} else {
-			// this section is just for the impossible case where...
-			// keep track of precision, so we can read in our
-			// numbers anyway
-			String strBuf;
-			String::DoubleToString(value, strBuf);
-			fOs << strBuf;
+	void ArrayAfterElement(long lIdx, const String &key) {
+		if ( fTrackXrefs ) {
+			fXref.Pop();
 		}
-	}
-	virtual void	VisitVoidBuf(const String &value, const AnyImpl *, long lIdx, const char *slotname) {
-		fOs << '[' << value.Length() << ';'; // separator
-		fOs.write(value.cstr(), value.Length());
-		fOs << ']';
-
-	}
-	virtual void	VisitObject(IFAObject *value, const AnyImpl *id, long lIdx, const char *slotname) {
-		fOs << '&' << reinterpret_cast<unsigned long>(value);
-	}
-};
-
-class PrettyAnyPrinter: public SimpleAnyPrinter
-{
-protected:
-	long	fLevel;
-	void Tab() {
-		for (long i = 0; i < fLevel; ++i) {
-			fOs.put(' ').put(' ');
+		if ( fPretty ) {
+			fBuf.Append('\n');
+		}
+		if ( fBuf.Length() >= eFlushSize ) {
+			Flush();
 		}
-	}
-	void ArrayBefore(const ROAnything , const AnyImpl *, long , const char *) {
-		fOs << "{\n"; // } trick sniff
-		++fLevel;
-	}
-	void ArrayBeforeElement(long lIdx, const String &key) {
-		Tab();
-		SimpleAnyPrinter::ArrayBeforeElement(lIdx, key);
-	}
-	void ArrayAfterElement(long lIdx, const String &key) {
-		fOs << '\n';
 	}
 	void ArrayAfter(const ROAnything , const AnyImpl *, long , const char *) {
-		--fLevel;
-		Tab(); // { trick sniff
-		fOs << '}';
+		if ( fPretty ) {
+			--fLevel;
+			Tab(); // { trick sniff
+		}
+		fBuf.Append('}');
 	}
 
 public:
-	PrettyAnyPrinter(std::ostream &os, long level = 0): SimpleAnyPrinter(os), fLevel(level) {}
-};
-class XrefAnyPrinter : public PrettyAnyPrinter
-{
-protected:
-	PrinterXrefHandler fXref;
-	bool PrintAsXref(const AnyImpl *ai) {
-		if (!fXref.IsDefined(reinterpret_cast<long>(ai))) {
-			fXref.DefineBackRef(reinterpret_cast<long>(ai)); // remember symbolic slot name
-			return false;
-		} else {
-			fOs << "%\"" << fXref.GetBackRef(reinterpret_cast<long>(ai)) << "\"";
-			return true;
-		}
-
-	}
-	void ArrayBeforeElement(long lIdx, const String &key) {
-		PrettyAnyPrinter::ArrayBeforeElement(lIdx, key);
-		if (key.Length() > 0) {
-			fXref.PushKey(key);
-		} else {
-			fXref.PushIndex(lIdx);
-		}
+	//! \param bPretty put each slot on a line of its own, indented by two spaces per level
+	//! \param level initial indentation
+	//! \param bTrackXrefs print impls contained more than once as reference to their first occurrence
+	AnyPrinter(std::ostream &os, bool bPretty, long level = 0, bool bTrackXrefs = false) :
+		fOs(os), fBuf(eFlushSize + 256L), fLevel(level), fPretty(bPretty), fTrackXrefs(bTrackXrefs) {
 	}
-	void ArrayAfterElement(long lIdx, const String &key) {
-		fXref.Pop();
-		PrettyAnyPrinter::ArrayAfterElement(lIdx, key);
+	//! hand the remaining output to the stream
+	void Flush() {
+		fOs.write(fBuf.cstr(), fBuf.Length());
+		fBuf.Trim(0L);
 	}
-
-public:
-	XrefAnyPrinter(std::ostream &os, long level = 0): PrettyAnyPrinter(os, level) {
+	virtual void	VisitNull(long lIdx, const char *slotname) {
+		fBuf.Append('*');
 	}
-	//!@FIXME take mechanics from IntPrintOnWithRef to this class.
 	virtual void	VisitCharPtr(const String &value, const AnyImpl *id, long lIdx, const char *slotname) {
 		if (!PrintAsXref(id)) {
-			PrettyAnyPrinter::VisitCharPtr(value, id, lIdx, slotname);
+			PutQuoted(value.cstr(), value.Length());
 		}
 	}
 	//!trick to avoid leaking AnyArrayImpl class to the outside use ROAnything instead
 	virtual void	VisitArray(const ROAnything value, const AnyImpl *id, long lIdx, const char *slotname) {
 		if (!PrintAsXref(id)) {
-			PrettyAnyPrinter::VisitArray(value, id, lIdx, slotname);
+			AnyVisitor::VisitArray(value, id, lIdx, slotname);
 		}
 	}
 	virtual void	VisitLong(long value, const AnyImpl *id, long lIdx, const char *slotname) {
-		if (!PrintAsXref(id)) {
-			PrettyAnyPrinter::VisitLong(value, id, lIdx, slotname);
+		if (PrintAsXref(id)) {
+			return;
+		}
+		if ( id->GetType() == AnyLongType ) {
+			long lLength = 0L;
+			const char *pc = id->AsCharPtr("", lLength);
+			Put(pc, lLength);
+		} else {
+			// this section is just for the impossible case where...
+			fBuf.Append(value);
 		}
 	}
 	virtual void	VisitDouble(double value, const AnyImpl *id, long lIdx, const char *slotname) {
-		if (!PrintAsXref(id)) {
-			PrettyAnyPrinter::VisitDouble(value, id, lIdx, slotname);
+		if (PrintAsXref(id)) {
+			return;
+		}
+		if ( id->GetType() == AnyDoubleType ) {
+			long lLength = 0L;
+			const char *pc = id->AsCharPtr("", lLength);
+			Put(pc, lLength);
+		} else {
+			// this section is just for the impossible case where...
+			// keep track of precision, so we can read in our
+			// numbers anyway
+			String strBuf;
+			String::DoubleToString(value, strBuf);
+			fBuf.Append(strBuf);
 		}
 	}
 	virtual void	VisitVoidBuf(const String &value, const AnyImpl *id, long lIdx, const char *slotname) {
 		if (!PrintAsXref(id)) {
-			PrettyAnyPrinter::VisitVoidBuf(value, id, lIdx, slotname);
+			fBuf.Append('[').Append(value.Length()).Append(';'); // separator
+			Put(value.cstr(), value.Length());
+			fBuf.Append(']');
 		}
 	}
 	virtual void	VisitObject(IFAObject *value, const AnyImpl *id, long lIdx, const char *slotname) {
 		if (!PrintAsXref(id)) {
-			PrettyAnyPrinter::VisitObject(value, id, lIdx, slotname);
+			fBuf.Append('&').Append(reinterpret_cast<unsigned long>(value));
 		}
 	}
 };
+
 std::ostream &Anything::PrintOn(std::ostream &os, bool pretty) const
 {
-	if (pretty) {
-		PrettyAnyPrinter p(os);
-		this->Accept(p);
-	} else {
-		SimpleAnyPrinter p(os);
-		this->Accept(p);
-	}
+	AnyPrinter p(os, pretty);
+	this->Accept(p);
+	p.Flush();
 	return os;
 }
 
 void Anything::Export(std::ostream &os, int level) const
 {
 	if (! ! os) {
-		XrefAnyPrinter pp(os, level);
+		AnyPrinter pp(os, true, level, true);
 		this->Accept(pp);
+		pp.Flush();
 		os.flush(); // export should really flush it.
 	}
 }
@@ -1381,20 +1598,10 @@ bool Anything::Import(std::istream &is, const char *fname)
 {
 	if (! !is) {
 		InputContext context(is, fname);
-		AnythingParser p(context);
+		AnythingParser p(context, GetAllocator());
 		if ( !p.DoParse(*this) ) {
 			// there has been a syntax error
-			String m("Anything::Import "), strFName(context.FileName());
-			bool bHasExt = true;
-			if ( !strFName.Length() && fname != NULL ) {
-				strFName << fname;
-				bHasExt = (strFName.SubString(strFName.Length() - 4L) == ".any");
-			} else {
-				strFName << "<NoName>";
-			}
-			m << strFName << (bHasExt ? ":" : ".any");
-			m.Append(": syntax error");
-			SYSERROR(m);
+			AnythingParser::ImportError(context, fname);
 			return false;
 		}
 
@@ -1865,21 +2072,18 @@ bool ROAnything::Contains(const char *k) const
 
 std::ostream &ROAnything::PrintOn(std::ostream &os, bool pretty) const
 {
-	if (pretty) {
-		PrettyAnyPrinter p(os);
-		this->Accept(p);
-	} else {
-		SimpleAnyPrinter p(os);
-		this->Accept(p);
-	}
+	AnyPrinter p(os, pretty);
+	this->Accept(p);
+	p.Flush();
 	return os;
 }
 
 void ROAnything::Export(std::ostream &os, int level) const
 {
 	if (! ! os) {
-		XrefAnyPrinter pp(os, level);
+		AnyPrinter pp(os, true, level, true);
 		this->Accept(pp);
+		pp.Flush();
 		os.flush(); // export should really flush it.
 	}
 }
@@ -2231,7 +2435,13 @@ void AnythingParser::ImportIncludeAny(Anything &element, const String &url)
 
 		std::iostream *pStream = system::OpenStream(fileName, "");
 		if (pStream) {
-			if ( element.Import(*pStream, fileName) && queryString.Length() > 0 ) {
+			// read the whole file, its content identifies already parsed includes
+			String content;
+			while ( pStream->good() ) {
+				content.Append(*pStream, 16384L);
+			}
+			delete pStream;
+			if ( ParseIncludeContent(element, content, fileName) && queryString.Length() > 0 ) {
 				Anything anyLevel = escapedQueryStringToAny(queryString);
 				element = std::for_each(anyLevel.begin(), anyLevel.end(), resolveToAnyLevel(element)).result;
 				if ( element.IsNull() ) {
@@ -2240,7 +2450,6 @@ void AnythingParser::ImportIncludeAny(Anything &element, const String &url)
 					SystemLog::WriteToStderr(m);
 				}
 			}
-			delete pStream;
 		} else {
 			Error("cannot open included Anything at", url);
 		}
@@ -2249,6 +2458,47 @@ void AnythingParser::ImportIncludeAny(Anything &element, const String &url)
 	}
 }
 
+bool AnythingParser::ParseIncludeContent(Anything &element, const String &content, const String &fileName)
+{
+	anyStartTrace1(AnythingParser.ParseIncludeContent, "file [" << fileName << "] length:" << content.Length());
+	Allocator *a = (element.GetAllocator()) ? element.GetAllocator() : coast::storage::Current();
+	long lLength = 0L;
+	String strHash;
+	strHash.Append(IFAHash(content.cstr(), lLength, '\0', '\0')).Append('_').Append(content.Length());
+	long lIdx = fIncludes.FindIndex(strHash);
+	if ( lIdx >= 0 && content == fIncludes[lIdx]["Content"].AsString() ) {
+		anyTrace("reusing content parsed before");
+		// the first user shares the parsed result, all others get their own copy
+		element = fIncludes[lIdx]["Any"].DeepClone(a);
+		return true;
+	}
+	IStringStream is(&content);
+	InputContext context(is, fileName);
+	AnythingParser p(context, fIncludes);
+	if ( !p.DoParse(element) ) {
+		ImportError(context, fileName);
+		return false;
+	}
+	fIncludes[strHash]["Content"] = content;
+	fIncludes[strHash]["Any"] = element;
+	return true;
+}
+
+void AnythingParser::ImportError(InputContext &context, const char *fname)
+{
+	String m("Anything::Import "), strFName(context.FileName());
+	bool bHasExt = true;
+	if ( !strFName.Length() && fname != NULL ) {
+		strFName << fname;
+		bHasExt = (strFName.SubString(strFName.Length() - 4L) == ".any");
+	} else {
+		strFName << "<NoName>";
+	}
+	m << strFName << (bHasExt ? ":" : ".any");
+	m.Append(": syntax error");
+	SYSERROR(m);
+}
+
 void AnythingParser::Error(String const &msg, String const &toktext)
 {
 	// put a space in front to give poor Sniff a chance
@@ -305,6 +305,10 @@ public:
 	void SortByStringValues();
 	//!in-core sort of Anything by String values, temporary, will provide comparer interface
 	void SortByAnyComparer(const AnyComparer &comparer);
+	//!reorder the slots of an array Anything, slot names move with their values
+	/*! used to apply a sort order computed on extracted sort keys
+		\param order the slot at index order[i] moves to index i, must be a permutation of 0..GetSize()-1 */
+	void SortByOrder(const long *order);
 
 //------ support STL compliant container behavior
 	typedef Anything_iterator iterator;
@@ -14,6 +14,7 @@
 #include <errno.h>
 #include <cstring>
 #include <climits>
+#include <ctime>
 #include <fstream>
 #include <sys/stat.h>
 #if defined(WIN32)
@@ -105,6 +106,9 @@ namespace {
 	};
     typedef coast::utility::singleton_default<PathInitializer> PathInitializerSingleton;
 
+	//! cache installed by coast::system::SetPathCache, zero initialized before any constructor runs
+	coast::system::PathCache *fgPathCache = 0;
+
 	//! checks existence of a path using stat
 	/*! \param path file or directory path
 		\param stbuf stat buffer to fill
@@ -211,6 +215,12 @@ namespace {
 
 		coast::system::ResolvePath(filepath);
 
+		coast::system::PathCache *pCache = coast::system::GetPathCache();
+		if ( pCache && ( mode & std::ios::out ) ) {
+			// the file might be one we remembered as missing or found elsewhere in the pathlist
+			pCache->ForgetWritten(filepath);
+		}
+
 		if (coast::system::IsAbsolutePath(filepath)) {
 			Trace("file [" << filepath << "] is going to be opened absolute");
 		} else {
@@ -476,14 +486,107 @@ namespace coast {
 
 		void InitPath(const char *root, const char *path) {
 			PathInitializerSingleton::instance().initialize(root, path);
+			FlushPathCache();
 		}
 
 		void SetRootDir(const char *root, bool print) {
 			PathInitializerSingleton::instance().SetRootDir(root, print);
+			FlushPathCache();
 		}
 
 		void SetPathList(const char *pathlist, bool print) {
 			PathInitializerSingleton::instance().SetPathList(pathlist, print);
+			FlushPathCache();
+		}
+
+		PathCache::PathCache(long lTtl, long lNegativeTtl, long lMaxEntries) :
+			fTtl(lTtl), fNegativeTtl(lNegativeTtl), fMaxEntries(lMaxEntries), fEntries(Anything::ArrayMarker(), coast::storage::Global()) {
+		}
+
+		class PathCache::LockEntry {
+			PathCache &fCache;
+		public:
+			LockEntry(PathCache &cache) : fCache(cache) {
+				fCache.DoLock();
+			}
+			~LockEntry() {
+				fCache.DoUnlock();
+			}
+		};
+
+		time_t PathCache::Now() const {
+			return time(0);
+		}
+
+		bool PathCache::Lookup(const String &relpath, String &resolved) {
+			LockEntry me(*this);
+			long lIdx = fEntries.FindIndex(relpath.cstr());
+			if ( lIdx < 0L ) {
+				return false;
+			}
+			ROAnything roaEntry(fEntries[lIdx]);
+			if ( roaEntry["Expires"].AsLong(0L) <= static_cast<long>(Now()) ) {
+				fEntries.Remove(lIdx);
+				return false;
+			}
+			resolved = roaEntry["Path"].AsString();
+			return true;
+		}
+
+		void PathCache::Remember(const String &relpath, const String &resolved) {
+			long lTtl = ( resolved.empty() ? fNegativeTtl : fTtl );
+			LockEntry me(*this);
+			if ( lTtl <= 0L ) {
+				fEntries.Remove(relpath.cstr());
+				return;
+			}
+			if ( fEntries.GetSize() >= fMaxEntries ) {
+				fEntries = Anything(Anything::ArrayMarker(), coast::storage::Global());
+			}
+			Anything anyEntry(Anything::ArrayMarker(), coast::storage::Global());
+			anyEntry["Path"] = Anything(resolved, coast::storage::Global());
+			anyEntry["Expires"] = static_cast<long>(Now()) + lTtl;
+			fEntries[relpath.cstr()] = anyEntry;
+		}
+
+		bool PathCache::Forget(const String &relpath) {
+			LockEntry me(*this);
+			return fEntries.Remove(relpath.cstr());
+		}
+
+		void PathCache::ForgetWritten(const String &path) {
+			LockEntry me(*this);
+			// a name can only resolve to path if it is a trailing part of it
+			for (long lIdx = fEntries.GetSize() - 1L; lIdx >= 0L; --lIdx) {
+				const char *pName = fEntries.SlotName(lIdx);
+				long lNameLen = pName ? static_cast<long>(strlen(pName)) : 0L, lOffset = path.Length() - lNameLen;
+				if ( lNameLen > 0L && lOffset >= 0L && ( lOffset == 0L || path[lOffset - 1L] == cSep ) && strcmp(path.cstr() + lOffset, pName) == 0 ) {
+					fEntries.Remove(lIdx);
+				}
+			}
+		}
+
+		void PathCache::Flush() {
+			LockEntry me(*this);
+			if ( fEntries.GetSize() > 0L ) {
+				fEntries = Anything(Anything::ArrayMarker(), coast::storage::Global());
+			}
+		}
+
+		PathCache *SetPathCache(PathCache *pCache) {
+			PathCache *pOld = fgPathCache;
+			fgPathCache = pCache;
+			return pOld;
+		}
+
+		PathCache *GetPathCache() {
+			return fgPathCache;
+		}
+
+		void FlushPathCache() {
+			if ( fgPathCache ) {
+				fgPathCache->Flush();
+			}
 		}
 
 		// used to smoothify the given path;
@@ -641,6 +744,8 @@ namespace coast {
 				if (!IsDirectory(dir) || chdir(dir) != 0) {
 					return false;
 				}
+				// a relative root directory now points elsewhere
+				FlushPathCache();
 			}
 			return true;
 		}
@@ -686,7 +791,13 @@ namespace coast {
 
 		std::iostream *OpenStreamWithSearch(const String &path, openmode mode)
 		{
-			return IntOpenStream(GetFilePathOrInput(path), mode);
+			std::iostream *Ios = IntOpenStream(GetFilePathOrInput(path), mode);
+			PathCache *pCache = GetPathCache();
+			if ( !Ios && pCache && pCache->Forget(path) ) {
+				// remembered location is gone, search again
+				Ios = IntOpenStream(GetFilePathOrInput(path), mode);
+			}
+			return Ios;
 		}
 
 		String GetFilePath(const char *name, const char *extension)
@@ -723,8 +834,16 @@ namespace coast {
 				Trace("absolute path given [" << relpath << "]");
 				resultPath = relpath;
 			} else {
-				Trace("file [" << relpath << "] is going to be searched in [" << GetRootDir() << "] with pathlist: [" << GetPathList() << "]");
-				resultPath = searchFilePath(relpath, GetPathList());
+				PathCache *pCache = GetPathCache();
+				if ( pCache && pCache->Lookup(relpath, resultPath) ) {
+					Trace("file [" << relpath << "] found in path cache as [" << resultPath << "]");
+				} else {
+					Trace("file [" << relpath << "] is going to be searched in [" << GetRootDir() << "] with pathlist: [" << GetPathList() << "]");
+					resultPath = searchFilePath(relpath, GetPathList());
+					if ( pCache ) {
+						pCache->Remember(relpath, resultPath);
+					}
+				}
 			}
 
 			if (resultPath.Length() > 0L) {
@@ -1079,8 +1198,15 @@ namespace coast {
 		bool LoadConfigFile(Anything &config, const char *name, const char *ext, String &realfilename)
 		{
 			StartTrace(System.LoadConfigFile);
-			realfilename = GetFilePath(buildFilename(name, ext));
+			String filename = buildFilename(name, ext);
+			realfilename = GetFilePath(filename);
 			std::istream *is = OpenStream(realfilename, (std::ios::in));
+			PathCache *pCache = GetPathCache();
+			if ( !is && pCache && pCache->Forget(filename) ) {
+				// remembered location is gone, search again
+				realfilename = GetFilePath(filename);
+				is = OpenStream(realfilename, (std::ios::in));
+			}
 			bool result = false;
 			if (!is || !(result = config.Import(*is, realfilename))) {
 				String logMsg("cannot import config file ");
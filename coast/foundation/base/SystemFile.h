@@ -10,6 +10,8 @@
 #define _SYSTEMFILE_H_
 
 #include "Anything.h"
+#include "AllocatorNewDelete.h"
+#include <ctime>
 
 //  definitions for io namespace
 #if !defined (R_OK)
@@ -123,6 +125,69 @@ namespace coast {
 			\param print if true prints the new settings to cerr */
 		void SetPathList(const char *pathlist, bool print = false);
 
+		//! cache of pathlist searches done by GetFilePath and OpenStreamWithSearch, keyed by the relative name searched for
+		/*! A found file is remembered for a limited time or until opening the remembered path fails. A miss is remembered
+			for a shorter time since files might be created by other processes in the meantime. Root directory or pathlist
+			changes flush the cache, opening a file for writing forgets the names it could have been found as.
+			Foundation has no threading primitives, therefore the default implementation does no locking at all and no cache
+			is installed by default. Multithreaded code must install a subclass which implements DoLock and DoUnlock, the
+			mtfoundation library does so when it gets loaded.
+			\note All internal storage is allocated from the global allocator because entries outlive the requests creating them */
+		class PathCache : public coast::AllocatorNewDelete {
+		public:
+			/*! \param lTtl seconds a found path is remembered
+				\param lNegativeTtl seconds a miss is remembered
+				\param lMaxEntries upper bound of cached names, the names searched for might come from requests */
+			PathCache(long lTtl = 60L, long lNegativeTtl = 5L, long lMaxEntries = 4096L);
+			virtual ~PathCache() {
+			}
+			//! look up a previous search
+			/*! \param relpath name searched for
+				\param resolved receives the path found, empty for a remembered miss
+				\return true if a valid entry for relpath is in the cache */
+			bool Lookup(const String &relpath, String &resolved);
+			//! remember the result of a search, an empty resolved path marks a miss
+			void Remember(const String &relpath, const String &resolved);
+			//! forget a remembered path which could not be opened anymore
+			/*! \return true if relpath was in the cache */
+			bool Forget(const String &relpath);
+			//! forget all names which could be resolved to path, called when path gets opened for writing
+			void ForgetWritten(const String &path);
+			//! forget everything
+			void Flush();
+
+		protected:
+			//! current time in seconds, overridable for testing
+			virtual time_t Now() const;
+			//! acquire lock protecting the entries
+			virtual void DoLock() {
+			}
+			//! release lock protecting the entries
+			virtual void DoUnlock() {
+			}
+
+		private:
+			PathCache(const PathCache &);
+			PathCache &operator=(const PathCache &);
+
+			long fTtl, fNegativeTtl, fMaxEntries;
+			//! name searched for -> { /Path /Expires }
+			Anything fEntries;
+
+			class LockEntry;
+		};
+
+		/*! install the cache used by GetFilePath; ownership remains with the caller
+			\param pCache cache to use or NULL to disable caching
+			\return previously installed cache */
+		PathCache *SetPathCache(PathCache *pCache);
+		//! currently installed cache, NULL if caching is disabled
+		PathCache *GetPathCache();
+
+		//! forget the results of earlier searches in the pathlist
+		/*! Call this after files were added or moved by other means than opening them for writing, see PathCache. */
+		void FlushPathCache();
+
 		//! returns the current rootdir for this process
 		const char *GetRootDir();
 
@@ -182,6 +182,52 @@ void AnyBuiltInSortTest::SortIsStable() {
 
 }
 
+void AnyBuiltInSortTest::SortCommonPrefix() {
+	StartTrace(AnyBuiltInSortTest.SortCommonPrefix);
+	Anything a;
+	a["CommonPrefix_b"] = 1;
+	a["CommonPrefix_a"] = 2;
+	a["CommonPrefix"] = 3;
+	a["Common"] = 4;
+	a["\xe4" "Common"] = 5;
+	a["CommonPrefix_"] = 6;
+	a.SortByKey();
+	t_assert(checksorted(a));
+	assertEqual("Common", a.SlotName(0));
+	assertEqual("CommonPrefix", a.SlotName(1));
+	assertEqual("CommonPrefix_", a.SlotName(2));
+	assertEqual("CommonPrefix_a", a.SlotName(3));
+	assertEqual("CommonPrefix_b", a.SlotName(4));
+	assertEqual("\xe4" "Common", a.SlotName(5));
+	assertEqual(2, a["CommonPrefix_a"].AsLong());
+	assertEqual(5, a["\xe4" "Common"].AsLong());
+	a.SortReverseByKey();
+	assertEqual("\xe4" "Common", a.SlotName(0));
+	assertEqual("CommonPrefix_b", a.SlotName(1));
+	assertEqual("CommonPrefix_a", a.SlotName(2));
+	assertEqual("Common", a.SlotName(5));
+	assertEqual(1, a["CommonPrefix_b"].AsLong());
+}
+
+void AnyBuiltInSortTest::SortByOrder() {
+	StartTrace(AnyBuiltInSortTest.SortByOrder);
+	Anything a;
+	a["a"] = 1;
+	a.Append(2);
+	a["c"] = 3;
+	const long order[] = { 2, 0, 1 };
+	a.SortByOrder(order);
+	assertEqual(3L, a.GetSize());
+	assertEqual("c", a.SlotName(0));
+	assertEqual("a", a.SlotName(1));
+	t_assert(a.SlotName(2) == 0);
+	assertEqual(3, a[0L].AsLong());
+	assertEqual(1, a[1L].AsLong());
+	assertEqual(2, a[2L].AsLong());
+	assertEqual(3, a["c"].AsLong());
+	assertEqual(1, a["a"].AsLong());
+}
+
 // builds up a suite of testcases, add a line for each testmethod
 Test *AnyBuiltInSortTest::suite() {
 	StartTrace(AnyBuiltInSortTest.suite);
@@ -193,5 +239,7 @@ Test *AnyBuiltInSortTest::suite() {
 	ADD_CASE(testSuite, AnyBuiltInSortTest, SortMany);
 	ADD_CASE(testSuite, AnyBuiltInSortTest, SortManyStringValues);
 	ADD_CASE(testSuite, AnyBuiltInSortTest, SortIsStable);
+	ADD_CASE(testSuite, AnyBuiltInSortTest, SortCommonPrefix);
+	ADD_CASE(testSuite, AnyBuiltInSortTest, SortByOrder);
 	return testSuite;
 }
@@ -36,6 +36,11 @@ public:
 	//! without keys, elements should keep their order
 	void SortIsStable();
 
+	//! keys sharing more than the compared prefix are sorted by their full content
+	void SortCommonPrefix();
+	//! slots are moved with their names to a given order
+	void SortByOrder();
+
 protected:
 	bool checksorted(const Anything &a, bool shouldfail = false);
 	bool checksortedbyvalue(const Anything &a, bool shouldfail = false);
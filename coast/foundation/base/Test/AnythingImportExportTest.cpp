@@ -23,9 +23,11 @@ Test *AnythingImportExportTest::suite() {
 	ADD_CASE(testSuite, AnythingImportExportTest, WriteRead8Test);
 	ADD_CASE(testSuite, AnythingImportExportTest, RefSlotTest);
 	ADD_CASE(testSuite, AnythingImportExportTest, AnyIncludeTest);
+	ADD_CASE(testSuite, AnythingImportExportTest, AnyIncludeTwiceTest);
 	ADD_CASE(testSuite, AnythingImportExportTest, RefBug227Test);
 	ADD_CASE(testSuite, AnythingImportExportTest, RefBug231Test);
 	ADD_CASE(testSuite, AnythingImportExportTest, RefBug220Test);
+	ADD_CASE(testSuite, AnythingImportExportTest, PrintFormatTest);
 	return testSuite;
 }
 
@@ -195,6 +197,41 @@ void AnythingImportExportTest::WriteRead8Test() {
 	t_assert( AnythingImportExportTest::check5DimArray(any0, any1, 5) == true );
 }
 
+void AnythingImportExportTest::AnyIncludeTwiceTest() {
+	String strIncl(_QUOTE_( {/100 {/d foo /e frim} /200 %100}));
+	{
+		Anything anyIncl;
+		IStringStream is(strIncl);
+		anyIncl.Import(is);
+		std::iostream *pStream = system::OpenOStream("include", "any");
+		t_assert(pStream != 0);
+		if (pStream) {
+			anyIncl.Export(*pStream);
+			delete pStream;
+		}
+	}
+	String strMain(_QUOTE_( {/first !"file:///include.any" /second !"file:///include.any" /part !"file:///include.any?100" /third !"file:///include.any"}));
+	String strRef(_QUOTE_( {/first {/100 {/d foo /e frim} /200 %first.100} /second {/100 {/d foo /e frim} /200 %second.100} /part {/d foo /e frim} /third {/100 {/d foo /e frim} /200 %third.100}}));
+	Anything anyMain, anyRef;
+	{
+		IStringStream is(strMain);
+		t_assert(anyMain.Import(is));
+	}
+	{
+		IStringStream is(strRef);
+		anyRef.Import(is);
+	}
+	assertAnyEqual(anyRef, anyMain);
+	anyMain["first"]["100"]["d"] = "bar";
+	assertEqual("bar", anyMain["first"]["200"]["d"].AsString());
+	assertEqual("foo", anyMain["second"]["100"]["d"].AsString());
+	assertEqual("foo", anyMain["part"]["d"].AsString());
+	assertEqual("foo", anyMain["third"]["200"]["d"].AsString());
+	anyMain["third"]["200"]["e"] = "frum";
+	assertEqual("frum", anyMain["third"]["100"]["e"].AsString());
+	assertEqual("frim", anyMain["second"]["100"]["e"].AsString());
+}
+
 void AnythingImportExportTest::RefSlotTest() {
 	{
 		// Check Ref Export and Import of primitive types
@@ -679,3 +716,66 @@ void AnythingImportExportTest::RefBug220Test() {
 		assertAnyEqual(anyExpected, anyResult);
 	}
 }
+
+void AnythingImportExportTest::PrintFormatTest() {
+	Anything shared;
+	shared[0L] = "q\"\\\n\x01";
+	shared["d"] = 1.5;
+	Anything a;
+	a["1st"] = shared;
+	a["a.b"]["x y"] = shared;
+	a["list"].Append(shared);
+	a["list"].Append(Anything());
+	a["buf"] = Anything((void *)"ab", 2);
+	{
+		String strOut;
+		OStringStream os(strOut);
+		a.PrintOn(os, false);
+		os.flush();
+		assertCharPtrEqual("{/\"1st\" {\"q\\\"\\\\\\n\\x01\"/d 1.5}/a.b {/\"x y\" {\"q\\\"\\\\\\n\\x01\"/d 1.5}}"
+				"/list {{\"q\\\"\\\\\\n\\x01\"/d 1.5}*}/buf [2;ab]}", strOut);
+	}
+	{
+		String strOut;
+		OStringStream os(strOut);
+		a.PrintOn(os, true);
+		os.flush();
+		assertCharPtrEqual("{\n  /\"1st\" {\n    \"q\\\"\\\\\\n\\x01\"\n    /d 1.5\n  }\n  /a.b {\n    /\"x y\" {\n"
+				"      \"q\\\"\\\\\\n\\x01\"\n      /d 1.5\n    }\n  }\n  /list {\n    {\n      \"q\\\"\\\\\\n\\x01\"\n"
+				"      /d 1.5\n    }\n    *\n  }\n  /buf [2;ab]\n}", strOut);
+	}
+	{
+		String strOut;
+		OStringStream os(strOut);
+		a.Export(os);
+		assertCharPtrEqual("{\n  /\"1st\" {\n    \"q\\\"\\\\\\n\\x01\"\n    /d 1.5\n  }\n  /a.b {\n    /\"x y\" %\"1st\"\n  }\n"
+				"  /list {\n    %\"1st\"\n    *\n  }\n  /buf [2;ab]\n}", strOut);
+		Anything anyImported;
+		IStringStream is(strOut);
+		t_assert(anyImported.Import(is));
+		anyImported["1st"]["d"] = 2L;
+		assertEqual(2L, anyImported["list"][0L]["d"].AsLong(0L));
+	}
+	{
+		Anything anyLarge;
+		for (long i = 0; i < 2000L; ++i) {
+			anyLarge[String("key") << i] = shared;
+		}
+		String strOut;
+		{
+			OStringStream os(strOut);
+			anyLarge.PrintOn(os, true);
+		}
+		t_assert(strOut.Length() > 8192L);
+		Anything anyImported;
+		IStringStream is(strOut);
+		t_assert(anyImported.Import(is));
+		assertEqual(anyLarge.GetSize(), anyImported.GetSize());
+		String strReprinted;
+		{
+			OStringStream os(strReprinted);
+			anyImported.PrintOn(os, true);
+		}
+		assertCharPtrEqual(strOut, strReprinted);
+	}
+}
@@ -27,11 +27,15 @@ public:
 	void WriteRead7Test();
 	void WriteRead8Test();
 	void AnyIncludeTest();
+	//! the same file included more than once results in independent Anythings
+	void AnyIncludeTwiceTest();
 
 	void RefSlotTest();
 	void RefBug227Test();
 	void RefBug231Test();
 	void RefBug220Test();
+	//! exact output of PrintOn and Export including references and output larger than one buffered block
+	void PrintFormatTest();
 
 protected:
 	Anything init5DimArray(long);
@@ -10,6 +10,7 @@
 #include "TestSuite.h"
 #include "SystemLog.h"
 #include "boost/bind.hpp"
+#include <fstream>
 
 using namespace coast;
 
@@ -606,6 +607,59 @@ void SystemFileTest::GetFilePathTest() {
 	testGetFilePath(boost::bind(&coast::system::GetFilePathOrInput, "Tracer.any"), "Tracer.any");
 }
 
+namespace {
+	//! PathCache with a clock under control of the test
+	class TestPathCache: public system::PathCache {
+	public:
+		TestPathCache() :
+			system::PathCache(10L, 2L), fNow(1000) {
+		}
+		time_t fNow;
+	protected:
+		virtual time_t Now() const {
+			return fNow;
+		}
+	};
+}
+
+void SystemFileTest::PathCacheTest() {
+	StartTrace(SystemFileTest.PathCacheTest);
+	const char *pcName = "PathCacheTest.tst";
+	TestPathCache aCache;
+	system::PathCache *pOldCache = system::SetPathCache(&aCache);
+	String strFile(system::GetRootDir());
+	strFile.Append(system::Sep()).Append("config").Append(system::Sep()).Append(pcName);
+	system::io::unlink(strFile);
+	assertEqual("", system::GetFilePath(pcName));
+	{
+		std::ofstream os(strFile.cstr());
+		os << "cached" << std::endl;
+	}
+	assertEqualm("", system::GetFilePath(pcName), "miss should be remembered");
+	aCache.fNow += 3;
+	String strFound(system::GetFilePath(pcName));
+	t_assertm(strFound.Length() > 0L, "remembered miss should expire");
+	system::io::unlink(strFile);
+	assertEqualm(strFound, system::GetFilePath(pcName), "found location should be remembered");
+	std::iostream *Ios = system::OpenStreamWithSearch(pcName);
+	t_assertm(Ios == 0, "file is gone");
+	delete Ios;
+	assertEqualm("", system::GetFilePath(pcName), "vanished file should be forgotten");
+	aCache.Remember("OtherName.tst", "");
+	Ios = system::OpenOStream(strFile);
+	if ( t_assertm(Ios != 0, "could not create file") ) {
+		*Ios << "cached" << std::endl;
+	}
+	delete Ios;
+	assertEqualm(strFound, system::GetFilePath(pcName), "writing should forget the remembered miss");
+	String strOther;
+	t_assertm(aCache.Lookup("OtherName.tst", strOther), "writing must not forget other names");
+	system::io::unlink(strFile);
+	aCache.fNow += 11;
+	assertEqualm("", system::GetFilePath(pcName), "found location should expire");
+	system::SetPathCache(pOldCache);
+}
+
 void SystemFileTest::dirFileListTest() {
 	StartTrace(SystemFileTest.dirFileListTest);
 	Anything dir(system::DirFileList("."));
@@ -1498,6 +1552,9 @@ Test *SystemFileTest::suite() {
 	ADD_CASE(testSuite, SystemFileTest, OpenOStreamTest);
 	ADD_CASE(testSuite, SystemFileTest, OpenIStreamTest);
 	ADD_CASE(testSuite, SystemFileTest, GetFilePathTest);
+#if !defined(WIN32)
+	ADD_CASE(testSuite, SystemFileTest, PathCacheTest);
+#endif
 	ADD_CASE(testSuite, SystemFileTest, dirFileListTest);
 	ADD_CASE(testSuite, SystemFileTest, IStreamTest);
 	ADD_CASE(testSuite, SystemFileTest, OStreamTest);
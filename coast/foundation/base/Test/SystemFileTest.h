@@ -28,6 +28,7 @@ public:
 	void OpenOStreamTest();
 	void OpenIStreamTest();
 	void GetFilePathTest();
+	void PathCacheTest();
 	void dirFileListTest();
 	void IStreamTest();
 	void OStreamTest();
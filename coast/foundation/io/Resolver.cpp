@@ -10,9 +10,11 @@
 #include "SystemLog.h"
 #include "Socket.h"
 #include "Tracer.h"
+#include "DiffTimer.h"
 #if !defined(WIN32)
 #include <arpa/inet.h>		// for inet_ntop gethostbyname etc.
 #include <netdb.h>			// for gethostbyname etc.
+#include <cstring>			// for memset
 #else
 #include <io.h>
 #endif
@@ -70,6 +72,235 @@ public:
 	bool IP2DNS(const String &ipAddress, unsigned long addr);
 };
 
+namespace {
+	ResolverCache *fgResolverCache = 0;
+	const char cDNS2IPPrefix = 'n';
+	const char cIP2DNSPrefix = 'a';
+
+	String MakeCacheKey(char cPrefix, const String &strValue) {
+		String strKey(strValue.Length() + 1, coast::storage::Current());
+		strKey.Append(cPrefix).Append(strValue);
+		return strKey.ToLower();
+	}
+}
+
+//! scoped locking of one shard using the DoLock/DoUnlock hooks
+class ResolverCache::ShardLockEntry
+{
+	ResolverCache &fCache;
+	long fShard;
+public:
+	ShardLockEntry(ResolverCache &aCache, long lShard) :
+		fCache(aCache), fShard(lShard) {
+		fCache.DoLock(fShard);
+	}
+	~ShardLockEntry() {
+		fCache.DoUnlock(fShard);
+	}
+};
+
+ResolverCache::ResolverCache(long lTtl, long lNegativeTtl, long lShards, long lMaxEntries) :
+	fTtl(lTtl), fNegativeTtl(lNegativeTtl), fShards(lShards > 0 ? lShards : 1L), fMaxEntries(lMaxEntries > 0 ? lMaxEntries : 1L), fShardList(Anything::ArrayMarker(), coast::storage::Global())
+{
+	StartTrace1(ResolverCache.ResolverCache, "ttl:" << fTtl << " negative ttl:" << fNegativeTtl << " shards:" << fShards);
+	for (long lShard = 0; lShard < fShards; ++lShard) {
+		Anything anyShard(Anything::ArrayMarker(), coast::storage::Global());
+		anyShard["Entries"] = Anything(Anything::ArrayMarker(), coast::storage::Global());
+		anyShard["Hits"] = 0L;
+		anyShard["NegativeHits"] = 0L;
+		anyShard["Misses"] = 0L;
+		anyShard["Expired"] = 0L;
+		anyShard["Evicted"] = 0L;
+		anyShard["Resolved"] = 0L;
+		anyShard["ResolveTimeSum"] = 0L;
+		anyShard["ResolveTimeMax"] = 0L;
+		fShardList.Append(anyShard);
+	}
+}
+
+ResolverCache::~ResolverCache()
+{
+}
+
+time_t ResolverCache::Now() const
+{
+	return time(0);
+}
+
+long ResolverCache::ShardFor(const String &strKey) const
+{
+	// FNV-1a, good enough to spread hostnames over shards
+	unsigned long ulHash = 2166136261UL;
+	for (long lIdx = 0, lLen = strKey.Length(); lIdx < lLen; ++lIdx) {
+		ulHash = (ulHash ^ static_cast<unsigned char>(strKey[lIdx])) * 16777619UL;
+	}
+	return static_cast<long>(ulHash % static_cast<unsigned long>(fShards));
+}
+
+bool ResolverCache::Lookup(const String &strKey, String &strValue)
+{
+	StartTrace1(ResolverCache.Lookup, "key [" << strKey << "]");
+	long lShard = ShardFor(strKey);
+	ShardLockEntry aEntry(*this, lShard);
+	Anything &anyShard = fShardList[lShard];
+	long lIdx = anyShard["Entries"].FindIndex(strKey);
+	if ( lIdx >= 0 ) {
+		Anything &anyCached = anyShard["Entries"][lIdx];
+		if ( anyCached["Expires"].AsLong(0L) > static_cast<long>(Now()) ) {
+			strValue = anyCached["Value"].AsString();
+			anyCached["Used"] = 1L;
+			const char *pCounter = ( strValue.Length() ? "Hits" : "NegativeHits" );
+			anyShard[pCounter] = anyShard[pCounter].AsLong(0L) + 1L;
+			Trace("cached value [" << strValue << "]");
+			return true;
+		}
+		anyShard["Entries"].Remove(lIdx);
+		anyShard["Expired"] = anyShard["Expired"].AsLong(0L) + 1L;
+	}
+	anyShard["Misses"] = anyShard["Misses"].AsLong(0L) + 1L;
+	return false;
+}
+
+void ResolverCache::Store(const String &strKey, const String &strValue, long lMicroSecs)
+{
+	StartTrace1(ResolverCache.Store, "key [" << strKey << "] value [" << strValue << "]");
+	long lShard = ShardFor(strKey);
+	ShardLockEntry aEntry(*this, lShard);
+	Anything &anyShard = fShardList[lShard];
+	anyShard["Resolved"] = anyShard["Resolved"].AsLong(0L) + 1L;
+	anyShard["ResolveTimeSum"] = anyShard["ResolveTimeSum"].AsLong(0L) + lMicroSecs;
+	if ( lMicroSecs > anyShard["ResolveTimeMax"].AsLong(0L) ) {
+		anyShard["ResolveTimeMax"] = lMicroSecs;
+	}
+	long lTtl = ( strValue.Length() ? fTtl : fNegativeTtl );
+	if ( lTtl <= 0L ) {
+		anyShard["Entries"].Remove(strKey);
+		return;
+	}
+	time_t tNow = Now();
+	Anything &anyEntries = anyShard["Entries"];
+	// a stored entry moves to the end, the entries stay ordered by the time they were stored
+	anyEntries.Remove(strKey);
+	if ( anyEntries.GetSize() >= fMaxEntries ) {
+		EvictEntries(anyShard, tNow);
+	}
+	Anything anyCached(Anything::ArrayMarker(), coast::storage::Global());
+	anyCached["Value"] = Anything(strValue, coast::storage::Global());
+	anyCached["Expires"] = static_cast<long>(tNow) + lTtl;
+	anyCached["Used"] = 0L;
+	anyEntries[strKey] = anyCached;
+}
+
+void ResolverCache::EvictEntries(Anything &anyShard, time_t tNow)
+{
+	StartTrace(ResolverCache.EvictEntries);
+	Anything &anyEntries = anyShard["Entries"];
+	long lEvicted = 0L;
+	for (long lIdx = anyEntries.GetSize() - 1L; lIdx >= 0L; --lIdx) {
+		if ( anyEntries[lIdx]["Expires"].AsLong(0L) <= static_cast<long>(tNow) ) {
+			anyEntries.Remove(lIdx);
+			++lEvicted;
+		}
+	}
+	// entries are ordered by store time, so the first ones are the oldest
+	while ( anyEntries.GetSize() >= fMaxEntries ) {
+		anyEntries.Remove(0L);
+		++lEvicted;
+	}
+	anyShard["Evicted"] = anyShard["Evicted"].AsLong(0L) + lEvicted;
+	Trace("evicted " << lEvicted << " entries");
+}
+
+void ResolverCache::CollectExpiring(Anything &anyKeys, long lWithinSecs)
+{
+	StartTrace1(ResolverCache.CollectExpiring, "within " << lWithinSecs << "s");
+	long lNow = static_cast<long>(Now()), lLimit = lNow + lWithinSecs;
+	for (long lShard = 0; lShard < fShards; ++lShard) {
+		ShardLockEntry aEntry(*this, lShard);
+		Anything &anyShard = fShardList[lShard];
+		Anything &anyEntries = anyShard["Entries"];
+		long lExpired = 0L;
+		for (long lIdx = anyEntries.GetSize() - 1L; lIdx >= 0L; --lIdx) {
+			Anything &anyCached = anyEntries[lIdx];
+			long lExpires = anyCached["Expires"].AsLong(0L);
+			if ( lExpires <= lNow ) {
+				anyEntries.Remove(lIdx);
+				++lExpired;
+			} else if ( lExpires < lLimit && anyCached["Used"].AsLong(0L) && anyCached["Value"].AsString().Length() ) {
+				// only names asked for since the last refresh are worth resolving again, failures just expire
+				anyCached["Used"] = 0L;
+				anyKeys.Append(anyEntries.SlotName(lIdx));
+			}
+		}
+		anyShard["Expired"] = anyShard["Expired"].AsLong(0L) + lExpired;
+	}
+	TraceAny(anyKeys, "expiring keys");
+}
+
+void ResolverCache::Clear()
+{
+	StartTrace(ResolverCache.Clear);
+	for (long lShard = 0; lShard < fShards; ++lShard) {
+		ShardLockEntry aEntry(*this, lShard);
+		fShardList[lShard]["Entries"] = Anything(Anything::ArrayMarker(), coast::storage::Global());
+	}
+}
+
+void ResolverCache::Statistic(Anything &anyStatistic)
+{
+	StartTrace(ResolverCache.Statistic);
+	static const char *counters[] = { "Hits", "NegativeHits", "Misses", "Expired", "Evicted", "Resolved", "ResolveTimeSum" };
+	const long lNumCounters = sizeof(counters) / sizeof(counters[0]);
+	for (long lCounter = 0; lCounter < lNumCounters; ++lCounter) {
+		anyStatistic[counters[lCounter]] = 0L;
+	}
+	anyStatistic["ResolveTimeMax"] = 0L;
+	anyStatistic["Entries"] = 0L;
+	for (long lShard = 0; lShard < fShards; ++lShard) {
+		ShardLockEntry aEntry(*this, lShard);
+		ROAnything roaShard = fShardList[lShard];
+		for (long lCounter = 0; lCounter < lNumCounters; ++lCounter) {
+			anyStatistic[counters[lCounter]] = anyStatistic[counters[lCounter]].AsLong(0L) + roaShard[counters[lCounter]].AsLong(0L);
+		}
+		if ( roaShard["ResolveTimeMax"].AsLong(0L) > anyStatistic["ResolveTimeMax"].AsLong(0L) ) {
+			anyStatistic["ResolveTimeMax"] = roaShard["ResolveTimeMax"].AsLong(0L);
+		}
+		anyStatistic["Entries"] = anyStatistic["Entries"].AsLong(0L) + roaShard["Entries"].GetSize();
+	}
+	long lResolved = anyStatistic["Resolved"].AsLong(0L);
+	anyStatistic["ResolveTimeAvg"] = ( lResolved > 0L ? anyStatistic["ResolveTimeSum"].AsLong(0L) / lResolved : 0L );
+	TraceAny(anyStatistic, "statistic");
+}
+
+ResolverCache *Resolver::SetCache(ResolverCache *pCache)
+{
+	StartTrace(Resolver.SetCache);
+	ResolverCache *pOld = fgResolverCache;
+	fgResolverCache = pCache;
+	return pOld;
+}
+
+ResolverCache *Resolver::GetCache()
+{
+	return fgResolverCache;
+}
+
+bool Resolver::DoDNS2IP(String &ipAddress, const String &dnsName)
+{
+	SystemSpecific(Resolver) sysResolver;
+	return sysResolver.DNS2IP(ipAddress, dnsName);
+}
+
+bool Resolver::DoIP2DNS(String &dnsName, const String &ipAddress)
+{
+	SystemSpecific(Resolver) sysResolver;
+	if ( sysResolver.IP2DNS(ipAddress, EndPoint::MakeInetAddr(ipAddress)) ) {
+		dnsName = sysResolver.getCanonicalName();
+		return true;
+	}
+	return false;
+}
+
 String Resolver::DNS2IPAddress( const String &dnsName, const String &dflt )
 {
 	StartTrace1(Resolver.DNS2IPAddress, "dns [" << dnsName << "]");
@@ -78,9 +309,20 @@ String Resolver::DNS2IPAddress( const String &dnsName, const String &dflt )
 		return dnsName;
 	} else {
 		String ipAddress;
-		SystemSpecific(Resolver) sysResolver;
-
-		if ( sysResolver.DNS2IP(ipAddress, dnsName) ) {
+		ResolverCache *pCache = fgResolverCache;
+		String strKey;
+		if ( pCache ) {
+			strKey = MakeCacheKey(cDNS2IPPrefix, dnsName);
+			if ( pCache->Lookup(strKey, ipAddress) ) {
+				return ( ipAddress.Length() ? ipAddress : dflt );
+			}
+		}
+		DiffTimer aTimer(DiffTimer::eMicroseconds);
+		bool bResolved = DoDNS2IP(ipAddress, dnsName);
+		if ( pCache ) {
+			pCache->Store(strKey, bResolved ? ipAddress : String(), static_cast<long>(aTimer.Diff()));
+		}
+		if ( bResolved ) {
 			Trace("resolved ip [" << ipAddress << "]");
 			return ipAddress;
 		}
@@ -95,18 +337,49 @@ String Resolver::DNS2IPAddress( const String &dnsName, const String &dflt )
 String Resolver::IPAddress2DNS( const String &ipAddress, const String &dflt )
 {
 	StartTrace1(Resolver.IPAddress2DNS, "ip [" << ipAddress << "]");
-	unsigned long addr = EndPoint::MakeInetAddr(ipAddress);
-
-	SystemSpecific(Resolver) sysResolver;
-
-	if ( !sysResolver.IP2DNS(ipAddress, addr) ) {
+	String dnsName;
+	ResolverCache *pCache = fgResolverCache;
+	String strKey;
+	if ( pCache ) {
+		strKey = MakeCacheKey(cIP2DNSPrefix, ipAddress);
+		if ( pCache->Lookup(strKey, dnsName) ) {
+			return ( dnsName.Length() ? dnsName : dflt );
+		}
+	}
+	DiffTimer aTimer(DiffTimer::eMicroseconds);
+	bool bResolved = DoIP2DNS(dnsName, ipAddress);
+	if ( pCache ) {
+		pCache->Store(strKey, bResolved ? dnsName : String(), static_cast<long>(aTimer.Diff()));
+	}
+	if ( !bResolved ) {
 		String logMsg("Resolving of IPAddress <");
 		logMsg << ipAddress << "> failed";
 		SystemLog::Error(logMsg);
 		return dflt;
 	}
-	Trace("resolved name [" << sysResolver.getCanonicalName() << "]");
-	return sysResolver.getCanonicalName();
+	Trace("resolved name [" << dnsName << "]");
+	return dnsName;
+}
+
+long Resolver::RefreshCache(long lWithinSecs)
+{
+	StartTrace1(Resolver.RefreshCache, "within " << lWithinSecs << "s");
+	ResolverCache *pCache = fgResolverCache;
+	if ( !pCache ) {
+		return 0L;
+	}
+	Anything anyKeys;
+	pCache->CollectExpiring(anyKeys, lWithinSecs);
+	long lRefreshed = 0L;
+	for (long lIdx = 0, lSize = anyKeys.GetSize(); lIdx < lSize; ++lIdx) {
+		String strKey = anyKeys[lIdx].AsString(), strValue, strQuery = strKey.SubString(1L);
+		DiffTimer aTimer(DiffTimer::eMicroseconds);
+		bool bResolved = ( strKey[0L] == cDNS2IPPrefix ) ? DoDNS2IP(strValue, strQuery) : DoIP2DNS(strValue, strQuery);
+		pCache->Store(strKey, bResolved ? strValue : String(), static_cast<long>(aTimer.Diff()));
+		++lRefreshed;
+	}
+	Trace("refreshed " << lRefreshed << " entries");
+	return lRefreshed;
 }
 
 #if defined(__sun)
@@ -208,20 +481,22 @@ bool AppleResolver::IP2DNS(const String &ipAddress, unsigned long addr)
 bool LinuxResolver::DNS2IP(String &ipAddress, const String &dnsName)
 {
 	StartTrace1(Resolver.DNS2IP, "<linux> dns [" << dnsName << "]");
-	struct hostent he;
-	struct hostent *res=0;
-	const int bufSz = 8192;
-	char buf[bufSz] = {0};
-	int err=0;
-
-	if (gethostbyname_r(dnsName, &he, buf, bufSz, &res, &err) == 0) {
-		Trace("err:" << static_cast<long>(err) << " res:" << reinterpret_cast<long>(res));
-		// according to man page of gethostbyname_r, res != NULL can be taken as valid result
-		if (res!=0) {
-			char **pptr;
-			char str[INET6_ADDRSTRLEN]={0};
-			pptr = he.h_addr_list;
-			ipAddress = inet_ntop(he.h_addrtype, *pptr, str, sizeof(str));
+	// getaddrinfo is reentrant and consults the same sources as gethostbyname_r (nsswitch, hosts file)
+	// EndPoint only deals with IPv4 addresses, therefore we restrict the query to AF_INET
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	struct addrinfo *res = 0;
+	int err = getaddrinfo(dnsName, 0, &hints, &res);
+	Trace("err:" << static_cast<long>(err));
+	if ( err == 0 && res != 0 ) {
+		char str[INET6_ADDRSTRLEN] = {0};
+		const struct sockaddr_in *pAddr = reinterpret_cast<const struct sockaddr_in *>(res->ai_addr);
+		const char *pIp = inet_ntop(res->ai_family, &pAddr->sin_addr, str, sizeof(str));
+		freeaddrinfo(res);
+		if ( pIp ) {
+			ipAddress = pIp;
 			return true;
 		}
 	}
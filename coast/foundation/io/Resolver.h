@@ -10,14 +10,86 @@
 #define _Resolver_H
 
 #include "ITOString.h"//lint !e537
+#include "Anything.h"//lint !e537
+#include "AllocatorNewDelete.h"
+#include <ctime>
 
 namespace {
 	static const String defaultIP("127.0.0.1");
 	static const String defaultName("localhost");
 }
+//! cache for resolved names and addresses used by Resolver
+/*! Entries are distributed over a configurable number of shards to keep lock contention low when many threads resolve concurrently.
+Failed lookups are cached too but expire after the (usually shorter) negative ttl.
+Foundation has no threading primitives, therefore the default implementation does no locking at all.
+Multithreaded code must install a subclass which implements DoLock and DoUnlock, see ResolverCacheModule in wdbase.
+\note All internal storage is allocated from the global allocator because entries outlive the requests creating them */
+class ResolverCache : public coast::AllocatorNewDelete
+{
+public:
+	/*! create cache
+		\param lTtl seconds a successfully resolved entry stays valid
+		\param lNegativeTtl seconds a failed lookup stays cached, 0 disables caching of failures
+		\param lShards number of independently locked partitions
+		\param lMaxEntries maximum number of entries per shard, oldest entries get evicted first */
+	ResolverCache(long lTtl = 300L, long lNegativeTtl = 30L, long lShards = 16L, long lMaxEntries = 1024L);
+	virtual ~ResolverCache();
+
+	/*! lookup a cached entry
+		\param strKey key to lookup
+		\param strValue cached value, empty if the entry was a cached failure
+		\return true if a valid entry was found, false if it needs to be resolved */
+	bool Lookup(const String &strKey, String &strValue);
+
+	/*! store resolver result, an empty value marks a failed lookup
+		\param strKey key to store the value under
+		\param strValue resolved value or empty string in case of failure
+		\param lMicroSecs time the resolver library needed for this lookup, used for statistics only */
+	void Store(const String &strKey, const String &strValue, long lMicroSecs = 0L);
+
+	/*! collect keys of successfully resolved entries which were looked up since they were stored or last collected
+		and will expire within the given number of seconds; collecting resets the used mark of an entry.
+		Entries already expired are removed, unused and negative entries are left to expire.
+		\param anyKeys array the keys get appended to
+		\param lWithinSecs collect entries expiring earlier than now + lWithinSecs */
+	void CollectExpiring(Anything &anyKeys, long lWithinSecs);
+
+	//! remove all entries, statistics are kept
+	void Clear();
+
+	//! retrieve hit, miss and latency counters summed up over all shards
+	void Statistic(Anything &anyStatistic);
+
+	long GetShards() const {
+		return fShards;
+	}
+
+protected:
+	//! current time in seconds, overridable for testing
+	virtual time_t Now() const;
+	//! acquire lock protecting the given shard
+	virtual void DoLock(long lShard) {}
+	//! release lock protecting the given shard
+	virtual void DoUnlock(long lShard) {}
+
+private:
+	ResolverCache(const ResolverCache &);
+	ResolverCache &operator=(const ResolverCache &);
+
+	long ShardFor(const String &strKey) const;
+	void EvictEntries(Anything &anyShard, time_t tNow);
+
+	long fTtl, fNegativeTtl, fShards, fMaxEntries;
+	//! per shard a slot "Entries" with key -> { /Value /Expires } and the shards counters
+	Anything fShardList;
+
+	class ShardLockEntry;
+};
+
 //!dns to ip adress and vice versa resolver
 //!api wrapper to resolver library;
 //!converts DNS names to ip addresses
+/*! If a ResolverCache is installed using SetCache, results of the resolver library - including failures - are cached */
 class Resolver
 {
 public:
@@ -26,7 +98,22 @@ public:
 	//!find the dns name of the ip address
 	static String IPAddress2DNS( const String &ipAddress, const String &dflt=defaultName );
 
+	/*! install cache used by DNS2IPAddress and IPAddress2DNS; ownership remains with the caller
+		\param pCache cache to use or NULL to disable caching
+		\return previously installed cache */
+	static ResolverCache *SetCache(ResolverCache *pCache);
+	//! currently installed cache, NULL if caching is disabled
+	static ResolverCache *GetCache();
+
+	/*! re-resolve cached entries which are about to expire and were used since the last refresh, intended to be called periodically from a background thread
+		\param lWithinSecs refresh entries which expire within the next lWithinSecs seconds
+		\return number of refreshed entries */
+	static long RefreshCache(long lWithinSecs);
+
 private:
+	static bool DoDNS2IP(String &ipAddress, const String &dnsName);
+	static bool DoIP2DNS(String &dnsName, const String &ipAddress);
+
 	Resolver();
 	Resolver(const Resolver &);
 	Resolver &operator=(const Resolver &);
@@ -17,9 +17,70 @@ using namespace coast;
 
 #if !defined(WIN32)
 #include <sys/socket.h> // used for send and recv
+#include <sys/uio.h>
 #include <errno.h>
+#include <cstring>
 #endif
 
+namespace {
+#if defined(MSG_DONTWAIT)
+	//! transfers are tried before polling the socket
+	const bool cOptimisticIO = true;
+	const int cTransferFlags = MSG_DONTWAIT;
+
+	bool WouldBlock() {
+		return errno == EAGAIN || errno == EWOULDBLOCK;
+	}
+
+	//! unlike system::SyscallWasInterrupted EAGAIN is not retried right away, the socket gets polled instead
+	bool Interrupted() {
+		return errno == EINTR;
+	}
+#else
+	const bool cOptimisticIO = false;
+	const int cTransferFlags = 0;
+
+	bool WouldBlock() {
+		return false;
+	}
+
+	bool Interrupted() {
+		return system::SyscallWasInterrupted();
+	}
+#endif
+
+	//! send what is left of two buffers after the first lOffset bytes with a single syscall
+	long SendFrom(int fd, long lOffset, const char *first, long lFirst, const char *second, long lSecond)
+	{
+		if ( lOffset >= lFirst ) {
+			second += lOffset - lFirst;
+			lSecond -= lOffset - lFirst;
+			lFirst = 0;
+		} else {
+			first += lOffset;
+			lFirst -= lOffset;
+		}
+		if ( lFirst <= 0 ) {
+			return send(fd, (char *)second, lSecond, cTransferFlags);//lint !e1773
+		}
+#if !defined(WIN32)
+		if ( lSecond > 0 ) {
+			struct iovec iov[2];
+			iov[0].iov_base = (char *)first;//lint !e1773
+			iov[0].iov_len = lFirst;
+			iov[1].iov_base = (char *)second;//lint !e1773
+			iov[1].iov_len = lSecond;
+			struct msghdr msg;
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_iov = iov;
+			msg.msg_iovlen = 2;
+			return sendmsg(fd, &msg, cTransferFlags);
+		}
+#endif
+		return send(fd, (char *)first, lFirst, cTransferFlags);//lint !e1773
+	}
+}
+
 
 iosITOSocket::iosITOSocket(Socket *s, long timeout, long sockbufsz, int mode )
 	: fSocketBuf(s, timeout, sockbufsz, mode)
@@ -67,6 +128,9 @@ SocketStreamBuf::SocketStreamBuf(Socket *psocket, long timeout, long sockbufsz,
 	, fSocket(psocket)
 	, fReadCount(0)
 	, fWriteCount(0)
+	, fWaitCount(0)
+	, fMaxBufSize(cSocketStreamMaxBufferSize)
+	, fReadBufFilled(false)
 {
 	SetTimeout(timeout);
 	xinit();
@@ -78,6 +142,9 @@ SocketStreamBuf::SocketStreamBuf(const SocketStreamBuf &ssbuf)
 	, fSocket(ssbuf.fSocket)//lint !e1554
 	, fReadCount(ssbuf.fReadCount)
 	, fWriteCount(ssbuf.fWriteCount)
+	, fWaitCount(ssbuf.fWaitCount)
+	, fMaxBufSize(ssbuf.fMaxBufSize)
+	, fReadBufFilled(false)
 {//lint !e1538
 	int mode = 0;
 	if (fReadBufStorage.Capacity() > 0) {
@@ -123,6 +190,21 @@ int SocketStreamBuf::overflow( int c )
 	return 0L;  // return 0 if successful
 } // overflow
 
+std::streamsize SocketStreamBuf::xsputn(const char *s, std::streamsize n)
+{
+	long lCapacity = fWriteBufStorage.Capacity();
+	if ( lCapacity <= 0 || n < lCapacity ) {
+		return std::streambuf::xsputn(s, n);
+	}
+	// copying would only split the block into buffer sized sends
+	long lPending = pptr() ? pptr() - pbase() : 0L;
+	if ( DoWriteVector(pbase(), lPending, s, n) == EOF ) {
+		return 0;
+	}
+	setp(startw(), endw());
+	return n;
+}
+
 int SocketStreamBuf::underflow()
 {
 	long count = 0;
@@ -138,11 +220,18 @@ int SocketStreamBuf::underflow()
 		}
 	}
 
-	if ((count = DoRead(startr(), fReadBufStorage.Capacity())) <= 0) {
+	long lCapacity = fReadBufStorage.Capacity();
+	if ( fReadBufFilled && lCapacity > 0 && lCapacity < fMaxBufSize ) {
+		// the get area is empty, the buffer can be replaced
+		fReadBufStorage.Reserve(( lCapacity * 2 < fMaxBufSize ) ? lCapacity * 2 : fMaxBufSize);
+		lCapacity = fReadBufStorage.Capacity();
+	}
+	if ((count = DoRead(startr(), lCapacity)) <= 0) {
 		return EOF;    // might mean eofbit or failbit or badbit
 	} else {
 		AddReadCount( count );
 	}
+	fReadBufFilled = ( count >= lCapacity );
 
 	setg(startr(), startr(), startr() + count);
 	return (int)(unsigned char) * gptr();
@@ -187,17 +276,33 @@ void SocketStreamBuf::AddWriteCount(long bytes)
 
 long SocketStreamBuf::DoWrite(const char *buf, long len)
 {
-	long bytesSent = 0;
+	return SendBuffers(buf, len, 0, 0L);
+}
+
+long SocketStreamBuf::DoWriteVector(const char *pending, long lPending, const char *buf, long len)
+{
+	return SendBuffers(pending, lPending, buf, len);
+}
+
+long SocketStreamBuf::SendBuffers(const char *first, long lFirst, const char *second, long lSecond)
+{
+	long bytesSent = 0, len = lFirst + lSecond;
 	std::iostream *Ios = fSocket ? fSocket->GetStream() : 0; // neeed for errorhandling
+	bool bWait = !cOptimisticIO;
 
 	while (len > bytesSent && Ios && Ios->good()) {
 		long nout = 0;
-		if ( fSocket->IsReadyForWriting() ) {//lint !e613
+		if ( !bWait || ( ++fWaitCount, fSocket->IsReadyForWriting() ) ) {//lint !e613
 			do {
-				nout = send(fSocket->GetFd(), (char *)buf + bytesSent, len - bytesSent, 0);//lint !e1773//lint !e613
-			} while (nout < 0 && system::SyscallWasInterrupted());
+				nout = SendFrom(fSocket->GetFd(), bytesSent, first, lFirst, second, lSecond);//lint !e613
+			} while (nout < 0 && Interrupted());
 			if (nout > 0) {
 				bytesSent += nout;
+				bWait = !cOptimisticIO;
+				continue;
+			}
+			if (nout < 0 && WouldBlock()) {
+				bWait = true;
 				continue;
 			}
 		} else if (fSocket->HadTimeout()) {//lint !e613
@@ -217,7 +322,12 @@ long SocketStreamBuf::DoWrite(const char *buf, long len)
 	if ( bytesSent > 0 ) {
 		AddWriteCount( bytesSent );
 #if defined(STREAM_TRACE)
-		SystemLog::WriteToStderr(buf, bytesSent);
+		if ( bytesSent <= lFirst ) {
+			SystemLog::WriteToStderr(first, bytesSent);
+		} else {
+			SystemLog::WriteToStderr(first, lFirst);
+			SystemLog::WriteToStderr(second, bytesSent - lFirst);
+		}
 #endif
 	}
 
@@ -230,27 +340,34 @@ long SocketStreamBuf::DoRead(char *buf, long len) const
 
 	if (fSocket) {
 		std::iostream *Ios = fSocket->GetStream();
-		if (fSocket->IsReadyForReading() ) {
+		bool bReady = cOptimisticIO || ( ++fWaitCount, fSocket->IsReadyForReading() );
+		while ( bReady ) {
 			do {
-				bytesRead = recv(fSocket->GetFd(), buf, len, 0);
-			} while (bytesRead < 0 && system::SyscallWasInterrupted());
-
-			if ( bytesRead < 0 ) {
-				String msg("Socket Error: <");
-				msg << static_cast<long>(errno) << ">=" << SystemLog::SysErrorMsg(errno);
-				SystemLog::Error(msg);
-				Ios->clear(std::ios::badbit);
-			} else if ( bytesRead == 0 ) {
-#if defined(STREAM_TRACE)
-				String msg("Socket:    end of data (read)              on file descriptor: ");
-				msg << fSocket->GetFd();
-				SystemLog::Info(msg);
-#endif
-				// socket is closed, stream recognizes this via
-				// streambuf::underflow() returning eof, if no more bytes are available
+				bytesRead = recv(fSocket->GetFd(), buf, len, cTransferFlags);
+			} while (bytesRead < 0 && Interrupted());
+			if ( bytesRead >= 0 || !WouldBlock() ) {
+				break;
 			}
-		} else {
+			// nothing pending, wait for data guarded by the timeout
+			++fWaitCount;
+			bReady = fSocket->IsReadyForReading();
+		}
+		if ( !bReady ) {
+			bytesRead = EOF;
 			Ios->clear(fSocket->HadTimeout() ? std::ios::failbit : std::ios::badbit);
+		} else if ( bytesRead < 0 ) {
+			String msg("Socket Error: <");
+			msg << static_cast<long>(errno) << ">=" << SystemLog::SysErrorMsg(errno);
+			SystemLog::Error(msg);
+			Ios->clear(std::ios::badbit);
+		} else if ( bytesRead == 0 ) {
+#if defined(STREAM_TRACE)
+			String msg("Socket:    end of data (read)              on file descriptor: ");
+			msg << fSocket->GetFd();
+			SystemLog::Info(msg);
+#endif
+			// socket is closed, stream recognizes this via
+			// streambuf::underflow() returning eof, if no more bytes are available
 		}
 #ifdef STREAM_TRACE
 		if ( bytesRead > 0 ) {
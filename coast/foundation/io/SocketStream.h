@@ -15,8 +15,14 @@
 #include <iomanip>
 
 const int cSocketStreamBufferSize = 8024;
+//! default limit the read buffer of a SocketStreamBuf grows to while reads keep filling it
+const int cSocketStreamMaxBufferSize = 65536;
 
 //! streambuf implementation for sockets
+/*! Where the platform supports MSG_DONTWAIT, reads and writes are tried first and the socket is only polled, guarded by
+	the timeout, if the transfer would block. While data keeps flowing a buffer fill or flush costs one syscall instead of
+	a poll and a recv/send pair. Blocks written at once that are at least as large as the write buffer are sent together
+	with the pending bytes in one sendmsg instead of being copied through the buffer. */
 class SocketStreamBuf : public std::streambuf
 {
 public:
@@ -45,6 +51,19 @@ public:
 	virtual long GetWriteCount() const {
 		return fWriteCount;
 	}
+	//!returns how many times a read or write had to wait for the socket
+	long GetWaitCount() const {
+		return fWaitCount;
+	}
+
+	//! let the read buffer grow up to lMaxBufSize bytes while reads keep filling it completely
+	/*! \param lMaxBufSize values below the initial buffer size keep the buffer at its size */
+	void SetMaxBufferSize(long lMaxBufSize) {
+		fMaxBufSize = lMaxBufSize;
+	}
+	long GetMaxBufferSize() const {
+		return fMaxBufSize;
+	}
 
 	//! canonical output operator for SocketStreamBufs
 	friend std::ostream &operator<<(std::ostream &os, SocketStreamBuf *ssbuf);
@@ -68,6 +87,9 @@ protected: // seekxxx are protected in the std..
 	//! consumes chars of the put area
 	virtual int overflow(int c = EOF);
 
+	//! large blocks are sent directly together with the pending bytes of the put area
+	virtual std::streamsize xsputn(const char *s, std::streamsize n);
+
 	//! produces characters for the get area
 	virtual int underflow();
 
@@ -76,6 +98,15 @@ protected: // seekxxx are protected in the std..
 	//! \param len the maximum length of the buffer
 	virtual long DoWrite(const char *buf, long len);
 
+	//! writes pending bytes followed by a second buffer to the socket guarded by fTimeout
+	//! subclasses changing the bytes in DoWrite, e.g. encrypting them, must override this too
+	//! \param pending the bytes to write first
+	//! \param lPending number of pending bytes
+	//! \param buf the bytes to write after the pending ones
+	//! \param len the length of buf
+	//! \return number of bytes written or EOF
+	virtual long DoWriteVector(const char *pending, long lPending, const char *buf, long len);
+
 	//! reads pending bytes from the socket guarded by fTimeout
 	//! \param buf the buffer to read bytes in
 	//! \param len the maximum length of the buffer
@@ -122,6 +153,16 @@ protected: // seekxxx are protected in the std..
 	//! statistic variable
 	long fReadCount;
 	long fWriteCount;
+	mutable long fWaitCount;
+
+	//! limit of read buffer growth
+	long fMaxBufSize;
+	//! the last read filled the whole read buffer, more data is likely pending
+	bool fReadBufFilled;
+
+private:
+	//! sends both buffers, the common part of DoWrite and DoWriteVector
+	long SendBuffers(const char *first, long lFirst, const char *second, long lSecond);
 };
 
 //! adapts ios to a Socket Stream buffer
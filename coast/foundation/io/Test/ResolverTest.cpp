@@ -10,6 +10,21 @@
 #include "TestSuite.h"
 #include "ResolverTest.h"
 
+namespace {
+	//! cache with adjustable clock to test expiration without sleeping
+	class TestResolverCache: public ResolverCache {
+	public:
+		TestResolverCache(long lTtl, long lNegativeTtl, long lShards, long lMaxEntries) :
+			ResolverCache(lTtl, lNegativeTtl, lShards, lMaxEntries), fNow(1000) {
+		}
+		time_t fNow;
+	protected:
+		virtual time_t Now() const {
+			return fNow;
+		}
+	};
+}
+
 ResolverTest::ResolverTest(TString tname) :
 	TestCaseType(tname)
 {
@@ -59,10 +74,126 @@ void ResolverTest::simpleIP2DNSTest()
 	}
 }
 
+void ResolverTest::cacheExpirationTest()
+{
+	StartTrace(ResolverTest.cacheExpirationTest);
+	TestResolverCache aCache(10L, 2L, 4L, 16L);
+	String strValue;
+	t_assert(!aCache.Lookup("nsomehost", strValue));
+	aCache.Store("nsomehost", "10.0.0.1", 100L);
+	t_assert(aCache.Lookup("nsomehost", strValue));
+	assertEqual("10.0.0.1", strValue);
+	aCache.Store("nfaultyhost", "", 50L);
+	strValue = "dummy";
+	t_assert(aCache.Lookup("nfaultyhost", strValue));
+	assertEqual("", strValue);
+	aCache.fNow += 3;
+	t_assertm(!aCache.Lookup("nfaultyhost", strValue), "negative entry should have expired");
+	t_assert(aCache.Lookup("nsomehost", strValue));
+	aCache.fNow += 10;
+	t_assertm(!aCache.Lookup("nsomehost", strValue), "entry should have expired");
+
+	Anything anyStatistic;
+	aCache.Statistic(anyStatistic);
+	assertEqual(2L, anyStatistic["Hits"].AsLong(-1L));
+	assertEqual(1L, anyStatistic["NegativeHits"].AsLong(-1L));
+	assertEqual(3L, anyStatistic["Misses"].AsLong(-1L));
+	assertEqual(2L, anyStatistic["Expired"].AsLong(-1L));
+	assertEqual(2L, anyStatistic["Resolved"].AsLong(-1L));
+	assertEqual(100L, anyStatistic["ResolveTimeMax"].AsLong(-1L));
+	assertEqual(75L, anyStatistic["ResolveTimeAvg"].AsLong(-1L));
+	assertEqual(0L, anyStatistic["Entries"].AsLong(-1L));
+}
+
+void ResolverTest::cacheEvictionTest()
+{
+	StartTrace(ResolverTest.cacheEvictionTest);
+	TestResolverCache aCache(10L, 0L, 1L, 2L);
+	String strValue;
+	aCache.Store("nfirst", "10.0.0.1");
+	aCache.Store("nsecond", "10.0.0.2");
+	aCache.Store("nthird", "10.0.0.3");
+	t_assertm(!aCache.Lookup("nfirst", strValue), "oldest entry should have been evicted");
+	t_assert(aCache.Lookup("nsecond", strValue));
+	t_assert(aCache.Lookup("nthird", strValue));
+	aCache.Store("nsecond", "10.0.0.2");
+	aCache.Store("nfourth", "10.0.0.4");
+	t_assertm(aCache.Lookup("nsecond", strValue), "stored again, so it is newer than third");
+	t_assertm(!aCache.Lookup("nthird", strValue), "oldest entry should have been evicted");
+	t_assert(aCache.Lookup("nfourth", strValue));
+	aCache.Store("nfaulty", "");
+	t_assertm(!aCache.Lookup("nfaulty", strValue), "failures must not be cached with negative ttl 0");
+	Anything anyKeys;
+	aCache.fNow += 5;
+	aCache.CollectExpiring(anyKeys, 5L);
+	assertEqual(0L, anyKeys.GetSize());
+	aCache.CollectExpiring(anyKeys, 6L);
+	assertEqual(2L, anyKeys.GetSize());
+	aCache.Clear();
+	t_assert(!aCache.Lookup("nsecond", strValue));
+}
+
+void ResolverTest::cacheRefreshTest()
+{
+	StartTrace(ResolverTest.cacheRefreshTest);
+	TestResolverCache aCache(10L, 10L, 1L, 16L);
+	String strValue;
+	aCache.Store("nused", "10.0.0.1");
+	aCache.Store("nunused", "10.0.0.2");
+	aCache.Store("nfaulty", "");
+	t_assert(aCache.Lookup("nused", strValue));
+	t_assert(aCache.Lookup("nfaulty", strValue));
+	Anything anyKeys;
+	aCache.fNow += 5;
+	aCache.CollectExpiring(anyKeys, 6L);
+	assertEqualm(1L, anyKeys.GetSize(), "neither unused nor negative entries should be refreshed");
+	assertEqual("nused", anyKeys[0L].AsString());
+	anyKeys = Anything();
+	aCache.CollectExpiring(anyKeys, 6L);
+	assertEqualm(0L, anyKeys.GetSize(), "not used since the last refresh");
+	t_assert(aCache.Lookup("nused", strValue));
+	aCache.CollectExpiring(anyKeys, 6L);
+	assertEqual(1L, anyKeys.GetSize());
+	aCache.fNow += 5;
+	aCache.CollectExpiring(anyKeys, 6L);
+	Anything anyStatistic;
+	aCache.Statistic(anyStatistic);
+	assertEqualm(0L, anyStatistic["Entries"].AsLong(-1L), "expired entries should have been removed");
+	assertEqual(3L, anyStatistic["Expired"].AsLong(-1L));
+}
+
+void ResolverTest::cachedDNS2IPTest()
+{
+	StartTrace(ResolverTest.cachedDNS2IPTest);
+	TestResolverCache aCache(10L, 2L, 4L, 16L);
+	ResolverCache *pOld = Resolver::SetCache(&aCache);
+	ROAnything roaConfig;
+	AnyExtensions::Iterator<ROAnything, ROAnything, TString> aEntryIterator(
+		GetTestCaseConfig());
+	while (aEntryIterator.Next(roaConfig)) {
+		TString strCase;
+		if (!aEntryIterator.SlotName(strCase)) {
+			strCase << "idx:" << aEntryIterator.Index();
+		}
+		String expIP = roaConfig["ip"].AsString();
+		assertEqualm(expIP, Resolver::DNS2IPAddress(roaConfig["name"].AsString()), TString("Failed at: ") << strCase);
+		assertEqualm(expIP, Resolver::DNS2IPAddress(roaConfig["name"].AsString()), TString("Failed cached at: ") << strCase);
+	}
+	Anything anyStatistic;
+	aCache.Statistic(anyStatistic);
+	assertEqual(aEntryIterator.Index() + 1L, anyStatistic["Misses"].AsLong(-1L));
+	assertEqual(aEntryIterator.Index() + 1L, anyStatistic["Hits"].AsLong(0L) + anyStatistic["NegativeHits"].AsLong(0L));
+	Resolver::SetCache(pOld);
+}
+
 Test *ResolverTest::suite()
 {
 	TestSuite *testSuite = new TestSuite;
 	ADD_CASE(testSuite, ResolverTest, simpleDNS2IPTest);
 	ADD_CASE(testSuite, ResolverTest, simpleIP2DNSTest);
+	ADD_CASE(testSuite, ResolverTest, cacheExpirationTest);
+	ADD_CASE(testSuite, ResolverTest, cacheEvictionTest);
+	ADD_CASE(testSuite, ResolverTest, cacheRefreshTest);
+	ADD_CASE(testSuite, ResolverTest, cachedDNS2IPTest);
 	return testSuite;
 }
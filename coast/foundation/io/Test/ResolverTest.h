@@ -29,6 +29,18 @@ public:
 
 	//!tests the Socket class with a invalid fd
 	void simpleIP2DNSTest();
+
+	//!tests expiration of positive and negative ResolverCache entries
+	void cacheExpirationTest();
+
+	//!tests eviction of ResolverCache entries when a shard is full
+	void cacheEvictionTest();
+
+	//!tests that only used and successfully resolved ResolverCache entries get refreshed
+	void cacheRefreshTest();
+
+	//!tests Resolver::DNS2IPAddress using an installed cache
+	void cachedDNS2IPTest();
 };
 
 #endif
@@ -9,6 +9,10 @@
 #include "SocketStreamTest.h"
 #include "SocketStream.h"
 #include "TestSuite.h"
+#include "DiffTimer.h"
+#if !defined(WIN32)
+#include <sys/socket.h>
+#endif
 
 SocketStreamTest::SocketStreamTest(TString tname)
 	: TestCaseType(tname),
@@ -136,6 +140,81 @@ void SocketStreamTest::opLeftShiftTest()
 	delete socket;
 }
 
+void SocketStreamTest::optimisticTransferTest()
+{
+#if !defined(WIN32)
+	int fds[2];
+	if ( !t_assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) ) {
+		return;
+	}
+	Socket writer(fds[0], Anything(), true, 1000L), reader(fds[1], Anything(), true, 100L);
+	std::iostream *pOut = writer.GetStream(), *pIn = reader.GetStream();
+	SocketStreamBuf *pOutBuf = dynamic_cast<SocketStreamBuf *>(pOut->rdbuf()), *pInBuf = dynamic_cast<SocketStreamBuf *>(pIn->rdbuf());
+	if ( !t_assert(pOutBuf != NULL) || !t_assert(pInBuf != NULL) ) {
+		return;
+	}
+	// the large block is sent together with the pending header instead of being copied through the buffer
+	String strHeader("header:"), strBlock(3L * cSocketStreamBufferSize);
+	for (long i = 0; i < 3L * cSocketStreamBufferSize; ++i) {
+		strBlock.Append((char)('a' + i % 26));
+	}
+	(*pOut) << strHeader;
+	pOut->write(strBlock, strBlock.Length());
+	pOut->flush();
+	t_assert(!!(*pOut));
+	assertEqual(strHeader.Length() + strBlock.Length(), pOutBuf->GetWriteCount());
+
+	String strRead(strHeader.Length() + strBlock.Length());
+	char c;
+	while ( strRead.Length() < strHeader.Length() + strBlock.Length() && pIn->get(c) ) {
+		strRead.Append(c);
+	}
+	assertCharPtrEqual(String(strHeader).Append(strBlock), strRead);
+	assertEqual(strRead.Length(), pInBuf->GetReadCount());
+#if defined(MSG_DONTWAIT)
+	// data was pending on every read and the peer accepted every write
+	assertEqual(0L, pInBuf->GetWaitCount());
+	assertEqual(0L, pOutBuf->GetWaitCount());
+#endif
+	// nothing pending, the read waits for the timeout
+	t_assert(!pIn->get(c));
+	t_assert(reader.HadTimeout());
+	t_assert(pInBuf->GetWaitCount() > 0L);
+#endif
+}
+
+void SocketStreamTest::transferBenchmark()
+{
+#if !defined(WIN32)
+	int fds[2];
+	if ( !t_assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) ) {
+		return;
+	}
+	Socket writer(fds[0], Anything(), true, 1000L), reader(fds[1], Anything(), true, 1000L);
+	std::iostream *pOut = writer.GetStream(), *pIn = reader.GetStream();
+	SocketStreamBuf *pOutBuf = dynamic_cast<SocketStreamBuf *>(pOut->rdbuf()), *pInBuf = dynamic_cast<SocketStreamBuf *>(pIn->rdbuf());
+	if ( !t_assert(pOutBuf != NULL) || !t_assert(pInBuf != NULL) ) {
+		return;
+	}
+	const long lChunk = 4096L, lRounds = 2000L;
+	char buf[lChunk];
+	memset(buf, 'x', lChunk);
+	DiffTimer dt(DiffTimer::eMicroseconds);
+	for (long i = 0; i < lRounds && !!(*pOut) && !!(*pIn); ++i) {
+		pOut->write(buf, lChunk - 1L);
+		pOut->flush();
+		pIn->read(buf, lChunk - 1L);
+	}
+	long lTime = (long) dt.Diff();
+	t_assert(!!(*pOut));
+	t_assert(!!(*pIn));
+	assertEqual(lRounds * (lChunk - 1L), pInBuf->GetReadCount());
+	std::cerr << "socket stream transfer of " << lRounds << " x " << (lChunk - 1L) << " bytes took " << lTime << " us ("
+			  << ( lTime > 0L ? ( lRounds * (lChunk - 1L) ) / lTime : 0L ) << " MB/s), "
+			  << pInBuf->GetWaitCount() << " polls for reading, " << pOutBuf->GetWaitCount() << " polls for writing\n";
+#endif
+}
+
 void SocketStreamTest::parseHTTPReplyTest()
 {
 	Connector connector(GetConfig()["HTTPReplyHost"]["name"].AsString(), GetConfig()["HTTPReplyHost"]["port"].AsLong(), 2000L);
@@ -218,6 +297,8 @@ Test *SocketStreamTest::suite ()
 	ADD_CASE(testSuite, SocketStreamTest, parseHTTPReplyTest);
 	ADD_CASE(testSuite, SocketStreamTest, opLeftShiftTest);
 	ADD_CASE(testSuite, SocketStreamTest, timeoutTest);
+	ADD_CASE(testSuite, SocketStreamTest, optimisticTransferTest);
+	ADD_CASE(testSuite, SocketStreamTest, transferBenchmark);
 
 	return testSuite;
 
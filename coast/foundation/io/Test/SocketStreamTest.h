@@ -28,6 +28,8 @@ public:
 	void timeoutTest();
 	void parseHTTPReplyTest();
 	void opLeftShiftTest();
+	void optimisticTransferTest();
+	void transferBenchmark();
 
 protected:
 	void parseParams(String &line, Anything &request);
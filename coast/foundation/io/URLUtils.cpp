@@ -11,17 +11,57 @@
 #include "Resolver.h"
 #include "Tracer.h"
 #include <cstring>
+#include <cstdio>
+#include <algorithm>
 
 namespace coast {
 	namespace urlutils {
-		// replace '+' characters in-place into ' '
-		void Convert(String &str) {
-			if (str.Length() > 0) {
-				for (long l = 0; l < str.Length(); ++l) {
-					if (str[l] == '+') {
-						str.PutAt(l, ' ');
+		namespace {
+			//! byte classification tables used by the scanning loops below, indexed by unsigned char
+			class CharClassTables {
+			public:
+				//! true for bytes DoUrlEncode has to escape unless they are part of the exclusion set
+				bool fUrlUnsafe[256];
+				//! true for bytes HTMLEscape copies unchanged
+				bool fHtmlSafe[256];
+				//! precomputed "&#ddd;" entities and their lengths used by HTMLEscape
+				char fHtmlEntity[256][7];
+				long fHtmlEntityLen[256];
+				CharClassTables() {
+					const char *pUnsafe = "\"#%;<>?[\\]^`{/}~";
+					for (int i = 0; i < 256; ++i) {
+						fUrlUnsafe[i] = ( i <= 0x20 || i >= 0x7F || strchr(pUnsafe, i) != 0 );
+						fHtmlSafe[i] = ( isalnum(i) != 0 );
+						fHtmlEntityLen[i] = sprintf(fHtmlEntity[i], "&#%d;", i);
 					}
 				}
+			};
+			const CharClassTables &Tables() {
+				static CharClassTables fgTables;
+				return fgTables;
+			}
+
+			//! length of the run starting at pBegin which contains no byte of pTable marked with bMarker
+			inline long CleanRunLength(const char *pBegin, const char *pEnd, const bool *pTable, bool bMarker) {
+				const char *p = pBegin;
+				while ( p < pEnd && pTable[static_cast<unsigned char>(*p)] != bMarker ) {
+					++p;
+				}
+				return p - pBegin;
+			}
+
+			//! position of next c in [pBegin, pEnd) or pEnd; memchr is vectorized in all libc's we care about
+			inline const char *FindNext(const char *pBegin, const char *pEnd, char c) {
+				const char *p = ( pBegin < pEnd ) ? static_cast<const char *>(memchr(pBegin, c, pEnd - pBegin)) : 0;
+				return p ? p : pEnd;
+			}
+		}
+
+		// replace '+' characters in-place into ' '
+		void Convert(String &str) {
+			const char *pBegin = str, *pEnd = pBegin + str.Length();
+			for (const char *p = FindNext(pBegin, pEnd, '+'); p < pEnd; p = FindNext(p + 1, pEnd, '+')) {
+				str.PutAt(p - pBegin, ' ');
 			}
 		}
 		String& TrimChars(String &str, bool front, char c) {
@@ -102,19 +142,17 @@ namespace coast {
 			}
 		}
 
-		void DecodeSpecialHTMLChars(const String &str, String &res, long &lPos)
+		// decodes the character reference starting at lPos, the terminating ';' is only searched within the maximal entity length
+		void DoDecodeSpecialHTMLChar(const String &str, String &res, long &lPos)
 		{
-			StartTrace(URLUtils.DecodeSpecialHTMLChars);
+			StartTrace(URLUtils.DoDecodeSpecialHTMLChar);
 			// character encodings accocrding to HTML4 W3C recommendation
-			// Shortcut
-			if ( str.StrChr('&') == -1L ) {
-				res = str;
-				return;
-			}
-
-			long endPos(str.StrChr(';', lPos));
+			const long lMaxDelta = 7L;
+			const char *pBegin = (const char *)str + lPos;
+			const char *pSemicolon = FindNext(pBegin, pBegin + std::min(lMaxDelta + 1L, str.Length() - lPos), ';');
+			long endPos( ( pSemicolon - pBegin <= lMaxDelta && *pSemicolon == ';' ) ? lPos + ( pSemicolon - pBegin ) : -1L );
 			Trace("endPos: " << endPos << " lPos: " << lPos);
-			if ( ( str[lPos] != '&' || str[lPos+1] != '#' ) || (endPos == -1L) ||  (endPos - lPos > 7L) ) {
+			if ( ( str[lPos] != '&' || str[lPos+1] != '#' ) || (endPos == -1L) ||  (endPos - lPos > lMaxDelta) ) {
 				Trace("Appending: " << str[lPos] << " lPos: " << lPos);
 				res.Append(str[lPos]);
 				return;
@@ -176,6 +214,17 @@ namespace coast {
 			Trace("Result string is: [" << res << "]");
 		}
 
+		void DecodeSpecialHTMLChars(const String &str, String &res, long &lPos)
+		{
+			StartTrace(URLUtils.DecodeSpecialHTMLChars);
+			// Shortcut
+			if ( str.StrChr('&') == -1L ) {
+				res = str;
+				return;
+			}
+			DoDecodeSpecialHTMLChar(str, res, lPos);
+		}
+
 		// encode the given char *p into res by expanding problematic characters into %XX escapes
 		bool DoUrlEncode(const String &str, const String &exclusionSet, String &encoded, bool doCheck)
 		{
@@ -245,39 +294,34 @@ namespace coast {
 			// characters which always need escaping: 0x00-0x1F, 0x7F-0xFF
 			// to be escaped too: "<>\"#%{}|\\^~[]`"
 			// for path encoding we need to escape "?;" too
-			if (str.Length() > 0) {
-				for (long l = 0, sz = str.Length(); l < sz; ++l) {
-					c = str[l];
-					unsigned int ui = c;
-					if ( ui <= 0x20 ||
-						 ui >= 0x7F ||
-						 ui == '"'  ||
-						 ui == '#'  ||
-						 ui == '%'  ||
-						 ui == ';'  ||
-						 ui == '<'  ||
-						 ui == '>'  ||
-						 ui == '?'  ||
-						 ui == '['  ||
-						 ui == '\\' ||
-						 ui == ']'  ||
-						 ui == '^'  ||
-						 ui == '`'  ||
-						 ui == '{'  ||
-						 ui == '/'  ||
-						 ui == '}'  ||
-						 ui == '~'
-					   ) {
-						if ( (exclusionSet.StrChr(c) == -1L) ) {
-							if ( doCheck ) {
-								Trace("failed at character [" << c << "]");
-								return false;
-							}
-							encoded.Append('%');
-							encoded.AppendAsHex(c);
-							continue;
-						}
+			const bool *pUnsafe = Tables().fUrlUnsafe;
+			const char *pBegin = str, *pEnd = pBegin + str.Length();
+			if ( !doCheck ) {
+				// every escaped char needs two more bytes, reserve upfront to avoid repeated reallocations
+				long lEscapes = 0L;
+				for (const char *p = pBegin; p < pEnd; ++p) {
+					lEscapes += pUnsafe[static_cast<unsigned char>(*p)] ? 1L : 0L;
+				}
+				encoded.Reserve(encoded.Length() + ( pEnd - pBegin ) + 2L * lEscapes + 1L);
+			}
+			for (const char *p = pBegin; p < pEnd; ) {
+				long lRun = CleanRunLength(p, pEnd, pUnsafe, true);
+				if ( lRun > 0L ) {
+					if ( !doCheck ) {
+						encoded.Append(static_cast<const void *>(p), lRun);
 					}
+					p += lRun;
+					continue;
+				}
+				c = *p++;
+				if ( (exclusionSet.StrChr(c) == -1L) ) {
+					if ( doCheck ) {
+						Trace("failed at character [" << c << "]");
+						return false;
+					}
+					encoded.Append('%');
+					encoded.AppendAsHex(c);
+				} else if ( !doCheck ) {
 					encoded.Append(c);
 				}
 			}
@@ -375,6 +419,14 @@ namespace coast {
 			}
 		}
 
+		namespace {
+			//! another urlDecode pass would not change str, saves the last decode and compare round of ExhaustiveUrlDecode
+			inline bool IsFullyUrlDecoded(const String &str, bool replacePlusByBlank) {
+				const char *pBegin = str, *pEnd = pBegin + str.Length();
+				return FindNext(pBegin, pEnd, '%') == pEnd && ( !replacePlusByBlank || FindNext(pBegin, pEnd, '+') == pEnd );
+			}
+		}
+
 		String ExhaustiveUrlDecode(const String &instr, URLCheckStatus &eUrlCheckStatus, bool replacePlusByBlank)
 		{
 			StartTrace1(URLUtils.ExhaustiveUrlDecode, "Url [" << instr << "]");
@@ -389,6 +441,9 @@ namespace coast {
 					eUrlCheckStatus = eSuspiciousChar;
 				}
 				Trace("Intermediate: " << current);
+				if ( IsFullyUrlDecoded(current, replacePlusByBlank) ) {
+					break;
+				}
 			}
 			return current;
 		}
@@ -402,6 +457,9 @@ namespace coast {
 				previous = current;
 				current = urlDecode(previous, replacePlusByBlank);
 				Trace("Intermediate: " << current);
+				if ( IsFullyUrlDecoded(current, replacePlusByBlank) ) {
+					break;
+				}
 			}
 			return current;
 		}
@@ -422,12 +480,23 @@ namespace coast {
 		String HTMLDecode(const String &instr)
 		{
 			StartTrace(URLUtils.HTMLDecode);
-			String res, str(instr);
-			long length(str.Length());
-			if (length > 0) {
-				for (long lPos = 0; lPos < length; ++lPos) {
-					DecodeSpecialHTMLChars(str, res, lPos);
+			long length(instr.Length());
+			const char *pBegin = instr, *pEnd = pBegin + length;
+			const char *pAmp = FindNext(pBegin, pEnd, '&');
+			// Shortcut
+			if ( pAmp == pEnd ) {
+				return instr;
+			}
+			// decoding never enlarges the string
+			String res(length + 1L);
+			for (long lPos = 0; lPos < length; ++lPos) {
+				if ( pBegin[lPos] != '&' ) {
+					long lRun = FindNext(pBegin + lPos, pEnd, '&') - ( pBegin + lPos );
+					res.Append(static_cast<const void *>(pBegin + lPos), lRun);
+					lPos += lRun - 1L;
+					continue;
 				}
+				DoDecodeSpecialHTMLChar(instr, res, lPos);
 			}
 			return res;
 		}
@@ -457,46 +526,58 @@ namespace coast {
 		String urlDecode(const String &instr, URLCheckStatus &eUrlCheckStatus, bool replacePlusByBlank)
 		{
 			StartTrace1(URLUtils.urlDecode, "[" << instr.SubString(0,100L).Append(instr.Length()>100?"...":"") << "]");
-			String res, str(instr);
 			eUrlCheckStatus = eOk;
+			long length(instr.Length());
+			const char *pInBegin = instr;
+			// Shortcut
+			if ( FindNext(pInBegin, pInBegin + length, '%') == pInBegin + length ) {
+				if ( replacePlusByBlank && FindNext(pInBegin, pInBegin + length, '+') != pInBegin + length ) {
+					String str(instr);
+					Convert(str);	// converts browser inserted '+' to ' '
+					return str;
+				}
+				return instr;
+			}
+			String str(instr);
 			if ( replacePlusByBlank ) {
 				Convert(str);	// converts browser inserted '+' to ' '
 			}
-			// Shortcut
-			if ( instr.StrChr('%') == -1L ) {
-				return replacePlusByBlank ? str : instr;
-			}
+			const char *pBegin = str, *pEnd = pBegin + length;
+			// decoding never enlarges the string
+			String res(length + 1L);
 			char c ;		// current character
-			long length(str.Length());
-			if (length > 0) {
-				for (long lPos = 0; lPos < length; ++lPos) {
-					if ((c = str[lPos]) == '%') {
-						// Escape: next 5 chars are %uxxxx representation of the actual character
-						if ( (c = str[lPos]) == '%' && ((lPos + 1L < length) && (str[lPos+1L] == 'u' ||  str[lPos+1L] == 'U')) ) {
-							if (((lPos + 5L < length) &&
-								 isxdigit(str[lPos+2L]) && isxdigit(str[lPos+3L]) && isxdigit(str[lPos+4L]) && isxdigit(str[lPos+5L]))) {
-								if (str[lPos+2L] == '0' && (str[lPos+3L]) == '0') {
-									res.AppendTwoHexAsChar(&((const char *)str)[lPos+4L]);
-								} else {
-									// char above FF
-									eUrlCheckStatus = eSuspiciousChar;
-								}
-								lPos += 5L;
-								continue;
-							}
-							c = DecodeSpecialChars(str, c, lPos, 2);
-						} else {
-							// Escape: next 2 chars are hex representation of the actual character
-							if ((lPos + 1L < length) && isxdigit(str[lPos+1L]) && (lPos + 2L < length) && isxdigit( str[lPos+2L])) {
-								res.AppendTwoHexAsChar(&((const char *)str)[lPos+1L]);
-								lPos += 2L;
-								continue;
+			for (long lPos = 0; lPos < length; ++lPos) {
+				if ((c = str[lPos]) == '%') {
+					// Escape: next 5 chars are %uxxxx representation of the actual character
+					if ( (c = str[lPos]) == '%' && ((lPos + 1L < length) && (str[lPos+1L] == 'u' ||  str[lPos+1L] == 'U')) ) {
+						if (((lPos + 5L < length) &&
+							 isxdigit(str[lPos+2L]) && isxdigit(str[lPos+3L]) && isxdigit(str[lPos+4L]) && isxdigit(str[lPos+5L]))) {
+							if (str[lPos+2L] == '0' && (str[lPos+3L]) == '0') {
+								res.AppendTwoHexAsChar(&((const char *)str)[lPos+4L]);
+							} else {
+								// char above FF
+								eUrlCheckStatus = eSuspiciousChar;
 							}
-							c = DecodeSpecialChars(str, c, lPos, 1);
+							lPos += 5L;
+							continue;
 						}
+						c = DecodeSpecialChars(str, c, lPos, 2);
+					} else {
+						// Escape: next 2 chars are hex representation of the actual character
+						if ((lPos + 1L < length) && isxdigit(str[lPos+1L]) && (lPos + 2L < length) && isxdigit( str[lPos+2L])) {
+							res.AppendTwoHexAsChar(&((const char *)str)[lPos+1L]);
+							lPos += 2L;
+							continue;
+						}
+						c = DecodeSpecialChars(str, c, lPos, 1);
 					}
 					res.Append(c);
+					continue;
 				}
+				// copy everything up to the next escape in one go
+				long lRun = FindNext(pBegin + lPos, pEnd, '%') - ( pBegin + lPos );
+				res.Append(static_cast<const void *>(pBegin + lPos), lRun);
+				lPos += lRun - 1L;
 			}
 			return res;
 		}
@@ -797,19 +878,22 @@ namespace coast {
 		String HTMLEscape(const String &toEscape)
 		{
 			StartTrace(URLUtils.HTMLEscape);
-			String escPrefix("&#");
-			String escPostfix(";");
-			String escapedString;
-			long length(toEscape.Length());
-			for (long i = 0; i < length; ++i ) {
-				unsigned int work = (unsigned char) toEscape[i];
-				if ( isalnum(work) ) {
-					escapedString.Append((char) work);
-				} else {
-					escapedString.Append(escPrefix);
-					escapedString.Append(static_cast<long>(work));
-					escapedString.Append(escPostfix);
+			const CharClassTables &aTables = Tables();
+			const char *pBegin = toEscape, *pEnd = pBegin + toEscape.Length();
+			long lSize = 0L;
+			for (const char *p = pBegin; p < pEnd; ++p) {
+				lSize += aTables.fHtmlSafe[static_cast<unsigned char>(*p)] ? 1L : aTables.fHtmlEntityLen[static_cast<unsigned char>(*p)];
+			}
+			String escapedString(lSize + 1L);
+			for (const char *p = pBegin; p < pEnd; ) {
+				long lRun = CleanRunLength(p, pEnd, aTables.fHtmlSafe, false);
+				if ( lRun > 0L ) {
+					escapedString.Append(static_cast<const void *>(p), lRun);
+					p += lRun;
+					continue;
 				}
+				unsigned char work = static_cast<unsigned char>(*p++);
+				escapedString.Append(static_cast<const void *>(aTables.fHtmlEntity[work]), aTables.fHtmlEntityLen[work]);
 			}
 			return escapedString;
 		}
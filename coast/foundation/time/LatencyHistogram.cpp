@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "LatencyHistogram.h"
+#include "Tracer.h"
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram(long lSignificantBits)
+	: fSignificantBits(lSignificantBits < 2L ? 2L : ( lSignificantBits > 16L ? 16L : lSignificantBits ))
+	, fCount(0L)
+	, fSum(0L)
+	, fMin(0L)
+	, fMax(0L)
+{
+}
+
+long LatencyHistogram::BucketIndex(long lValue) const
+{
+	long lSubBuckets = 1L << fSignificantBits;
+	if ( lValue < lSubBuckets ) {
+		return lValue;
+	}
+	long lHighestBit = 0L;
+	for (unsigned long ulValue = (unsigned long)lValue; ulValue > 1UL; ulValue >>= 1) {
+		++lHighestBit;
+	}
+	long lShift = lHighestBit - fSignificantBits + 1L;
+	return lShift * (lSubBuckets >> 1) + (lValue >> lShift);
+}
+
+long LatencyHistogram::LowestEquivalentValue(long lIndex) const
+{
+	long lSubBuckets = 1L << fSignificantBits, lHalf = lSubBuckets >> 1;
+	if ( lIndex < lSubBuckets ) {
+		return lIndex;
+	}
+	long lShift = lIndex / lHalf - 1L;
+	return ( lIndex - lShift * lHalf ) << lShift;
+}
+
+long LatencyHistogram::HighestEquivalentValue(long lIndex) const
+{
+	return LowestEquivalentValue(lIndex + 1L) - 1L;
+}
+
+void LatencyHistogram::Record(long lValue, long lCount)
+{
+	if ( lCount <= 0L ) {
+		return;
+	}
+	if ( lValue < 0L ) {
+		lValue = 0L;
+	}
+	long lIndex = BucketIndex(lValue);
+	if ( lIndex >= (long)fCounts.size() ) {
+		fCounts.resize(lIndex + 1L, 0L);
+	}
+	fCounts[lIndex] += lCount;
+	if ( fCount == 0L || lValue < fMin ) {
+		fMin = lValue;
+	}
+	if ( lValue > fMax ) {
+		fMax = lValue;
+	}
+	fCount += lCount;
+	fSum += lValue * lCount;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+	if ( other.fCount == 0L ) {
+		return;
+	}
+	if ( other.fSignificantBits == fSignificantBits ) {
+		if ( other.fCounts.size() > fCounts.size() ) {
+			fCounts.resize(other.fCounts.size(), 0L);
+		}
+		for (size_t i = 0; i < other.fCounts.size(); ++i) {
+			fCounts[i] += other.fCounts[i];
+		}
+	} else {
+		for (size_t i = 0; i < other.fCounts.size(); ++i) {
+			long lValue = other.LowestEquivalentValue((long)i);
+			if ( other.fCounts[i] ) {
+				long lIndex = BucketIndex(lValue);
+				if ( lIndex >= (long)fCounts.size() ) {
+					fCounts.resize(lIndex + 1L, 0L);
+				}
+				fCounts[lIndex] += other.fCounts[i];
+			}
+		}
+	}
+	if ( fCount == 0L || other.fMin < fMin ) {
+		fMin = other.fMin;
+	}
+	if ( other.fMax > fMax ) {
+		fMax = other.fMax;
+	}
+	fCount += other.fCount;
+	fSum += other.fSum;
+}
+
+bool LatencyHistogram::Merge(ROAnything roaHistogram)
+{
+	StartTrace(LatencyHistogram.Merge);
+	if ( !roaHistogram.IsDefined("SignificantBits") || !roaHistogram.IsDefined("Counts") ) {
+		return false;
+	}
+	LatencyHistogram other(roaHistogram["SignificantBits"].AsLong(fSignificantBits));
+	ROAnything roaCounts = roaHistogram["Counts"];
+	for (long i = 0, sz = roaCounts.GetSize(); i < sz; ++i) {
+		long lIndex = String(roaCounts.SlotName(i)).AsLong(-1L);
+		long lCount = roaCounts[i].AsLong(0L);
+		if ( lIndex < 0L || lCount <= 0L ) {
+			continue;
+		}
+		if ( lIndex >= (long)other.fCounts.size() ) {
+			other.fCounts.resize(lIndex + 1L, 0L);
+		}
+		other.fCounts[lIndex] += lCount;
+	}
+	other.fCount = roaHistogram["Count"].AsLong(0L);
+	other.fSum = roaHistogram["Sum"].AsLong(0L);
+	other.fMin = roaHistogram["Min"].AsLong(0L);
+	other.fMax = roaHistogram["Max"].AsLong(0L);
+	Merge(other);
+	return true;
+}
+
+void LatencyHistogram::Reset()
+{
+	fCounts.clear();
+	fCount = fSum = fMin = fMax = 0L;
+}
+
+long LatencyHistogram::GetValueAtPercentile(double dPercentile) const
+{
+	if ( fCount == 0L ) {
+		return 0L;
+	}
+	if ( dPercentile <= 0.0 ) {
+		return fMin;
+	}
+	double dRank = std::ceil(dPercentile / 100.0 * double(fCount));
+	long lRank = ( dRank < 1.0 ) ? 1L : (long)dRank;
+	long lSeen = 0L;
+	for (size_t i = 0; i < fCounts.size(); ++i) {
+		lSeen += fCounts[i];
+		if ( lSeen >= lRank ) {
+			long lValue = HighestEquivalentValue((long)i);
+			return ( lValue > fMax ) ? fMax : ( lValue < fMin ? fMin : lValue );
+		}
+	}
+	return fMax;
+}
+
+void LatencyHistogram::Export(Anything &anyHistogram) const
+{
+	anyHistogram["SignificantBits"] = fSignificantBits;
+	anyHistogram["Count"] = fCount;
+	anyHistogram["Sum"] = fSum;
+	anyHistogram["Min"] = GetMin();
+	anyHistogram["Max"] = fMax;
+	Anything anyCounts(Anything::ArrayMarker(), anyHistogram.GetAllocator());
+	for (size_t i = 0; i < fCounts.size(); ++i) {
+		if ( fCounts[i] ) {
+			String strIndex;
+			strIndex << (long)i;
+			anyCounts[strIndex] = fCounts[i];
+		}
+	}
+	anyHistogram["Counts"] = anyCounts;
+}
+
+void LatencyHistogram::Summarize(Anything &anySummary) const
+{
+	anySummary["Count"] = fCount;
+	anySummary["Min"] = GetMin();
+	anySummary["Mean"] = GetMean();
+	anySummary["P50"] = GetValueAtPercentile(50.0);
+	anySummary["P90"] = GetValueAtPercentile(90.0);
+	anySummary["P99"] = GetValueAtPercentile(99.0);
+	anySummary["P999"] = GetValueAtPercentile(99.9);
+	anySummary["Max"] = fMax;
+}
+
+bool LatencyHistogram::MergeExported(Anything &anyTarget, ROAnything roaSource)
+{
+	StartTrace(LatencyHistogram.MergeExported);
+	LatencyHistogram merged(roaSource["SignificantBits"].AsLong(7L));
+	if ( !anyTarget.IsNull() ) {
+		merged = LatencyHistogram(anyTarget["SignificantBits"].AsLong(7L));
+		merged.Merge(ROAnything(anyTarget));
+	}
+	if ( !merged.Merge(roaSource) ) {
+		return false;
+	}
+	anyTarget = Anything(anyTarget.GetAllocator());
+	merged.Export(anyTarget);
+	return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _LatencyHistogram_H
+#define _LatencyHistogram_H
+
+#include "Anything.h"
+#include <vector>
+
+//! Mergeable log-linear histogram of latencies, modelled after HdrHistogram
+/*!
+Values are bucketed with a bounded relative error: every power of two range is split into 2^(SignificantBits-1)
+sub buckets, values below 2^SignificantBits are counted exactly. With the default of 7 bits the reported percentiles
+are at most 1/64 above the recorded values. The unit of the values is up to the user, latencies are usually
+recorded in microseconds.
+Recording is not synchronized, use one histogram per thread and merge them afterwards. Histograms are exported
+into an Anything to pass them along with other results; exported histograms can be merged without converting them back.
+\par Exported form
+\code
+{
+	/SignificantBits	long	precision used for bucketing
+	/Count				long	number of recorded values
+	/Sum				long	sum of recorded values, used for the mean
+	/Min				long	smallest recorded value
+	/Max				long	largest recorded value
+	/Counts {					only non empty buckets
+		/<bucket index>	long	number of values in bucket
+		...
+	}
+}
+\endcode
+*/
+class LatencyHistogram
+{
+public:
+	//! create an empty histogram
+	/*! \param lSignificantBits precision of bucketing, between 2 and 16 */
+	explicit LatencyHistogram(long lSignificantBits = 7L);
+
+	//! count lCount occurrences of lValue, negative values are counted as zero
+	void Record(long lValue, long lCount = 1L);
+
+	//! add all values of other
+	void Merge(const LatencyHistogram &other);
+
+	//! add all values of an exported histogram
+	/*! \return false if roaHistogram does not look like an exported histogram */
+	bool Merge(ROAnything roaHistogram);
+
+	//! remove all values
+	void Reset();
+
+	long GetCount() const {
+		return fCount;
+	}
+	long GetMin() const {
+		return fCount ? fMin : 0L;
+	}
+	long GetMax() const {
+		return fMax;
+	}
+	double GetMean() const {
+		return fCount ? double(fSum) / double(fCount) : 0.0;
+	}
+
+	//! value below or equal which dPercentile percent of the recorded values are
+	/*! The result is the upper bound of the bucket containing the value, limited by the largest recorded value
+		\param dPercentile between 0.0 and 100.0
+		\return 0 if nothing was recorded */
+	long GetValueAtPercentile(double dPercentile) const;
+
+	//! store histogram in anyHistogram, see class description
+	void Export(Anything &anyHistogram) const;
+
+	//! store the usual figures of the histogram
+	/*! \param anySummary gets /Count /Min /Mean /P50 /P90 /P99 /P999 /Max, P999 being the 99.9th percentile */
+	void Summarize(Anything &anySummary) const;
+
+	//! merge an exported histogram into another exported histogram
+	/*! anyTarget is initialized by the first merge, so an empty Anything can be used to start with
+		\return false if roaSource does not look like an exported histogram */
+	static bool MergeExported(Anything &anyTarget, ROAnything roaSource);
+
+private:
+	long BucketIndex(long lValue) const;
+	long LowestEquivalentValue(long lIndex) const;
+	long HighestEquivalentValue(long lIndex) const;
+
+	long fSignificantBits;
+	long fCount, fSum, fMin, fMax;
+	std::vector<long> fCounts;
+};
+
+#endif
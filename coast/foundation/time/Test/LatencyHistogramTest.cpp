@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "LatencyHistogramTest.h"
+#include "TestSuite.h"
+#include "FoundationTestTypes.h"
+#include "LatencyHistogram.h"
+#include "Tracer.h"
+
+Test *LatencyHistogramTest::suite ()
+{
+	TestSuite *testSuite = new TestSuite;
+	ADD_CASE(testSuite, LatencyHistogramTest, ExactValuesTest);
+	ADD_CASE(testSuite, LatencyHistogramTest, PercentileTest);
+	ADD_CASE(testSuite, LatencyHistogramTest, MergeTest);
+	return testSuite;
+}
+
+void LatencyHistogramTest::ExactValuesTest()
+{
+	StartTrace(LatencyHistogramTest.ExactValuesTest);
+	LatencyHistogram histogram;
+	assertEqual(0L, histogram.GetCount());
+	assertEqual(0L, histogram.GetValueAtPercentile(50.0));
+	for (long l = 1L; l <= 100L; ++l) {
+		histogram.Record(l);
+	}
+	histogram.Record(-5L);
+	assertEqual(101L, histogram.GetCount());
+	assertEqual(0L, histogram.GetMin());
+	assertEqual(100L, histogram.GetMax());
+	assertEqual(50L, histogram.GetValueAtPercentile(50.0));
+	assertEqual(90L, histogram.GetValueAtPercentile(90.0));
+	assertEqual(100L, histogram.GetValueAtPercentile(100.0));
+	assertEqual(0L, histogram.GetValueAtPercentile(0.0));
+	assertDoublesEqual(5050.0 / 101.0, histogram.GetMean(), 0.0001);
+	histogram.Reset();
+	assertEqual(0L, histogram.GetCount());
+	assertEqual(0L, histogram.GetMax());
+}
+
+void LatencyHistogramTest::PercentileTest()
+{
+	StartTrace(LatencyHistogramTest.PercentileTest);
+	LatencyHistogram histogram;
+	for (long l = 1L; l <= 100000L; ++l) {
+		histogram.Record(l * 10L);
+	}
+	// a server stall, counted as if 200 requests were waiting for it
+	histogram.Record(5000000L, 200L);
+	assertEqual(100200L, histogram.GetCount());
+	double expected[] = { 50.0, 501000.0, 90.0, 901800.0, 99.0, 991980.0 };
+	for (long i = 0; i < 6; i += 2) {
+		double dValue = (double)histogram.GetValueAtPercentile(expected[i]);
+		t_assertm(dValue >= expected[i + 1], TString("percentile ") << (long)expected[i]);
+		t_assertm(dValue <= expected[i + 1] * (1.0 + 1.0 / 64.0), TString("percentile ") << (long)expected[i]);
+	}
+	assertEqual(5000000L, histogram.GetValueAtPercentile(99.9));
+	assertEqual(5000000L, histogram.GetMax());
+	assertEqual(10L, histogram.GetMin());
+
+	Anything anySummary;
+	histogram.Summarize(anySummary);
+	assertEqual(100200L, anySummary["Count"].AsLong(0L));
+	assertEqual(histogram.GetValueAtPercentile(99.0), anySummary["P99"].AsLong(0L));
+	assertEqual(5000000L, anySummary["P999"].AsLong(0L));
+}
+
+void LatencyHistogramTest::MergeTest()
+{
+	StartTrace(LatencyHistogramTest.MergeTest);
+	LatencyHistogram all, odd, even, coarse(4L);
+	for (long l = 0L; l < 20000L; l += 7L) {
+		all.Record(l);
+		( ( l & 1L ) ? odd : even ).Record(l);
+	}
+	coarse.Merge(odd);
+	coarse.Merge(even);
+	odd.Merge(even);
+	assertEqual(all.GetCount(), odd.GetCount());
+	assertEqual(all.GetMin(), odd.GetMin());
+	assertEqual(all.GetMax(), odd.GetMax());
+	assertEqual(all.GetValueAtPercentile(99.0), odd.GetValueAtPercentile(99.0));
+	assertEqual(all.GetCount(), coarse.GetCount());
+	assertEqual(all.GetMax(), coarse.GetMax());
+
+	Anything anyAll, anyOdd, anyEven, anyMerged;
+	all.Export(anyAll);
+	LatencyHistogram imported;
+	t_assert(imported.Merge(ROAnything(anyAll)));
+	assertEqual(all.GetCount(), imported.GetCount());
+	assertEqual(all.GetValueAtPercentile(90.0), imported.GetValueAtPercentile(90.0));
+	assertDoublesEqual(all.GetMean(), imported.GetMean(), 0.0001);
+	t_assert(!imported.Merge(ROAnything()));
+
+	LatencyHistogram odd2, even2;
+	for (long l = 0L; l < 20000L; l += 7L) {
+		( ( l & 1L ) ? odd2 : even2 ).Record(l);
+	}
+	odd2.Export(anyOdd);
+	even2.Export(anyEven);
+	t_assert(LatencyHistogram::MergeExported(anyMerged, anyOdd));
+	t_assert(LatencyHistogram::MergeExported(anyMerged, anyEven));
+	assertAnyEqual(anyAll, anyMerged);
+}
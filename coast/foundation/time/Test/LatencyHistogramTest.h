@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _LatencyHistogramTest_H
+#define _LatencyHistogramTest_H
+
+#include "TestCase.h"
+
+class LatencyHistogramTest : public testframework::TestCase
+{
+public:
+	LatencyHistogramTest(TString tstrName) : TestCaseType(tstrName) {}
+
+	//!builds up a suite of testcases for this test
+	static Test *suite ();
+
+	//!values below 2^SignificantBits are kept exactly
+	void ExactValuesTest();
+	//!percentiles stay within the relative error of the bucketing
+	void PercentileTest();
+	//!merging histograms and exported histograms gives the same result as recording all values into one
+	void MergeTest();
+};
+
+#endif
@@ -9,8 +9,10 @@
 #include "TestRunner.h"
 #include "DiffTimerTest.h"
 #include "TimeStampTest.h"
+#include "LatencyHistogramTest.h"
 
 void setupRunner(TestRunner &runner) {
 	ADD_SUITE(runner, DiffTimerTest);
 	ADD_SUITE(runner, TimeStampTest);
+	ADD_SUITE(runner, LatencyHistogramTest);
 } // setupRunner
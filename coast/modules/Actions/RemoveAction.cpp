@@ -26,7 +26,7 @@ bool RemoveAction::DoExecAction(String &transitionToken, Context &ctx, const ROA
 		char delim = config["Delim"].AsCharPtr(".")[0L];
 		char indexdelim = config["IndexDelim"].AsCharPtr(":")[0L];
 		// must use reference here to prevent copying the content due to different allocator locations
-		Anything &anyStore = StoreFinder::FindStore(ctx, store), anyParent(anyStore, anyStore.GetAllocator());
+		Anything &anyStore = StoreFinder::FindStore(ctx, store, slotName, delim, indexdelim), anyParent(anyStore, anyStore.GetAllocator());
 		SubTraceAny(TraceContent, anyParent, String("content in store [") << store << "], looking for slot [" << slotName << "]");
 
 		// test if the path to be deleted exists in the store, avoids creation of nonexisting slot
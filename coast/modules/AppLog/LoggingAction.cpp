@@ -71,3 +71,25 @@ bool TimeLoggingAction::GenLogEntries(const String &strSection, const ROAnything
 	}
 	return true;
 }
+
+RegisterAction(PhaseTimingLoggingAction);
+
+bool PhaseTimingLoggingAction::DoExecAction(String &transitionToken, Context &ctx, const ROAnything &config) {
+	StartTrace(PhaseTimingLoggingAction.DoExecAction);
+	String channel(config["Channel"].AsString(ctx.Lookup("Channel", "")));
+	if (!channel.Length()) {
+		return false;
+	}
+	AppLogModule::eLogLevel iLevel = (AppLogModule::eLogLevel) config["Severity"].AsLong(ctx.Lookup("Severity", (long) AppLogModule::eINFO));
+	Anything anySummary;
+	PhaseTiming::Summarize(anySummary);
+	AnyExtensions::Iterator<Anything> aTimerIter(anySummary);
+	Anything anyTimer;
+	while (aTimerIter.Next(anyTimer)) {
+		Context::PushPopEntry<Anything> aTimerEntry(ctx, "LoggingEntryKey", anyTimer, "PhaseTimeEntry");
+		if (!AppLogModule::Log(ctx, channel, iLevel)) {
+			return false;
+		}
+	}
+	return true;
+}
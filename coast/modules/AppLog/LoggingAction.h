@@ -71,4 +71,32 @@ protected:
 	virtual bool GenLogEntries(const String &strSection, const ROAnything &entry, Context &ctx, const String &channel, AppLogModule::eLogLevel iLevel);
 };
 
+//! Logs the PhaseTiming summary since its last execution, one entry per timer
+/*!
+Meant to be executed by the PeriodicAction of TimeLoggingModule, which makes the slots of its /Summary configuration available
+for lookup. Each timer is logged with <I>PhaseTimeEntry</I> pushed into the context:
+{ /Section /Key /Count /Total /Mean /Max }, times are in microseconds.
+\par Configuration
+\code
+{
+	/Channel		String		mandatory, channel name to log to, looked up in the context if not configured
+	/Severity		long		optional, default AppLogModule::eINFO, looked up in the context if not configured, Severity [CRITICAL=1, FATAL=2, ERROR=4, WARN=8, INFO=16, OK=32, MAINT=64, DEBUG=128], all levels lower_equal (<=) the specified value will get logged
+}
+\endcode
+*/
+class PhaseTimingLoggingAction: public Action {
+public:
+	PhaseTimingLoggingAction(const char *name) :
+		Action(name) {
+	}
+
+protected:
+	//! Logs the phase timing summary on the Channel defined by <I>config /Channel</I>
+	/*!	\param transitionToken (in/out) the event passed by the caller, can be modified.
+		\param ctx the context the action runs within.
+		\param config the configuration of the action.
+		\return true if the action run successfully, false if an error occurred. */
+	virtual bool DoExecAction(String &transitionToken, Context &ctx, const ROAnything &config);
+};
+
 #endif
@@ -44,22 +44,15 @@ bool DataAccess::StdExec(Context &trxContext)
 
 	if (trx) {
 		trxContext.Push("DataAccess", trx);
-		ParameterMapper *params = 0;
-		bool pIsTemp = GetMyParameterMapper(trxContext, params);
-		ResultMapper *results = 0;
-		bool rIsTemp = GetMyResultMapper(trxContext, results);
+		// mappers are resolved once per DataAccessImpl, inline scripts included
+		ParameterMapper *params = GetMyParameterMapper(trxContext, trx);
+		ResultMapper *results = GetMyResultMapper(trxContext, trx);
 
 		// execute data access
-		result = Exec(params, results, trxContext);
-
-		// cleanup mappers that were created on the fly
-		// as interpreters for scripting
-		if (pIsTemp) {
-			delete params;
-		}
-		if (rIsTemp) {
-			delete results;
-		}
+		result = DoExec(trx, params, results, trxContext);
+
+		// mappers created on the fly as interpreters for scripting
+		// belong to the DataAccessImpl, nothing to clean up here
 		trxContext.Remove("DataAccess");
 	}
 	return result;
@@ -69,9 +62,13 @@ bool DataAccess::Exec(ParameterMapper *params, ResultMapper *results, Context &t
 {
 	StartTrace(DataAccess.Exec);
 	DAAccessTimer(DataAccess.Exec, fName, trxContext);
+	return DoExec(GetImpl(fName, trxContext), params, results, trxContext);
+}
 
+bool DataAccess::DoExec(DataAccessImpl *trx, ParameterMapper *params, ResultMapper *results, Context &trxContext)
+{
+	StartTrace(DataAccess.DoExec);
 	// if we don't have a complete triple, return immediately
-	DataAccessImpl *trx = GetImpl(fName, trxContext);
 	Assert(trx && params && results);
 	if ( !(trx && params && results) ) {
 		return false;
@@ -88,76 +85,76 @@ bool DataAccess::Exec(ParameterMapper *params, ResultMapper *results, Context &t
 	return ret;
 }
 
-bool DataAccess::GetMyParameterMapper(Context &c, ParameterMapper *&pm)
+ParameterMapper *DataAccess::GetMyParameterMapper(Context &c, DataAccessImpl *trx)
 {
 	StartTrace(DataAccess.GetMyParameterMapper);
-	bool isScriptInterpreter;
+	ParameterMapper *pm = trx->GetCachedParameterMapper();
+	if (pm) {
+		return pm;
+	}
 
 	// look into own config
-	ROAnything script = c.Lookup("ParameterMapperScript");
+	ROAnything script = trx->Lookup("ParameterMapperScript");
 	if (script.GetType() == AnyArrayType) {
-		isScriptInterpreter = true;
-
 		Trace("Parameter script found. Using interpreter.");
-		pm = new (coast::storage::Current()) EagerParameterMapper(String("ParamScriptInterpreterFor") << fName, script);
-	} else {
-		// no script present, check if a named mapper can be found
-		isScriptInterpreter = false;
-
-		String name(script.AsString(fName));
-		pm = ParameterMapper::FindParameterMapper(name);
-		if (pm) {
-			Trace("Using specified ParameterMapper: " << name);
-		} else {
-			// is there a fallback mapper defined?
-			String fallback = c.Lookup("FallbackParameterMapper", "");
-
-			pm = ParameterMapper::FindParameterMapper(fallback);
-			if (pm) {
-				Trace("Using fallback ParameterMapper: " << fallback);
-			} else {
-				Trace("ERROR: No mapper with name [" << name << "] found.");
-				HandleError(c, name, __FILE__, __LINE__, "DataAccess::GetMyParameterMapper returned 0");
-			}
-		}
+		pm = new (coast::storage::Global()) EagerParameterMapper(String("ParamScriptInterpreterFor") << fName, script);
+		return trx->CacheParameterMapper(pm, true);
+	}
+
+	// no script present, check if a named mapper can be found
+	String name(script.AsString(fName));
+	pm = ParameterMapper::FindParameterMapper(name);
+	if (pm) {
+		Trace("Using specified ParameterMapper: " << name);
+		return trx->CacheParameterMapper(pm, false);
 	}
-	return isScriptInterpreter;
+	// is there a fallback mapper defined?
+	String fallback = trx->Lookup("FallbackParameterMapper", "");
+
+	pm = ParameterMapper::FindParameterMapper(fallback);
+	if (pm) {
+		Trace("Using fallback ParameterMapper: " << fallback);
+		return trx->CacheParameterMapper(pm, false);
+	}
+	Trace("ERROR: No mapper with name [" << name << "] found.");
+	HandleError(c, name, __FILE__, __LINE__, "DataAccess::GetMyParameterMapper returned 0");
+	return 0;
 }
 
-bool DataAccess::GetMyResultMapper(Context &c, ResultMapper *&rm)
+ResultMapper *DataAccess::GetMyResultMapper(Context &c, DataAccessImpl *trx)
 {
 	StartTrace(DataAccess.GetMyResultMapper);
-	bool isScriptInterpreter;
+	ResultMapper *rm = trx->GetCachedResultMapper();
+	if (rm) {
+		return rm;
+	}
 
 	// look into own config
-	ROAnything script = c.Lookup("ResultMapperScript");
+	ROAnything script = trx->Lookup("ResultMapperScript");
 	if (script.GetType() == AnyArrayType) {
-		isScriptInterpreter = true;
-
 		Trace("Result script found. Using interpreter.");
-		rm = new (coast::storage::Current()) EagerResultMapper(String("ResultScriptInterpreterFor") << fName, script);
-	} else {
-		// no script present, check if a named mapper can be found
-		isScriptInterpreter = false;
-
-		String name(script.AsString(fName));
-		rm = ResultMapper::FindResultMapper(name);
-		if (rm) {
-			Trace("Using specified ResultMapper: " << name);
-		} else {
-			// is there a fallback mapper defined?
-			String fallback = c.Lookup("FallbackResultMapper", "");
-
-			rm = ResultMapper::FindResultMapper(fallback);
-			if (rm) {
-				Trace("Using fallback ResultMapper: " << fallback);
-			} else {
-				Trace("ERROR: No mapper with name [" << name << "] found.");
-				HandleError(c, name, __FILE__, __LINE__, "DataAccess::GetMyResultMapper returned 0");
-			}
-		}
+		rm = new (coast::storage::Global()) EagerResultMapper(String("ResultScriptInterpreterFor") << fName, script);
+		return trx->CacheResultMapper(rm, true);
+	}
+
+	// no script present, check if a named mapper can be found
+	String name(script.AsString(fName));
+	rm = ResultMapper::FindResultMapper(name);
+	if (rm) {
+		Trace("Using specified ResultMapper: " << name);
+		return trx->CacheResultMapper(rm, false);
+	}
+	// is there a fallback mapper defined?
+	String fallback = trx->Lookup("FallbackResultMapper", "");
+
+	rm = ResultMapper::FindResultMapper(fallback);
+	if (rm) {
+		Trace("Using fallback ResultMapper: " << fallback);
+		return trx->CacheResultMapper(rm, false);
 	}
-	return isScriptInterpreter;
+	Trace("ERROR: No mapper with name [" << name << "] found.");
+	HandleError(c, name, __FILE__, __LINE__, "DataAccess::GetMyResultMapper returned 0");
+	return 0;
 }
 
 void DataAccess::HandleError(Context &context, String mapperName, const char *file, long line, String msg)
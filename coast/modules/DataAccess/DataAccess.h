@@ -44,8 +44,10 @@ protected:
 	String fName;
 
 private:
-	bool GetMyParameterMapper(Context &c, ParameterMapper *&pm);
-	bool GetMyResultMapper(Context &c, ResultMapper *&rm);
+	bool DoExec(DataAccessImpl *trx, ParameterMapper *input, ResultMapper *output, Context &context);
+	//! mappers are resolved from the configuration of trx and cached there, see DataAccessImpl::CacheParameterMapper()
+	ParameterMapper *GetMyParameterMapper(Context &c, DataAccessImpl *trx);
+	ResultMapper *GetMyResultMapper(Context &c, DataAccessImpl *trx);
 	void HandleError(Context &c, String name, const char *file, long line, String msg);
 };
 
@@ -49,7 +49,12 @@ const char* DataAccessImpl::gpcConfigPath = "DataAccessImpls";
 const char* DataAccessImpl::gpcConfigFileName = "DataAccessImplMeta";
 
 DataAccessImpl::DataAccessImpl(const char *name) :
-	HierarchConfNamed(name) {
+	HierarchConfNamed(name), fMapperCacheMutex("DataAccessImplMapperCache", coast::storage::Global()), fParameterMapper(0), fResultMapper(0), fOwnsParameterMapper(false), fOwnsResultMapper(false) {
+}
+
+DataAccessImpl::~DataAccessImpl()
+{
+	ResetMapperCache();
 }
 
 IFAObject *DataAccessImpl::Clone(Allocator *a) const
@@ -70,9 +75,69 @@ bool DataAccessImpl::Exec(Context &c, ParameterMapper *input, ResultMapper *outp
 	return false;
 }
 
+ParameterMapper *DataAccessImpl::GetCachedParameterMapper()
+{
+	LockUnlockEntry me(fMapperCacheMutex);
+	return fParameterMapper;
+}
+
+ResultMapper *DataAccessImpl::GetCachedResultMapper()
+{
+	LockUnlockEntry me(fMapperCacheMutex);
+	return fResultMapper;
+}
+
+ParameterMapper *DataAccessImpl::CacheParameterMapper(ParameterMapper *pm, bool bOwned)
+{
+	StartTrace1(DataAccessImpl.CacheParameterMapper, "Name: " << fName);
+	LockUnlockEntry me(fMapperCacheMutex);
+	if ( fParameterMapper == 0 ) {
+		fParameterMapper = pm;
+		fOwnsParameterMapper = bOwned;
+	} else if ( bOwned && pm != fParameterMapper ) {
+		delete pm;
+	}
+	return fParameterMapper;
+}
+
+ResultMapper *DataAccessImpl::CacheResultMapper(ResultMapper *rm, bool bOwned)
+{
+	StartTrace1(DataAccessImpl.CacheResultMapper, "Name: " << fName);
+	LockUnlockEntry me(fMapperCacheMutex);
+	if ( fResultMapper == 0 ) {
+		fResultMapper = rm;
+		fOwnsResultMapper = bOwned;
+	} else if ( bOwned && rm != fResultMapper ) {
+		delete rm;
+	}
+	return fResultMapper;
+}
+
+void DataAccessImpl::ResetMapperCache()
+{
+	LockUnlockEntry me(fMapperCacheMutex);
+	if ( fOwnsParameterMapper ) {
+		delete fParameterMapper;
+	}
+	if ( fOwnsResultMapper ) {
+		delete fResultMapper;
+	}
+	fParameterMapper = 0;
+	fResultMapper = 0;
+	fOwnsParameterMapper = fOwnsResultMapper = false;
+}
+
+bool DataAccessImpl::DoFinalize()
+{
+	StartTrace1(DataAccessImpl.DoFinalize, "Name: " << fName);
+	ResetMapperCache();
+	return HierarchConfNamed::DoFinalize();
+}
+
 bool DataAccessImpl::DoLoadConfig(const char *category)
 {
 	StartTrace(DataAccessImpl.DoLoadConfig);
+	ResetMapperCache();
 	if ( HierarchConfNamed::DoLoadConfig(category) && fConfig.IsDefined(fName) ) {
 		// trx impls use only a subset of the whole configuration file
 		fConfig = fConfig[fName];
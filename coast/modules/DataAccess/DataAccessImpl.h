@@ -10,6 +10,7 @@
 #define _DataAccessImpl_H
 
 #include "Mapper.h"
+#include "Threads.h"
 
 //---- DataAccessImplsModule -----------------------------------------------------------
 //! WDModule to initialize, configure and register DataAccessImpl objects
@@ -61,6 +62,7 @@ class DataAccessImpl : public HierarchConfNamed
 public:
 	/*! @copydoc RegisterableObject::RegisterableObject(const char *) */
 	DataAccessImpl(const char *name);
+	~DataAccessImpl();
 
 	static const char* gpcCategory;
 	static const char* gpcConfigPath;
@@ -76,6 +78,23 @@ public:
 	 * @param output ResultMapper object that maps the result of the access back into client space */
 	virtual bool Exec(Context &ctx, ParameterMapper *input, ResultMapper *output);
 
+	//! ParameterMapper resolved by DataAccess for this data access, 0 if not resolved yet
+	/*! The cache is valid until the configuration gets unloaded, eg. on ResetInit */
+	ParameterMapper *GetCachedParameterMapper();
+
+	//! ResultMapper resolved by DataAccess for this data access, 0 if not resolved yet
+	ResultMapper *GetCachedResultMapper();
+
+	//! Remember the ParameterMapper resolved for this data access
+	/*! @param pm resolved mapper
+	 * @param bOwned true if pm was created for this data access only, eg. to interpret an inline script, it gets deleted along with the cache
+	 * @return the cached mapper, if another thread was faster an owned pm gets deleted */
+	ParameterMapper *CacheParameterMapper(ParameterMapper *pm, bool bOwned);
+
+	//! Remember the ResultMapper resolved for this data access
+	/*! @copydetails CacheParameterMapper() */
+	ResultMapper *CacheResultMapper(ResultMapper *rm, bool bOwned);
+
 	//--- Registration
 	RegCacheDef(DataAccessImpl);	// FindDataAccessImpl()
 
@@ -88,10 +107,21 @@ protected:
 	/*! @copydetails ConfNamedObject::DoLoadConfig() */
 	virtual bool DoLoadConfig(const char *category);
 
+	//! Drop the cached mappers as they might refer to the configuration being unloaded
+	/*! @copydetails RegisterableObject::DoFinalize() */
+	virtual bool DoFinalize();
+
 private:
 	DataAccessImpl();
 	DataAccessImpl(const DataAccessImpl &);
 	DataAccessImpl &operator=(const DataAccessImpl &);
+
+	void ResetMapperCache();
+
+	SimpleMutex fMapperCacheMutex;
+	ParameterMapper *fParameterMapper;
+	ResultMapper *fResultMapper;
+	bool fOwnsParameterMapper, fOwnsResultMapper;
 };
 
 //--- LoopBackDAImpl ---------------------------------------------------
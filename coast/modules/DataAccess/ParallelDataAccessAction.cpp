@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+#include "ParallelDataAccessAction.h"
+#include "DataAccess.h"
+#include "Renderer.h"
+#include "Server.h"
+#include "Role.h"
+#include "Page.h"
+#include "TaskGraph.h"
+#include "DiffTimer.h"
+#include <vector>
+RegisterAction(ParallelDataAccessAction);
+
+namespace {
+	//! makes the stores of the calling Context visible to a call, after the stores of the call itself
+	class ParentStoresLookup: public LookupInterface {
+	public:
+		ParentStoresLookup(ROAnything tmpStore, ROAnything sessionStore)
+			: fTmpStore(tmpStore), fSessionStore(sessionStore) {
+		}
+	protected:
+		virtual bool DoLookup(const char *key, ROAnything &result, char delim, char indexdelim) const {
+			return fTmpStore.LookupPath(result, key, delim, indexdelim) || fSessionStore["RoleStore"].LookupPath(result, key, delim, indexdelim)
+					|| fSessionStore.LookupPath(result, key, delim, indexdelim);
+		}
+	private:
+		ROAnything fTmpStore;
+		ROAnything fSessionStore;
+	};
+
+	//! executes one DataAccess on a child Context, the TaskGraph might run several of them at the same time
+	/*! the calling Context is only read through ROAnythings while the graph runs, the results are kept in
+		global memory because the calls run on threads of their own */
+	class DataAccessCallTask: public TaskGraph::Task {
+	public:
+		DataAccessCallTask(const char *callName, const String &dataAccessName, ROAnything config, const ParentStoresLookup &parentStores,
+				ROAnything request, Context &ctx)
+			: fCallName(callName, -1, coast::storage::Global())
+			, fDataAccessName(dataAccessName, -1, coast::storage::Global())
+			, fConfig(config)
+			, fParentStores(parentStores)
+			, fRequest(request)
+			, fServer(ctx.GetServer())
+			, fRole(ctx.GetRole())
+			, fPage(ctx.GetPage())
+			, fLanguage(ctx.Language(), -1, coast::storage::Global())
+			, fExecuted(false)
+			, fSucceeded(false)
+			, fTimedOut(false)
+			, fTime(0L)
+			, fTmpStore(coast::storage::Global())
+			, fSessionStore(coast::storage::Global()) {
+		}
+		virtual bool Run() {
+			StartTrace1(DataAccessCallTask.Run, "call [" << fCallName << "] DataAccess [" << fDataAccessName << "]");
+			fExecuted = true;
+			if (fDataAccessName.Length() == 0) {
+				return false;
+			}
+			DiffTimer aTimer;
+			{
+				Context ctx;
+				Anything anyRequest = fRequest.DeepClone();
+				ctx.PushRequest(anyRequest);
+				ctx.SetLanguage(fLanguage);
+				ctx.Push("Server", fServer);
+				ctx.Push("Role", fRole);
+				ctx.Push("Page", fPage);
+				ctx.Push("ParentStores", const_cast<ParentStoresLookup *>(&fParentStores));
+				Context::PushPopEntry<ROAnything> aEntry(ctx, "ActionParameters", fConfig["Parameters"]);
+				DataAccess da(fDataAccessName);
+				fSucceeded = da.StdExec(ctx);
+				fTmpStore = ctx.GetTmpStore();
+				fSessionStore = ctx.GetSessionStore();
+			}
+			fTime = aTimer.Diff();
+			long lTimeout = fConfig["Timeout"].AsLong(0L);
+			fTimedOut = (lTimeout > 0L && fTime > lTimeout);
+			Trace("succeeded: " << (fSucceeded ? "true" : "false") << " time: " << fTime << "ms" << (fTimedOut ? " timed out" : ""));
+			return fSucceeded && !fTimedOut;
+		}
+		String fCallName;
+		String fDataAccessName;
+		ROAnything fConfig;
+		const ParentStoresLookup &fParentStores;
+		ROAnything fRequest;
+		Server *fServer;
+		Role *fRole;
+		Page *fPage;
+		String fLanguage;
+		bool fExecuted;
+		bool fSucceeded;
+		bool fTimedOut;
+		long fTime;
+		Anything fTmpStore;
+		Anything fSessionStore;
+	};
+
+	bool HasNamedSlot(const ROAnything &roa) {
+		for (long i = 0, sz = roa.GetSize(); i < sz; ++i) {
+			if (roa.SlotName(i)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//! named slots are merged recursively, unnamed slots are appended and any other value replaces the existing one
+	void MergeStore(Anything &anyStore, const ROAnything &roaCallStore) {
+		for (long i = 0, sz = roaCallStore.GetSize(); i < sz; ++i) {
+			const char *slotName = roaCallStore.SlotName(i);
+			ROAnything roaValue = roaCallStore[i];
+			if (!slotName) {
+				anyStore.Append(roaValue.DeepClone(anyStore.GetAllocator()));
+			} else if (roaValue.GetType() == AnyArrayType && HasNamedSlot(roaValue) && anyStore.IsDefined(slotName)
+					&& anyStore[slotName].GetType() == AnyArrayType) {
+				MergeStore(anyStore[slotName], roaValue);
+			} else {
+				anyStore[slotName] = roaValue.DeepClone(anyStore.GetAllocator());
+			}
+		}
+	}
+}
+
+bool ParallelDataAccessAction::DoExecAction(String &action, Context &ctx, const ROAnything &config) {
+	StartTrace(ParallelDataAccessAction.DoExecAction);
+	ROAnything calls = config["Calls"];
+	if (calls.GetSize() == 0) {
+		return false;
+	}
+	// the calls only read the copy, the session itself is unlocked while they run
+	Anything anySessionStore = ROAnything(ctx.GetSessionStore()).DeepClone();
+	ParentStoresLookup parentStores(ctx.GetTmpStore(), anySessionStore);
+	TaskGraph graph("ParallelDataAccess", config["Threads"].AsLong(calls.GetSize()));
+	std::vector<DataAccessCallTask *> tasks;
+	for (long i = 0, sz = calls.GetSize(); i < sz; ++i) {
+		ROAnything call = calls[i];
+		ROAnything dataAccessNameSpec = (call.IsDefined("DataAccess") ? call["DataAccess"] : call[0L]);
+		String dataAccessName;
+		Renderer::RenderOnString(dataAccessName, ctx, dataAccessNameSpec);
+		String callName(calls.SlotName(i));
+		if (callName.Length() == 0) {
+			callName = dataAccessName;
+		}
+		Trace("call [" << callName << "] resulting DataAccess name [" << dataAccessName << "]");
+		tasks.push_back(new DataAccessCallTask(callName, dataAccessName, call, parentStores, ctx.GetRequest(), ctx));
+		graph.AddTask(tasks.back(), call["Mandatory"].AsBool(true));
+	}
+	bool bRet = false;
+	{
+		SessionReleaser slr(ctx);
+		slr.Use();
+		bRet = graph.Run();
+	}
+	Anything &tmpStore = ctx.GetTmpStore();
+	for (std::vector<DataAccessCallTask *>::iterator aIt = tasks.begin(); aIt != tasks.end(); ++aIt) {
+		DataAccessCallTask &task = **aIt;
+		if (task.fExecuted && !task.fTimedOut) {
+			MergeStore(tmpStore, task.fTmpStore);
+			if (task.fSessionStore.GetSize()) {
+				MergeStore(ctx.GetSessionStore(), task.fSessionStore);
+			}
+		}
+		Anything anyStatus;
+		anyStatus["DataAccess"] = task.fDataAccessName;
+		anyStatus["Executed"] = task.fExecuted;
+		anyStatus["Succeeded"] = task.fSucceeded;
+		anyStatus["TimedOut"] = task.fTimedOut;
+		anyStatus["Time"] = task.fTime;
+		tmpStore["ParallelDataAccess"][task.fCallName] = anyStatus;
+		delete *aIt;
+	}
+	TraceAny(tmpStore["ParallelDataAccess"], "outcome of the calls");
+	return bRet;
+}
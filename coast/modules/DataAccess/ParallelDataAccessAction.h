@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _ParallelDataAccessAction_H
+#define _ParallelDataAccessAction_H
+
+#include "Action.h"
+
+//! Action to perform several independent DataAccesses at the same time
+//! Preferred Alias : ParallelCallDA <BR>
+//! Each call runs on its own child Context. Lookups of a call see its /Parameters as ActionParameters,
+//! then its own TmpStore and SessionStore, then the stores of the calling Context (TmpStore, RoleStore and
+//! SessionStore), then Page, Role and Server of the calling Context and finally the request. The mapper outputs
+//! of a call are written into its own stores only. When all calls are done, the stores of every call not timed out are merged into the stores of the
+//! calling Context in configuration order: named slots are merged recursively, any other value replaces the
+//! existing one, so a later call wins if two calls write the same slot.
+//! The session of the calling Context is unlocked while the calls run, the calls see a copy of its SessionStore.
+//! <PRE> { /ParallelCallDA {
+//!		/Calls {
+//!			/NameOfTheCall {
+//!				/DataAccess		NameOfTheDataAccessToPerform (Renderer spec)
+//!				/Parameters {	# Anything that gets pushed on the context of this call only
+//!					...
+//!				}
+//!				/Timeout		optional, default 0, a call running longer than this many ms has its results discarded and counts as failed, 0 means no limit
+//!				/Mandatory		optional, default 1, if set a failure of the call fails the action and calls not yet started are skipped
+//!			}
+//!			/NameOfAnotherCall	NameOfTheDataAccessToPerform	# short cut form
+//!			...
+//!		}
+//!		/Threads			optional, default number of calls, maximum number of calls running at the same time
+//! } }</PRE>
+//! The outcome of every call is stored in TmpStore.ParallelDataAccess.NameOfTheCall
+//! <PRE> { /DataAccess rendered name /Executed 0|1 /Succeeded 0|1 /TimedOut 0|1 /Time ms }</PRE>
+//! \note /Timeout only decides whether the results of a call are used, it does not limit how long the action waits.
+//! The action always waits until every started call has returned, a running DataAccess is not interrupted. Use the
+//! timeout parameters of the DataAccessImpl, e.g. /Parameters { /Timeout 5 }, to limit blocking backends.
+class ParallelDataAccessAction: public Action {
+public:
+	ParallelDataAccessAction(const char *name) :
+		Action(name) {
+	}
+protected:
+	//! Calls the DataAccesses
+	//! \param transitionToken (in/out) the event passed by the caller, can be modified.
+	//! \param c the context the action runs within.
+	//! \param config the configuration of the action.
+	//! \return true if all mandatory DataAccesses run successfully, false if one of them failed or the configuration is invalid.
+	virtual bool DoExecAction(String &transitionToken, Context &ctx, const ROAnything &config);
+};
+
+#endif
@@ -33,12 +33,18 @@ bool ReadXMLFileDAImpl::Exec( Context &context, ParameterMapper *in, ResultMappe
 	bool retVal = false;
 	std::istream *Ios = GetFileStream(context, in);
 	if (Ios) {
-		GenericXMLParser p;
-		Anything result = p.Parse(*Ios);
-		TraceAny(result, "Parsed XML");
 		String targetLoc("ParsedXMLAsAny");
 		in->Get("ResultSlotName", targetLoc, context);
-		retVal = out->Put(targetLoc, result, context);
+		bool bStream = false;
+		in->Get("StreamXML", bStream, context);
+		if (bStream) {
+			retVal = out->Put(targetLoc, *Ios, context);
+		} else {
+			GenericXMLParser p;
+			Anything result = p.Parse(*Ios);
+			TraceAny(result, "Parsed XML");
+			retVal = out->Put(targetLoc, result, context);
+		}
 		delete Ios;
 	}
 	return retVal;
@@ -21,6 +21,8 @@
 	/Extension		Mapperspec		optional, extension of the file if not already specified in Filename slot
 	/Mode			Mapperspec		optional, [text|binary] (all lowercase!), default text, mode to open file
 	/ResultSlotName	Mapperspec		optional, store the parsed XML in this slot, default is ParsedXMLAsAny
+	/StreamXML		Mapperspec		optional, default false, put the file as stream instead of the parsed XML, lets the
+									XMLMapper build only the configured elements of large files
 }
 </PRE>
 */
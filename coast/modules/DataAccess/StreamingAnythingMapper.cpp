@@ -8,6 +8,7 @@
 
 #include "StreamingAnythingMapper.h"
 #include "Timers.h"
+#include "JSONParser.h"
 
 //---- AnythingToStreamMapper ----------------------------------------------------------------
 RegisterParameterMapper(AnythingToStreamMapper);
@@ -53,3 +54,45 @@ bool StreamToAnythingMapper::DoPutStream(const char *key, std::istream &is, Cont
 	}
 	return importok;
 }
+
+//---- AnythingToJSONMapper ----------------------------------------------------------------
+RegisterParameterMapper(AnythingToJSONMapper);
+
+bool AnythingToJSONMapper::DoFinalGetStream(const char *key, std::ostream &os, Context &ctx)
+{
+	StartTrace1(AnythingToJSONMapper.DoFinalGetStream, NotNull(key));
+	if ( key ) {
+		Anything anyValue;
+		DoFinalGetAny(key, anyValue, ctx);
+		if ( !anyValue.IsNull() ) {
+			DAAccessTimer(AnythingToJSONMapper.DoFinalGetStream, "writing JSON to stream", ctx);
+			JSONPrinter::PrintOn(os, anyValue);
+			os << std::flush;
+			return true;
+		}
+		Trace("Nothing written to stream, value was null.");
+	}
+	return false;
+}
+
+//---- JSONToAnythingMapper ----------------------------------------------------------------
+RegisterResultMapper(JSONToAnythingMapper);
+
+bool JSONToAnythingMapper::DoPutStream(const char *key, std::istream &is, Context &ctx, ROAnything script)
+{
+	StartTrace1(JSONToAnythingMapper.DoPutStream, NotNull(key));
+	Anything anyResult;
+	bool parseok;
+	{
+		DAAccessTimer(JSONToAnythingMapper.DoPutStream, "parsing JSON from stream", ctx);
+		JSONParser aParser(key);
+		parseok = aParser.Parse(is, anyResult);
+	}
+	if ( parseok ) {
+		TraceAny(anyResult, "anything parsed from JSON stream:");
+		parseok = DoPutAny(key, anyResult, ctx, script);
+	} else {
+		SYSWARNING("parsing JSON from stream failed!");
+	}
+	return parseok;
+}
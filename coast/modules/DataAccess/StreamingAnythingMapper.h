@@ -93,4 +93,49 @@ protected:
 	/*! @copydoc ResultMapper::DoPutAnyWithSlotname() */
 	virtual bool DoFinalGetStream(const char *key, std::ostream &os, Context &ctx);
 };
+
+//---- JSONToAnythingMapper ----------------------------------------------------------
+//! converts a JSON stream into an Anything and puts it into the context using an optional mapper script
+/*!
+Works like StreamToAnythingMapper but reads JSON using JSONParser, see there for the mapping of JSON values.
+ */
+class JSONToAnythingMapper : public AnythingLookupPathResultMapper {
+public:
+	/*! @copydoc RegisterableObject::RegisterableObject(const char *) */
+	JSONToAnythingMapper(const char *name)
+		: AnythingLookupPathResultMapper(name) {}
+
+	/*! @copydoc IFAObject::Clone(Allocator *) */
+	IFAObject *Clone(Allocator *a) const {
+		return new (a) JSONToAnythingMapper(fName);
+	}
+
+protected:
+	//! reads JSON from istream and puts the resulting Anything according to key
+	/*! @copydoc ResultMapper::DoPutStream() */
+	virtual bool DoPutStream(const char *key, std::istream &is, Context &ctx, ROAnything script);
+};
+
+//---- AnythingToJSONMapper ----------------------------------------------------------
+//! streams Anythings out from context as JSON
+/*!
+looks up 'key' in context and writes it as JSON using JSONPrinter on the client provided stream
+ */
+class AnythingToJSONMapper : public ParameterMapper
+{
+public:
+	/*! @copydoc RegisterableObject::RegisterableObject(const char *) */
+	AnythingToJSONMapper(const char *name)
+		: ParameterMapper(name) {}
+
+	/*! @copydoc IFAObject::Clone(Allocator *) */
+	IFAObject *Clone(Allocator *a) const {
+		return new (a) AnythingToJSONMapper(fName);
+	}
+
+protected:
+	//! write the Anything retrieved from key to the output stream as JSON
+	/*! @copydoc ParameterMapper::DoFinalGetStream() */
+	virtual bool DoFinalGetStream(const char *key, std::ostream &os, Context &ctx);
+};
 #endif
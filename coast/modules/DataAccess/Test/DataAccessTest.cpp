@@ -19,6 +19,7 @@ Test *DataAccessTest::suite ()
 	ADD_CASE(testSuite, DataAccessTest, GetImplTest);
 	ADD_CASE(testSuite, DataAccessTest, ExecTest);
 	ADD_CASE(testSuite, DataAccessTest, CopySessionStoreTest);
+	ADD_CASE(testSuite, DataAccessTest, MapperCacheTest);
 	return testSuite;
 }
 
@@ -128,3 +129,52 @@ void DataAccessTest::CopySessionStoreTest()
 		t_assert(!s.IsLockedByMe());
 	}
 }
+
+void DataAccessTest::MapperCacheTest()
+{
+	StartTrace(DataAccessTest.MapperCacheTest);
+	Anything dummy;
+	Context ctx(dummy, dummy, 0, 0, 0, 0);
+	Anything tmpStore(ctx.GetTmpStore());
+	tmpStore["In"] = "first";
+
+	const char *daName = "DATest_StdMappers_Script";
+	DataAccessImpl *trx = DataAccessImpl::FindDataAccessImpl(daName);
+	t_assert(trx != 0);
+	if ( trx ) {
+		t_assert(trx->GetCachedParameterMapper() == 0);
+		t_assert(DataAccess(daName).StdExec(ctx));
+		assertEqual("first", tmpStore["Mapper"]["Out"].AsString());
+		ParameterMapper *pm = trx->GetCachedParameterMapper();
+		ResultMapper *rm = trx->GetCachedResultMapper();
+		t_assert(pm != 0);
+		t_assert(rm != 0);
+
+		// inline script interpreters get reused
+		tmpStore.Remove("Mapper");
+		tmpStore["In"] = "second";
+		t_assert(DataAccess(daName).StdExec(ctx));
+		assertEqual("second", tmpStore["Mapper"]["Out"].AsString());
+		t_assert(pm == trx->GetCachedParameterMapper());
+		t_assert(rm == trx->GetCachedResultMapper());
+
+		// unloading the configuration drops the cache
+		t_assert(trx->Finalize());
+		t_assert(trx->GetCachedParameterMapper() == 0);
+		t_assert(trx->GetCachedResultMapper() == 0);
+		t_assert(trx->Initialize(DataAccessImpl::gpcCategory));
+		tmpStore.Remove("Mapper");
+		tmpStore["In"] = "third";
+		t_assert(DataAccess(daName).StdExec(ctx));
+		assertEqual("third", tmpStore["Mapper"]["Out"].AsString());
+	}
+
+	daName = "DATest_UseFallbackMapper";
+	trx = DataAccessImpl::FindDataAccessImpl(daName);
+	t_assert(trx != 0);
+	if ( trx ) {
+		t_assert(DataAccess(daName).StdExec(ctx));
+		t_assert(trx->GetCachedParameterMapper() == ParameterMapper::FindParameterMapper("ParameterMapper"));
+		t_assert(trx->GetCachedResultMapper() == ResultMapper::FindResultMapper("ResultMapper"));
+	}
+}
@@ -28,6 +28,7 @@ public:
 	void GetImplTest();
 	void ExecTest();
 	void CopySessionStoreTest();
+	void MapperCacheTest();
 };
 
 #endif
@@ -61,12 +61,61 @@ void StreamingAnythingMapperTest::PutTest()
 	assertEqual(42, result["Slot2"].AsLong(0));
 }
 
+void StreamingAnythingMapperTest::JSONGetTest()
+{
+	StartTrace(StreamingAnythingMapperTest.JSONGetTest);
+	Anything clientData;
+	clientData["Input"]["Slot1"] = "Something";
+	clientData["Input"]["Slot2"] = 42;
+
+	Context ctx(clientData, Anything(), 0, 0, 0, 0);
+	AnythingToJSONMapper mapper("NoName");
+	mapper.Initialize("ParameterMapper");
+	String streamedAny;
+	{
+		OStringStream out(&streamedAny);
+		t_assert(mapper.Get("Input", out, ctx));
+	}
+	assertEqual( "{\"Slot1\":\"Something\",\"Slot2\":42}" , streamedAny);
+	String streamedAny2;
+	{
+		OStringStream out2(&streamedAny2);
+		t_assert(!mapper.Get("Input.NotThere", out2, ctx));
+	}
+	assertEqual( "" , streamedAny2);
+}
+
+void StreamingAnythingMapperTest::JSONPutTest()
+{
+	StartTrace(StreamingAnythingMapperTest.JSONPutTest);
+
+	Anything dummy;
+	Context ctx(dummy, Anything(), 0, 0, 0, 0);
+	JSONToAnythingMapper jam("NoName");
+	jam.Initialize("ResultMapper");
+	String streamedJSON("{ \"Slot1\": \"Something\", \"Slot2\": [42, true] }");
+	IStringStream in(streamedJSON);
+	t_assert(jam.Put("Output", in, ctx));
+
+	Anything result = ctx.GetTmpStore()["Mapper"]["Output"];
+	assertEqual("Something", result["Slot1"].AsCharPtr("x"));
+	assertEqual(42, result["Slot2"][0L].AsLong(0));
+	assertEqual(1, result["Slot2"][1L].AsLong(0));
+
+	String brokenJSON("{ \"Slot1\": ");
+	IStringStream in2(brokenJSON);
+	t_assert(!jam.Put("Broken", in2, ctx));
+	t_assert(!ctx.GetTmpStore()["Mapper"].IsDefined("Broken"));
+}
+
 Test *StreamingAnythingMapperTest::suite ()
 {
 	TestSuite *testSuite = new TestSuite;
 
 	ADD_CASE(testSuite, StreamingAnythingMapperTest, PutTest);
 	ADD_CASE(testSuite, StreamingAnythingMapperTest, GetTest);
+	ADD_CASE(testSuite, StreamingAnythingMapperTest, JSONPutTest);
+	ADD_CASE(testSuite, StreamingAnythingMapperTest, JSONGetTest);
 
 	return testSuite;
 
@@ -32,6 +32,10 @@ public:
 	void GetTest();
 	//! Reads an Anything form client's stream and stores it in context
 	void PutTest();
+	//! Writes an Anything from context as JSON on client's stream
+	void JSONGetTest();
+	//! Reads JSON from client's stream and stores the Anything in context
+	void JSONPutTest();
 };
 
 #endif
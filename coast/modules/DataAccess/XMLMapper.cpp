@@ -10,6 +10,68 @@
 
 #include "XMLMapper.h"
 #include "Context.h"
+#include "GenericXMLParser.h"
+
+namespace {
+	//! builds the elements listed in /Elements including everything within them, the rest of the document is dropped
+	class ElementCollector: public GenericXMLParser::EventHandler {
+		ROAnything fElements;
+		Anything &fResult;
+		//! elements being built, innermost last
+		Anything fOpen;
+	public:
+		ElementCollector(ROAnything roaElements, Anything &result) :
+			fElements(roaElements), fResult(result), fOpen(Anything::ArrayMarker(), result.GetAllocator()) {
+		}
+		virtual void StartElement(const String &tag, Anything &attributes) {
+			if ( fOpen.GetSize() == 0L && !IsListed(tag, attributes) ) {
+				return;
+			}
+			Anything element(Anything::ArrayMarker(), fResult.GetAllocator());
+			element[tag] = attributes;
+			fOpen.Append(element);
+		}
+		virtual void EndElement(const String &) {
+			long lOpen = fOpen.GetSize();
+			if ( lOpen > 0L ) {
+				Anything element = fOpen[lOpen - 1L];
+				fOpen.Remove(lOpen - 1L);
+				Append(element);
+			}
+		}
+		virtual void Characters(const String &text) {
+			if ( fOpen.GetSize() > 0L ) {
+				Append(Anything(text, fResult.GetAllocator()));
+			}
+		}
+		virtual void Node(Anything &node) {
+			if ( fOpen.GetSize() > 0L ) {
+				Append(node);
+			}
+		}
+	private:
+		void Append(const Anything &anyContent) {
+			long lOpen = fOpen.GetSize();
+			if ( lOpen > 0L ) {
+				fOpen[lOpen - 1L].Append(anyContent);
+			} else {
+				fResult.Append(anyContent);
+			}
+		}
+		bool IsListed(const String &tag, ROAnything roaAttributes) const {
+			if ( fElements.Contains(tag) ) {
+				return true;
+			}
+			for ( long l = 0, sz = roaAttributes.GetSize(); l < sz; ++l ) {
+				const char *pcName = roaAttributes.SlotName(l);
+				if ( pcName && fElements.Contains(pcName) ) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+}
 
 //---- XMLMapper ------------------------------------------------------------------
 RegisterResultMapper(XMLMapper);
@@ -54,6 +116,19 @@ bool XMLMapper::DoPutAny(const char *key, Anything &value, Context &ctx, ROAnyth
 	return true;
 }
 
+bool XMLMapper::DoPutStream(const char *key, std::istream &is, Context &ctx, ROAnything)
+{
+	StartTrace1(XMLMapper.DoPutStream, NotNull(key));
+	if ( !fConfig.IsDefined("Elements") || String().IsEqual(key) ) {
+		return false;
+	}
+	Anything elements = Anything(Anything::ArrayMarker());
+	ElementCollector aCollector(fConfig["Elements"], elements);
+	GenericXMLParser p;
+	p.ParseEvents(is, aCollector);
+	return DoPutAny(key, elements, ctx, ROAnything());
+}
+
 bool XMLMapper::Iterate(Anything currentAny, String pathSoFar, long slotIndex, String slotName, bool bFound, Anything &result)
 {
 	StartTrace1(XMLMapper.Iterate, pathSoFar);
@@ -33,6 +33,10 @@
 
 	Using ReadXMLFileDAImpl and XMLMapper together gives you a neat way to retrieve your XML-Elements
 	from a file. For restrictions see the GenericXMLParser.
+
+	When the XML is put as a stream it is parsed with GenericXMLParser::ParseEvents() and only the elements whose
+	name or one of whose attribute names is listed in /Elements are built, including everything within them.
+	/ParsedXMLAsAny then is the list of these elements in document order and /LookupPathes refer to it.
 }
 </PRE>
 */
@@ -45,6 +49,8 @@ public:
 	IFAObject *Clone(Allocator *a) const;
 	// ignores the SelectScript-Hook, operates directly on fConfig (FIXME?)
 	virtual bool DoPutAny(const char *key, Anything &value, Context &ctx, ROAnything);
+	//! parses the XML read from is without building the whole document, see class description
+	virtual bool DoPutStream(const char *key, std::istream &is, Context &ctx, ROAnything);
 
 protected:
 	bool Iterate(Anything currentAny, String pathSoFar, long slotIndex, String slotName, bool bFound, Anything &result);
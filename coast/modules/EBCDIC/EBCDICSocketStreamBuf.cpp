@@ -28,6 +28,19 @@ long EBCDICSocketStreamBuf::DoWrite(const char *buf, long len)
 	return bytesWritten;
 }
 
+long EBCDICSocketStreamBuf::DoWriteVector(const char *pending, long lPending, const char *buf, long len)
+{
+	char *ebcdicBuf = new char[lPending + len];
+
+	ascii2ebcdic(ebcdicBuf, pending, lPending);
+	ascii2ebcdic(ebcdicBuf + lPending, buf, len);
+
+	long bytesWritten = SocketStreamBuf::DoWrite(ebcdicBuf, lPending + len);
+	delete[] ebcdicBuf;
+
+	return bytesWritten;
+}
+
 long EBCDICSocketStreamBuf::DoRead(char *buf, long len) const
 {
 	long bytesRead = SocketStreamBuf::DoRead(buf, len);
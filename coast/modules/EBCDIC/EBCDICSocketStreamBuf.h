@@ -29,6 +29,9 @@ protected:
 	//! \pre buf is not 0
 	virtual long DoWrite(const char *buf, long len);
 
+	//! translate both buffers from ASCII to EBCDIC before writing them to the socket
+	virtual long DoWriteVector(const char *pending, long lPending, const char *buf, long len);
+
 	//!translate buf from EBCDIC to ASCII after reading from the socket
 	//! \param buf the buffer to write
 	//! \param len the maximum length of the buffer
@@ -9,8 +9,14 @@
 #include "MultifunctionListBoxRenderer.h"
 #include "StringStream.h"
 #include "utf8.h"
+#include "AnySorter.h"
 
 namespace {
+	//! session store slot keeping the cached sorted lists, one entry per box name
+	const char *cSortedListsSlot = "MultifunctionListBoxSortedLists";
+	//! number of boxes which may keep a sorted list in the session, the least recently stored one is dropped first
+	const long cMaxCachedSortedLists = 8L;
+
 	long getStringLength(String const &str) {
 		long len = 0L;
 		try {
@@ -414,6 +420,11 @@ void MultifunctionListBoxRenderer::RenderAll(std::ostream &reply, Context &c, co
 		String strBoxName, strFormName;
 		MultifunctionListBoxRenderer::RenderBoxName(strBoxName, c, config);
 		MultifunctionListBoxRenderer::RenderFormName(strFormName, c, config);
+		// rows and scripts of the box need to see the same sorted list, keep it pushed while rendering
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		PrepareList(c, config, strBoxName, anySortedList, roaSortedList);
+		Context::PushPopEntry<ROAnything> aSortedList(c, "MultifunctionListBoxSortedList", roaSortedList, "MultifunctionListBoxSortedList");
 
 		reply << "\n<!-- BEGIN [" << strBoxName << "] -->\n";
 
@@ -475,6 +486,108 @@ void MultifunctionListBoxRenderer::RenderAll(std::ostream &reply, Context &c, co
 	}
 }
 
+void MultifunctionListBoxRenderer::PrepareList(Context &c, const ROAnything &config, const String &strBoxName, Anything &anySortedList, ROAnything &roaSortedList)
+{
+	StartTrace(MultifunctionListBoxRenderer.PrepareList);
+	if ( !config.IsDefined("SortKey") && !config.IsDefined("PageSize") ) {
+		return;
+	}
+	String strListName;
+	ROAnything roaList;
+	RenderOnString(strListName, c, config["ListName"]);
+	if ( !strListName.Length() || !c.Lookup(strListName, roaList) ) {
+		Trace("list [" << strListName << "] not found");
+		return;
+	}
+	Anything anyPaging;
+	String strSortKey;
+	RenderOnString(strSortKey, c, config["SortKey"]);
+	if ( strSortKey.Length() ) {
+		String strSortOrder = RenderToStringWithDefault(c, config["SortOrder"], "asc");
+		bool bSortCritIsNumber = ( RenderToString(c, config["SortCritIsNumber"]).AsLong(0L) == 1L );
+		String strListVersion;
+		if ( RenderToString(c, config["CacheSortedList"]).AsLong(0L) == 1L ) {
+			RenderOnString(strListVersion, c, config["ListVersion"]);
+		}
+		String strSignature;
+		if ( strListVersion.Length() ) {
+			// the version is bumped by whoever changes the list, so it is not necessary to look at the entries
+			strSignature << strListName << '|' << strListVersion << '|' << roaList.GetSize() << '|' << strSortKey << '|' << strSortOrder << '|' << ( bSortCritIsNumber ? 1L : 0L );
+		}
+		ROAnything roaCached;
+		c.Lookup(String(cSortedListsSlot) << '.' << strBoxName, roaCached);
+		if ( strSignature.Length() && roaCached["Signature"].AsString() == strSignature ) {
+			Trace("using sorted list cached in session for [" << strSignature << "]");
+			roaSortedList = roaCached["List"];
+		} else {
+			anySortedList = roaList.DeepClone();
+			AnySorter::SortByKeyInArray(strSortKey, anySortedList, ( strSortOrder == "desc" ) ? AnySorter::desc : AnySorter::asc, bSortCritIsNumber);
+			roaSortedList = anySortedList;
+			if ( strSignature.Length() || !roaCached.IsNull() ) {
+				Anything &anySortedLists = c.GetSessionStore(cSortedListsSlot)[cSortedListsSlot];
+				// a stored list moves to the end, the entries stay ordered by the time they were stored
+				anySortedLists.Remove(strBoxName);
+				if ( strSignature.Length() ) {
+					while ( anySortedLists.GetSize() >= cMaxCachedSortedLists ) {
+						anySortedLists.Remove(0L);
+					}
+					Anything anyCached;
+					anyCached["Signature"] = strSignature;
+					anyCached["List"] = anySortedList;
+					// copied once into the session allocator, following page flips render from there
+					anySortedLists[strBoxName] = anyCached;
+				}
+			}
+		}
+		anyPaging["Sorted"] = 1L;
+		roaList = roaSortedList;
+	}
+	long lRows = roaList.GetSize();
+	anyPaging["Rows"] = lRows;
+	long lPageSize = RenderToString(c, config["PageSize"]).AsLong(0L);
+	if ( lPageSize > 0L ) {
+		long lPages = ( lRows + lPageSize - 1L ) / lPageSize;
+		long lPage = RenderToString(c, config["Page"]).AsLong(0L);
+		if ( lPage >= lPages ) {
+			lPage = lPages - 1L;
+		}
+		if ( lPage < 0L ) {
+			lPage = 0L;
+		}
+		long lStart = lPage * lPageSize;
+		long lEnd = ( ( lStart + lPageSize < lRows ) ? lStart + lPageSize : lRows ) - 1L;
+		if ( lEnd < lStart ) {
+			// empty list, a negative end would only make the ListRenderer complain
+			lEnd = lStart;
+		}
+		anyPaging["PageSize"] = lPageSize;
+		anyPaging["Page"] = lPage;
+		anyPaging["Pages"] = lPages;
+		anyPaging["Start"] = lStart;
+		anyPaging["End"] = lEnd;
+	}
+	TraceAny(anyPaging, "paging of [" << strBoxName << "]");
+	c.GetTmpStore()["MultifunctionListBoxPaging"][strBoxName] = anyPaging;
+}
+
+void MultifunctionListBoxRenderer::ApplyListWindow(Context &c, const ROAnything &config, Anything &listSpec)
+{
+	StartTrace(MultifunctionListBoxRenderer.ApplyListWindow);
+	if (config.IsDefined("ListName")) {
+		listSpec["ListName"] = config["ListName"].DeepClone();
+	}
+	String strBoxName;
+	MultifunctionListBoxRenderer::GetBoxName(strBoxName, c);
+	ROAnything roaPaging = ROAnything(c.GetTmpStore())["MultifunctionListBoxPaging"][strBoxName];
+	if ( roaPaging["Sorted"].AsBool(false) ) {
+		listSpec["ListName"] = "MultifunctionListBoxSortedList";
+	}
+	if ( roaPaging.IsDefined("PageSize") ) {
+		listSpec["Start"] = roaPaging["Start"].AsLong(0L);
+		listSpec["End"] = roaPaging["End"].AsLong(-1L);
+	}
+}
+
 void MultifunctionListBoxRenderer::RenderStyleSheet(std::ostream &reply, Context &c, const ROAnything &config)
 {
 	StartTrace(MultifunctionListBoxRenderer.RenderStyleSheet);
@@ -600,9 +713,7 @@ void MultifunctionListBoxRenderer::RenderBoxRow(std::ostream &reply, Context &c,
 					if (config.IsDefined("Multiple")) {
 						rendererConfig["Multiple"] = config["Multiple"].DeepClone();
 					}
-					if (config.IsDefined("ListName")) {
-						rendererConfig["ListName"] = config["ListName"].DeepClone();
-					}
+					ApplyListWindow(c, config, rendererConfig);
 					if (config.IsDefined("ValueRenderer")) {
 						rendererConfig["ValueRenderer"] = config["ValueRenderer"].DeepClone();
 					}
@@ -1684,6 +1795,7 @@ void MultifunctionListBoxRenderer::RenderScripts(std::ostream &reply, Context &c
 				if (pListRenderer) {
 					Anything anyListSpec;
 					anyListSpec["ListName"] = config["ListName"].DeepClone();
+					ApplyListWindow(c, config, anyListSpec);
 					anyListSpec["EntryStore"] = "SelectBoxOption";
 					anyListSpec["IndexSlot"] = "SelectBoxOptionIndex";
 
@@ -110,6 +110,20 @@
 
 	}
 	/StatusMessage				optional, message to display to the right of the navigation
+	/SortKey					Rendererspec	optional, slotname (path) within the list entries to sort the list on the server, see AnySorter
+	/SortOrder					Rendererspec	optional, asc or desc, default asc
+	/SortCritIsNumber			Rendererspec	optional, 1 or 0, default 0, set to 1 when SortKey denotes a numeric value
+	/CacheSortedList			Rendererspec	optional, 1 or 0, default 0, keep the sorted list in the session store and reuse it as long as
+												ListName, ListVersion, the number of entries and the sort slots do not change, eg. when flipping pages,
+												only effective together with ListVersion, at most 8 boxes keep a sorted list in the session
+	/ListVersion				Rendererspec	optional, version or generation of the list content which changes whenever the list is modified,
+												eg. a counter stored together with the list, the entries themselves are not compared
+	/PageSize					Rendererspec	optional, number of rows per page, when set only the rows of the current page are rendered
+	/Page						Rendererspec	optional, default 0, zero based page to render, limited to the last page
+
+	* When SortKey or PageSize is given the renderer stores the paging state of the box in
+	  TmpStore.MultifunctionListBoxPaging.<boxname> { /Rows /Sorted /PageSize /Page /Pages /Start /End }
+	  Rows is the number of entries of the whole list and can be used for status messages or the navigation.
 }
 </PRE>
  column list slots:
@@ -220,6 +234,13 @@ private:
 
 	bool Lookup(const ROAnything &nameConfig, Context &c, const ROAnything &config, Anything &result);
 
+	//! sorts the list and computes the page to render according to the config, stores the paging state in the TmpStore
+	//! \param anySortedList holds the sorted list if it was sorted in this request
+	//! \param roaSortedList the sorted list to render, null if the list is not sorted
+	void PrepareList(Context &c, const ROAnything &config, const String &strBoxName, Anything &anySortedList, ROAnything &roaSortedList);
+	//! sets ListName, Start and End of a list renderer config according to the paging state of the current box
+	void ApplyListWindow(Context &c, const ROAnything &config, Anything &listSpec);
+
 	friend class MultifunctionListBoxRendererTest;
 };
 
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "MultifunctionListBoxRendererTest.h"
+#include "MultifunctionListBoxRenderer.h"
+#include "TestSuite.h"
+#include "Tracer.h"
+#include "Context.h"
+
+namespace {
+	void AppendEntry(Anything &anyList, const char *pcName, long lAmount) {
+		Anything anyEntry;
+		anyEntry["Name"] = pcName;
+		anyEntry["Amount"] = lAmount;
+		anyList.Append(anyEntry);
+	}
+}
+
+//---- MultifunctionListBoxRendererTest ----------------------------------------------------------------
+MultifunctionListBoxRendererTest::MultifunctionListBoxRendererTest(TString tstrName) : TestCaseType(tstrName)
+{
+	StartTrace(MultifunctionListBoxRendererTest.Ctor);
+}
+
+MultifunctionListBoxRendererTest::~MultifunctionListBoxRendererTest()
+{
+	StartTrace(MultifunctionListBoxRendererTest.Dtor);
+}
+
+void MultifunctionListBoxRendererTest::SortOrderTest()
+{
+	StartTrace(MultifunctionListBoxRendererTest.SortOrderTest);
+	MultifunctionListBoxRenderer renderer("MultifunctionListBoxRenderer");
+	Context ctx;
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "b", 20L);
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "c", 3L);
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "a", 100L);
+	Anything config;
+	config["ListName"] = "BoxList";
+	config["SortKey"] = "Amount";
+	config["SortCritIsNumber"] = 1L;
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+		if ( assertEqual(3L, roaSortedList.GetSize()) ) {
+			assertEqual("c", roaSortedList[0L]["Name"].AsString());
+			assertEqual("b", roaSortedList[1L]["Name"].AsString());
+			assertEqual("a", roaSortedList[2L]["Name"].AsString());
+		}
+		ROAnything roaPaging = ROAnything(ctx.GetTmpStore())["MultifunctionListBoxPaging"]["MyBox"];
+		assertEqual(1L, roaPaging["Sorted"].AsLong(0L));
+		assertEqual(3L, roaPaging["Rows"].AsLong(0L));
+		t_assert(!roaPaging.IsDefined("PageSize"));
+	}
+	config["SortOrder"] = "desc";
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+		if ( assertEqual(3L, roaSortedList.GetSize()) ) {
+			assertEqual("a", roaSortedList[0L]["Name"].AsString());
+			assertEqual("b", roaSortedList[1L]["Name"].AsString());
+			assertEqual("c", roaSortedList[2L]["Name"].AsString());
+		}
+	}
+	assertEqual("b", ctx.GetTmpStore()["BoxList"][0L]["Name"].AsString());
+}
+
+void MultifunctionListBoxRendererTest::PagePastEndTest()
+{
+	StartTrace(MultifunctionListBoxRendererTest.PagePastEndTest);
+	MultifunctionListBoxRenderer renderer("MultifunctionListBoxRenderer");
+	Context ctx;
+	for (long l = 0; l < 5L; ++l) {
+		AppendEntry(ctx.GetTmpStore()["BoxList"], "x", l);
+	}
+	ctx.GetTmpStore()["MultifunctionListBoxName"] = "MyBox";
+	Anything config;
+	config["ListName"] = "BoxList";
+	config["PageSize"] = 2L;
+	config["Page"] = 7L;
+	Anything anySortedList;
+	ROAnything roaSortedList;
+	renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+	t_assert(roaSortedList.IsNull());
+	ROAnything roaPaging = ROAnything(ctx.GetTmpStore())["MultifunctionListBoxPaging"]["MyBox"];
+	assertEqual(5L, roaPaging["Rows"].AsLong(-1L));
+	assertEqual(3L, roaPaging["Pages"].AsLong(-1L));
+	assertEqual(2L, roaPaging["Page"].AsLong(-1L));
+	assertEqual(4L, roaPaging["Start"].AsLong(-1L));
+	assertEqual(4L, roaPaging["End"].AsLong(-1L));
+	Anything listSpec;
+	renderer.ApplyListWindow(ctx, config, listSpec);
+	assertEqual("BoxList", listSpec["ListName"].AsString());
+	assertEqual(4L, listSpec["Start"].AsLong(-1L));
+	assertEqual(4L, listSpec["End"].AsLong(-1L));
+}
+
+void MultifunctionListBoxRendererTest::EmptyListTest()
+{
+	StartTrace(MultifunctionListBoxRendererTest.EmptyListTest);
+	MultifunctionListBoxRenderer renderer("MultifunctionListBoxRenderer");
+	Context ctx;
+	ctx.GetTmpStore()["BoxList"] = Anything(Anything::ArrayMarker());
+	ctx.GetTmpStore()["MultifunctionListBoxName"] = "MyBox";
+	Anything config;
+	config["ListName"] = "BoxList";
+	config["SortKey"] = "Amount";
+	config["PageSize"] = 2L;
+	config["Page"] = 1L;
+	Anything anySortedList;
+	ROAnything roaSortedList;
+	renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+	assertEqual(0L, roaSortedList.GetSize());
+	ROAnything roaPaging = ROAnything(ctx.GetTmpStore())["MultifunctionListBoxPaging"]["MyBox"];
+	assertEqual(0L, roaPaging["Rows"].AsLong(-1L));
+	assertEqual(0L, roaPaging["Pages"].AsLong(-1L));
+	assertEqual(0L, roaPaging["Page"].AsLong(-1L));
+	Anything listSpec;
+	renderer.ApplyListWindow(ctx, config, listSpec);
+	assertEqual("MultifunctionListBoxSortedList", listSpec["ListName"].AsString());
+	assertEqual(0L, listSpec["Start"].AsLong(-1L));
+	assertEqualm(0L, listSpec["End"].AsLong(-1L), "end must not be negative for an empty list");
+}
+
+void MultifunctionListBoxRendererTest::CacheReuseTest()
+{
+	StartTrace(MultifunctionListBoxRendererTest.CacheReuseTest);
+	MultifunctionListBoxRenderer renderer("MultifunctionListBoxRenderer");
+	Context ctx;
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "b", 2L);
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "a", 1L);
+	Anything config;
+	config["ListName"] = "BoxList";
+	config["SortKey"] = "Amount";
+	config["SortCritIsNumber"] = 1L;
+	config["CacheSortedList"] = 1L;
+	config["ListVersion"] = 1L;
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+		t_assertm(!anySortedList.IsNull(), "first request should sort");
+		t_assert(ROAnything(ctx.GetSessionStore())["MultifunctionListBoxSortedLists"].IsDefined("MyBox"));
+	}
+	// the entries are not looked at, only the version tells if the list changed
+	ctx.GetTmpStore()["BoxList"][0L]["Amount"] = 0L;
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+		t_assertm(anySortedList.IsNull(), "unchanged version should be taken from the session");
+		assertEqual("a", roaSortedList[0L]["Name"].AsString());
+	}
+	config["ListVersion"] = 2L;
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "MyBox", anySortedList, roaSortedList);
+		t_assertm(!anySortedList.IsNull(), "changed version should be sorted again");
+		assertEqual("b", roaSortedList[0L]["Name"].AsString());
+		assertEqual("b", ctx.GetSessionStore()["MultifunctionListBoxSortedLists"]["MyBox"]["List"][0L]["Name"].AsString());
+	}
+}
+
+void MultifunctionListBoxRendererTest::CacheBoundTest()
+{
+	StartTrace(MultifunctionListBoxRendererTest.CacheBoundTest);
+	MultifunctionListBoxRenderer renderer("MultifunctionListBoxRenderer");
+	Context ctx;
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "b", 2L);
+	AppendEntry(ctx.GetTmpStore()["BoxList"], "a", 1L);
+	Anything config;
+	config["ListName"] = "BoxList";
+	config["SortKey"] = "Amount";
+	config["CacheSortedList"] = 1L;
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "NoVersion", anySortedList, roaSortedList);
+		t_assertm(!ROAnything(ctx.GetSessionStore()).IsDefined("MultifunctionListBoxSortedLists"), "nothing to cache without a version");
+	}
+	config["ListVersion"] = 1L;
+	for (long lBox = 0L; lBox < 9L; ++lBox) {
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, String("Box") << lBox, anySortedList, roaSortedList);
+	}
+	ROAnything roaSortedLists = ROAnything(ctx.GetSessionStore())["MultifunctionListBoxSortedLists"];
+	assertEqual(8L, roaSortedLists.GetSize());
+	t_assertm(!roaSortedLists.IsDefined("Box0"), "least recently stored box should have been dropped");
+	t_assert(roaSortedLists.IsDefined("Box8"));
+	config["CacheSortedList"] = 0L;
+	{
+		Anything anySortedList;
+		ROAnything roaSortedList;
+		renderer.PrepareList(ctx, config, "Box8", anySortedList, roaSortedList);
+		t_assertm(!anySortedList.IsNull(), "not cached anymore");
+		t_assertm(!ROAnything(ctx.GetSessionStore())["MultifunctionListBoxSortedLists"].IsDefined("Box8"), "stale entry should be removed");
+	}
+}
+
+// builds up a suite of testcases, add a line for each testmethod
+Test *MultifunctionListBoxRendererTest::suite ()
+{
+	StartTrace(MultifunctionListBoxRendererTest.suite);
+	TestSuite *testSuite = new TestSuite;
+	ADD_CASE(testSuite, MultifunctionListBoxRendererTest, SortOrderTest);
+	ADD_CASE(testSuite, MultifunctionListBoxRendererTest, PagePastEndTest);
+	ADD_CASE(testSuite, MultifunctionListBoxRendererTest, EmptyListTest);
+	ADD_CASE(testSuite, MultifunctionListBoxRendererTest, CacheReuseTest);
+	ADD_CASE(testSuite, MultifunctionListBoxRendererTest, CacheBoundTest);
+	return testSuite;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _MultifunctionListBoxRendererTest_H
+#define _MultifunctionListBoxRendererTest_H
+
+#include "TestCase.h"
+
+//---- MultifunctionListBoxRendererTest ----------------------------------------------------------
+//! tests sorting and paging of the list of a MultifunctionListBoxRenderer
+class MultifunctionListBoxRendererTest : public testframework::TestCase
+{
+public:
+	//--- constructors
+
+	//! TestCase constructor
+	//! \param name name of the test
+	MultifunctionListBoxRendererTest(TString tstrName);
+
+	//! destroys the test case
+	~MultifunctionListBoxRendererTest();
+
+	//--- public api
+
+	//! builds up a suite of testcases for this test
+	static Test *suite ();
+
+	//! sorts the list ascending and descending
+	void SortOrderTest();
+	//! a page past the end of the list is limited to the last page
+	void PagePastEndTest();
+	//! an empty list has no rows and an empty window
+	void EmptyListTest();
+	//! the sorted list cached in the session is reused until the version of the list changes
+	void CacheReuseTest();
+	//! sorted lists are only cached with a version, for a limited number of boxes and removed when caching is off
+	void CacheBoundTest();
+};
+
+#endif
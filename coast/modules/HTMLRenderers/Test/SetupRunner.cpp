@@ -10,10 +10,12 @@
 
 //--- test cases ---------------------------------------------------------------
 #include "NewRendererTest.h"
+#include "MultifunctionListBoxRendererTest.h"
 
 void setupRunner(TestRunner &runner)
 {
 	// add a whole suite with the ADD_SUITE(runner,"Suites's Classname") macro
 	ADD_SUITE(runner, NewRendererTest);
+	ADD_SUITE(runner, MultifunctionListBoxRendererTest);
 }
 
@@ -308,7 +308,7 @@ bool LDAPConnection::WaitForResult(int msgId, Anything &result, LDAPErrorHandler
 
 	while (!finished) {
 		// wait for result
-		resultCode = ldap_result(fHandle, msgId, 1, tvp, &ldapResult);
+		resultCode = DoGetResult(msgId, tvp, &ldapResult);
 
 		// check result
 		if (resultCode == -1 && fSearchTimeout == 0) {
@@ -362,6 +362,12 @@ bool LDAPConnection::WaitForResult(int msgId, Anything &result, LDAPErrorHandler
 	return success;
 }
 
+int LDAPConnection::DoGetResult(int msgId, timeval *tvp, LDAPMessage **ldapResult)
+{
+	StartTrace(LDAPConnection.DoGetResult);
+	return ldap_result(fHandle, msgId, 1, tvp, ldapResult);
+}
+
 void LDAPConnection::HandleWait4ResultError(int msgId, String &errMsg, LDAPErrorHandler &eh)
 {
 	StartTrace(LDAPConnection.HandleWait4ResultError);
@@ -398,12 +404,14 @@ void LDAPConnection::TransformResult(LDAPMessage *ldapResult, Anything &result,
 
 		// extract data
 		LDAPMessage *entry = ldap_first_entry(fHandle, ldapResult);
-		String valStr, attrString, dn;
+		String attrString, dn;
 		struct berval **vals;
 		BerElement *ber;
-		int count = 0;
 		int nofVals;
 		Anything entries;
+		// evaluate once per result instead of once per value
+		const bool bPlainBinaryValues = eh.GetConnectionParams()["PlainBinaryValues"].AsBool(false);
+		const bool bMapUTF8 = eh.GetConnectionParams()["MapUTF8"].AsBool(true);
 
 		// step through all entries
 		while (entry) {
@@ -413,6 +421,7 @@ void LDAPConnection::TransformResult(LDAPMessage *ldapResult, Anything &result,
 				dn = ptrToDn;
 				ldap_memfree( ptrToDn );
 			}
+			Anything &dnEntry = entries[dn];
 			char *attr = ldap_first_attribute(fHandle, entry, &ber);
 			//
 			// kgu: might want to add dn ass attribute to each
@@ -433,20 +442,9 @@ void LDAPConnection::TransformResult(LDAPMessage *ldapResult, Anything &result,
 				if ( nofVals == 0 ) {
 					// there might be attributes without values
 					// (eg. if AttrsOnly was requested)
-					entries[dn].Append(attrString);
+					dnEntry.Append(attrString);
 				} else {
-					for (int i = 0; i < nofVals; ++i) {
-						valStr = String((void *)vals[i]->bv_val, (long)vals[i]->bv_len);
-
-						if ( !eh.GetConnectionParams()["PlainBinaryValues"].AsBool(false) ) {
-							MapUTF8Chars(valStr, eh.GetConnectionParams()["MapUTF8"].AsBool(true));
-						}
-						if (i == 0) {
-							entries[dn][attrString] = valStr;
-						} else {
-							entries[dn][attrString].Append(valStr);
-						}
-					}
+					DecodeValues(vals, nofVals, dnEntry[attrString], bPlainBinaryValues, bMapUTF8);
 				}
 				// free used memory
 				if ( vals != ( berval ** ) NULL ) {
@@ -458,7 +456,6 @@ void LDAPConnection::TransformResult(LDAPMessage *ldapResult, Anything &result,
 				attr = ldap_next_attribute(fHandle, entry, ber);
 			}
 			entry = ldap_next_entry(fHandle, entry);
-			++count;
 			// free used memory
 			if (ber) {
 				ber_free(ber, 0);
@@ -493,12 +490,37 @@ bool LDAPConnection::Disconnect(LDAP *handle)
 	return true;
 }
 
+void LDAPConnection::DecodeValues(struct berval **vals, int nofVals, Anything &attrEntry, bool bPlainBinaryValues, bool bMapUTF8)
+{
+	StartTrace1(LDAPConnection.DecodeValues, "#values: " << (long)nofVals);
+	for (int i = 0; i < nofVals; ++i) {
+		const char *pVal = vals[i]->bv_val;
+		long lLen = (long)vals[i]->bv_len;
+		String valStr((void *)pVal, lLen);
+		if ( !bPlainBinaryValues ) {
+			// plain 7bit values are the same in UTF-8 and need no mapping
+			long l = 0;
+			while ( l < lLen && !(pVal[l] & 0x80) ) {
+				++l;
+			}
+			if ( l < lLen ) {
+				MapUTF8Chars(valStr, bMapUTF8);
+			}
+		}
+		if (i == 0) {
+			attrEntry = valStr;
+		} else {
+			attrEntry.Append(valStr);
+		}
+	}
+}
+
 void LDAPConnection::MapUTF8Chars(String &str, bool bMapUTF8)
 {
 	StartTrace(LDAPConnection.MapUTF8Chars);
 	Trace("Do UTF8 to HTML mapping: " << (bMapUTF8 ? "yes" : "no"));
 
-	String result;
+	String result(str.Length() + 16L);
 	for (long i = 0; i < str.Length(); ) {
 		const char *theChar = ((const char *)str) + i;
 		const char *theStartChar = theChar;
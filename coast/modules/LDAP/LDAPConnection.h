@@ -98,6 +98,13 @@ protected:
 		\param eh error handling structure */
 	virtual void DoHandleWait4ResultError(LDAPErrorHandler &eh) {}
 
+	/*! fetch the complete result of msgId, used by WaitForResult
+		\param msgId id of message to wait for
+		\param tvp timeout, NULL to wait forever
+		\param ldapResult returned message chain, freed by the caller
+		\return same as ldap_result(): -1 on error, 0 on timeout, message type otherwise */
+	virtual int DoGetResult(int msgId, timeval *tvp, LDAPMessage **ldapResult);
+
 	//! does the Connect and reports details what it has done.
 	virtual LDAPConnection::EConnectState DoConnect(ROAnything bindParams, LDAPErrorHandler &eh);
 
@@ -134,6 +141,9 @@ private:
 	//! (LDAPv3 uses UTF-8). conversion is changes the passed string.
 	void MapUTF8Chars(String &str, bool bMapUTF8);
 
+	//! decode all values of an attribute at once into attrEntry, a single value is stored as plain String
+	void DecodeValues(struct berval **vals, int nofVals, Anything &attrEntry, bool bPlainBinaryValues, bool bMapUTF8);
+
 	//! returns a human readable string describing the message type code
 	String GetTypeStr(int msgType);
 
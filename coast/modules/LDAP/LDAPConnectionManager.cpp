@@ -8,6 +8,7 @@
 
 #include "LDAPConnectionManager.h"
 #include "PersistentLDAPConnection.h"
+#include "LDAPResultDispatcher.h"
 #include "TraceLocks.h"
 #include "TimeStamp.h"
 #include "SystemLog.h"
@@ -27,6 +28,8 @@ LDAPConnectionManager::LDAPConnectionManager(const char *name)
 	, fFreeListMutex("FreeListMutex", coast::storage::Global())
 	, fLdapConnectionStore(coast::storage::Global())
 	, fFreeList(coast::storage::Global())
+	, fSharedConnectionMutex("SharedConnectionMutex", coast::storage::Global())
+	, fSharedConnectionStore(coast::storage::Global())
 	, fDefMaxConnections(0L)
 {
 	StartTrace1(LDAPConnectionManager.LDAPConnectionManager, "Name:<" << NotNull(name) << ">");
@@ -140,6 +143,118 @@ bool LDAPConnectionManager::SetLdapConnection(long maxConnections, const String
 	return ret;
 }
 
+Anything LDAPConnectionManager::GetSharedLdapConnection(long maxConnections, long maxPending, const String &poolId, long rebindTimeout)
+{
+	StartTrace1(LDAPConnectionManager.GetSharedLdapConnection, "poolId: " << poolId);
+	maxConnections = (maxConnections != 0L) ? maxConnections :  fDefMaxConnections;
+	maxPending = (maxPending > 0L) ? maxPending : 1L;
+	Anything returned;
+	LockUnlockEntry me(fSharedConnectionMutex);
+	while ( true ) {
+		// other pools might have been added while waiting, get the reference again
+		Anything &pool = fSharedConnectionStore[poolId];
+		while ( pool.GetSize() < maxConnections ) {
+			Anything slot(Anything::ArrayMarker(), fSharedConnectionStore.GetAllocator());
+			slot["Users"] = 0L;
+			pool.Append(slot);
+		}
+		// prefer the least loaded usable connection
+		long slotIndex = -1L, minUsers = maxPending;
+		for ( long l = 0; l < maxConnections; ++l ) {
+			long users = pool[l]["Users"].AsLong(0L);
+			if ( users < minUsers && !SharedSlotNeedsRebind(pool[l], rebindTimeout) ) {
+				slotIndex = l;
+				minUsers = users;
+			}
+		}
+		if ( slotIndex != -1L ) {
+			Anything &slot = pool[slotIndex];
+			slot["Users"] = minUsers + 1L;
+			returned["Slot"] = slotIndex;
+			returned["Handle"] = slot["Handle"];
+			returned["Dispatcher"] = slot["Dispatcher"];
+			returned["MustRebind"] = false;
+			Trace("sharing slot " << slotIndex << " with " << minUsers << " other users");
+			return returned;
+		}
+		// no usable connection has capacity left, (re)bind one nobody uses
+		for ( long l = 0; l < maxConnections; ++l ) {
+			Anything &slot = pool[l];
+			if ( slot["Users"].AsLong(0L) == 0L && !slot["Binding"].AsBool(false) ) {
+				slot["Users"] = 1L;
+				slot["Binding"] = true;
+				returned["Slot"] = l;
+				returned["MustRebind"] = true;
+				Trace("slot " << l << " must be bound");
+				return returned;
+			}
+		}
+		Trace("all connections busy, waiting");
+		fSharedConnectionCond.Wait(fSharedConnectionMutex);
+	}
+}
+
+bool LDAPConnectionManager::SharedSlotNeedsRebind(ROAnything slot, long rebindTimeout)
+{
+	StartTrace(LDAPConnectionManager.SharedSlotNeedsRebind);
+	if ( slot["Handle"].AsIFAObject(0) == 0 || slot["Binding"].AsBool(false) || slot["MustRebind"].AsBool(false) ) {
+		return true;
+	}
+	if ( rebindTimeout != 0L ) {
+		TimeStamp lastRebind( slot["LastRebind"].AsString() );
+		return ( (lastRebind + rebindTimeout) <= TimeStamp::Now() );
+	}
+	return false;
+}
+
+LDAPResultDispatcher *LDAPConnectionManager::SetSharedLdapConnection(const String &poolId, long slotIndex, LDAP *handle)
+{
+	StartTrace1(LDAPConnectionManager.SetSharedLdapConnection, "poolId: " << poolId << " slot: " << slotIndex);
+	LDAPResultDispatcher *dispatcher = (LDAPResultDispatcher *) NULL;
+	LockUnlockEntry me(fSharedConnectionMutex);
+	Anything &slot = fSharedConnectionStore[poolId][slotIndex];
+	LDAP *storedHandle = (LDAP *) slot["Handle"].AsIFAObject(0);
+	if ( storedHandle != (LDAP *) NULL && storedHandle != handle ) {
+		Trace("Disconnecting storedHandle: " << PersistentLDAPConnection::DumpConnectionHandle(storedHandle));
+		delete (LDAPResultDispatcher *) slot["Dispatcher"].AsIFAObject(0);
+		PersistentLDAPConnection::Disconnect(storedHandle);
+	}
+	if ( handle != (LDAP *) NULL ) {
+		dispatcher = new LDAPResultDispatcher(handle);
+	}
+	slot["Handle"] = (IFAObject *) handle;
+	slot["Dispatcher"] = (IFAObject *) dispatcher;
+	slot["LastRebind"] = TimeStamp::Now().AsStringWithZ();
+	slot["MustRebind"] = false;
+	slot["Binding"] = false;
+	fSharedConnectionCond.BroadCast();
+	return dispatcher;
+}
+
+void LDAPConnectionManager::InvalidateSharedLdapConnection(const String &poolId, long slotIndex)
+{
+	StartTrace1(LDAPConnectionManager.InvalidateSharedLdapConnection, "poolId: " << poolId << " slot: " << slotIndex);
+	LockUnlockEntry me(fSharedConnectionMutex);
+	fSharedConnectionStore[poolId][slotIndex]["MustRebind"] = true;
+}
+
+bool LDAPConnectionManager::ReleaseSharedHandleInfo(const String &poolId, long slotIndex)
+{
+	StartTrace1(LDAPConnectionManager.ReleaseSharedHandleInfo, "poolId: " << poolId << " slot: " << slotIndex);
+	LockUnlockEntry me(fSharedConnectionMutex);
+	if ( !fSharedConnectionStore.IsDefined(poolId) || slotIndex < 0L || slotIndex >= fSharedConnectionStore[poolId].GetSize() ) {
+		return false;
+	}
+	Anything &slot = fSharedConnectionStore[poolId][slotIndex];
+	long users = slot["Users"].AsLong(0L);
+	if ( users <= 0L ) {
+		return false;
+	}
+	slot["Users"] = users - 1L;
+	fSharedConnectionCond.BroadCast();
+	return true;
+}
+
 Semaphore *LDAPConnectionManager::LookupSema(long maxConnections, const String &poolId)
 {
 	StartTrace(LDAPConnectionManager.LookupSema);
@@ -398,6 +513,26 @@ bool LDAPConnectionManager::Finis()
 		}
 		fLdapConnectionStore = Anything(coast::storage::Global());
 	}
+	{
+		LockUnlockEntry me(fSharedConnectionMutex);
+		for ( long pools = 0; pools < fSharedConnectionStore.GetSize(); pools++ ) {
+			for ( long items = 0; items < fSharedConnectionStore[pools].GetSize(); items++ ) {
+				Anything &slot = fSharedConnectionStore[pools][items];
+				LDAP *handle = (LDAP *) slot["Handle"].AsIFAObject(0);
+				if ( slot["Users"].AsLong(0L) > 0L ) {
+					SystemLog::Info(String("LDAPConnectionManager: Shared pool: [") << fSharedConnectionStore.SlotName(pools) << "] " <<
+									"At index: [" << items << "] still in use, not freeing " << PersistentLDAPConnection::DumpConnectionHandle(handle));
+					ret = false;
+					continue;
+				}
+				delete (LDAPResultDispatcher *) slot["Dispatcher"].AsIFAObject(0);
+				if (handle) {
+					PersistentLDAPConnection::Disconnect(handle);
+				}
+			}
+		}
+		fSharedConnectionStore = Anything(coast::storage::Global());
+	}
 	THRKEYDELETE(LDAPConnectionManager::fgErrnoKey);
 	return ret;
 }
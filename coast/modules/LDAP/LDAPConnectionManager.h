@@ -13,6 +13,8 @@
 #include "Threads.h"
 #include "ldap.h"
 
+class LDAPResultDispatcher;
+
 //---- LDAPConnectionManager ----------------------------------------------------------
 //! Manages LDAP connections represented by binding handles.
 /*!
@@ -77,6 +79,9 @@ On termination, all allocated structures are freed.
 		If set to 0, this setting is ignored. Otherwise a connection is re-established after the /RebindTimeout
 		second. Evaluation of this value takes place every time a LDAP operation on this connection is executed.
 		Default is to ignore this setting.
+	/MultiplexedRequests
+		If > 0, up to this many requests share one pooled connection at the same time (MultiplexedLDAPConnection).
+		Such connections are kept in a separate pool structure, /MaxConnections still limits the number of connections.
 }
 \endcode
 */
@@ -102,6 +107,18 @@ public:
 	//! Release HandleInfo (releases mutex and semaphore)
 	virtual bool ReleaseHandleInfo(long maxConnections, const String &poolId);
 
+	//! Get a share of a connection used concurrently by up to maxPending threads (MultiplexedLDAPConnection).
+	//! Blocks while all connections of the pool carry maxPending requests. If the returned slot has /MustRebind set,
+	//! the caller is its only user and must bind a new handle and store it using SetSharedLdapConnection.
+	Anything GetSharedLdapConnection(long maxConnections, long maxPending, const String &poolId, long rebindTimeout = 0L);
+	//! Store the freshly bound handle of a shared slot, NULL if binding failed. Disconnects the previous handle.
+	//! \return the dispatcher routing the results of handle, NULL if handle is NULL
+	LDAPResultDispatcher *SetSharedLdapConnection(const String &poolId, long slot, LDAP *handle);
+	//! Mark a shared slot to be rebound as soon as no request is pending on it anymore
+	void InvalidateSharedLdapConnection(const String &poolId, long slot);
+	//! Give back a share obtained by GetSharedLdapConnection
+	bool ReleaseSharedHandleInfo(const String &poolId, long slot);
+
 	//--- module initialization termination ---
 	//!initialize
 	virtual bool Init(const ROAnything config);
@@ -135,6 +152,15 @@ protected:
 	//!The freelist - reduce time we spend locked iterating over fLdapConnectionStore
 	Anything fFreeList;
 
+	//!The mutex that protects the shared connection pools
+	SimpleMutex fSharedConnectionMutex;
+
+	//!Signaled when a share of a connection got released or a shared connection got bound
+	SimpleCondition fSharedConnectionCond;
+
+	//!The shared connection pools: /poolid { { /Handle /Dispatcher /Users /Binding /MustRebind /LastRebind } ... }
+	Anything fSharedConnectionStore;
+
 	//! The maximum number of connections per connection "type"
 	long fDefMaxConnections;
 
@@ -170,6 +196,9 @@ protected:
 	//! Get the free list entry the current thread is using
 	long GetThisThreadsFreeListEntry(long maxConnections, const String &poolId);
 
+	//! Decide wether a shared slot must be bound before it can be used
+	bool SharedSlotNeedsRebind(ROAnything slot, long rebindTimeout);
+
 private:
 	LDAPConnectionManager(const LDAPConnectionManager &);
 	LDAPConnectionManager &operator=(const LDAPConnectionManager &);
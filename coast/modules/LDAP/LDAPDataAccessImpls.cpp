@@ -7,6 +7,7 @@
  */
 
 #include "LDAPDataAccessImpls.h"
+#include "MultiplexedLDAPConnection.h"
 #include "Renderer.h"
 
 void ReleaseHandleInfo(Context &ctx, LDAPConnection *lc)
@@ -61,6 +62,8 @@ LDAPConnection *LDAPAbstractDAI::LDAPConnectionFactory(ROAnything cp)
 	StartTrace(LDAPAbstractDAI.LDAPConnectionFactory);
 	if ( cp["PooledConnections"].AsLong(0) == 0L ) {
 		return new LDAPConnection(cp);
+	} else if ( cp["MultiplexedRequests"].AsLong(0) > 0L ) {
+		return new MultiplexedLDAPConnection(cp);
 	} else {
 		return new PersistentLDAPConnection(cp);
 	}
@@ -125,6 +128,10 @@ bool LDAPAbstractDAI::DoExec( Context &ctx, ParameterMapper *getter, ResultMappe
 	getter->Get("LDAPMaxConnections", maxConnections, ctx);
 	cp["MaxConnections"] = maxConnections;
 
+	long multiplexedRequests = 0L;
+	getter->Get("LDAPMultiplexedRequests", multiplexedRequests, ctx);
+	cp["MultiplexedRequests"] = multiplexedRequests;
+
 	long tryAutoRebind = 0L;
 	getter->Get("LDAPTryAutoRebind", tryAutoRebind, ctx);
 	cp["TryAutoRebind"] = tryAutoRebind;
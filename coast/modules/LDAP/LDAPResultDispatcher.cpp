@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "LDAPResultDispatcher.h"
+#include "Tracer.h"
+#include <ctime>
+
+namespace {
+	//! seconds a result for a forgotten message id gets dropped on arrival
+	const long cForgottenLifetime = 300L;
+}
+
+//---- LDAPResultDispatcher ----------------------------------------------------------------
+LDAPResultDispatcher::LDAPResultDispatcher(LDAP *handle)
+	: fHandle(handle)
+	, fMutex("LDAPResultDispatcher", coast::storage::Global())
+	, fReading(false)
+	, fResults(Anything::ArrayMarker(), coast::storage::Global())
+	, fForgotten(Anything::ArrayMarker(), coast::storage::Global())
+{
+	StartTrace(LDAPResultDispatcher.LDAPResultDispatcher);
+}
+
+LDAPResultDispatcher::~LDAPResultDispatcher()
+{
+	StartTrace(LDAPResultDispatcher.~LDAPResultDispatcher);
+	LockUnlockEntry me(fMutex);
+	for ( long l = 0; l < fResults.GetSize(); ++l ) {
+		LDAPMessage *msg = (LDAPMessage *) fResults[l]["Message"].AsIFAObject(0);
+		if ( msg != NULL ) {
+			ldap_msgfree(msg);
+		}
+	}
+	fResults = Anything(Anything::ArrayMarker(), coast::storage::Global());
+}
+
+int LDAPResultDispatcher::WaitForResult(int msgId, timeval *tvp, LDAPMessage **ldapResult)
+{
+	StartTrace1(LDAPResultDispatcher.WaitForResult, "msgId: [" << (long)msgId << "]");
+	*ldapResult = NULL;
+	String key;
+	key << (long)msgId;
+	time_t deadline = ( tvp != NULL ) ? time(NULL) + tvp->tv_sec : 0;
+
+	LockUnlockEntry me(fMutex);
+	while ( true ) {
+		if ( fResults.IsDefined(key) ) {
+			int resultCode = (int) fResults[key]["Code"].AsLong(-1L);
+			*ldapResult = (LDAPMessage *) fResults[key]["Message"].AsIFAObject(0);
+			fResults.Remove(key);
+			Trace("picked up result, code: " << (long)resultCode);
+			return resultCode;
+		}
+		long remaining = ( tvp != NULL ) ? (long) (deadline - time(NULL)) : 0L;
+		if ( tvp != NULL && remaining <= 0L ) {
+			Trace("timed out");
+			return 0;
+		}
+		if ( fReading ) {
+			// somebody else reads, wait until it filed a result or gave up reading
+			if ( tvp != NULL ) {
+				fResultArrived.TimedWait(fMutex, remaining);
+			} else {
+				fResultArrived.Wait(fMutex);
+			}
+			continue;
+		}
+		fReading = true;
+		LDAPMessage *msg = NULL;
+		int resultCode;
+		{
+			fMutex.Unlock();
+			timeval tv;
+			tv.tv_sec = remaining;
+			tv.tv_usec = 0;
+			resultCode = ReadResult(( tvp != NULL ) ? &tv : NULL, &msg);
+			fMutex.Lock();
+		}
+		fReading = false;
+		if ( resultCode > 0 && msg != NULL ) {
+			String msgKey;
+			msgKey << (long)ldap_msgid(msg);
+			if ( fForgotten.IsDefined(msgKey) ) {
+				Trace("dropping late result for forgotten msgId: [" << msgKey << "]");
+				fForgotten.Remove(msgKey);
+				ldap_msgfree(msg);
+			} else {
+				Trace("filing result for msgId: [" << msgKey << "]");
+				fResults[msgKey]["Code"] = (long)resultCode;
+				fResults[msgKey]["Message"] = (IFAObject *) msg;
+			}
+		}
+		fResultArrived.BroadCast();
+		if ( resultCode == -1 ) {
+			// connection level error, the others will run into it on their own when reading
+			Trace("ldap_result failed");
+			return resultCode;
+		}
+	}
+}
+
+int LDAPResultDispatcher::ReadResult(timeval *tvp, LDAPMessage **ldapResult)
+{
+	StartTrace(LDAPResultDispatcher.ReadResult);
+	return ldap_result(fHandle, LDAP_RES_ANY, LDAP_MSG_ALL, tvp, ldapResult);
+}
+
+void LDAPResultDispatcher::Forget(int msgId)
+{
+	StartTrace1(LDAPResultDispatcher.Forget, "msgId: [" << (long)msgId << "]");
+	String key;
+	key << (long)msgId;
+	LockUnlockEntry me(fMutex);
+	ExpireForgotten();
+	if ( fResults.IsDefined(key) ) {
+		LDAPMessage *msg = (LDAPMessage *) fResults[key]["Message"].AsIFAObject(0);
+		if ( msg != NULL ) {
+			ldap_msgfree(msg);
+		}
+		fResults.Remove(key);
+	} else {
+		Trace("result not arrived yet, dropping it on arrival");
+		// keep the ids in the order of their expiry
+		fForgotten.Remove(key);
+		fForgotten[key] = (long) time(NULL) + cForgottenLifetime;
+	}
+}
+
+void LDAPResultDispatcher::ExpireForgotten()
+{
+	StartTrace(LDAPResultDispatcher.ExpireForgotten);
+	// all ids share the same lifetime, so the expired ones are at the front
+	long now = (long) time(NULL);
+	while ( fForgotten.GetSize() > 0L && fForgotten[0L].AsLong(0L) <= now ) {
+		Trace("forgotten msgId expired: [" << fForgotten.SlotName(0L) << "]");
+		fForgotten.Remove(0L);
+	}
+}
+
+long LDAPResultDispatcher::GetUnclaimedCount()
+{
+	LockUnlockEntry me(fMutex);
+	return fResults.GetSize();
+}
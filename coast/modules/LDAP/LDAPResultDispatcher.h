@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _LDAPResultDispatcher_H
+#define _LDAPResultDispatcher_H
+
+#include "LDAPAPI.h"
+#include "Threads.h"
+
+//---- LDAPResultDispatcher ----------------------------------------------------------
+//! Routes the results of an LDAP handle shared by several request threads.
+/*!
+Every thread waits for its own message id only. There is no extra dispatcher thread: one of the waiting
+threads reads from the handle using ldap_result(LDAP_RES_ANY, LDAP_MSG_ALL) and files whatever complete result
+arrives under its message id, then wakes up the others. A waiter whose result was filed takes it out and returns,
+while another waiter takes over reading. Results are kept even if nobody waits for them yet, because the response
+to a request might arrive before its sender started waiting.
+Message ids given up with Forget() are remembered for a while, a result arriving for them later is freed
+right away instead of being filed.
+\par Internal structure
+\code
+/fResults
+{
+	/<msgId>
+	{
+		/Code		<return code of ldap_result>
+		/Message	<ptr to LDAPMessage chain>
+	}
+}
+/fForgotten
+{
+	/<msgId>	<time until which a late result gets dropped>
+}
+\endcode
+*/
+class LDAPResultDispatcher
+{
+public:
+	//! dispatch results of handle, the handle remains owned by the caller
+	LDAPResultDispatcher(LDAP *handle);
+	//! frees results nobody picked up
+	~LDAPResultDispatcher();
+
+	/*! wait for the complete result of msgId
+		\param msgId id of the message to wait for
+		\param tvp timeout, NULL to wait forever
+		\param ldapResult returned message chain, must be freed by the caller
+		\return same as ldap_result(): -1 on error, 0 on timeout, message type otherwise */
+	int WaitForResult(int msgId, timeval *tvp, LDAPMessage **ldapResult);
+
+	//! drop the result of msgId, eg. after the request has been abandoned
+	/*! if the result did not arrive yet, it gets dropped when it arrives within the next five minutes */
+	void Forget(int msgId);
+
+	//! number of results waiting to be picked up
+	long GetUnclaimedCount();
+
+private:
+	LDAPResultDispatcher(const LDAPResultDispatcher &);
+	LDAPResultDispatcher &operator=(const LDAPResultDispatcher &);
+
+	//! read one complete result, called without holding fMutex
+	int ReadResult(timeval *tvp, LDAPMessage **ldapResult);
+	//! remove forgotten message ids whose lifetime is over, called with fMutex held
+	void ExpireForgotten();
+
+	LDAP *fHandle;
+	//! protects fResults, fForgotten and fReading
+	SimpleMutex fMutex;
+	//! signaled whenever a result was filed or the reader role became free
+	SimpleCondition fResultArrived;
+	//! true while one of the waiters reads from the handle
+	bool fReading;
+	Anything fResults;
+	//! forgotten message ids in the order of their expiry
+	Anything fForgotten;
+};
+
+#endif
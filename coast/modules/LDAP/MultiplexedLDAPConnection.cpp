@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "MultiplexedLDAPConnection.h"
+#include "LDAPConnectionManager.h"
+#include "LDAPResultDispatcher.h"
+
+MultiplexedLDAPConnection::MultiplexedLDAPConnection(ROAnything connectionParams)
+	: PersistentLDAPConnection(connectionParams)
+	, fMaxPendingRequests(connectionParams["MultiplexedRequests"].AsLong(1L))
+	, fSlot(-1L)
+	, fDispatcher(0)
+{
+	StartTrace(MultiplexedLDAPConnection.MultiplexedLDAPConnection);
+}
+
+MultiplexedLDAPConnection::~MultiplexedLDAPConnection()
+{
+	StartTrace(MultiplexedLDAPConnection.~MultiplexedLDAPConnection);
+}
+
+LDAPConnection::EConnectState MultiplexedLDAPConnection::DoConnect(ROAnything bindParams, LDAPErrorHandler &eh)
+{
+	StartTrace(MultiplexedLDAPConnection.DoConnect);
+	fHandle = NULL;
+	fDispatcher = 0;
+	fPoolId = GetLdapPoolId(bindParams);
+	Anything returned = LDAPConnectionManager::LDAPCONNMGR()->GetSharedLdapConnection(GetMaxConnections(), fMaxPendingRequests, fPoolId, fRebindTimeout);
+	fSlot = returned["Slot"].AsLong(-1L);
+	if ( fSlot == -1L ) {
+		eh.HandleSessionError(fHandle, "Could not get a share of a pooled connection.");
+		return eNok;
+	}
+	if ( !returned["MustRebind"].AsBool(true) ) {
+		fHandle = (LDAP *) returned["Handle"].AsIFAObject(0);
+		fDispatcher = (LDAPResultDispatcher *) returned["Dispatcher"].AsIFAObject(0);
+		Trace("sharing " << DumpConnectionHandle(fHandle) << " at slot " << fSlot);
+		return eOk;
+	}
+	// nobody else uses the slot until SetSharedLdapConnection, bind without dispatcher
+	String bindName = bindParams["BindName"].AsString("");
+	String bindPW = bindParams["BindPW"].AsString("");
+	EConnectState eConnectState = eInitNok;
+	if ( (fHandle = Init(eh)) != NULL ) {
+		eConnectState = eSetOptionsNok;
+		if ( SetProtocol(eh) && SetConnectionTimeout(eh) && SetSearchTimeout(eh) && SetErrnoHandler(eh, true) ) {
+			eConnectState = eBindNok;
+			int msgId;
+			Anything result;
+			if ( Bind(bindName, bindPW, msgId, eh) && WaitForResult(msgId, result, eh) ) {
+				eConnectState = eRebindOk;
+			}
+		}
+	}
+	if ( !IsConnectOk(eConnectState) && fHandle != NULL ) {
+		Disconnect();
+		fHandle = NULL;
+	}
+	fDispatcher = LDAPConnectionManager::LDAPCONNMGR()->SetSharedLdapConnection(fPoolId, fSlot, fHandle);
+	Trace("eConnectState: " << ConnectRetToString(eConnectState) << " Handle: " << DumpConnectionHandle(fHandle));
+	return eConnectState;
+}
+
+int MultiplexedLDAPConnection::DoGetResult(int msgId, timeval *tvp, LDAPMessage **ldapResult)
+{
+	StartTrace(MultiplexedLDAPConnection.DoGetResult);
+	if ( fDispatcher == 0 ) {
+		// still binding, we are the only user
+		return LDAPConnection::DoGetResult(msgId, tvp, ldapResult);
+	}
+	int resultCode = fDispatcher->WaitForResult(msgId, tvp, ldapResult);
+	if ( resultCode <= 0 ) {
+		// the request gets abandoned, a late result must not pile up
+		fDispatcher->Forget(msgId);
+	}
+	return resultCode;
+}
+
+bool MultiplexedLDAPConnection::DoReleaseHandleInfo()
+{
+	StartTrace(MultiplexedLDAPConnection.DoReleaseHandleInfo);
+	bool ret = ( fSlot != -1L ) && LDAPConnectionManager::LDAPCONNMGR()->ReleaseSharedHandleInfo(fPoolId, fSlot);
+	fSlot = -1L;
+	fDispatcher = 0;
+	return ret;
+}
+
+void MultiplexedLDAPConnection::DoHandleBindFailure(LDAPErrorHandler &eh, String &errMsg)
+{
+	StartTrace(MultiplexedLDAPConnection.DoHandleBindFailure);
+	LDAPConnection::DoHandleBindFailure(eh, errMsg);
+}
+
+void MultiplexedLDAPConnection::DoHandleWaitForResultTimeout(LDAPErrorHandler &eh)
+{
+	StartTrace(MultiplexedLDAPConnection.DoHandleWaitForResultTimeout);
+}
+
+void MultiplexedLDAPConnection::DoHandleWait4ResultError(LDAPErrorHandler &eh)
+{
+	StartTrace(MultiplexedLDAPConnection.DoHandleWait4ResultError);
+	// other requests might still be pending on the handle, it gets replaced once it is unused
+	if ( fDispatcher != 0 ) {
+		LDAPConnectionManager::LDAPCONNMGR()->InvalidateSharedLdapConnection(fPoolId, fSlot);
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _MultiplexedLDAPConnection_H
+#define _MultiplexedLDAPConnection_H
+
+#include "PersistentLDAPConnection.h"
+
+class LDAPResultDispatcher;
+
+//---- MultiplexedLDAPConnection ----------------------------------------------------------
+//! Persistent LDAP connection shared by several request threads at the same time.
+/*!
+Instead of locking a pooled connection for the whole request, up to /MultiplexedRequests threads send their
+requests over the same connection and wait for their own message id only, see LDAPResultDispatcher.
+A connection is only rebound when none of its requests is pending anymore. A latency spike of the LDAP server
+therefore no longer blocks every request thread on the pool semaphore as long as the connections accept more requests.
+\par Configuration
+Same as PersistentLDAPConnection, additionally:
+\code
+{
+	/MultiplexedRequests	Maximum number of concurrent requests per connection. A value > 0 together with
+							/PooledConnections selects this connection type.
+}
+\endcode
+/TryAutoRebind is not evaluated since the retry would need exclusive access to the connection. A failing
+connection is marked and rebound by the next request finding it unused.
+*/
+class MultiplexedLDAPConnection: public PersistentLDAPConnection
+{
+public:
+	//! create a new multiplexed ldap connection
+	/*! \param connectionParams see PersistentLDAPConnection, additionally /MultiplexedRequests */
+	MultiplexedLDAPConnection(ROAnything connectionParams);
+	~MultiplexedLDAPConnection();
+
+protected:
+	//! Give back our share of the pooled connection
+	virtual bool DoReleaseHandleInfo();
+
+	//! report only, DoConnect disconnects a handle which could not be bound
+	virtual void DoHandleBindFailure(LDAPErrorHandler &eh, String &errMsg);
+
+	//! no retry on the shared connection, see class description
+	virtual void DoHandleWaitForResultTimeout(LDAPErrorHandler &eh);
+
+	//! mark the shared connection to be rebound once it is unused
+	virtual void DoHandleWait4ResultError(LDAPErrorHandler &eh);
+
+	//! get a share of a pooled connection, bind it if we are the first user
+	LDAPConnection::EConnectState DoConnect(ROAnything bindParams, LDAPErrorHandler &eh);
+
+	//! wait for our message id using the dispatcher of the shared connection
+	virtual int DoGetResult(int msgId, timeval *tvp, LDAPMessage **ldapResult);
+
+private:
+	long fMaxPendingRequests;
+	long fSlot;
+	LDAPResultDispatcher *fDispatcher;
+};
+
+#endif
@@ -98,6 +98,29 @@ int PersistentLDAPConnection::get_errno( void )
 	return( errno );
 }
 
+/* Functions guarding a handle used by several threads concurrently. */
+void *PersistentLDAPConnection::mutex_alloc( void )
+{
+	return new SimpleMutex("LDAPHandleMutex", coast::storage::Global());
+}
+
+void PersistentLDAPConnection::mutex_free( void *mutex )
+{
+	delete static_cast<SimpleMutex *>(mutex);
+}
+
+int PersistentLDAPConnection::mutex_lock( void *mutex )
+{
+	static_cast<SimpleMutex *>(mutex)->Lock();
+	return 0;
+}
+
+int PersistentLDAPConnection::mutex_unlock( void *mutex )
+{
+	static_cast<SimpleMutex *>(mutex)->Unlock();
+	return 0;
+}
+
 PersistentLDAPConnection::PersistentLDAPConnection(ROAnything connectionParams) : LDAPConnection(connectionParams)
 {
 	StartTrace(PersistentLDAPConnection.PersistentLDAPConnection);
@@ -120,7 +143,7 @@ int PersistentLDAPConnection::GetMaxConnections()
 	return fMaxConnections;
 }
 
-bool PersistentLDAPConnection::SetErrnoHandler(LDAPErrorHandler &eh)
+bool PersistentLDAPConnection::SetErrnoHandler(LDAPErrorHandler &eh, bool bSharedHandle)
 {
 	StartTrace(PersistentLDAPConnection.SetErrnoHandler);
 
@@ -134,6 +157,12 @@ bool PersistentLDAPConnection::SetErrnoHandler(LDAPErrorHandler &eh)
 	tfns.ltf_get_lderrno = get_ld_error;
 	tfns.ltf_set_lderrno = set_ld_error;
 	tfns.ltf_lderrno_arg = NULL;
+	if ( bSharedHandle ) {
+		tfns.ltf_mutex_alloc = mutex_alloc;
+		tfns.ltf_mutex_free = mutex_free;
+		tfns.ltf_mutex_lock = mutex_lock;
+		tfns.ltf_mutex_unlock = mutex_unlock;
+	}
 
 	/* Set up this session to use those function pointers. */
 	if ( ::ldap_set_option( fHandle, LDAP_OPT_THREAD_FN_PTRS, (void *) &tfns ) != LDAP_SUCCESS ) {
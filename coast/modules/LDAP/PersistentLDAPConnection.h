@@ -85,6 +85,20 @@ protected:
 	//! does the Connect and reports details what it has done.
 	LDAPConnection::EConnectState DoConnect(ROAnything bindParams, LDAPErrorHandler &eh);
 
+	//! Build the connection pool id used by LDAPConnectionManager
+	String GetLdapPoolId(ROAnything bindParams);
+
+	//! set errno handler because the ldap lib does not know whether threads are used or not. By calling
+	//! this wrapper functions to errno, at compile time the right (thread safe errno macro) is used.
+	//! \param bSharedHandle additionally install mutex functions, needed if several threads use the handle concurrently
+	bool SetErrnoHandler(LDAPErrorHandler &eh, bool bSharedHandle = false);
+
+	long 	fRebindTimeout;
+	String	fPoolId;
+	bool	fTryAutoRebind;
+	int		fMaxConnections;
+	int		fPooledConnections;
+
 private:
 	//! Function to set up thread-specific data.
 	static void tsd_setup();
@@ -96,12 +110,11 @@ private:
 	static void set_errno( int err );
 	//! Function for getting errno.
 	static int get_errno( void);
-
-	long 	fRebindTimeout;
-	String	fPoolId;
-	bool	fTryAutoRebind;
-	int		fMaxConnections;
-	int		fPooledConnections;
+	//! Functions guarding the internals of a shared handle.
+	static void *mutex_alloc( void );
+	static void mutex_free( void *mutex );
+	static int mutex_lock( void *mutex );
+	static int mutex_unlock( void *mutex );
 
 	/* Error structure. */
 	struct ldap_error_struct {
@@ -114,19 +127,12 @@ private:
 	//! Hook when using LDAPConnectionManager
 	LDAPConnection::EConnectState DoConnectHook(ROAnything bindParams, LDAPErrorHandler &eh);
 
-	//! Build the connection pool id used by LDAPConnectionManager
-	String GetLdapPoolId(ROAnything bindParams);
-
 	static String GetLdapPoolId(const String &server, long port, const String &bindName,
 								const String &bindPW, long connectionTimeout);
 
 	//! create a base64 armoured md5 hash
 	static String Base64ArmouredMD5Hash(const String &text);
 
-	//! set errno handler because the ldap lib does not know whether threads are used or not. By calling
-	//! this wrapper functions to errno, at compile time the right (thread safe errno macro) is used.
-	bool SetErrnoHandler(LDAPErrorHandler &eh);
-
 	//! These test classes acesse private methods of PersistentLDAPConnection
 	friend class LDAPConnectionManager;
 	friend class LDAPConnectionManagerTest;
@@ -170,6 +170,51 @@ void LDAPConnectionManagerTest::AutoRebindTest()
 	}
 }
 
+void LDAPConnectionManagerTest::SharedConnectionTest()
+{
+	StartTrace(LDAPConnectionManagerTest.SharedConnectionTest);
+	LDAPConnectionManager *mgr = LDAPConnectionManager::LDAPCONNMGR();
+	String poolId("SharedConnectionTestPool");
+	long maxConnections = 2L, maxPending = 2L;
+
+	// first users of unbound slots must bind them
+	Anything first = mgr->GetSharedLdapConnection(maxConnections, maxPending, poolId);
+	assertEqual(0L, first["Slot"].AsLong(-1L));
+	t_assert(first["MustRebind"].AsBool(false));
+	Anything second = mgr->GetSharedLdapConnection(maxConnections, maxPending, poolId);
+	assertEqual(1L, second["Slot"].AsLong(-1L));
+	t_assert(second["MustRebind"].AsBool(false));
+
+	LDAP *handle = ::ldap_init("localhost", 389);
+	t_assert(mgr->SetSharedLdapConnection(poolId, 0L, handle) != NULL);
+	// failed bind
+	t_assert(mgr->SetSharedLdapConnection(poolId, 1L, (LDAP *) NULL) == NULL);
+	t_assert(mgr->ReleaseSharedHandleInfo(poolId, 1L));
+
+	// the bound connection is shared until maxPending requests use it
+	Anything third = mgr->GetSharedLdapConnection(maxConnections, maxPending, poolId);
+	assertEqual(0L, third["Slot"].AsLong(-1L));
+	t_assert(!third["MustRebind"].AsBool(true));
+	t_assert(handle == (LDAP *) third["Handle"].AsIFAObject(0));
+	t_assert(third["Dispatcher"].AsIFAObject(0) != 0);
+	Anything fourth = mgr->GetSharedLdapConnection(maxConnections, maxPending, poolId);
+	assertEqual(1L, fourth["Slot"].AsLong(-1L));
+	t_assert(fourth["MustRebind"].AsBool(false));
+	mgr->SetSharedLdapConnection(poolId, 1L, (LDAP *) NULL);
+	t_assert(mgr->ReleaseSharedHandleInfo(poolId, 1L));
+
+	// an invalidated connection is rebound once nobody uses it anymore
+	mgr->InvalidateSharedLdapConnection(poolId, 0L);
+	t_assert(mgr->ReleaseSharedHandleInfo(poolId, 0L));
+	t_assert(mgr->ReleaseSharedHandleInfo(poolId, 0L));
+	t_assert(!mgr->ReleaseSharedHandleInfo(poolId, 0L));
+	Anything fifth = mgr->GetSharedLdapConnection(maxConnections, maxPending, poolId);
+	assertEqual(0L, fifth["Slot"].AsLong(-1L));
+	t_assert(fifth["MustRebind"].AsBool(false));
+	mgr->SetSharedLdapConnection(poolId, 0L, (LDAP *) NULL);
+	t_assert(mgr->ReleaseSharedHandleInfo(poolId, 0L));
+}
+
 Anything LDAPConnectionManagerTest::getConnectionParams(ParameterMapper* pGetter) {
 	Context ctx;
 	Anything params;
@@ -195,6 +240,7 @@ Test *LDAPConnectionManagerTest::suite ()
 	ADD_CASE(testSuite, LDAPConnectionManagerTest, ConnectionManagerTest);
 	ADD_CASE(testSuite, LDAPConnectionManagerTest, AutoRebindTest);
 	ADD_CASE(testSuite, LDAPConnectionManagerTest, NoAutoRebindTest);
+	ADD_CASE(testSuite, LDAPConnectionManagerTest, SharedConnectionTest);
 
 	return testSuite;
 }
@@ -36,6 +36,8 @@ public:
 	void ConnectionManagerTest();
 	void AutoRebindTest();
 	void NoAutoRebindTest();
+	//! slot assignment of connections shared by several requests
+	void SharedConnectionTest();
 
 private:
 	LDAP *CreateBadConnectionHandle(const String &name, String &badConnectionPoolId, long &maxBadConnections);
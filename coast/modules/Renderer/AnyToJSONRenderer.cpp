@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "AnyToJSONRenderer.h"
+#include "JSONParser.h"
+#include "Tracer.h"
+
+//---- AnyToJSONRenderer ---------------------------------------------------------
+RegisterRenderer(AnyToJSONRenderer);
+
+void AnyToJSONRenderer::RenderAll(std::ostream &reply, Context &c, const ROAnything &config)
+{
+	StartTrace(AnyToJSONRenderer.RenderAll);
+	TraceAny(config, "config");
+
+	ROAnything inputInfo;
+	if (! config.LookupPath(inputInfo, "Input")) {
+		return;
+	}
+	String inputAnyName;
+	RenderOnString(inputAnyName, c, inputInfo);
+
+	ROAnything input;
+	if ( c.Lookup(inputAnyName, input) ) {
+		JSONPrinter::PrintOn(reply, input, config["Pretty"].AsBool(false));
+	}
+}
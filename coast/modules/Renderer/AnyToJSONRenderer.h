@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _AnyToJSONRenderer_H
+#define _AnyToJSONRenderer_H
+
+#include "Renderer.h"
+
+//---- AnyToJSONRenderer -----------------------------------------------------------
+//! Renders an Anything as JSON
+/*!
+\par Configuration
+\code
+{
+	/Input	Rendererspec	mandatory, produces a lookup string used to lookup the Anything that serves as Input
+	/Pretty	long			optional, default 0, write members and elements indented on lines of their own
+}
+\endcode
+The mapping of Anything to JSON is described at JSONPrinter. Nothing is rendered if the Input is not found.
+*/
+class AnyToJSONRenderer : public Renderer
+{
+public:
+	//! basic constructor
+	//! \param name	Name of class to register
+	AnyToJSONRenderer(const char *name) : Renderer(name) {}
+
+	//! The well known Renderer main method
+	virtual void RenderAll(std::ostream &reply, Context &c, const ROAnything &config);
+};
+
+#endif
@@ -227,11 +227,11 @@ void SelectBoxRenderer::RenderAll(std::ostream &reply, Context &context, const R
 			}
 
 			if ( strListName.Length() ) {
-				RenderOptionList(reply, context, config, strListName);
+				RenderOptionList(reply, context, config, strListName, true);
 			} else {
 				strListName = "SelectBoxData";
 				Context::PushPopEntry<ROAnything> aEntryData(context, strListName, roaListData, strListName);
-				RenderOptionList(reply, context, config, strListName);
+				RenderOptionList(reply, context, config, strListName, true);
 			}
 
 			if ( strAppendListName.Length() ) {
@@ -248,7 +248,7 @@ void SelectBoxRenderer::RenderAll(std::ostream &reply, Context &context, const R
 	}
 }
 
-void SelectBoxRenderer::RenderOptionList(std::ostream &reply, Context &context, const ROAnything &config, String listname)
+void SelectBoxRenderer::RenderOptionList(std::ostream &reply, Context &context, const ROAnything &config, String listname, bool bUseRange)
 {
 	StartTrace(SelectBoxRenderer.RenderOptionList);
 	TraceAny(config, "config");
@@ -283,6 +283,12 @@ void SelectBoxRenderer::RenderOptionList(std::ostream &reply, Context &context,
 		if ( config.LookupPath(value, "Options.class") ) {
 			rendererConfig["Options"]["class"] = value.DeepClone();
 		}
+		if ( bUseRange && config.LookupPath(value, "Start") ) {
+			rendererConfig["Start"] = value.DeepClone();
+		}
+		if ( bUseRange && config.LookupPath(value, "End") ) {
+			rendererConfig["End"] = value.DeepClone();
+		}
 		TraceAny(rendererConfig, "OptionListRenderer Config");
 		pRenderer->RenderAll(reply, context, rendererConfig);
 	}
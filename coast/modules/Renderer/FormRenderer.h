@@ -118,6 +118,8 @@ protected:
 		...
 		...
 	}
+	/Start					Rendererspec	optional, default 0, index (zero based) of the first ListName/ListData entry to render, not applied to the prepended and appended lists
+	/End					Rendererspec	optional, default size of list, index (zero based) of the last ListName/ListData entry to render, not applied to the prepended and appended lists
 	/Options 			{...}			optional, An array of Key-Value pairs that allows to render any HTML option within the SELECT tag. Refer to OptionsPrinter for further description
 }
 \endcode
@@ -188,8 +190,8 @@ protected:
 	virtual void RenderType(std::ostream &, Context &, const ROAnything &) { }
 	// Renderers SELECT Tag attributes
 	virtual void RenderOptions(std::ostream &reply, Context &context, const ROAnything &config);
-	// Renderes the <OPTION> list using a ListRenderer
-	virtual void RenderOptionList(std::ostream &reply, Context &context, const ROAnything &config, String listname);
+	// Renderes the <OPTION> list using a ListRenderer, bUseRange passes /Start and /End on to it
+	virtual void RenderOptionList(std::ostream &reply, Context &context, const ROAnything &config, String listname, bool bUseRange = false);
 	virtual bool IsMultipleSelect(Context &context, const ROAnything &config);
 };
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+#include "FragmentCacheRenderer.h"
+#include "Threads.h"
+#include "StringStream.h"
+#include "singleton.hpp"
+#include <ctime>
+RegisterRenderer(FragmentCacheRenderer);
+
+namespace {
+	const long cMaxFragments = 4096L;
+
+	class FragmentCache {
+		Anything fEntries;
+		SimpleMutex fMutex;
+	public:
+		FragmentCache() : fEntries(Anything::ArrayMarker(), coast::storage::Global()), fMutex("FragmentCache", coast::storage::Global()) {
+		}
+		bool Lookup(const String &strKey, String &strOutput) {
+			LockUnlockEntry me(fMutex);
+			if ( !fEntries.IsDefined(strKey) ) {
+				return false;
+			}
+			ROAnything roaEntry = ROAnything(fEntries)[strKey];
+			if ( roaEntry["Expires"].AsLong(0L) <= (long)time(0) ) {
+				return false;
+			}
+			strOutput = roaEntry["Output"].AsString();
+			return true;
+		}
+		void Store(const String &strKey, const String &strOutput, long lTTL) {
+			LockUnlockEntry me(fMutex);
+			if ( fEntries.GetSize() >= cMaxFragments && !fEntries.IsDefined(strKey) ) {
+				long lNow = (long)time(0);
+				for (long i = fEntries.GetSize() - 1L; i >= 0L; --i) {
+					if ( fEntries[i]["Expires"].AsLong(0L) <= lNow ) {
+						fEntries.Remove(i);
+					}
+				}
+				if ( fEntries.GetSize() >= cMaxFragments ) {
+					fEntries = Anything(Anything::ArrayMarker(), coast::storage::Global());
+				}
+			}
+			Anything anyEntry(Anything::ArrayMarker(), coast::storage::Global());
+			anyEntry["Output"] = strOutput;
+			anyEntry["Expires"] = (long)time(0) + lTTL;
+			fEntries[strKey] = anyEntry;
+		}
+		void Flush() {
+			LockUnlockEntry me(fMutex);
+			fEntries = Anything(Anything::ArrayMarker(), coast::storage::Global());
+		}
+	};
+	typedef coast::utility::singleton_default<FragmentCache> FragmentCacheSingleton;
+}
+
+void FragmentCacheRenderer::RenderAll(std::ostream &reply, Context &ctx, const ROAnything &config) {
+	StartTrace(FragmentCacheRenderer.RenderAll);
+	TraceAny(config, "config");
+	String strKey = config["Name"].AsString();
+	if ( strKey.Length() == 0 ) {
+		SystemLog::Error("FragmentCacheRenderer::RenderAll: /Name is not defined, fragment is not cached");
+		Render(reply, ctx, config["Renderer"]);
+		return;
+	}
+	ROAnything roaInputs = config["Inputs"];
+	for (long i = 0, sz = roaInputs.GetSize(); i < sz; ++i) {
+		// values are separated so that different splits of the same characters do not match
+		strKey.Append('\x1f');
+		ROAnything roaValue;
+		if ( ctx.Lookup(roaInputs[i].AsString(), roaValue) ) {
+			if ( roaValue.GetType() == AnyArrayType ) {
+				OStringStream os(strKey);
+				roaValue.PrintOn(os, false);
+			} else {
+				strKey.Append(roaValue.AsString());
+			}
+		}
+	}
+	String strOutput;
+	if ( FragmentCacheSingleton::instance().Lookup(strKey, strOutput) ) {
+		Trace("reusing output of [" << config["Name"].AsString() << "]");
+	} else {
+		RenderOnString(strOutput, ctx, config["Renderer"]);
+		FragmentCacheSingleton::instance().Store(strKey, strOutput, config["TTL"].AsLong(60L));
+	}
+	reply << strOutput;
+}
+
+void FragmentCacheRenderer::Flush() {
+	FragmentCacheSingleton::instance().Flush();
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _FragmentCacheRenderer_H
+#define _FragmentCacheRenderer_H
+
+#include "Renderer.h"
+
+//! Renders a fragment once per combination of its declared context inputs and reuses the output for a while
+/*! @section FragmentCacheRendererDescription FragmentCacheRenderer Description
+ * The output of /Renderer is kept together with /Name and the values /Inputs lookup in the context. As long as
+ * the output is younger than /TTL seconds, it is written again instead of being rendered.
+ * The output is shared between all requests and sessions. Mark only fragments cacheable whose output depends on
+ * nothing but the declared inputs.
+ * At most 4096 fragments are kept. If more are rendered, the expired ones are dropped, or all of them if none expired.
+ * @subsection FragmentCacheRendererConfiguration FragmentCacheRenderer Configuration
+\code
+{
+	/Name		String			mandatory, identifies the fragment, different fragments must not share a name
+	/Inputs {	Anything		optional, context lookup paths whose values the output depends on
+		"Path.To.Input"
+		...
+	}
+	/TTL		long			optional, default 60, number of seconds the output gets reused
+	/Renderer	Rendererspec	mandatory, the fragment to render
+}
+\endcode
+ * @subsection FragmentCacheRendererExample FragmentCacheRenderer Example
+\code
+/FragmentCacheRenderer {
+	/Name		NavigationBar
+	/Inputs		{ "Language" "RoleName" }
+	/TTL		300
+	/Renderer	{ /ContextLookupRenderer NavigationBarLayout }
+}
+\endcode
+ * The navigation bar is rendered once per language and role every five minutes.
+*/
+class FragmentCacheRenderer: public Renderer {
+public:
+	/*! @copydoc RegisterableObject::RegisterableObject(const char *) */
+	FragmentCacheRenderer(const char *name) :
+		Renderer(name) {
+	}
+	//! Renders the fragment or writes the output kept from before
+	/*! @copydetails Renderer::RenderAll(std::ostream &, Context &, const ROAnything &) */
+	virtual void RenderAll(std::ostream &reply, Context &ctx, const ROAnything &config);
+
+	//! forget the output of all fragments
+	static void Flush();
+};
+
+#endif
@@ -10,10 +10,42 @@
 #include "SystemFile.h"
 #include "TemplateParser.h"
 #include "HTMLTemplateRenderer.h"
+#include "TaskGraph.h"
 
 using namespace coast;
 RegisterModule(TemplatesCacheModule );
 
+namespace {
+	//! parses one html-file with its own parser, the TaskGraph might run several of them at the same time
+	class TemplateParseTask: public TaskGraph::Task {
+	public:
+		TemplateParseTask(const char *fileKey, const ROAnything config)
+			: fFileKey(fileKey, -1, coast::storage::Global()), fConfig(config), fCache(coast::storage::Global()) {
+		}
+		virtual bool Run() {
+			TemplateParser tp;
+			HTMLTemplateCacheLoader htcl(&tp, fConfig);
+			fCache = htcl.Load(fFileKey);
+			return true;
+		}
+		String fFileKey;
+		ROAnything fConfig;
+		Anything fCache;
+	};
+
+	//! hands an already parsed html-file to the CacheHandler
+	class ParsedTemplateLoader: public CacheLoadPolicy {
+		Anything fCache;
+	public:
+		ParsedTemplateLoader(const Anything &cache) :
+			fCache(cache) {
+		}
+		virtual Anything Load(const char *) {
+			return fCache;
+		}
+	};
+}
+
 bool TemplatesCacheModule::Init(const ROAnything config) {
 	StartTrace(TemplatesCacheModule.Init);
 	TraceAny(config["HTMLTemplateConfig"], "my config");
@@ -66,16 +98,14 @@ void HTMLTemplateCacheBuilder::BuildCache(const ROAnything config) {
 	String filepath;
 	String templateDir;
 	Anything fileNameMap(coast::storage::Global());
-
-	TemplateParser tp;
-	HTMLTemplateCacheLoader htcl(&tp, config);
+	Anything toParse(Anything::ArrayMarker(), coast::storage::Global());
 
 	while (st.NextToken(templateDir)) {
 		// cache templates of template dir
 		filepath = rootDir;
 		filepath << system::Sep() << templateDir;
 		system::ResolvePath(filepath);
-		CacheDir(filepath, &htcl, langDirMap, fileNameMap);
+		CacheDir(filepath, langDirMap, fileNameMap, toParse);
 
 		// search over localized dirs
 		for (long j = 0, sz = langDirMap.GetSize(); j < sz; ++j) {
@@ -87,9 +117,10 @@ void HTMLTemplateCacheBuilder::BuildCache(const ROAnything config) {
 			filepath << system::Sep() << langDirMap[j].AsCharPtr("");
 			system::ResolvePath(filepath);
 
-			CacheDir(filepath, &htcl, langDirMap.SlotName(j), fileNameMap);
+			CacheDir(filepath, langDirMap.SlotName(j), fileNameMap, toParse);
 		}
 	}
+	ParseFiles(config, toParse);
 	TraceAny(fileNameMap, "FileNameMap after caching pages");
 
 	// install the mapping from file names to absolute pathnames in the cache
@@ -99,8 +130,8 @@ void HTMLTemplateCacheBuilder::BuildCache(const ROAnything config) {
 	SystemLog::WriteToStderr(" done\n");
 }
 
-void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, CacheLoadPolicy *htcl, const ROAnything langDirMap,
-		Anything &fileNameMap) {
+void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, const ROAnything langDirMap, Anything &fileNameMap,
+		Anything &toParse) {
 	StartTrace1(HTMLTemplateCacheBuilder.CacheDir, "cache-path [" << filepath << "]");
 	// get all files of this directory
 	Anything fileList = system::DirFileList(filepath, "html");
@@ -112,8 +143,10 @@ void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, CacheLoadPolicy *h
 		fileKey << filepath << system::Sep() << file;
 		// smothen path not to load relative-path files more than once
 		system::ResolvePath(fileKey);
-		// ignore results, they are stored in the cachehandler anyway
-		CacheHandler::instance().Load("HTML", fileKey, htcl);
+		// parsed later, results are stored in the cachehandler
+		if ( CacheHandler::instance().Get("HTML", fileKey).IsNull() ) {
+			toParse[fileKey] = true;
+		}
 		// store away the name,langKey to fileKey mapping
 		for (long j = 0, szl = langDirMap.GetSize(); j < szl; ++j) {
 			const char *langKey = langDirMap.SlotName(j);
@@ -121,12 +154,11 @@ void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, CacheLoadPolicy *h
 		}
 		// reset the filekey
 		fileKey = "";
-		SystemLog::WriteToStderr(".", 1);
 	}
 }
 
-void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, CacheLoadPolicy *htcl, const char *langKey,
-		Anything &fileNameMap) {
+void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, const char *langKey, Anything &fileNameMap,
+		Anything &toParse) {
 	StartTrace1(HTMLTemplateCacheBuilder.CacheDir, "cache-path [" << filepath << "]");
 	// get all files of this directory
 	Anything fileList = system::DirFileList(filepath, "html");
@@ -138,12 +170,32 @@ void HTMLTemplateCacheBuilder::CacheDir(const char *filepath, CacheLoadPolicy *h
 		fileKey << filepath << system::Sep() << file;
 		// smothen path not to load relative-path files more than once
 		system::ResolvePath(fileKey);
-		// ignore results, they are stored in the cachehandler anyway
-		CacheHandler::instance().Load("HTML", fileKey, htcl);
+		// parsed later, results are stored in the cachehandler
+		if ( CacheHandler::instance().Get("HTML", fileKey).IsNull() ) {
+			toParse[fileKey] = true;
+		}
 		// store away the name,langKey to fileKey mapping
 		fileNameMap[file][langKey] = fileKey;
 		// reset the filekey
 		fileKey = "";
+	}
+}
+
+void HTMLTemplateCacheBuilder::ParseFiles(const ROAnything config, const ROAnything toParse) {
+	StartTrace1(HTMLTemplateCacheBuilder.ParseFiles, "files: " << toParse.GetSize());
+	long lThreads = config["CacheThreads"].AsLong(1L);
+	TaskGraph graph("HTMLTemplateCache", lThreads);
+	std::vector<TemplateParseTask *> tasks;
+	for (long i = 0, sz = toParse.GetSize(); i < sz; ++i) {
+		tasks.push_back(new TemplateParseTask(toParse.SlotName(i), config));
+		graph.AddTask(tasks.back());
+	}
+	graph.Run();
+	for (std::vector<TemplateParseTask *>::iterator aIt = tasks.begin(); aIt != tasks.end(); ++aIt) {
+		ParsedTemplateLoader ptl((*aIt)->fCache);
+		// ignore results, they are stored in the cachehandler anyway
+		CacheHandler::instance().Load("HTML", (*aIt)->fFileKey, &ptl);
+		delete *aIt;
 		SystemLog::WriteToStderr(".", 1);
 	}
 }
@@ -42,6 +42,7 @@ public:
 	/ParserConfig {					optional, global TemplateParser options, see TemplateParser for available options
 		...
 	}
+	/CacheThreads		long		optional, default 1, number of html-files parsed at the same time
 }</PRE>
 example configuration of Config.any
 <PRE>
@@ -82,9 +83,13 @@ public:
 };
 
 //! Worker class to load the html-files using the given CacheHandler and CacheLoadPolicy
+/*! The files of all directories are collected first and then parsed on /CacheThreads threads, each one using its
+	own TemplateParser. */
 class HTMLTemplateCacheBuilder {
-	void CacheDir(const char *filepath, CacheLoadPolicy *htcl, const ROAnything langDirMap, Anything &fileNameMap);
-	void CacheDir(const char *filepath, CacheLoadPolicy *htcl, const char *langDir, Anything &fileNameMap);
+	void CacheDir(const char *filepath, const ROAnything langDirMap, Anything &fileNameMap, Anything &toParse);
+	void CacheDir(const char *filepath, const char *langDir, Anything &fileNameMap, Anything &toParse);
+	//! parse the files not cached yet and put them into the CacheHandler
+	void ParseFiles(const ROAnything config, const ROAnything toParse);
 public:
 	void BuildCache(const ROAnything config);
 };
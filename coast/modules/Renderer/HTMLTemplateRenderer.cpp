@@ -17,7 +17,15 @@ RegisterRenderer(HTMLTemplateRenderer);
 ROAnything HTMLTemplateRenderer::fgTemplates;
 ROAnything HTMLTemplateRenderer::fgNameMap;
 
-HTMLTemplateRenderer::HTMLTemplateRenderer(const char *name) : Renderer(name)
+namespace {
+	//! inline templates parsed once per renderer, further templates are parsed on every use
+	const long cMaxInlineTemplates = 1024L;
+}
+
+HTMLTemplateRenderer::HTMLTemplateRenderer(const char *name)
+	: Renderer(name)
+	, fInlineTemplates(coast::storage::Global())
+	, fInlineTemplatesMutex("HTMLTemplateRendererInlineTemplates", coast::storage::Global())
 {
 }
 void HTMLTemplateRenderer::BuildCache(const ROAnything config)
@@ -31,6 +39,36 @@ void HTMLTemplateRenderer::BuildCache(const ROAnything config)
 	TraceAny(fgNameMap, "Cache Map");
 }
 
+ROAnything HTMLTemplateRenderer::ParseInlineTemplate(const String &strTemplate, const ROAnything roaParserConfig, Anything &anyParsed)
+{
+	StartTrace(HTMLTemplateRenderer.ParseInlineTemplate);
+	String strKey;
+	if ( !roaParserConfig.IsNull() ) {
+		OStringStream os(strKey);
+		roaParserConfig.PrintOn(os, false);
+	}
+	strKey.Append(strTemplate);
+	{
+		LockUnlockEntry me(fInlineTemplatesMutex);
+		if ( fInlineTemplates.IsDefined(strKey) ) {
+			// entries are never removed, the parsed template stays valid after unlocking
+			return ROAnything(fInlineTemplates)[strKey];
+		}
+	}
+	IStringStream reader(strTemplate);
+	TemplateParser *tp = GetParser();
+	anyParsed = tp->Parse(reader, "from config", 1L, anyParsed.GetAllocator(), roaParserConfig);
+	delete tp;
+	LockUnlockEntry me(fInlineTemplatesMutex);
+	if ( !fInlineTemplates.IsDefined(strKey) && fInlineTemplates.GetSize() < cMaxInlineTemplates ) {
+		fInlineTemplates[strKey] = anyParsed;
+	}
+	if ( fInlineTemplates.IsDefined(strKey) ) {
+		return ROAnything(fInlineTemplates)[strKey];
+	}
+	return anyParsed;
+}
+
 TemplateParser *HTMLTemplateRenderer::GetParser()
 {
 	return new TemplateParser;
@@ -102,12 +140,7 @@ void HTMLTemplateRenderer::RenderAll(std::ostream &reply, Context &context, cons
 				buf.Append(templ[i].AsCharPtr());
 			}
 		}
-		IStringStream reader(buf);
-		TemplateParser *tp = GetParser();
-		rendererConfig = tp->Parse(reader, "from config", 1L, rendererConfig.GetAllocator(), roaParserConfig);
-		delete tp;
-		theRendererConfig = rendererConfig;
-
+		theRendererConfig = ParseInlineTemplate(buf, roaParserConfig, rendererConfig);
 	}
 	Render(reply, context, theRendererConfig);
 }
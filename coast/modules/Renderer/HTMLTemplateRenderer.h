@@ -10,6 +10,7 @@
 #define _HTMLTEMPLATERENDERER_H
 
 #include "Renderer.h"
+#include "Threads.h"
 
 //---- HTMLTemplateRenderer ----------------------------------------------------
 //! Uses HTML, file or inline, as input to render a page
@@ -67,8 +68,8 @@ Note that HTMLTemplateRenderer manages a cache for all files/templates that
 were not specified inline. The cache is built at server-startup time by
 processing all files of the given HTML template directory hierarchy.
 These templates are interpreted only once and are then stored in the cache in a
-preprocessed intermediate format. (This improves performance as compared to
-templates that are defined inline.)
+preprocessed intermediate format, adjacent literal HTML is joined into a single
+block. Templates defined inline are parsed on first use and kept per renderer.
 
 HTMLTemplateRenderer uses the SystemLog mechanism to record error conditions!
 */
@@ -83,6 +84,15 @@ public:
 	virtual class TemplateParser *GetParser();
 
 private:
+	//! parse strTemplate or take it from the inline templates parsed before
+	/*! \param anyParsed holds the parsed template if it could not be kept
+		\return parsed template to render */
+	ROAnything ParseInlineTemplate(const String &strTemplate, const ROAnything roaParserConfig, Anything &anyParsed);
+
+	//! parsed inline templates, keyed by parser config and template text
+	Anything fInlineTemplates;
+	SimpleMutex fInlineTemplatesMutex;
+
 	static ROAnything fgTemplates;
 	static ROAnything fgNameMap;
 	friend class HTMLCacheLoaderTest;
@@ -8,7 +8,6 @@
 
 #include "ListRenderer.h"
 #include "Tracer.h"
-#include "AnyIterators.h"
 
 static String ENRTY_STORE_NAME_DEFAULT("EntryData", -1, coast::storage::Global());
 //---- ListRenderer ---------------------------------------------------------
@@ -89,24 +88,19 @@ void ListRenderer::RenderAll(std::ostream &reply, Context &ctx, const ROAnything
 		anyRenderState["Start"] = start;
 		anyRenderState["End"] = end;
 
-		// render entries
-		ROAnything roaEntry;
-		AnyExtensions::Iterator<ROAnything, ROAnything, String> aIterator(roaList);
-		while ( aIterator.Next(roaEntry) ) {
-			long i = aIterator.Index();
+		// render entries, index directly into the list to skip the entries before start
+		for ( long i = start; i < lListSize && i <= end; ++i ) {
+			ROAnything roaEntry = roaList[i];
 			SubTraceAny(TraceEntry, roaEntry, "data at index: " << i);
-			if ( i < start ) {
-				continue;
-			} else if ( i > end ) {
-				break;
-			}
 			// prepare data for rendering
 			// special case of PushPopEntry, last param specifies the segment which we simulate to start with
 			Context::PushPopEntry<ROAnything> aEntryData(ctx, entryStoreName, roaEntry, entryStoreName);
 			Anything anyAdditionalInfo;
 			anyAdditionalInfo[strIndexSlot] = ( i - start );
 
-			if ( aIterator.SlotName(strSlotName) ) {
+			const char *pcSlotName = roaList.SlotName(i);
+			if ( pcSlotName != NULL ) {
+				strSlotName = pcSlotName;
 				anyAdditionalInfo[strSlotNameSlot] = strSlotName;
 			}
 			Context::PushPopEntry<Anything> aEntryDataInfo(ctx, "EntryDataInfo", anyAdditionalInfo);
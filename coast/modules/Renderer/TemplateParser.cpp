@@ -330,26 +330,40 @@ void TemplateParser::CompactHTMLBlocks(Anything &cache)
 {
 	StartTrace(TemplateParser.CompactHTMLBlocks);
 	TraceAny(cache, "Cache:");
-	Anything a(cache.GetAllocator());
 	Anything compactedCache(cache.GetAllocator());
 	String htmlBlock;
-	for (long i = 0, sz = cache.GetSize(); i < sz; ++i) {
-		a = cache[i];
-		if (a.GetType() == AnyCharPtrType) {
+	CompactInto(compactedCache, htmlBlock, cache);
+	if ( htmlBlock.Length() > 0) {
+		StoreInto( compactedCache, htmlBlock );
+	}
+
+	TraceAny(compactedCache, "Compacted:");
+	cache = compactedCache;
+}
+
+void TemplateParser::CompactInto(Anything &compactedCache, String &htmlBlock, Anything &specs)
+{
+	for (long i = 0, sz = specs.GetSize(); i < sz; ++i) {
+		Anything a(compactedCache.GetAllocator());
+		a = specs[i];
+		const char *slotname = specs.SlotName(i);
+		if ( slotname ) {
+			// renderer in a sequence, keep it apart so its neighbours can join the surrounding literals
+			StoreInto( compactedCache, htmlBlock );
+			Anything spec(compactedCache.GetAllocator());
+			spec[slotname] = a;
+			compactedCache.Append(spec);
+		} else if (a.GetType() == AnyCharPtrType) {
 			htmlBlock.Append(a.AsCharPtr(""));
+		} else if ( a.GetType() == AnyArrayType && a.GetSize() > 0 && !a.IsDefined("Type") && !a.SlotName(0L) ) {
+			// sequence starting with a literal like a tag rendered with OptionsPrinter, splice it
+			CompactInto(compactedCache, htmlBlock, a);
 		} else {
 			// otherwise it is a renderer spec in an AnyArray
 			StoreInto( compactedCache, htmlBlock );
-			htmlBlock = "";
 			compactedCache.Append(a);
 		}
 	}
-	if ( htmlBlock.Length() > 0) {
-		StoreInto( compactedCache, htmlBlock );
-	}
-
-	TraceAny(compactedCache, "Compacted:");
-	cache = compactedCache;
 }
 
 void TemplateParser::SkipWhitespace()
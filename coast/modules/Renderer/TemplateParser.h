@@ -60,7 +60,9 @@ protected:
 	virtual void Store(String &htmlBlock);
 	void StoreInto(Anything &cache, String &htmlBlock);
 	virtual void Store(const Anything &args);
+	//! join adjacent literals into one block, sequences are spliced so their literals join the surrounding ones
 	void CompactHTMLBlocks(Anything &cache);
+	void CompactInto(Anything &compactedCache, String &htmlBlock, Anything &specs);
 
 	String ParseName();
 	String ParseUpToWhitespaceOrMacroEnd();
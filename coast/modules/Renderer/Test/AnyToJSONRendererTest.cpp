@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "AnyToJSONRendererTest.h"
+#include "TestSuite.h"
+#include "AnyToJSONRenderer.h"
+#include "Tracer.h"
+
+AnyToJSONRendererTest::AnyToJSONRendererTest(TString tstrName) : RendererTest(tstrName)
+{
+	StartTrace(AnyToJSONRendererTest.Ctor);
+}
+
+String AnyToJSONRendererTest::Render(const ROAnything &config)
+{
+	AnyToJSONRenderer r("AnyToJSONRenderer");
+	String strResult;
+	{
+		OStringStream os(strResult);
+		r.RenderAll(os, fContext, config);
+	}
+	return strResult;
+}
+
+void AnyToJSONRendererTest::RenderTest()
+{
+	StartTrace(AnyToJSONRendererTest.RenderTest);
+	Anything data;
+	data["Name"] = "Peter \"P\"";
+	data["Age"] = 42L;
+	data["Tags"].Append("a");
+	data["Tags"].Append(1.5);
+	data["Empty"] = Anything(Anything::ArrayMarker());
+	fContext.GetTmpStore()["Data"] = data;
+	fContext.GetTmpStore()["Which"] = "Data";
+
+	Anything config;
+	config["Input"] = "Data";
+	assertCharPtrEqual("{\"Name\":\"Peter \\\"P\\\"\",\"Age\":42,\"Tags\":[\"a\",1.5],\"Empty\":[]}", Render(config));
+	config["Input"] = "Data.Tags";
+	assertCharPtrEqual("[\"a\",1.5]", Render(config));
+	config["Input"] = "Data.Age";
+	assertCharPtrEqual("42", Render(config));
+	config["Input"] = Anything();
+	config["Input"]["ContextLookupRenderer"] = "Which";
+	assertCharPtrEqual("{\"Name\":\"Peter \\\"P\\\"\",\"Age\":42,\"Tags\":[\"a\",1.5],\"Empty\":[]}", Render(config));
+}
+
+void AnyToJSONRendererTest::PrettyTest()
+{
+	StartTrace(AnyToJSONRendererTest.PrettyTest);
+	Anything data;
+	data["Name"] = "Peter";
+	data["Tags"].Append(1L);
+	data["Tags"].Append(2L);
+	fContext.GetTmpStore()["Data"] = data;
+
+	Anything config;
+	config["Input"] = "Data";
+	config["Pretty"] = 1L;
+	assertCharPtrEqual("{\n  \"Name\": \"Peter\",\n  \"Tags\": [\n    1,\n    2\n  ]\n}", Render(config));
+}
+
+void AnyToJSONRendererTest::MissingInputTest()
+{
+	StartTrace(AnyToJSONRendererTest.MissingInputTest);
+	Anything config;
+	assertCharPtrEqual("", Render(config));
+	config["Input"] = "NotThere";
+	assertCharPtrEqual("", Render(config));
+}
+
+Test *AnyToJSONRendererTest::suite ()
+{
+	StartTrace(AnyToJSONRendererTest.suite);
+	TestSuite *testSuite = new TestSuite;
+
+	ADD_CASE(testSuite, AnyToJSONRendererTest, RenderTest);
+	ADD_CASE(testSuite, AnyToJSONRendererTest, PrettyTest);
+	ADD_CASE(testSuite, AnyToJSONRendererTest, MissingInputTest);
+
+	return testSuite;
+}
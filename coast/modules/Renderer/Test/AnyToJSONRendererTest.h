@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _AnyToJSONRendererTest_H
+#define _AnyToJSONRendererTest_H
+
+#include "RendererTest.h"
+
+//! tests rendering of context content as JSON
+class AnyToJSONRendererTest : public RendererTest
+{
+public:
+	AnyToJSONRendererTest(TString tstrName);
+
+	static Test *suite ();
+
+	//! objects, arrays and simple values
+	void RenderTest();
+	//! indented output
+	void PrettyTest();
+	//! nothing is rendered for unknown input or missing config
+	void MissingInputTest();
+
+private:
+	String Render(const ROAnything &config);
+};
+
+#endif
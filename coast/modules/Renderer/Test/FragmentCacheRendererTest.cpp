@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "FragmentCacheRendererTest.h"
+#include "TestSuite.h"
+#include "FragmentCacheRenderer.h"
+#include "Tracer.h"
+
+FragmentCacheRendererTest::FragmentCacheRendererTest(TString tstrName) : RendererTest(tstrName)
+{
+	StartTrace(FragmentCacheRendererTest.Ctor);
+}
+
+void FragmentCacheRendererTest::setUp()
+{
+	RendererTest::setUp();
+	FragmentCacheRenderer::Flush();
+}
+
+String FragmentCacheRendererTest::RenderFragment(long lTTL, const char *pcName)
+{
+	FragmentCacheRenderer r("FragmentCacheRenderer");
+	Anything config;
+	if ( pcName ) {
+		config["Name"] = pcName;
+	}
+	config["Inputs"].Append("Who");
+	config["TTL"] = lTTL;
+	config["Renderer"]["ContextLookupRenderer"]["LookupName"] = "Count";
+	String strResult;
+	{
+		OStringStream os(strResult);
+		r.RenderAll(os, fContext, config);
+	}
+	return strResult;
+}
+
+void FragmentCacheRendererTest::ReuseTest()
+{
+	StartTrace(FragmentCacheRendererTest.ReuseTest);
+	fContext.GetTmpStore()["Who"] = "Peter";
+	fContext.GetTmpStore()["Count"] = "1";
+	assertEqual("1", RenderFragment(60L, "Counter"));
+	fContext.GetTmpStore()["Count"] = "2";
+	assertEqual("1", RenderFragment(60L, "Counter"));
+	fContext.GetTmpStore()["Who"] = "Paul";
+	assertEqual("2", RenderFragment(60L, "Counter"));
+	assertEqual("2", RenderFragment(60L, "OtherCounter"));
+	fContext.GetTmpStore()["Count"] = "3";
+	fContext.GetTmpStore()["Who"] = "Peter";
+	assertEqual("1", RenderFragment(60L, "Counter"));
+	FragmentCacheRenderer::Flush();
+	assertEqual("3", RenderFragment(60L, "Counter"));
+}
+
+void FragmentCacheRendererTest::ExpiryTest()
+{
+	StartTrace(FragmentCacheRendererTest.ExpiryTest);
+	fContext.GetTmpStore()["Who"] = "Peter";
+	fContext.GetTmpStore()["Count"] = "1";
+	assertEqual("1", RenderFragment(0L, "Counter"));
+	fContext.GetTmpStore()["Count"] = "2";
+	assertEqual("2", RenderFragment(0L, "Counter"));
+}
+
+void FragmentCacheRendererTest::NoNameTest()
+{
+	StartTrace(FragmentCacheRendererTest.NoNameTest);
+	fContext.GetTmpStore()["Count"] = "1";
+	assertEqual("1", RenderFragment(60L, 0));
+	fContext.GetTmpStore()["Count"] = "2";
+	assertEqual("2", RenderFragment(60L, 0));
+}
+
+Test *FragmentCacheRendererTest::suite ()
+{
+	StartTrace(FragmentCacheRendererTest.suite);
+	TestSuite *testSuite = new TestSuite;
+
+	ADD_CASE(testSuite, FragmentCacheRendererTest, ReuseTest);
+	ADD_CASE(testSuite, FragmentCacheRendererTest, ExpiryTest);
+	ADD_CASE(testSuite, FragmentCacheRendererTest, NoNameTest);
+
+	return testSuite;
+}
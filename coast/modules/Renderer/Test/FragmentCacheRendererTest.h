@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _FragmentCacheRendererTest_H
+#define _FragmentCacheRendererTest_H
+
+#include "RendererTest.h"
+
+//! tests reuse and expiry of cached fragments
+class FragmentCacheRendererTest : public RendererTest
+{
+public:
+	FragmentCacheRendererTest(TString tstrName);
+
+	static Test *suite ();
+	void setUp();
+
+	//! output is reused while the declared inputs do not change
+	void ReuseTest();
+	//! output is rendered again when it expired
+	void ExpiryTest();
+	//! without name nothing gets cached
+	void NoNameTest();
+
+private:
+	String RenderFragment(long lTTL, const char *pcName);
+};
+
+#endif
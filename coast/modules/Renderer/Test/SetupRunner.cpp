@@ -36,6 +36,8 @@
 #include "NewRendererTest.h"
 #include "GetEnvRendererTest.h"
 #include "UTF8RendererTest.h"
+#include "FragmentCacheRendererTest.h"
+#include "AnyToJSONRendererTest.h"
 
 void setupRunner(TestRunner &runner)
 {
@@ -69,4 +71,6 @@ void setupRunner(TestRunner &runner)
 	ADD_SUITE(runner, TemplateParserTest);
 	ADD_SUITE(runner, GetEnvRendererTest);
 	ADD_SUITE(runner, UTF8RendererTest);
+	ADD_SUITE(runner, FragmentCacheRendererTest);
+	ADD_SUITE(runner, AnyToJSONRendererTest);
 } // setupRunner
@@ -195,6 +195,26 @@ void TemplateParserTest::MacroWithinTagWithinQuote() {
 	assertEqual(_QUOTE_(start <img src="../images/foo.jpg"> end), result);
 }
 
+void TemplateParserTest::CompactTagWithMacro() {
+	StartTrace(TemplateParserTest.CompactTagWithMacro);
+	TemplateParser p;
+
+	String templ("start <img src=\"[[#wd ContextLookupRenderer myimage]]\"> end");
+	IStringStream is(templ);
+	Anything cache;
+	cache = p.Parse(is);
+	TraceAny(cache, "compacted cache");
+	assertEqual(3L, cache.GetSize());
+	assertCharPtrEqual("start <img", cache[0L].AsCharPtr());
+	t_assert(cache[1L].IsDefined("OptionsPrinter"));
+	assertCharPtrEqual("> end", cache[2L].AsCharPtr());
+	String result;
+	Context ctx;
+	ctx.GetTmpStore()["myimage"] = "foo.jpg";
+	Renderer::RenderOnString(result, ctx, cache);
+	assertEqual(_QUOTE_(start <img src="foo.jpg"> end), result);
+}
+
 void TemplateParserTest::InvalidMacroTests() {
 	StartTrace(TemplateParserTest.InvalidMacroTest);
 	InvalidMacroTest("start [[#invalid ]] end");
@@ -309,6 +329,7 @@ Test * TemplateParserTest::suite() {
 	ADD_CASE(testSuite, TemplateParserTest, BuildCacheWithMacro);
 	ADD_CASE(testSuite, TemplateParserTest, MacroWithinTag);
 	ADD_CASE(testSuite, TemplateParserTest, MacroWithinTagWithinQuote);
+	ADD_CASE(testSuite, TemplateParserTest, CompactTagWithMacro);
 	ADD_CASE(testSuite, TemplateParserTest, InvalidMacroTests);
 	ADD_CASE(testSuite, TemplateParserTest, QuotelessAttributes);
 	ADD_CASE(testSuite, TemplateParserTest, AnythingBracesWrong);
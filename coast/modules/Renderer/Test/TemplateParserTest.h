@@ -40,6 +40,8 @@ public:
 	void MacroWithinTag();
 	//! build a cache using macro syntax within a tag, i.e. <img src="[[#wd foo bar]]"> as Monika wished...
 	void MacroWithinTagWithinQuote();
+	//! static parts of a tag containing a macro are joined with the surrounding literals
+	void CompactTagWithMacro();
 	//! look for invalid syntax within a macro
 	void InvalidMacroTests();
 	void InvalidMacroTest(const char *invalidmacro);
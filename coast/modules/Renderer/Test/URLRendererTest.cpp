@@ -13,6 +13,7 @@
 #include "TestSuite.h"
 #include "URLRenderers.h"
 #include "URLRendererTest.h"
+#include "SecurityModule.h"
 
 URLRendererTest::URLRendererTest (TString tname) : RendererTest(tname) {};
 URLRendererTest::~URLRendererTest() {};
@@ -40,6 +41,7 @@ Test *URLRendererTest::suite ()
 	ADD_CASE(testSuite, URLRendererTest, BaseURL);
 	ADD_CASE(testSuite, URLRendererTest, BaseR3SSL);
 	ADD_CASE(testSuite, URLRendererTest, IntraPage);
+	ADD_CASE(testSuite, URLRendererTest, LinkStateBatch);
 
 	return testSuite;
 
@@ -114,3 +116,44 @@ void URLRendererTest::IntraPage()
 	// well, actually I doubt that this is still of any use, but that it is
 
 } // IntraPage
+
+void URLRendererTest::LinkStateBatch()
+{
+	Anything content, link, otherLink, namedLink;
+	link["URLRenderer"] = fConfig;
+	otherLink["URLRenderer"]["Action"] = "OtherAction";
+	namedLink["LinkRenderer"]["Action"] = "NamedAction";
+	namedLink["LinkRenderer"]["Label"] = "named";
+	content.Append("<a href=\"");
+	content.Append(link);
+	content.Append("\">first</a>\n<a href=\"");
+	content.Append(otherLink);
+	content.Append("\">second</a>\n");
+	content.Append(namedLink);
+	Anything batchConfig;
+	batchConfig["Renderer"] = content;
+
+	String expected;
+	Renderer::RenderOnString(expected, fContext, content);
+	LinkStateBatchRenderer batchRenderer("TestLinkStateBatchRenderer");
+	batchRenderer.RenderAll(fReply, fContext, batchConfig);
+	assertEqual(expected, fReply.str());
+	long lLinks = 0L;
+	for (String rest(expected); rest.Contains("wdgateway?X=") >= 0L; ++lLinks) {
+		rest = rest.SubString(rest.Contains("wdgateway?X=") + 1L);
+	}
+	assertEqualm(3L, lLinks, "every link must be rendered");
+	t_assertm(!fContext.GetTmpStore().IsDefined("LinkStateBatch"), "batch must be removed after rendering");
+
+	Anything states, scrambledStates;
+	states.Append(fConfig);
+	states.Append(otherLink["URLRenderer"]);
+	SecurityModule::ScrambleStates(scrambledStates, states);
+	if ( assertEqual(states.GetSize(), scrambledStates.GetSize()) ) {
+		for (long i = 0, sz = states.GetSize(); i < sz; ++i) {
+			String scrambled;
+			SecurityModule::ScrambleState(scrambled, states[i]);
+			assertEqual(scrambled, scrambledStates[i].AsString());
+		}
+	}
+}
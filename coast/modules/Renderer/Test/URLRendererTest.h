@@ -28,6 +28,7 @@ protected:
 	void BaseURL();
 	void BaseR3SSL();
 	void IntraPage();
+	void LinkStateBatch();
 };
 
 #endif
@@ -9,8 +9,81 @@
 #include "URLRenderers.h"
 #include "SecurityModule.h"
 #include "URLUtils.h"
+#include "StringStream.h"
 #include "Tracer.h"
 
+namespace {
+	const char *const cLinkStateBatchSlot = "LinkStateBatch";
+
+	//! writes argName=scrambledState, url encoded if needed
+	void PrintEncodedState(std::ostream &reply, const char *argName, const String &scrambledState) {
+		StartTrace(URLPrinter.PrintEncodedState);
+		String s(argName);
+		s.Append("=").Append(scrambledState);
+		Trace("scrambled state [" << s << "]");
+		if ( coast::urlutils::CheckUrlEncoding(s) ) {
+			reply << s;
+		} else {
+			// now we need to encode the string according to RFC1738/1808
+			String strEncoded = coast::urlutils::urlEncode(s);
+			Trace("state after additional encoding [" << strEncoded << "]");
+			reply << strEncoded;
+		}
+	}
+
+	//! collects the link states of everything LinkStateBatchRenderer renders onto its own stream
+	/*! the encoded states are left out of the collected output, Flush scrambles all of them at once and writes them in place */
+	class LinkStateBatch : public IFAObject {
+		LinkStateBatch(const LinkStateBatch &);
+		LinkStateBatch &operator=(const LinkStateBatch &);
+		OStringStream &fCollector;
+		Anything fEntries;
+	public:
+		explicit LinkStateBatch(OStringStream &collector) :
+			fCollector(collector), fEntries(Anything::ArrayMarker()) {
+		}
+		//! batching is not copyable
+		IFAObject *Clone(Allocator *) const {
+			return NULL;
+		}
+		//! only links rendered directly onto the collecting stream can be deferred, others are on their own string
+		bool Collects(std::ostream &reply) const {
+			return &reply == &fCollector;
+		}
+		void Defer(const Anything &state, const char *argName) {
+			Anything entry;
+			entry["State"] = state;
+			entry["ArgName"] = argName;
+			entry["Offset"] = fCollector.str().Length();
+			fEntries.Append(entry);
+		}
+		void Flush(std::ostream &reply) {
+			StartTrace1(LinkStateBatch.Flush, "deferred links: " << fEntries.GetSize());
+			const String &content = fCollector.str();
+			Anything states, scrambledStates;
+			for (long i = 0, sz = fEntries.GetSize(); i < sz; ++i) {
+				states.Append(fEntries[i]["State"]);
+			}
+			if (states.GetSize() > 0L) {
+				SecurityModule::ScrambleStates(scrambledStates, states);
+			}
+			long lPos = 0L;
+			for (long i = 0, sz = fEntries.GetSize(); i < sz; ++i) {
+				long lOffset = fEntries[i]["Offset"].AsLong(0L);
+				reply.write(content.cstr() + lPos, lOffset - lPos);
+				PrintEncodedState(reply, fEntries[i]["ArgName"].AsCharPtr(), scrambledStates[i].AsString());
+				lPos = lOffset;
+			}
+			reply.write(content.cstr() + lPos, content.Length() - lPos);
+		}
+	};
+
+	LinkStateBatch *FindLinkStateBatch(Context &c) {
+		Anything &tmpStore = c.GetTmpStore();
+		return tmpStore.IsDefined(cLinkStateBatchSlot) ? SafeCast(tmpStore[cLinkStateBatchSlot].AsIFAObject(0), LinkStateBatch) : 0;
+	}
+}
+
 //---- LinkRenderer ----------------------------------------------------------------
 
 RegisterRenderer(LinkRenderer);
@@ -200,19 +273,16 @@ void URLPrinter::BuildPrivateState(std::ostream &, Context &c, const ROAnything
 void URLPrinter::AppendEncodedState(std::ostream &reply, Context &c, const Anything &state, const char *argName)
 {
 	StartTrace(URLPrinter.AppendEncodedState);
+	LinkStateBatch *batch = FindLinkStateBatch(c);
+	if ( batch && batch->Collects(reply) ) {
+		Trace("deferred to LinkStateBatchRenderer");
+		batch->Defer(state, argName);
+		return;
+	}
 	// encode state string
-	String s(argName);
-	s.Append("=");
+	String s;
 	SecurityModule::ScrambleState(s, state);
-	Trace("scrambled state [" << s << "]");
-	if ( coast::urlutils::CheckUrlEncoding(s) ) {
-		reply << s;
-	} else {
-		// now we need to encode the string according to RFC1738/1808
-		String strEncoded = coast::urlutils::urlEncode(s);
-		Trace("state after additional encoding [" << strEncoded << "]");
-		reply << strEncoded;
-	}
+	PrintEncodedState(reply, argName, s);
 }
 
 void URLPrinter::GetState(Anything &state, Context &c)
@@ -406,3 +476,31 @@ String URLRenderer::CreateIntraPageLink(Context &c, String id)
 
 	return path;
 }
+
+//---- LinkStateBatchRenderer -------------------------------------------------------
+RegisterRenderer(LinkStateBatchRenderer);
+
+LinkStateBatchRenderer::LinkStateBatchRenderer(const char *name) : Renderer(name)
+{
+}
+
+void LinkStateBatchRenderer::RenderAll(std::ostream &reply, Context &c, const ROAnything &config)
+{
+	StartTrace(LinkStateBatchRenderer.RenderAll);
+	OStringStream os;
+	LinkStateBatch batch(os);
+	Anything &tmpStore = c.GetTmpStore();
+	Anything anyOuterBatch;
+	bool bNested = tmpStore.IsDefined(cLinkStateBatchSlot);
+	if ( bNested ) {
+		anyOuterBatch = tmpStore[cLinkStateBatchSlot];
+	}
+	tmpStore[cLinkStateBatchSlot] = Anything(&batch);
+	Render(os, c, config["Renderer"]);
+	if ( bNested ) {
+		tmpStore[cLinkStateBatchSlot] = anyOuterBatch;
+	} else {
+		tmpStore.Remove(cLinkStateBatchSlot);
+	}
+	batch.Flush(reply);
+}
@@ -239,6 +239,33 @@ public:
 	void RenderAll(std::ostream &reply, Context &c, const ROAnything &data);
 };
 
+//---- LinkStateBatchRenderer -------------------------------------------------------
+//! Renders its content and scrambles the state of all links in it at once
+/*!
+\par Configuration
+\code
+{
+	/Renderer	Rendererspec	mandatory, content with links, e.g. a whole page body
+}
+\endcode
+
+URLPrinter and its subclasses leave the encoded state of a link open while
+it is rendered inside a LinkStateBatchRenderer. When the content is
+complete, all open states are passed to SecurityModule::ScrambleStates
+in one call, which looks up each SecurityItem once and lets it share its
+per call setup (e.g. the cipher context of AESGCMScrambler) over all links.
+The output is the same as without the LinkStateBatchRenderer.
+Links rendered onto a string of their own (e.g. with RenderOnString) are
+scrambled immediately as before.
+*/
+class LinkStateBatchRenderer : public Renderer
+{
+public:
+	LinkStateBatchRenderer(const char *name);
+
+	void RenderAll(std::ostream &reply, Context &c, const ROAnything &config);
+};
+
 //--- inlines -------------------------
 inline char URLPrinter::ArgSep()
 {
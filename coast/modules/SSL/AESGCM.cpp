@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "AESGCM.h"
+#include "SystemLog.h"
+#include "Tracer.h"
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+	const long cHeaderLength = 1L + AESGCMKeyRing::eNonceLength;
+	const long cOverhead = cHeaderLength + AESGCMKeyRing::eTagLength;
+	//! number of nonces requested from the random generator at once
+	const long cNonceBatch = 64L;
+
+	//! one AES-256-GCM cipher context, the key schedule is only recomputed when the key id changes
+	class GCMCipher {
+		GCMCipher(const GCMCipher &);
+		GCMCipher &operator=(const GCMCipher &);
+		EVP_CIPHER_CTX *fCtx;
+		long fKeyId;
+		bool fEncrypt;
+	public:
+		explicit GCMCipher(bool bEncrypt) :
+			fCtx(EVP_CIPHER_CTX_new()), fKeyId(-1L), fEncrypt(bEncrypt) {
+		}
+		~GCMCipher() {
+			if (fCtx) {
+				EVP_CIPHER_CTX_free(fCtx);
+			}
+		}
+		bool SelectKey(const AESGCMKeyRing &ring, long keyId) {
+			if (!fCtx) {
+				return false;
+			}
+			if (keyId == fKeyId) {
+				return true;
+			}
+			const unsigned char *key = ring.GetKey(keyId);
+			if (!key) {
+				return false;
+			}
+			int ok = fEncrypt ? EVP_EncryptInit_ex(fCtx, EVP_aes_256_gcm(), 0, key, 0) : EVP_DecryptInit_ex(fCtx, EVP_aes_256_gcm(), 0, key, 0);
+			fKeyId = (ok == 1) ? keyId : -1L;
+			return ok == 1;
+		}
+		//! start a new message, the key id is authenticated as additional data
+		bool Start(const unsigned char *nonce) {
+			int ok = fEncrypt ? EVP_EncryptInit_ex(fCtx, 0, 0, 0, nonce) : EVP_DecryptInit_ex(fCtx, 0, 0, 0, nonce);
+			unsigned char aad = static_cast<unsigned char>(fKeyId);
+			return ok == 1 && Update(0, &aad, 1L);
+		}
+		//! pass out == 0 to add in as additional authenticated data, in place operation is allowed
+		bool Update(unsigned char *out, const unsigned char *in, long len) {
+			int outl = 0;
+			if (len <= 0) {
+				return true;
+			}
+			return (fEncrypt ? EVP_EncryptUpdate(fCtx, out, &outl, in, static_cast<int>(len)) : EVP_DecryptUpdate(fCtx, out, &outl, in,
+					static_cast<int>(len))) == 1;
+		}
+		bool FinishSeal(unsigned char *tag) {
+			unsigned char rest[AESGCMKeyRing::eTagLength];
+			int outl = 0;
+			return EVP_EncryptFinal_ex(fCtx, rest, &outl) == 1 && EVP_CIPHER_CTX_ctrl(fCtx, EVP_CTRL_GCM_GET_TAG, AESGCMKeyRing::eTagLength,
+					tag) == 1;
+		}
+		bool FinishOpen(const unsigned char *tag) {
+			unsigned char rest[AESGCMKeyRing::eTagLength];
+			int outl = 0;
+			return EVP_CIPHER_CTX_ctrl(fCtx, EVP_CTRL_GCM_SET_TAG, AESGCMKeyRing::eTagLength, const_cast<unsigned char *>(tag)) == 1
+					&& EVP_DecryptFinal_ex(fCtx, rest, &outl) > 0;
+		}
+	};
+
+	//! returns 0 if the random generator failed
+	const unsigned char *NextNonce(unsigned char *nonce) {
+		return RAND_bytes(nonce, AESGCMKeyRing::eNonceLength) == 1 ? nonce : 0;
+	}
+
+	//! hands out random nonces, fetching them in blocks of cNonceBatch from OpenSSL
+	class NonceSource {
+		NonceSource(const NonceSource &);
+		NonceSource &operator=(const NonceSource &);
+		unsigned char fBuf[cNonceBatch * AESGCMKeyRing::eNonceLength];
+		long fRemaining, fExpected, fPos;
+	public:
+		explicit NonceSource(long lExpected) :
+			fRemaining(0L), fExpected(lExpected > 0L ? lExpected : 1L), fPos(0L) {
+		}
+		//! returns 0 if the random generator failed
+		const unsigned char *Next() {
+			if (fRemaining <= 0L) {
+				long lCount = std::min(fExpected, cNonceBatch);
+				if (RAND_bytes(fBuf, static_cast<int>(lCount * AESGCMKeyRing::eNonceLength)) != 1) {
+					return 0;
+				}
+				fRemaining = lCount;
+				fExpected -= lCount;
+				fPos = 0L;
+			}
+			--fRemaining;
+			return fBuf + (fPos++) * AESGCMKeyRing::eNonceLength;
+		}
+	};
+
+	//! append key id, nonce and either ciphertext+tag or tag+cleartext to out
+	bool Seal(GCMCipher &cipher, const AESGCMKeyRing &ring, const unsigned char *nonce, String &out, const String &cleartext, bool bEncryptText) {
+		long keyId = ring.GetCurrentKeyId(), len = cleartext.Length();
+		if (!nonce || !cipher.SelectKey(ring, keyId) || !cipher.Start(nonce)) {
+			return false;
+		}
+		const unsigned char *pClear = reinterpret_cast<const unsigned char *>((const char *) cleartext);
+		unsigned char tag[AESGCMKeyRing::eTagLength];
+		out.Append(static_cast<char>(keyId)).Append(static_cast<const void *>(nonce), AESGCMKeyRing::eNonceLength);
+		if (bEncryptText) {
+			long pos = out.Length();
+			out.Append(static_cast<const void *>(pClear), len);
+			unsigned char *p = reinterpret_cast<unsigned char *>(const_cast<char *>((const char *) out)) + pos;
+			if (!cipher.Update(p, p, len) || !cipher.FinishSeal(tag)) {
+				return false;
+			}
+			out.Append(static_cast<const void *>(tag), AESGCMKeyRing::eTagLength);
+			return true;
+		}
+		if (!cipher.Update(0, pClear, len) || !cipher.FinishSeal(tag)) {
+			return false;
+		}
+		out.Append(static_cast<const void *>(tag), AESGCMKeyRing::eTagLength).Append(static_cast<const void *>(pClear), len);
+		return true;
+	}
+
+	//! verify and strip what Seal appended, cleartext is only touched on success
+	bool Open(GCMCipher &cipher, const AESGCMKeyRing &ring, String &cleartext, const String &text, bool bEncryptedText) {
+		long len = text.Length() - cOverhead;
+		if (len < 0L) {
+			return false;
+		}
+		const unsigned char *p = reinterpret_cast<const unsigned char *>((const char *) text);
+		if (!cipher.SelectKey(ring, p[0]) || !cipher.Start(p + 1)) {
+			return false;
+		}
+		if (bEncryptedText) {
+			String clear(static_cast<const void *>(p + cHeaderLength), len);
+			unsigned char *c = reinterpret_cast<unsigned char *>(const_cast<char *>((const char *) clear));
+			if (!cipher.Update(c, c, len) || !cipher.FinishOpen(p + cHeaderLength + len)) {
+				return false;
+			}
+			cleartext = clear;
+			return true;
+		}
+		if (!cipher.Update(0, p + cOverhead, len) || !cipher.FinishOpen(p + cHeaderLength)) {
+			return false;
+		}
+		cleartext = text.SubString(cOverhead, len);
+		return true;
+	}
+
+	void SealBatch(const AESGCMKeyRing &ring, Anything &encodedTexts, const Anything &cleartexts, bool bEncryptText, const char *pName) {
+		long sz = cleartexts.GetSize();
+		GCMCipher cipher(true);
+		NonceSource nonces(sz);
+		for (long i = 0; i < sz; ++i) {
+			String clear = cleartexts[i].AsString();
+			String encoded(clear.Length() + cOverhead, encodedTexts.GetAllocator());
+			if (!Seal(cipher, ring, nonces.Next(), encoded, clear, bEncryptText)) {
+				SystemLog::Error(String("AES-GCM encoding failed in ") << pName);
+				encoded.Trim(0L);
+			}
+			encodedTexts.Append(encoded);
+		}
+	}
+}
+
+//---- AESGCMKeyRing -----------------------------------------------------------
+AESGCMKeyRing::AESGCMKeyRing() :
+	fCurrentKeyId(0L) {
+	Clear();
+}
+
+void AESGCMKeyRing::Clear() {
+	memset(fKeys, 0, sizeof(fKeys));
+	memset(fValid, 0, sizeof(fValid));
+}
+
+void AESGCMKeyRing::SetKey(const String &key, long keyId, bool bCurrent) {
+	StartTrace1(AESGCMKeyRing.SetKey, "keyId: " << keyId << (bCurrent ? " current" : " retired"));
+	if (keyId < 0L || keyId >= eMaxKeys) {
+		SystemLog::Error(String("AES-GCM key id out of range [0..255]: ") << keyId);
+		return;
+	}
+	unsigned int len = 0;
+	fValid[keyId] = (EVP_Digest((const char *) key, key.Length(), fKeys[keyId], &len, EVP_sha256(), 0) == 1 && len == eKeyLength);
+	if (bCurrent && fValid[keyId]) {
+		fCurrentKeyId = keyId;
+	}
+}
+
+const unsigned char *AESGCMKeyRing::GetKey(long keyId) const {
+	return (keyId >= 0L && keyId < eMaxKeys && fValid[keyId]) ? fKeys[keyId] : 0;
+}
+
+//---- AESGCMScrambler -----------------------------------------------------------
+RegisterScrambler(AESGCMScrambler);
+RegisterAliasSecurityItem(gcm, AESGCMScrambler);
+
+AESGCMScrambler::AESGCMScrambler(const char *name) :
+	Scrambler(name), fConfiguredKeyId(0L) {
+	// set the default legacy key, if no config is given
+	InitKey(fgcLegacyMasterKey);
+}
+
+void AESGCMScrambler::InitKey(const String &key) {
+	InitKey(key, fConfiguredKeyId, true);
+}
+
+void AESGCMScrambler::InitKey(const String &key, long keyId, bool bCurrent) {
+	fKeyRing.SetKey(key, keyId, bCurrent);
+}
+
+bool AESGCMScrambler::Init(ROAnything config) {
+	StartTrace1(AESGCMScrambler.Init, fName);
+	fConfiguredKeyId = config["KeyId"].AsLong(0L);
+	// the legacy key installed by the constructor must not stay valid next to the configured keys
+	fKeyRing.Clear();
+	bool bRetCode = Scrambler::Init(config);
+	if (!bRetCode) {
+		InitKey(fgcLegacyMasterKey);
+	}
+	ROAnything retiredKeys = config["RetiredKeys"];
+	for (long i = 0, sz = retiredKeys.GetSize(); i < sz; ++i) {
+		String key = retiredKeys[i]["Key"].AsString();
+		if (!key.Length() && retiredKeys[i]["KeyLoc"].AsString().Length()) {
+			DoLoadKeyFile(retiredKeys[i]["KeyLoc"].AsCharPtr(), key);
+		}
+		InitKey(key, retiredKeys[i]["KeyId"].AsLong(-1L), false);
+	}
+	return bRetCode;
+}
+
+void AESGCMScrambler::DoEncode(String &scrambledText, const String &cleartext) const {
+	StartTrace(AESGCMScrambler.DoEncode);
+	GCMCipher cipher(true);
+	unsigned char nonce[AESGCMKeyRing::eNonceLength];
+	String encoded(cleartext.Length() + cOverhead);
+	if (!Seal(cipher, fKeyRing, NextNonce(nonce), encoded, cleartext, true)) {
+		SystemLog::Error(String("AES-GCM encoding failed in ") << fName);
+		encoded.Trim(0L);
+	}
+	scrambledText = encoded;
+}
+
+bool AESGCMScrambler::DoDecode(String &cleartext, const String &scrambledText) const {
+	StartTrace(AESGCMScrambler.DoDecode);
+	GCMCipher cipher(false);
+	return Open(cipher, fKeyRing, cleartext, scrambledText, true);
+}
+
+void AESGCMScrambler::DoEncodeBatch(Anything &scrambledTexts, const Anything &cleartexts) const {
+	StartTrace(AESGCMScrambler.DoEncodeBatch);
+	SealBatch(fKeyRing, scrambledTexts, cleartexts, true, fName);
+}
+
+//---- AESGCMSigner -----------------------------------------------------------
+RegisterSigner(AESGCMSigner);
+RegisterAliasSecurityItem(gmac, AESGCMSigner);
+
+AESGCMSigner::AESGCMSigner(const char *name) :
+	Signer(name), fConfiguredKeyId(0L) {
+	InitKey(fgcLegacyMasterKey);
+}
+
+void AESGCMSigner::InitKey(const String &key) {
+	InitKey(key, fConfiguredKeyId, true);
+}
+
+void AESGCMSigner::InitKey(const String &key, long keyId, bool bCurrent) {
+	fKeyRing.SetKey(key, keyId, bCurrent);
+}
+
+bool AESGCMSigner::Init(ROAnything config) {
+	StartTrace1(AESGCMSigner.Init, fName);
+	fConfiguredKeyId = config["KeyId"].AsLong(0L);
+	// the legacy key installed by the constructor must not stay valid next to the configured keys
+	fKeyRing.Clear();
+	bool bRetCode = Signer::Init(config);
+	if (!bRetCode) {
+		InitKey(fgcLegacyMasterKey);
+	}
+	ROAnything retiredKeys = config["RetiredKeys"];
+	for (long i = 0, sz = retiredKeys.GetSize(); i < sz; ++i) {
+		String key = retiredKeys[i]["Key"].AsString();
+		if (!key.Length() && retiredKeys[i]["KeyLoc"].AsString().Length()) {
+			DoLoadKeyFile(retiredKeys[i]["KeyLoc"].AsCharPtr(), key);
+		}
+		InitKey(key, retiredKeys[i]["KeyId"].AsLong(-1L), false);
+	}
+	return bRetCode;
+}
+
+void AESGCMSigner::DoEncode(String &scrambledText, const String &cleartext) const {
+	StartTrace(AESGCMSigner.DoEncode);
+	GCMCipher cipher(true);
+	unsigned char nonce[AESGCMKeyRing::eNonceLength];
+	String encoded(cleartext.Length() + cOverhead);
+	if (!Seal(cipher, fKeyRing, NextNonce(nonce), encoded, cleartext, false)) {
+		SystemLog::Error(String("AES-GMAC signing failed in ") << fName);
+		encoded.Trim(0L);
+	}
+	scrambledText = encoded;
+}
+
+bool AESGCMSigner::DoDecode(String &cleartext, const String &scrambledText) const {
+	StartTrace(AESGCMSigner.DoDecode);
+	GCMCipher cipher(false);
+	return Open(cipher, fKeyRing, cleartext, scrambledText, false);
+}
+
+void AESGCMSigner::DoEncodeBatch(Anything &scrambledTexts, const Anything &cleartexts) const {
+	StartTrace(AESGCMSigner.DoEncodeBatch);
+	SealBatch(fKeyRing, scrambledTexts, cleartexts, false, fName);
+}
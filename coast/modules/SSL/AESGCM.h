@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _AESGCM_H
+#define _AESGCM_H
+
+#include "SecurityModule.h"
+
+//---- AESGCMKeyRing -----------------------------------------------------------
+//! holds the AES-256 keys of an AES-GCM security item, indexed by a one byte key id
+/*! The id of the key used is stored in front of every encoded text, so texts produced with
+ * a retired key can still be decoded after a new key has become the current one.
+ * The item name prefix evaluated by SecurityItem::GetNamePrefixFromEncodedText stays untouched.
+ * Keys are given as arbitrary Strings (same as for BlowfishScrambler), the AES key is the SHA-256 digest of it.
+ * Config format of the items using it:<pre>
+ * /Key or /KeyLoc					current key, see SecurityItem::Init
+ * /KeyId		2					optional, id of the current key, default 0
+ * /RetiredKeys {					optional, keys only used for decoding
+ *   { /KeyId 1 /Key "..." }
+ *   { /KeyId 0 /KeyLoc "oldkey.txt" }
+ * }</pre>
+ */
+class AESGCMKeyRing
+{
+public:
+	enum { eKeyLength = 32, eNonceLength = 12, eTagLength = 16, eMaxKeys = 256 };
+
+	AESGCMKeyRing();
+
+	//! store key under keyId, make it the one used for encoding if bCurrent is set
+	void SetKey(const String &key, long keyId, bool bCurrent);
+	//! forget all keys
+	void Clear();
+	long GetCurrentKeyId() const {
+		return fCurrentKeyId;
+	}
+	//! returns 0 if no key with keyId is known
+	const unsigned char *GetKey(long keyId) const;
+
+private:
+	unsigned char fKeys[eMaxKeys][eKeyLength];
+	bool fValid[eMaxKeys];
+	long fCurrentKeyId;
+};
+
+//---- AESGCMScrambler -----------------------------------------------------------
+//! authenticated encryption of cookies and URL state using AES-256-GCM of OpenSSL
+/*! Encoded layout: key id (1 byte), random nonce (12 bytes), ciphertext, tag (16 bytes).
+ * The key id is authenticated as additional data. OpenSSL uses AES-NI/PCLMULQDQ where available.
+ * Since the tag already authenticates the text, SecurityModule can use the no-op Signer (nos)
+ * together with this scrambler.
+ */
+class AESGCMScrambler: public Scrambler
+{
+	AESGCMScrambler();
+	AESGCMScrambler(const AESGCMScrambler &);
+	AESGCMScrambler &operator=(const AESGCMScrambler &);
+public:
+	AESGCMScrambler(const char *name);
+
+	/*! @copydoc IFAObject::Clone(Allocator *) */
+	IFAObject *Clone(Allocator *a) const {
+		return new (a) AESGCMScrambler(fName);
+	}
+	//! install key as current key using the id configured in /KeyId
+	void InitKey(const String &key);
+	//! install an additional key, retired keys are still accepted by DoDecode
+	void InitKey(const String &key, long keyId, bool bCurrent);
+
+	virtual void DoEncode(String &scrambledText, const String &cleartext) const;
+	virtual bool DoDecode(String &cleartext, const String &scrambledText) const;
+	//! shares one cipher context and one random nonce request over all entries
+	virtual void DoEncodeBatch(Anything &scrambledTexts, const Anything &cleartexts) const;
+
+protected:
+	virtual bool Init(ROAnything config);
+
+	AESGCMKeyRing fKeyRing;
+	long fConfiguredKeyId;
+	friend class AESGCMTest;
+};
+
+//---- AESGCMSigner -----------------------------------------------------------
+//! signs text using AES-256-GMAC (AES-GCM with the whole text as additional data)
+/*! Encoded layout: key id (1 byte), random nonce (12 bytes), tag (16 bytes), cleartext.
+ * Supports the same key rotation configuration as AESGCMScrambler.
+ */
+class AESGCMSigner: public Signer
+{
+	AESGCMSigner();
+	AESGCMSigner(const AESGCMSigner &);
+	AESGCMSigner &operator=(const AESGCMSigner &);
+public:
+	AESGCMSigner(const char *name);
+
+	/*! @copydoc IFAObject::Clone(Allocator *) */
+	IFAObject *Clone(Allocator *a) const {
+		return new (a) AESGCMSigner(fName);
+	}
+	void InitKey(const String &key);
+	void InitKey(const String &key, long keyId, bool bCurrent);
+
+	virtual void DoEncode(String &scrambledText, const String &cleartext) const;
+	virtual bool DoDecode(String &cleartext, const String &scrambledText) const;
+	virtual void DoEncodeBatch(Anything &scrambledTexts, const Anything &cleartexts) const;
+
+protected:
+	virtual bool Init(ROAnything config);
+
+	AESGCMKeyRing fKeyRing;
+	long fConfiguredKeyId;
+	friend class AESGCMTest;
+};
+
+#endif
@@ -70,6 +70,19 @@ long SSLSocketStreamBuf::DoWrite(const char *buf, long len)
 	return bytesSent;
 }
 
+long SSLSocketStreamBuf::DoWriteVector(const char *pending, long lPending, const char *buf, long len)
+{
+	StartTrace(SSLSocketStreamBuf.DoWriteVector);
+	if ( lPending > 0 && DoWrite(pending, lPending) < 1 ) {
+		return EOF;
+	}
+	long bytesSent = DoWrite(buf, len);
+	if ( bytesSent < 1 ) {
+		return EOF;
+	}
+	return lPending + bytesSent;
+}
+
 long SSLSocketStreamBuf::DoRead(char *buf, long len) const
 {
 	StartTrace(SSLSocketStreamBuf.DoRead);
@@ -24,6 +24,8 @@ public:
 
 protected:					  // get area
 	virtual long DoWrite(const char *buf, long len);
+	//! SSL_write has no vectored form, both buffers are encrypted one after the other by DoWrite
+	virtual long DoWriteVector(const char *pending, long lPending, const char *buf, long len);
 	virtual long DoRead(char *buf, long len) const;
 	virtual void SetStreamState(long bytesProcessed) const;
 
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "AESGCMTest.h"
+#include "AESGCM.h"
+#include "TestSuite.h"
+#include "Tracer.h"
+
+//---- AESGCMTest ----------------------------------------------------------------
+AESGCMTest::AESGCMTest(TString tstrName)
+	: TestCaseType(tstrName)
+{
+	StartTrace(AESGCMTest.AESGCMTest);
+}
+
+AESGCMTest::~AESGCMTest()
+{
+	StartTrace(AESGCMTest.Dtor);
+}
+
+void AESGCMTest::ScrambleUnscrambleTest()
+{
+	StartTrace(AESGCMTest.ScrambleUnscrambleTest);
+	AESGCMScrambler scrambler("TestGCMScrambler");
+	scrambler.InitKey("A very simple test key");
+	String texts[] = { String("This is a simple test String"), String(), String("\0with\0nulls\0", 12) };
+	for (long i = 0; i < 3; ++i) {
+		String scrambled, scrambled2, transcript;
+		scrambler.DoEncode(scrambled, texts[i]);
+		scrambler.DoEncode(scrambled2, texts[i]);
+		assertEqualm(texts[i].Length() + 29L, scrambled.Length(), TString("entry ") << i);
+		t_assertm(scrambled != scrambled2, "expected a fresh nonce for every encoding");
+		t_assert(scrambler.DoDecode(transcript, scrambled));
+		assertEqual(texts[i], transcript);
+	}
+	AESGCMScrambler other("OtherGCMScrambler");
+	other.InitKey("This key is really different");
+	String scrambled, transcript("untouched");
+	scrambler.DoEncode(scrambled, texts[0]);
+	t_assert(!other.DoDecode(transcript, scrambled));
+	assertEqual("untouched", transcript);
+}
+
+void AESGCMTest::TamperedTextTest()
+{
+	StartTrace(AESGCMTest.TamperedTextTest);
+	AESGCMScrambler scrambler("TestGCMScrambler");
+	String clearText("/action \"GoHome\" /role \"Guest\""), scrambled, transcript;
+	scrambler.DoEncode(scrambled, clearText);
+	for (long i = 0; i < scrambled.Length(); ++i) {
+		String modified(scrambled);
+		modified.PutAt(i, static_cast<char>(modified[i] ^ 0x01));
+		t_assertm(!scrambler.DoDecode(transcript, modified), TString("modification at ") << i << " not detected");
+	}
+	t_assert(!scrambler.DoDecode(transcript, scrambled.SubString(0, scrambled.Length() - 1)));
+	t_assert(!scrambler.DoDecode(transcript, "short"));
+}
+
+void AESGCMTest::SignCheckTest()
+{
+	StartTrace(AESGCMTest.SignCheckTest);
+	AESGCMSigner signer("TestGMACSigner");
+	signer.InitKey("A key for signing");
+	String clearText("/action \"GoHome\""), signedText, transcript;
+	signer.DoEncode(signedText, clearText);
+	assertEqual(clearText, signedText.SubString(29));
+	t_assert(signer.DoDecode(transcript, signedText));
+	assertEqual(clearText, transcript);
+	String modified(signedText);
+	modified.PutAt(modified.Length() - 1, 'X');
+	t_assert(!signer.DoDecode(transcript, modified));
+	AESGCMSigner other("OtherGMACSigner");
+	other.InitKey("Another key for signing");
+	t_assert(!other.DoDecode(transcript, signedText));
+}
+
+void AESGCMTest::KeyRotationTest()
+{
+	StartTrace(AESGCMTest.KeyRotationTest);
+	Anything oldConfig;
+	oldConfig["Key"] = "the old key";
+	oldConfig["KeyId"] = 1L;
+	AESGCMScrambler oldScrambler("OldGCMScrambler");
+	t_assert(oldScrambler.Init(oldConfig));
+	AESGCMSigner oldSigner("OldGMACSigner");
+	t_assert(oldSigner.Init(oldConfig));
+
+	Anything newConfig;
+	newConfig["Key"] = "the new key";
+	newConfig["KeyId"] = 2L;
+	newConfig["RetiredKeys"][0L]["KeyId"] = 1L;
+	newConfig["RetiredKeys"][0L]["Key"] = "the old key";
+	AESGCMScrambler newScrambler("NewGCMScrambler");
+	t_assert(newScrambler.Init(newConfig));
+	AESGCMSigner newSigner("NewGMACSigner");
+	t_assert(newSigner.Init(newConfig));
+
+	String clearText("some state"), oldText, newText, transcript;
+	oldScrambler.DoEncode(oldText, clearText);
+	assertEqual(1L, (long) (unsigned char) oldText[0L]);
+	newScrambler.DoEncode(newText, clearText);
+	assertEqual(2L, (long) (unsigned char) newText[0L]);
+	t_assertm(newScrambler.DoDecode(transcript, oldText), "retired key must still decode");
+	assertEqual(clearText, transcript);
+	t_assertm(!oldScrambler.DoDecode(transcript, newText), "unknown key id must not decode");
+
+	oldSigner.DoEncode(oldText, clearText);
+	t_assert(newSigner.DoDecode(transcript, oldText));
+	assertEqual(clearText, transcript);
+	newSigner.DoEncode(newText, clearText);
+	t_assert(!oldSigner.DoDecode(transcript, newText));
+}
+
+void AESGCMTest::BatchTest()
+{
+	StartTrace(AESGCMTest.BatchTest);
+	Anything cleartexts, scrambledTexts, signedTexts;
+	for (long i = 0; i < 150; ++i) {
+		cleartexts.Append(String("/link ") << i);
+	}
+	Scrambler::ScrambleBatch("AESGCMScrambler", scrambledTexts, cleartexts);
+	Signer::SignBatch("gmac", signedTexts, cleartexts);
+	assertEqual(cleartexts.GetSize(), scrambledTexts.GetSize());
+	assertEqual(cleartexts.GetSize(), signedTexts.GetSize());
+	for (long i = 0, sz = cleartexts.GetSize(); i < sz; ++i) {
+		String name, transcript;
+		String scrambled = scrambledTexts[i].AsString();
+		assertEqual(15L, SecurityItem::GetNamePrefixFromEncodedText(name, scrambled));
+		assertEqual("AESGCMScrambler", name);
+		t_assert(Scrambler::Unscramble(transcript, scrambled));
+		assertEqual(cleartexts[i].AsString(), transcript);
+		t_assert(Signer::Check(transcript, signedTexts[i].AsString()));
+		assertEqual(cleartexts[i].AsString(), transcript);
+		if (i > 0) {
+			t_assertm(scrambled.SubString(17, 12) != scrambledTexts[i - 1L].AsString().SubString(17, 12), "nonces must differ");
+		}
+	}
+}
+
+void AESGCMTest::LegacyKeyTest()
+{
+	StartTrace(AESGCMTest.LegacyKeyTest);
+	AESGCMScrambler legacyScrambler("LegacyGCMScrambler");
+	AESGCMSigner legacySigner("LegacyGMACSigner");
+	String clearText("/role \"Admin\""), legacyScrambled, legacySigned, transcript;
+	legacyScrambler.DoEncode(legacyScrambled, clearText);
+	legacySigner.DoEncode(legacySigned, clearText);
+	for (long keyId = 0; keyId < 3; keyId += 2) {
+		Anything config;
+		config["Key"] = "a configured key";
+		config["KeyId"] = keyId;
+		AESGCMScrambler scrambler("ConfiguredGCMScrambler");
+		t_assert(scrambler.Init(config));
+		t_assertm(!scrambler.DoDecode(transcript, legacyScrambled), TString("legacy key accepted with key id ") << keyId);
+		AESGCMSigner signer("ConfiguredGMACSigner");
+		t_assert(signer.Init(config));
+		t_assertm(!signer.DoDecode(transcript, legacySigned), TString("legacy key accepted with key id ") << keyId);
+	}
+	AESGCMScrambler unconfigured("UnconfiguredGCMScrambler");
+	t_assert(!unconfigured.Init(Anything()));
+	t_assertm(unconfigured.DoDecode(transcript, legacyScrambled), "without a configured key the legacy key stays in use");
+	assertEqual(clearText, transcript);
+}
+
+// builds up a suite of tests, add a line for each testmethod
+Test *AESGCMTest::suite ()
+{
+	StartTrace(AESGCMTest.suite);
+	TestSuite *testSuite = new TestSuite;
+	ADD_CASE(testSuite, AESGCMTest, ScrambleUnscrambleTest);
+	ADD_CASE(testSuite, AESGCMTest, TamperedTextTest);
+	ADD_CASE(testSuite, AESGCMTest, SignCheckTest);
+	ADD_CASE(testSuite, AESGCMTest, KeyRotationTest);
+	ADD_CASE(testSuite, AESGCMTest, BatchTest);
+	ADD_CASE(testSuite, AESGCMTest, LegacyKeyTest);
+	return testSuite;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _AESGCMTest_H
+#define _AESGCMTest_H
+
+#include "TestCase.h"
+
+//---- AESGCMTest ----------------------------------------------------------
+//! tests AESGCMScrambler and AESGCMSigner including key rotation and batch encoding
+class AESGCMTest : public testframework::TestCase
+{
+public:
+	AESGCMTest(TString tstrName);
+	~AESGCMTest();
+
+	static Test *suite ();
+
+	void ScrambleUnscrambleTest();
+	void TamperedTextTest();
+	void SignCheckTest();
+	void KeyRotationTest();
+	void BatchTest();
+	void LegacyKeyTest();
+};
+
+#endif
@@ -12,6 +12,8 @@
 #include "SSLSocket.h"
 #include "SSLModule.h"
 #include "AnyIterators.h"
+#include "StringStream.h"
+#include "SocketStream.h"
 
 //---- SSLListenerPoolTest ----------------------------------------------------------------
 SSLListenerPoolTest::SSLListenerPoolTest(TString tname) : ListenerPoolTest(tname)
@@ -74,6 +76,42 @@ void SSLListenerPoolTest::PoolTest()
 	}
 }
 
+void SSLListenerPoolTest::LargeMessageTest()
+{
+	StartTrace(SSLListenerPoolTest.LargeMessageTest);
+	Anything config;
+	config.Append("TCP5010");
+
+	TestCallBackFactory *tcbf = new TestCallBackFactory;
+	ListenerPool lpToTest(tcbf);
+
+	String msg(3 * cSocketStreamBufferSize);
+	for (long l = 0; msg.Length() < 3 * cSocketStreamBufferSize; ++l) {
+		msg.Append(static_cast<char>('a' + l % 26));
+	}
+	Anything data;
+	data["MessageToSend"] = msg;
+	data["ChecksToDo"] = Anything(Anything::ArrayMarker());
+	// exported into a String first, the stream gets the whole block with a single write
+	String strData;
+	{
+		OStringStream os(strData);
+		data.Export(os);
+	}
+	if ( t_assertm( lpToTest.Init(config.GetSize(), config), "Init should work") && t_assertm(lpToTest.Start(false, 0, 0) == 0, "Start should work")) {
+		{
+			SSLConnector sc("localhost", 5010L, 0L);
+			DoSendReceive(&sc, strData);
+		}
+		if (t_assertm(lpToTest.Terminate(1, 10) == 0, "Terminate failed")) {
+			t_assertm(lpToTest.Join() == 0, "Join failed");
+			t_assertm(tcbf->GetResult().Contains(msg), "message should have been decrypted completely by the receiver");
+		}
+	}
+	Anything failures = tcbf->GetFailures();
+	t_assertm(failures.GetSize() == 0, "Receivers encountered a least one error");
+}
+
 void SSLListenerPoolTest::DoTestConnect()
 {
 	StartTrace(SSLListenerPoolTest.DoTestConnect);
@@ -140,6 +178,7 @@ Test *SSLListenerPoolTest::suite ()
 	StartTrace(SSLListenerPoolTest.suite);
 	TestSuite *testSuite = new TestSuite;
 	ADD_CASE(testSuite, SSLListenerPoolTest, PoolTest);
+	ADD_CASE(testSuite, SSLListenerPoolTest, LargeMessageTest);
 	ADD_CASE(testSuite, SSLListenerPoolTest, NullCallBackFactoryTest);
 	ADD_CASE(testSuite, SSLListenerPoolTest, InitFailureNullAcceptorTest);
 	return testSuite;
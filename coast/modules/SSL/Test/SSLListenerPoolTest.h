@@ -27,6 +27,9 @@ public:
 
 	void PoolTest();
 
+	//!sends a message larger than the stream buffer, it must arrive encrypted and complete
+	void LargeMessageTest();
+
 	//--- public api
 
 	//!builds up a suite of testcases for this test
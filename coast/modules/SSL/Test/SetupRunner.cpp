@@ -18,6 +18,7 @@
 #include "SSLSocketUtilsTest.h"
 #include "SSLObjectManagerTest.h"
 #include "SSLModuleTest.h"
+#include "AESGCMTest.h"
 
 void setupRunner(TestRunner &runner)
 {
@@ -28,4 +29,5 @@ void setupRunner(TestRunner &runner)
 	ADD_SUITE(runner, SSLListenerPoolTest);
 	ADD_SUITE(runner, SSLCertificateTest);
 	ADD_SUITE(runner, SSLObjectManagerTest);
+	ADD_SUITE(runner, AESGCMTest);
 } // setupRunner
@@ -10,6 +10,7 @@
 #include "Anything.h"
 #include "Tracer.h"
 #include "SystemLog.h"
+#include <cstring>
 #define CHAR64(c)  (index_64[(unsigned char)(c)])
 
 #define XX 127
@@ -20,6 +21,62 @@ RegisterAliasSecurityItem(b64, Base64);
 RegisterEncoder(Base64Regular);
 RegisterAliasSecurityItem(b64r, Base64Regular);
 
+namespace {
+	//! number of groups converted into a local buffer before appending it to the result
+	const long cChunkBlocks = 256L;
+}
+
+long Base64::EncodeBlocks(const char *basis_64, const char *pIn, long lBlocks, char *pOut)
+{
+	const unsigned char *buf = reinterpret_cast<const unsigned char *>(pIn);
+	for ( long i = 0; i < lBlocks; ++i, buf += 3, pOut += 4 ) {
+		unsigned char c1 = buf[0L], c2 = buf[1L], c3 = buf[2L];
+		pOut[0L] = basis_64[c1 >> 2];
+		pOut[1L] = basis_64[((c1 & 0x3) << 4) | ((c2 & 0xF0) >> 4)];
+		pOut[2L] = basis_64[((c2 & 0xF) << 2) | ((c3 & 0xC0) >> 6)];
+		pOut[3L] = basis_64[c3 & 0x3F];
+	}
+	return lBlocks * 4L;
+}
+
+long Base64::EncodeTail(const char *basis_64, const char *pIn, long lRemBytes, char *pOut)
+{
+	unsigned char c1 = pIn[0L];
+	unsigned char c2 = (lRemBytes > 1L) ? pIn[1L] : 0;
+	pOut[0L] = basis_64[c1 >> 2];
+	pOut[1L] = basis_64[((c1 & 0x3) << 4) | ((c2 & 0xF0) >> 4)];
+	pOut[2L] = (lRemBytes == 2L) ? basis_64[((c2 & 0xF) << 2)] : '=';
+	pOut[3L] = '=';
+	return 4L;
+}
+
+long Base64::DecodeBlocks(const char *pIn, long lBlocks, char *pOut)
+{
+	char *pStart = pOut;
+	unsigned char c1, c2, c3, c4;
+	unsigned char cr1, cr2, cr3, cr4;
+	for ( long i = 0; i < lBlocks; ++i, pIn += 4 ) {
+		cr1 = pIn[0L];
+		cr2 = pIn[1L];
+		cr3 = pIn[2L];
+		cr4 = pIn[3L];
+
+		c1 = CHAR64(cr1);
+		c2 = CHAR64(cr2);
+		c3 = (cr3 == '=') ? 0 : CHAR64(cr3);
+		c4 = (cr4 == '=') ? 0 : CHAR64(cr4);
+
+		*pOut++ = (char)((c1 << 2) | ((c2 & 0x30) >> 4));
+		if (cr3 != '=') {
+			*pOut++ = (char)(((c2 & 0x0F) << 4) | ((c3 & 0x3C) >> 2));
+			if (cr4 != '=') {
+				*pOut++ = (char)(((c3 & 0x03) << 6) | c4);
+			}
+		}
+	}
+	return pOut - pStart;
+}
+
 // base64 encoder, neglects newline after 73 characters
 // since it is not used for file encoding, but only for string encoding
 void Base64::DoEncode(String &encStr, const String &str) const
@@ -29,38 +86,20 @@ void Base64::DoEncode(String &encStr, const String &str) const
 	const char *basis_64 = DoGetBasis();
 
 	const int cBlockSize = 3;
-	unsigned char c1, c2, c3;
 	long blocks = str.Length() / cBlockSize;
 	long remBytes = str.Length() % cBlockSize;
-	long index = 0;
+	encStr.Reserve(encStr.Length() + (blocks + 1L) * 4L + 1L);
 
 	const char *buf = str;
-	for ( long i = 0; i < blocks; ++i, index += 3 ) {
-		c1 = buf[index+0L];
-		c2 = buf[index+1L];
-		c3 = buf[index+2L];
-
-		encStr.Append((char)basis_64[c1>>2]);
-		encStr.Append((char)basis_64[((c1 & 0x3)<< 4) | ((c2 & 0xF0) >> 4)]);
-		encStr.Append((char)basis_64[((c2 & 0xF) << 2) | ((c3 & 0xC0) >>6)]);
-		encStr.Append((char)basis_64[c3 & 0x3F] );
+	char out[cChunkBlocks * 4L];
+	while ( blocks > 0L ) {
+		long lChunk = ( blocks < cChunkBlocks ) ? blocks : cChunkBlocks;
+		encStr.Append(static_cast<const void *>(out), EncodeBlocks(basis_64, buf, lChunk, out));
+		buf += lChunk * cBlockSize;
+		blocks -= lChunk;
 	}
-
 	if ( remBytes != 0 ) {
-		c1 = buf[index];
-		c2 = (index + 1L < str.Length()) ? buf[index+1L] : 0;
-		c3 = 0;
-
-		encStr.Append(basis_64[c1>>2]);
-		encStr.Append(basis_64[((c1 & 0x3)<< 4) | ((c2 & 0xF0) >> 4)]);
-
-		if ( remBytes == 2 ) {
-			encStr.Append(basis_64[((c2 & 0xF) << 2) | ((c3 & 0xC0) >>6)]);
-			encStr.Append('=');
-		} else {
-			encStr.Append('=');
-			encStr.Append('=');
-		}
+		encStr.Append(static_cast<const void *>(out), EncodeTail(basis_64, buf, remBytes, out));
 	}
 	Trace("Result =" << encStr);
 }
@@ -72,37 +111,17 @@ bool Base64::DoDecode(String &str, const String &encStr) const
 	StartTrace(Base64.DoDecode);
 	Trace("input = " << encStr);
 	const int cBlockSize = 4;
-	unsigned char c1, c2, c3, c4;
-	unsigned char cr1, cr2, cr3, cr4;
-	unsigned char byte1, byte2, byte3;
 	long blocks = encStr.Length() / cBlockSize;
 	long remBytes = encStr.Length() % cBlockSize; // should be 0
-	long index = 0;
-
-	for ( long i = 0; i < blocks; ++i, index += 4 ) {
-		cr1 = encStr[index+0L];
-		cr2 = encStr[index+1L];
-		cr3 = encStr[index+2L];
-		cr4 = encStr[index+3L];
-
-		c1 = CHAR64(cr1);
-		c2 = CHAR64(cr2);
-		c3 = (cr3 == '=') ? 0 : CHAR64(cr3);
-		c4 = (cr4 == '=') ? 0 : CHAR64(cr4);
-
-		byte1 = ((c1 << 2) | ((c2 & 0x30) >> 4));
-		str.Append((char) byte1 );
-		if (cr3 == '=') {
-			// we're done
-		} else {
-			byte2 = ((c2 & 0x0F) << 4) | ((c3 & 0x3C) >> 2);
-			str.Append((char) (byte2) );
-
-			if (cr4 != '=') {
-				byte3 = (((c3 & 0x03) << 6) | c4);
-				str.Append((char) (byte3) );
-			}
-		}
+	str.Reserve(str.Length() + blocks * 3L + 1L);
+
+	const char *buf = encStr;
+	char out[cChunkBlocks * 3L];
+	while ( blocks > 0L ) {
+		long lChunk = ( blocks < cChunkBlocks ) ? blocks : cChunkBlocks;
+		str.Append(static_cast<const void *>(out), DecodeBlocks(buf, lChunk, out));
+		buf += lChunk * cBlockSize;
+		blocks -= lChunk;
 	}
 
 	if ( remBytes != 0 ) {
@@ -113,6 +132,97 @@ bool Base64::DoDecode(String &str, const String &encStr) const
 	return true;
 }
 
+Base64StreamBuf::Base64StreamBuf(std::ostream &os, const Base64 &aCodec, eMode mode, long lBufSize, Allocator *alloc)
+	: fAllocator(alloc ? alloc : coast::storage::Current())
+	, fStore(fAllocator)
+	, fOut(fAllocator)
+	, fOs(&os)
+	, fBasis(aCodec.GetBasis())
+	, fMode(mode)
+	// multiple of 12 to hold complete encoding and decoding groups
+	, fBufSize(((lBufSize > 12L ? lBufSize : 12L) + 11L) / 12L * 12L)
+	, fCorrupted(false)
+{
+	fStore.Reserve(fBufSize + 1L);
+	fOut.Reserve(fBufSize / 3L * 4L + 1L);
+	setg(0, 0, 0);
+	pinit(0L);
+}
+
+Base64StreamBuf::~Base64StreamBuf()
+{
+	close();
+}
+
+void Base64StreamBuf::pinit(long lKeep)
+{
+	char *sc = (char *)(const char *)fStore;
+	setp(sc, sc + fBufSize);
+	pbump(static_cast<int>(lKeep));
+}
+
+void Base64StreamBuf::Convert()
+{
+	StartTrace(Base64StreamBuf.Convert);
+	long len = pptr() - pbase();
+	long lBlockSize = ( fMode == eEncode ) ? 3L : 4L;
+	long lBlocks = len / lBlockSize, lKeep = len % lBlockSize;
+	char *pOut = (char *)(const char *)fOut;
+	long lOutLen = ( fMode == eEncode ) ? Base64::EncodeBlocks(fBasis, pbase(), lBlocks, pOut) : Base64::DecodeBlocks(pbase(), lBlocks, pOut);
+	fOs->write(pOut, lOutLen);
+	if ( lKeep > 0L ) {
+		memmove(pbase(), pbase() + lBlocks * lBlockSize, lKeep);
+	}
+	pinit(lKeep);
+}
+
+int Base64StreamBuf::sync()
+{
+	StartTrace(Base64StreamBuf.sync);
+	if (!fOs) {
+		return EOF;
+	}
+	Convert();
+	fOs->flush();
+	return 0;
+}
+
+bool Base64StreamBuf::close()
+{
+	StartTrace(Base64StreamBuf.close);
+	if (!fOs) {
+		return !fCorrupted;
+	}
+	Convert();
+	long lRemaining = pptr() - pbase();
+	if ( lRemaining > 0L ) {
+		if ( fMode == eEncode ) {
+			char out[4];
+			fOs->write(out, Base64::EncodeTail(fBasis, pbase(), lRemaining, out));
+		} else {
+			Trace("invalid aligned input stream");
+			SystemLog::Warning("Warning encoded stream is corrupted");
+			fCorrupted = true;
+		}
+	}
+	fOs->flush();
+	fOs = 0;
+	setp(0, 0);
+	return !fCorrupted;
+}
+
+int Base64StreamBuf::overflow(int c)
+{
+	if (!fOs) {
+		return EOF;
+	}
+	Convert();
+	if (c != EOF && (pptr() < epptr())) { // guard against recursion
+		sputc(c);
+	}
+	return 0L;  // return 0 if successful
+}
+
 // basis64 table defines conversion table for Base64 encoding scheme.
 // The last character '/' is replaced with '$' since a / is recognized by
 // the browser and has to be escaped
@@ -10,6 +10,7 @@
 #define _base64_h_
 
 #include "SecurityModule.h"
+#include "StringStream.h"
 
 //---- Base64 -----------------------------------------------------------
 //! Coasts Base64 encoding with the default URL style using -$ instead
@@ -29,6 +30,34 @@ public:
 	//! hook from SecurityItem decoding base 64 encoded string
 	virtual bool DoDecode(String &cleartext, const String &scrambledText) const;
 
+	//! the 64 character alphabet used for encoding
+	const char *GetBasis() const {
+		return DoGetBasis();
+	}
+
+	/*! encode complete groups of three bytes
+		\param basis alphabet to use
+		\param pIn input, must contain at least 3*lBlocks bytes
+		\param lBlocks number of three byte groups to encode
+		\param pOut output buffer, must have room for 4*lBlocks characters
+		\return number of characters written */
+	static long EncodeBlocks(const char *basis, const char *pIn, long lBlocks, char *pOut);
+
+	/*! encode the trailing one or two bytes including padding
+		\param basis alphabet to use
+		\param pIn input bytes
+		\param lRemBytes number of remaining bytes, 1 or 2
+		\param pOut output buffer, must have room for 4 characters
+		\return number of characters written */
+	static long EncodeTail(const char *basis, const char *pIn, long lRemBytes, char *pOut);
+
+	/*! decode complete groups of four characters, both alphabets are accepted
+		\param pIn input, must contain at least 4*lBlocks characters
+		\param lBlocks number of four character groups to decode
+		\param pOut output buffer, must have room for 3*lBlocks bytes
+		\return number of bytes written */
+	static long DecodeBlocks(const char *pIn, long lBlocks, char *pOut);
+
 protected:
 	//! hook for using the two different mappings, this one uses URL style
 	virtual const char *DoGetBasis() const {
@@ -68,4 +97,103 @@ private:
 	Base64Regular &operator=(const Base64Regular &);
 };
 
+//! Streambuffer for Base64OStream, encodes or decodes everything written to it into the wrapped ostream
+/*! Only complete groups (3 bytes when encoding, 4 characters when decoding) are converted when the buffer
+fills up or on sync(), the remainder is kept until more data arrives or the stream gets closed. */
+class Base64StreamBuf : public std::streambuf
+{
+public:
+	enum eMode {
+		eEncode,
+		eDecode
+	};
+	//! \param os wrapped output stream receiving the converted data
+	//! \param aCodec defines the alphabet used when encoding
+	//! \param mode encode or decode
+	//! \param lBufSize size of the internal buffer, rounded up to a multiple of 12
+	//! \param a memory allocator
+	Base64StreamBuf(std::ostream &os, const Base64 &aCodec, eMode mode, long lBufSize = 4092L, Allocator *a = coast::storage::Current());
+	virtual ~Base64StreamBuf();
+
+	//! Converts all complete groups of the buffer and flushes the wrapped ostream.
+	virtual int sync();
+
+	//! Converts the rest of the buffer, adds padding when encoding.
+	//! After close() the stream can not be used anymore.
+	//! \return false if the decoded input was not a multiple of four characters
+	bool close();
+
+protected:
+	//! consumes chars of the put area
+	virtual int overflow(int c = EOF);
+
+	//! converts complete groups and moves the remaining bytes to the start of the buffer
+	void Convert();
+	void pinit(long lKeep);
+
+	Allocator *fAllocator;
+	//! the storage of the holding area buffer
+	String fStore;
+	//! buffer receiving converted data before writing it to the wrapped ostream
+	String fOut;
+	//! the wrapped ostream
+	std::ostream *fOs;
+	const char *fBasis;
+	eMode fMode;
+	long fBufSize;
+	bool fCorrupted;
+
+private:
+	Base64StreamBuf(const Base64StreamBuf &);
+	Base64StreamBuf &operator=(const Base64StreamBuf &);
+};
+
+//! Base class for Base64OStream
+class Base64StreamBase : virtual public std::ios
+{
+public:
+	Base64StreamBase(std::ostream &os, const Base64 &aCodec, Base64StreamBuf::eMode mode, long lBufSize)
+		: fBuf(os, aCodec, mode, lBufSize) {
+		init(&fBuf);
+	}
+
+	//! Gets the internal buffer of the stream.
+	Base64StreamBuf *rdbuf() {
+		return &fBuf;
+	}
+
+	//! \copydoc Base64StreamBuf::close()
+	bool close() {
+		return fBuf.close();
+	}
+
+protected:
+	Base64StreamBuf fBuf;
+};
+
+//! Output stream filter encoding or decoding Base64 on the fly
+/*! Allows converting large bodies without holding the complete input and output in memory at once.
+\code
+Base64Regular b64("b64r");
+Base64OStream os(std::cout, b64);
+os << anyLargeInput;
+os.close();
+\endcode */
+class Base64OStream : public Base64StreamBase, public std::ostream
+{
+public:
+	//! \param os wrapped output stream receiving the converted data
+	//! \param aCodec defines the alphabet used when encoding
+	//! \param mode encode (default) or decode
+	//! \param lBufSize size of the internal buffer
+	Base64OStream(std::ostream &os, const Base64 &aCodec, Base64StreamBuf::eMode mode = Base64StreamBuf::eEncode, long lBufSize = 4092L)
+		: Base64StreamBase(os, aCodec, mode, lBufSize), std::ostream(rdbuf()) {}
+
+	//! The conversion is finished and the stream is closed.
+	//! The wrapped ostream is not closed.
+	virtual ~Base64OStream() {
+		close();
+	}
+};
+
 #endif
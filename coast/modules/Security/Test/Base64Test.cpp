@@ -20,6 +20,7 @@ Test *Base64Test::suite ()
 
 	ADD_CASE(testSuite, Base64Test, EncodeDecodeTest);
 	ADD_CASE(testSuite, Base64Test, EncodeDecodeOriginalTest);
+	ADD_CASE(testSuite, Base64Test, StreamEncodeDecodeTest);
 
 	return testSuite;
 
@@ -429,3 +430,58 @@ void Base64Test::EncodeDecodeOriginalTest()
 	t_assert( EncodedString.Length() == CalcEncodedLength( OriginalString.Length() ) );
 	assertCharPtrEqual( "AAECAwQFBg==", EncodedString );
 }
+
+void Base64Test::StreamEncodeDecodeTest()
+{
+	Base64 base64("base64");
+	Base64Regular base64r("base64r");
+	String OriginalString;
+	for ( long i = 0; i < 5000L; ++i ) {
+		OriginalString.Append( (char)(i * 7L) );
+	}
+	long lengths[] = { 0L, 1L, 2L, 3L, 4L, 11L, 12L, 13L, 4091L, 4092L, 4093L, 5000L };
+	long bufSizes[] = { 1L, 12L, 100L, 4092L };
+	for ( unsigned int l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l ) {
+		String strInput(OriginalString.SubString(0L, lengths[l]));
+		for ( unsigned int b = 0; b < sizeof(bufSizes) / sizeof(bufSizes[0]); ++b ) {
+			String strExpected, strEncoded, strDecoded, strExpectedRegular, strEncodedRegular;
+			base64.DoEncode(strExpected, strInput);
+			{
+				OStringStream os(strEncoded);
+				Base64OStream b64os(os, base64, Base64StreamBuf::eEncode, bufSizes[b]);
+				// write in odd sized pieces to cross buffer and group boundaries
+				for ( long pos = 0L; pos < strInput.Length(); pos += 5L ) {
+					b64os.write((const char *)strInput + pos, std::min(5L, strInput.Length() - pos));
+				}
+				t_assert(b64os.close());
+			}
+			assertEqualm(strExpected, strEncoded, TString("encode length:") << lengths[l] << " buffer:" << bufSizes[b]);
+			{
+				OStringStream os(strDecoded);
+				Base64OStream b64os(os, base64, Base64StreamBuf::eDecode, bufSizes[b]);
+				b64os << strEncoded;
+				t_assert(b64os.close());
+			}
+			assertEqualm(strInput.Length(), strDecoded.Length(), TString("decode length:") << lengths[l] << " buffer:" << bufSizes[b]);
+			t_assert( memcmp( (const char *)strInput, (const char *)strDecoded, strInput.Length() ) == 0 );
+
+			base64r.DoEncode(strExpectedRegular, strInput);
+			{
+				OStringStream os(strEncodedRegular);
+				Base64OStream b64os(os, base64r, Base64StreamBuf::eEncode, bufSizes[b]);
+				b64os << strInput;
+			}
+			assertEqualm(strExpectedRegular, strEncodedRegular, TString("regular encode length:") << lengths[l] << " buffer:" << bufSizes[b]);
+		}
+	}
+	String strCorrupted, strDecoded;
+	base64.DoEncode(strCorrupted, OriginalString.SubString(0L, 30L));
+	strCorrupted.Append("AB");
+	{
+		OStringStream os(strDecoded);
+		Base64OStream b64os(os, base64, Base64StreamBuf::eDecode);
+		b64os << strCorrupted;
+		t_assertm(!b64os.close(), "input not aligned to four characters must be reported");
+	}
+	assertEqual(30L, strDecoded.Length());
+}
@@ -27,6 +27,8 @@ public:
 
 	void EncodeDecodeTest();
 	void EncodeDecodeOriginalTest();
+	//! checks Base64OStream against DoEncode/DoDecode for various lengths and buffer sizes
+	void StreamEncodeDecodeTest();
 
 protected:
 	//--- subclass api
@@ -11,6 +11,16 @@
 #include "MIMEHeader.h"
 #include "Tracer.h"
 #include "HTTPConstants.h"
+#include "SystemFile.h"
+#include "SystemBase.h"
+#include "SystemLog.h"
+#include "Threads.h"
+#include <cstring>
+#include <algorithm>
+#if !defined(WIN32)
+#include <cstdlib>
+#include <unistd.h>
+#endif
 
 namespace {
 	void Decode(String str, Anything &result) {
@@ -18,6 +28,342 @@ namespace {
 		coast::urlutils::Split(coast::urlutils::TrimENDL(str), '&', result);
 		coast::urlutils::DecodeAll(result);
 	}
+
+	SimpleMutex fgBufferedBytesMutex("HTTPPostRequestBodyParserBufferedBytes", coast::storage::Global());
+	long fgBufferedBytes = 0L;
+
+	//! size of the window scanned for boundaries, the longest boundary accepted is a fraction of it
+	const long cScanBufferSize = 16384L;
+	const long cMaxBoundaryLength = 1024L;
+}
+
+//! reads a multipart body in chunks and splits it at delimiter lines (line starting with "--" and the boundary)
+/*! Reads never go beyond the body, so a pipelined request following it stays in the stream. With a Content-Length
+ * only data already available and within that length is read once the first byte is there, the epilogue left after
+ * the closing delimiter is skipped. Without one, reads stop at every line end because only the closing delimiter
+ * line ends the body. The delimiter search uses memchr for the line ends, which is vectorized by the usual C libraries.
+ */
+class HTTPPostRequestBodyParser::BoundaryScanner {
+	BoundaryScanner(const BoundaryScanner &);
+	BoundaryScanner &operator=(const BoundaryScanner &);
+	HTTPPostRequestBodyParser &fParser;
+	std::istream &fInput;
+	String fDelimiter;
+	long fRemaining, fBegin, fEnd;
+	bool fEof;
+	char fBuf[cScanBufferSize];
+
+	//! position of the LF starting the next complete delimiter at or after lFrom, -1 if none
+	long FindDelimiter(long lFrom) const {
+		const long lDelimLen = fDelimiter.Length();
+		while (lFrom < fEnd) {
+			const char *p = static_cast<const char *>(memchr(fBuf + lFrom, '\n', fEnd - lFrom));
+			if (!p) {
+				break;
+			}
+			long pos = p - fBuf;
+			if (pos + lDelimLen > fEnd) {
+				break;
+			}
+			if (memcmp(p, (const char *) fDelimiter, lDelimLen) == 0) {
+				return pos;
+			}
+			lFrom = pos + 1L;
+		}
+		return -1L;
+	}
+	//! move unconsumed bytes to the front and append what is available from input
+	bool Fill() {
+		if (fEof) {
+			return false;
+		}
+		if (fBegin > 0L) {
+			memmove(fBuf, fBuf + fBegin, fEnd - fBegin);
+			fEnd -= fBegin;
+			fBegin = 0L;
+		}
+		long lRoom = cScanBufferSize - fEnd;
+		if (fRemaining >= 0L) {
+			lRoom = std::min(lRoom, fRemaining);
+			fEof = (fRemaining == 0L);
+		}
+		std::streambuf *sb = fInput.rdbuf();
+		if (lRoom <= 0L || fEof || !fInput.good() || !sb) {
+			return false;
+		}
+		if (sb->sgetc() == EOF) {
+			fInput.setstate(std::ios::eofbit);
+			fEof = true;
+			return false;
+		}
+		long lRead = 0L;
+		if (fRemaining >= 0L) {
+			std::streamsize lAvail = sb->in_avail();
+			lRead = sb->sgetn(fBuf + fEnd, std::min(lRoom, static_cast<long>(lAvail > 0 ? lAvail : 1)));
+		} else {
+			int c = EOF;
+			while (lRead < lRoom && (c = sb->sbumpc()) != EOF) {
+				fBuf[fEnd + lRead++] = static_cast<char>(c);
+				if (c == '\n') {
+					break;
+				}
+			}
+		}
+		if (lRead <= 0L) {
+			fEof = true;
+			return false;
+		}
+		fParser.AppendUnparsed(fBuf + fEnd, lRead);
+		fEnd += lRead;
+		if (fRemaining >= 0L) {
+			fRemaining -= lRead;
+		}
+		return true;
+	}
+public:
+	BoundaryScanner(HTTPPostRequestBodyParser &parser, std::istream &input, const String &bound, long lContentLength) :
+		fParser(parser), fInput(input), fDelimiter("\n--"), fRemaining(lContentLength), fBegin(0L), fEnd(1L), fEof(false) {
+		fDelimiter.Append(bound);
+		// a delimiter at the very beginning of the body is not preceded by a line end
+		fBuf[0] = '\n';
+	}
+	//! pass everything up to the next delimiter line to sink, the line end in front of the delimiter belongs to it
+	//! \return true if a delimiter line was consumed, bLast tells whether it closes the multipart body
+	bool NextDelimiter(PartSink &sink, bool &bLast);
+	//! bytes read from input after the last consumed delimiter line
+	long Unconsumed() const {
+		return fEnd - fBegin;
+	}
+	//! read and drop the rest of the body announced by Content-Length, it is not part of the unparsed content
+	void SkipEpilogue() {
+		std::streambuf *sb = fInput.rdbuf();
+		while (fRemaining > 0L && sb) {
+			long lRead = sb->sgetn(fBuf, std::min(cScanBufferSize, fRemaining));
+			if (lRead <= 0L) {
+				break;
+			}
+			fRemaining -= lRead;
+		}
+		fBegin = fEnd = 0L;
+	}
+};
+
+//! collects one part in memory and moves its body into a spool file when limits are exceeded
+class HTTPPostRequestBodyParser::PartSink {
+	PartSink(const PartSink &);
+	PartSink &operator=(const PartSink &);
+	HTTPPostRequestBodyParser &fParser;
+	String fData, fPath;
+	std::iostream *fFile;
+	long fHeaderEnd, fHeaderScanPos, fFileLength;
+	bool fDiscard;
+
+	//! index behind the empty line ending the part headers, -1 while not yet seen
+	long FindHeaderEnd() {
+		if (fHeaderEnd < 0L) {
+			const char *pData = fData;
+			long lLen = fData.Length();
+			if (lLen > 0L && pData[0] == '\n') {
+				fHeaderEnd = 1L;
+			} else if (lLen > 1L && pData[0] == '\r' && pData[1] == '\n') {
+				fHeaderEnd = 2L;
+			}
+			while (fHeaderEnd < 0L && fHeaderScanPos < lLen) {
+				const char *p = static_cast<const char *>(memchr(pData + fHeaderScanPos, '\n', lLen - fHeaderScanPos));
+				if (!p) {
+					fHeaderScanPos = lLen;
+					break;
+				}
+				long pos = p - pData;
+				if (pos + 1L < lLen && pData[pos + 1L] == '\n') {
+					fHeaderEnd = pos + 2L;
+				} else if (pos + 2L < lLen && pData[pos + 1L] == '\r' && pData[pos + 2L] == '\n') {
+					fHeaderEnd = pos + 3L;
+				} else if (pos + 2L >= lLen) {
+					// incomplete, look at this line end again when more data arrived
+					break;
+				}
+				fHeaderScanPos = pos + 1L;
+			}
+		}
+		return fHeaderEnd;
+	}
+	bool OverThreshold() {
+		return fParser.fSpoolThreshold > 0L && FindHeaderEnd() >= 0L && fData.Length() - fHeaderEnd > fParser.fSpoolThreshold;
+	}
+	bool StartSpool() {
+		StartTrace(HTTPPostRequestBodyParser.StartSpool);
+		if (FindHeaderEnd() < 0L || !(fFile = fParser.CreateSpoolFile(fPath))) {
+			return false;
+		}
+		fFileLength = fData.Length() - fHeaderEnd;
+		fFile->write((const char *) fData + fHeaderEnd, fFileLength);
+		fData = fData.SubString(0L, fHeaderEnd);
+		fParser.ReleaseMemory(fFileLength);
+		fParser.DropUnparsed();
+		Trace("spooling part to [" << fPath << "] after " << fFileLength << " bytes");
+		return true;
+	}
+public:
+	PartSink(HTTPPostRequestBodyParser &parser, bool bDiscard) :
+		fParser(parser), fFile(0), fHeaderEnd(-1L), fHeaderScanPos(0L), fFileLength(0L), fDiscard(bDiscard) {
+	}
+	~PartSink() {
+		delete fFile;
+	}
+	void Write(const char *pBuf, long lLen) {
+		if (fDiscard || lLen <= 0L) {
+			return;
+		}
+		if (fFile) {
+			fFile->write(pBuf, lLen);
+			fFileLength += lLen;
+			return;
+		}
+		bool bFits = fParser.ChargeMemory(lLen);
+		fData.Append(static_cast<const void *>(pBuf), lLen);
+		if (!bFits || OverThreshold()) {
+			StartSpool();
+		}
+	}
+	//! hand the completed part over to the parser
+	void Finish() {
+		if (fDiscard) {
+			return;
+		}
+		if (fFile) {
+			bool bGood = fFile->good();
+			delete fFile;
+			fFile = 0;
+			if (!bGood) {
+				SystemLog::Error(String("HTTPPostRequestBodyParser: writing spool file [") << fPath << "] failed");
+			}
+			fParser.DoAddSpooledPart(fData, fPath, fFileLength);
+		} else if (fData.Length()) {
+			fParser.DoParsePart(fData);
+		}
+	}
+};
+
+bool HTTPPostRequestBodyParser::BoundaryScanner::NextDelimiter(PartSink &sink, bool &bLast) {
+	const long lDelimLen = fDelimiter.Length();
+	bLast = false;
+	for (;;) {
+		long pos = FindDelimiter(fBegin);
+		if (pos >= 0L) {
+			long lPartEnd = (pos > fBegin && fBuf[pos - 1L] == '\r') ? pos - 1L : pos;
+			sink.Write(fBuf + fBegin, lPartEnd - fBegin);
+			fBegin = pos;
+			// the rest of the delimiter line tells whether this is the closing delimiter
+			const char *pEol = 0;
+			while (!(pEol = static_cast<const char *>(memchr(fBuf + fBegin + lDelimLen, '\n', fEnd - fBegin - lDelimLen))) && Fill()) {
+			}
+			long lAfter = fBegin + lDelimLen;
+			bLast = (lAfter + 1L < fEnd && fBuf[lAfter] == '-' && fBuf[lAfter + 1L] == '-');
+			fBegin = pEol ? (pEol - fBuf) + 1L : fEnd;
+			return true;
+		}
+		// keep what could be the start of a delimiter including a preceding CR
+		long lSafeEnd = fEnd - lDelimLen - 1L;
+		if (lSafeEnd > fBegin) {
+			sink.Write(fBuf + fBegin, lSafeEnd - fBegin);
+			fBegin = lSafeEnd;
+		}
+		if (!Fill()) {
+			sink.Write(fBuf + fBegin, fEnd - fBegin);
+			fBegin = fEnd;
+			return false;
+		}
+	}
+}
+
+void HTTPPostRequestBodyParser::SetSpoolConfig(const ROAnything config) {
+	StartTrace(HTTPPostRequestBodyParser.SetSpoolConfig);
+	TraceAny(config, "spool config");
+	fSpoolThreshold = config["Threshold"].AsLong(0L);
+	fRequestMemoryLimit = config["RequestMemoryLimit"].AsLong(0L);
+	fGlobalMemoryLimit = config["GlobalMemoryLimit"].AsLong(0L);
+	fSpoolDirectory = config["Directory"].AsString();
+}
+
+long HTTPPostRequestBodyParser::GetGloballyBufferedBytes() {
+	LockUnlockEntry me(fgBufferedBytesMutex);
+	return fgBufferedBytes;
+}
+
+bool HTTPPostRequestBodyParser::ChargeMemory(long lBytes) {
+	long lGlobal = 0L;
+	{
+		LockUnlockEntry me(fgBufferedBytesMutex);
+		fgBufferedBytes += lBytes;
+		lGlobal = fgBufferedBytes;
+	}
+	fGloballyChargedBytes += lBytes;
+	fBufferedBytes += lBytes;
+	return (fRequestMemoryLimit <= 0L || fBufferedBytes <= fRequestMemoryLimit) && (fGlobalMemoryLimit <= 0L || lGlobal <= fGlobalMemoryLimit);
+}
+
+void HTTPPostRequestBodyParser::ReleaseMemory(long lBytes) {
+	lBytes = std::min(lBytes, fGloballyChargedBytes);
+	{
+		LockUnlockEntry me(fgBufferedBytesMutex);
+		fgBufferedBytes -= lBytes;
+	}
+	fGloballyChargedBytes -= lBytes;
+	fBufferedBytes -= lBytes;
+}
+
+void HTTPPostRequestBodyParser::AppendUnparsed(const char *pBuf, long lLen) {
+	if (fUnparsedContentDropped) {
+		return;
+	}
+	if (ChargeMemory(lLen)) {
+		fUnparsedContent.Append(static_cast<const void *>(pBuf), lLen);
+	} else {
+		ReleaseMemory(lLen);
+		DropUnparsed();
+	}
+}
+
+void HTTPPostRequestBodyParser::DropUnparsed() {
+	if (!fUnparsedContentDropped) {
+		StartTrace1(HTTPPostRequestBodyParser.DropUnparsed, "dropping " << fUnparsedContent.Length() << " bytes");
+		fUnparsedContentDropped = true;
+		ReleaseMemory(fUnparsedContent.Length());
+		fUnparsedContent = String();
+	}
+}
+
+std::iostream *HTTPPostRequestBodyParser::CreateSpoolFile(String &path) {
+	StartTrace(HTTPPostRequestBodyParser.CreateSpoolFile);
+	path = fSpoolDirectory.Length() ? fSpoolDirectory : coast::system::GetTempPath();
+	path.Append(coast::system::Sep()).Append("coast_upload_");
+#if !defined(WIN32)
+	path.Append("XXXXXX");
+	// create the file exclusively to not follow links planted in a shared temp directory
+	int fd = mkstemp(const_cast<char *>((const char *) path));
+	if (fd < 0) {
+		SystemLog::Error(String("HTTPPostRequestBodyParser: could not create spool file in [") << path << "]");
+		return 0;
+	}
+	::close(fd);
+#else
+	path.Append(static_cast<long>(coast::system::getpid())).Append('_').Append(fSpooledFiles.GetSize());
+#endif
+	fSpooledFiles.Append(path);
+	std::iostream *pFile = coast::system::OpenOStream(path, std::ios::binary | std::ios::trunc);
+	if (!pFile) {
+		SystemLog::Error(String("HTTPPostRequestBodyParser: could not open spool file [") << path << "]");
+	}
+	return pFile;
+}
+
+void HTTPPostRequestBodyParser::RemoveSpooledFiles(const ROAnything spooledFiles) {
+	StartTrace(HTTPPostRequestBodyParser.RemoveSpooledFiles);
+	for (long i = 0, sz = spooledFiles.GetSize(); i < sz; ++i) {
+		Trace("removing [" << spooledFiles[i].AsString() << "]");
+		coast::system::io::unlink(spooledFiles[i].AsCharPtr());
+	}
 }
 
 bool HTTPPostRequestBodyParser::Parse(std::istream &input) {
@@ -127,40 +473,109 @@ bool HTTPPostRequestBodyParser::DoReadToBoundary(std::istream &input, const Stri
 	return false;
 }
 
+namespace {
+	//! the global memory counter only reflects parsers currently reading a body
+	struct GlobalChargeReleaser {
+		long &fCharged;
+		GlobalChargeReleaser(long &lCharged) :
+			fCharged(lCharged) {
+		}
+		~GlobalChargeReleaser() {
+			LockUnlockEntry me(fgBufferedBytesMutex);
+			fgBufferedBytes -= fCharged;
+			fCharged = 0L;
+		}
+	};
+}
+
+void HTTPPostRequestBodyParser::DoParsePart(String &body) {
+	StartTrace(HTTPPostRequestBodyParser.DoParsePart);
+	Trace("Body: <" << body << ">");
+	IStringStream innerpart(body);
+	MIMEHeader hinner;
+	try {
+		if (hinner.ParseHeaders(innerpart)) {
+			Anything partInfo;
+			if (!hinner.GetHeaderInfo().IsDefined(coast::http::constants::contentTypeSlotname)) {
+				hinner.GetHeaderInfo()[coast::http::constants::contentTypeSlotname] = coast::http::constants::contentTypeMultipart;
+			}
+			partInfo["header"] = hinner.GetHeaderInfo();
+			TraceAny(hinner.GetHeaderInfo(), "Header: ");
+
+			HTTPPostRequestBodyParser part(hinner);
+			// nested multipart bodies spool their parts the same way
+			part.fSpoolThreshold = fSpoolThreshold;
+			part.fRequestMemoryLimit = fRequestMemoryLimit;
+			part.fGlobalMemoryLimit = fGlobalMemoryLimit;
+			part.fSpoolDirectory = fSpoolDirectory;
+			part.Parse(innerpart); // if we found a boundary, could we unget it?
+
+			partInfo["body"] = part.GetContent();
+			fContent.Append(partInfo);
+			for (long i = 0, sz = part.GetSpooledFiles().GetSize(); i < sz; ++i) {
+				fSpooledFiles.Append(part.GetSpooledFiles()[i]);
+			}
+		}
+	} catch (MIMEHeader::StreamNotGoodException &e) {
+		;
+	}
+}
+
+void HTTPPostRequestBodyParser::DoAddSpooledPart(String &header, const String &path, long length) {
+	StartTrace1(HTTPPostRequestBodyParser.DoAddSpooledPart, "path: <" << path << "> length: " << length);
+	IStringStream innerpart(header);
+	MIMEHeader hinner;
+	try {
+		if (hinner.ParseHeaders(innerpart)) {
+			Anything partInfo;
+			if (!hinner.GetHeaderInfo().IsDefined(coast::http::constants::contentTypeSlotname)) {
+				hinner.GetHeaderInfo()[coast::http::constants::contentTypeSlotname] = coast::http::constants::contentTypeMultipart;
+			}
+			partInfo["header"] = hinner.GetHeaderInfo();
+			partInfo["file"]["Path"] = path;
+			partInfo["file"]["Length"] = length;
+			TraceAny(partInfo, "spooled part");
+			fContent.Append(partInfo);
+		}
+	} catch (MIMEHeader::StreamNotGoodException &e) {
+		;
+	}
+}
+
 bool HTTPPostRequestBodyParser::DoParseMultiPart(std::istream &input, const String &bound) {
 	// assume next on input is bound and a line separator
 	StartTrace(HTTPPostRequestBodyParser.DoParseMultiPart);
+	if (bound.Length() == 0L || bound.Length() > cMaxBoundaryLength) {
+		SystemLog::Warning(String("HTTPPostRequestBodyParser: invalid multipart boundary length ") << bound.Length());
+		return false;
+	}
+	GlobalChargeReleaser releaser(fGloballyChargedBytes);
+	BoundaryScanner scanner(*this, input, bound, fHeader.GetContentLength());
 	bool endReached = false;
-
-	while (!endReached && input.good()) {
+	{
+		// anything in front of the first delimiter is preamble and ignored
+		PartSink preamble(*this, true);
+		if (!scanner.NextDelimiter(preamble, endReached)) {
+			Trace("no boundary found");
+			return false;
+		}
+	}
+	while (!endReached) {
 		// reaching eof is an error since end of input is determined by separators
-		String body;
-		endReached = DoReadToBoundary(input, bound, body);
-		Trace("Body: <" << body << ">");
-		if (body.Length()) {
-			IStringStream innerpart(body);
-			MIMEHeader hinner;
-			try {
-				if (hinner.ParseHeaders(innerpart)) {
-					Anything partInfo;
-					if (!hinner.GetHeaderInfo().IsDefined(coast::http::constants::contentTypeSlotname)) {
-						hinner.GetHeaderInfo()[coast::http::constants::contentTypeSlotname] = coast::http::constants::contentTypeMultipart;
-					}
-					partInfo["header"] = hinner.GetHeaderInfo();
-					TraceAny(hinner.GetHeaderInfo(), "Header: ");
-
-					HTTPPostRequestBodyParser part(hinner);
-					part.Parse(innerpart); // if we found a boundary, could we unget it?
-
-					partInfo["body"] = part.GetContent();
-					fContent.Append(partInfo);
-				}
-			} catch (MIMEHeader::StreamNotGoodException &e) {
-				;
-			}
+		PartSink part(*this, false);
+		bool delimiterFound = scanner.NextDelimiter(part, endReached);
+		part.Finish();
+		if (!delimiterFound) {
+			break;
 		}
 	}
+	if (endReached && !fUnparsedContentDropped) {
+		// epilogue already read from the stream does not belong to the parsed content
+		fUnparsedContent.Trim(fUnparsedContent.Length() - scanner.Unconsumed());
+	}
+	if (endReached) {
+		scanner.SkipEpilogue();
+	}
 	Trace("Actual length of unparsed body: " << fUnparsedContent.Length());
-
 	return endReached;
 }
@@ -17,17 +17,42 @@ class MIMEHeader;
 //! where content-disposition gives us a hint for decoding
 //! decodes bodies according to normal browser POST requests
 //! only works for multipart-form data
+/*! Multipart bodies are scanned in chunks for the boundary. Parts larger than the configured spool threshold,
+ * or parts arriving while the per request or global memory limit is exhausted, are written to temporary files.
+ * Such a part appears in the content as <tt>{ /header {...} /file { /Path "..." /Length n } }</tt> instead of
+ * <tt>{ /header {...} /body {...} }</tt>. The caller owns the files listed by GetSpooledFiles() and has to remove them.
+ * Spool configuration, see SetSpoolConfig():<pre>
+ * /Threshold			bytes of a part body kept in memory, larger parts are spooled, 0 (default) never spools
+ * /RequestMemoryLimit	bytes of part data and unparsed content kept in memory per request, 0 (default) means unlimited
+ * /GlobalMemoryLimit	bytes of part data buffered by all concurrently parsed requests, 0 (default) means unlimited
+ * /Directory			where to create spool files, default coast::system::GetTempPath()
+ * </pre>
+ * Parts of nested multipart bodies are spooled with the same configuration, their files are listed by GetSpooledFiles() too.
+ * The unparsed content, WHOLE_REQUEST_BODY of the request, is not retained at all once a part is spooled or
+ * RequestMemoryLimit is exceeded, see IsUnparsedContentDropped().
+ */
 class HTTPPostRequestBodyParser {
 	HTTPPostRequestBodyParser();
 	MIMEHeader &fHeader;
 	Anything fContent;
 	String fUnparsedContent;
+	Anything fSpooledFiles;
+	long fSpoolThreshold, fRequestMemoryLimit, fGlobalMemoryLimit;
+	String fSpoolDirectory;
+	//! bytes kept in memory for this request, checked against fRequestMemoryLimit
+	long fBufferedBytes;
+	//! part of fBufferedBytes accounted in the global counter until DoParseMultiPart returns
+	long fGloballyChargedBytes;
+	bool fUnparsedContentDropped;
 public:
 	//! ctor requires a header for parameters on length and decoding
 	HTTPPostRequestBodyParser(MIMEHeader &mainheader) :
-		fHeader(mainheader) {
+		fHeader(mainheader), fSpoolThreshold(0L), fRequestMemoryLimit(0L), fGlobalMemoryLimit(0L), fBufferedBytes(0L),
+				fGloballyChargedBytes(0L), fUnparsedContentDropped(false) {
 	}
 	virtual ~HTTPPostRequestBodyParser() {}
+	//! configure spooling of large multipart parts, see class description for the slots used
+	void SetSpoolConfig(const ROAnything config);
 	//! do the parsing, read everything
 	bool Parse(std::istream &input);
 	//! return the decoded result after parsing
@@ -38,6 +63,18 @@ public:
 	String &GetUnparsedContent() {
 		return fUnparsedContent;
 	}
+	//! whether the unparsed body was dropped to save memory, GetUnparsedContent() is empty then
+	bool IsUnparsedContentDropped() const {
+		return fUnparsedContentDropped;
+	}
+	//! return the paths of all temporary files created while parsing
+	Anything &GetSpooledFiles() {
+		return fSpooledFiles;
+	}
+	//! remove the files listed in spooledFiles, e.g. after the request has been processed
+	static void RemoveSpooledFiles(const ROAnything spooledFiles);
+	//! number of bytes currently buffered by all multipart parsers of the process
+	static long GetGloballyBufferedBytes();
 
 protected:
 	// operational methods
@@ -47,9 +84,24 @@ protected:
 	//! parse the mime body, usually xxx-form-urlencoded
 	//! \return indicates whether body was successfully read
 	virtual bool DoParseBody(std::istream &input);
-	//! auxiliary for ParseMultiPart
+	//! line based reading of one part up to the next boundary, DoParseMultiPart scans chunks itself
 	//! \return indicates whether body was successfully read
 	virtual bool DoReadToBoundary(std::istream &input, const String &bound, String &body);
+	//! decode a part kept in memory, body starts with the part headers
+	virtual void DoParsePart(String &body);
+	//! add a spooled part, header contains the raw part headers
+	virtual void DoAddSpooledPart(String &header, const String &path, long length);
+
+private:
+	class BoundaryScanner;
+	class PartSink;
+	//! account lBytes against the request and global limits, returns false if either is exceeded now
+	bool ChargeMemory(long lBytes);
+	void ReleaseMemory(long lBytes);
+	//! create a new spool file, returns 0 on failure
+	std::iostream *CreateSpoolFile(String &path);
+	void AppendUnparsed(const char *pBuf, long lLen);
+	void DropUnparsed();
 };
 
 #endif
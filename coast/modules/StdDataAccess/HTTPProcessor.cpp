@@ -21,6 +21,13 @@
 RegisterRequestProcessor(HTTPProcessor);
 
 namespace {
+	void RemoveSpooledRequestFiles(Context &ctx) {
+		ROAnything roaFiles;
+		if (ROAnything(ctx.GetRequest())["env"].LookupPath(roaFiles, "SPOOLED_FILES")) {
+			HTTPPostRequestBodyParser::RemoveSpooledFiles(roaFiles);
+		}
+	}
+
 	void CopyClientInfoIntoRequest(Context &ctx) {
 		Anything args(ctx.GetRequest());
 		long sz = args["ClientInfo"].GetSize();
@@ -98,6 +105,7 @@ bool HTTPProcessor::DoReadRequestBody(std::iostream &Ios, Context &ctx, Anything
 	MethodTimer(HTTPProcessor.DoReadRequestBody, "Reading request body", ctx);
 	if ( request["REQUEST_METHOD"].AsString().IsEqual(coast::http::constants::postMethodSlotname) ) {
 		HTTPPostRequestBodyParser sm = GetRequestBodyParser(reader.GetHeaderParser());
+		sm.SetSpoolConfig(ctx.Lookup("MultiPartSpool"));
 		try {
 			sm.Parse(Ios);
 		} catch (MIMEHeader::LineSizeExceededException &e) {
@@ -109,8 +117,17 @@ bool HTTPProcessor::DoReadRequestBody(std::iostream &Ios, Context &ctx, Anything
 		}
 		request["REQUEST_BODY"] = sm.GetContent();
 		TraceAny(request["REQUEST_BODY"], "Body");
-		request["WHOLE_REQUEST_BODY"] = sm.GetUnparsedContent();
-		TraceAny(request["WHOLE_REQUEST_BODY"], "Whole Body");
+		if (sm.IsUnparsedContentDropped()) {
+			// spooled parts or the memory limits do not allow to keep a copy of the whole body
+			Trace("whole request body dropped, WHOLE_REQUEST_BODY not set");
+		} else {
+			request["WHOLE_REQUEST_BODY"] = sm.GetUnparsedContent();
+			TraceAny(request["WHOLE_REQUEST_BODY"], "Whole Body");
+		}
+		if (sm.GetSpooledFiles().GetSize()) {
+			// removed again in DoProcessRequest or when reading/verifying the request failed
+			request["SPOOLED_FILES"] = sm.GetSpooledFiles();
+		}
 	}
 	return true;
 }
@@ -189,12 +206,14 @@ namespace {
 
 bool HTTPProcessor::DoHandleReadInputError(std::iostream &Ios, Context &ctx) {
 	StartTrace(HTTPProcessor.DoHandleReadInputError);
+	RemoveSpooledRequestFiles(ctx);
 	GenericRequestProcessorErrorHandler(Ios, ctx);
 	return false;
 }
 
 bool HTTPProcessor::DoHandleVerifyRequestError(std::iostream &Ios, Context &ctx) {
 	StartTrace(HTTPProcessor.DoHandleVerifyRequestError);
+	RemoveSpooledRequestFiles(ctx);
 	GenericRequestProcessorErrorHandler(Ios, ctx);
 	return false;
 }
@@ -211,7 +230,9 @@ bool HTTPProcessor::DoProcessRequest(std::ostream &reply, Context &ctx)
 	if (IsZipEncodingAcceptedByClient(ctx)) {
 		ctx.GetTmpStore()["ClientAcceptsGzipEnc"] = 1L;
 	}
-	return RequestProcessor::DoProcessRequest(reply, ctx);
+	bool bRet = RequestProcessor::DoProcessRequest(reply, ctx);
+	RemoveSpooledRequestFiles(ctx);
+	return bRet;
 }
 
 void HTTPProcessor::DoRenderProtocolStatus(std::ostream &os, Context &ctx) {
@@ -308,6 +308,175 @@ void HTTPPostRequestBodyParserTest::ParseMultiPartTest()
 	}
 }
 
+namespace {
+	String BuildMultiPartBody(const String &boundary, const String &fileContent) {
+		String body;
+		body << "--" << boundary << "\r\n"
+			 << "Content-Disposition: form-data; name=\"field\"\r\n\r\n"
+			 << "value\r\n"
+			 << "--" << boundary << "\r\n"
+			 << "Content-Disposition: form-data; name=\"upload\"; filename=\"data.bin\"\r\n"
+			 << "Content-Type: application/octet-stream\r\n\r\n"
+			 << fileContent << "\r\n"
+			 << "--" << boundary << "--\r\n";
+		return body;
+	}
+	String BuildFileContent(const String &boundary, long length) {
+		String content(length);
+		for (long i = 0; content.Length() < length; ++i) {
+			// sprinkle line ends and near misses of the delimiter over the content
+			if (i % 97 == 0) {
+				content << "\r\n--" << boundary.SubString(0, boundary.Length() - 1) << 'X';
+			} else {
+				content.Append(static_cast<char>(i % 251));
+			}
+		}
+		content.Trim(length);
+		return content;
+	}
+}
+
+void HTTPPostRequestBodyParserTest::ParseLargeMultiPartTest()
+{
+	StartTrace(HTTPPostRequestBodyParserTest.ParseLargeMultiPartTest);
+	String boundary("---------------------------4711");
+	long lengths[] = { 0L, 1L, 16300L, 16350L, 16384L, 16400L, 40000L };
+	for (unsigned i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+		String fileContent = BuildFileContent(boundary, lengths[i]);
+		String body = BuildMultiPartBody(boundary, fileContent);
+		IStringStream is(body);
+		MIMEHeader mh;
+		TestPostRequestBodyParser sm(mh);
+		t_assertm(sm.DoParseMultiPart(is, boundary), TString("length ") << lengths[i]);
+		assertEqualm(2L, sm.GetContent().GetSize(), TString("length ") << lengths[i]);
+		assertEqualm("value", sm.GetContent()[0L]["body"][0L].AsString(), TString("length ") << lengths[i]);
+		assertEqualm(fileContent, sm.GetContent()[1L]["body"][0L].AsString(), TString("length ") << lengths[i]);
+		assertEqualm(body, sm.GetUnparsedContent(), TString("length ") << lengths[i]);
+	}
+	assertEqual(0L, HTTPPostRequestBodyParser::GetGloballyBufferedBytes());
+}
+
+void HTTPPostRequestBodyParserTest::SpoolMultiPartTest()
+{
+	StartTrace(HTTPPostRequestBodyParserTest.SpoolMultiPartTest);
+	String boundary("---------------------------4712");
+	String fileContent = BuildFileContent(boundary, 50000L);
+	String body = BuildMultiPartBody(boundary, fileContent);
+	Anything spoolConfigs;
+	spoolConfigs[0L]["Threshold"] = 1000L;
+	spoolConfigs[1L]["RequestMemoryLimit"] = 20000L;
+	spoolConfigs[2L]["GlobalMemoryLimit"] = 10000L;
+	for (long i = 0, sz = spoolConfigs.GetSize(); i < sz; ++i) {
+		TString strCase("config ");
+		strCase << i;
+		IStringStream is(body);
+		MIMEHeader mh;
+		TestPostRequestBodyParser sm(mh);
+		sm.SetSpoolConfig(spoolConfigs[i]);
+		t_assertm(sm.DoParseMultiPart(is, boundary), strCase);
+		Anything content = sm.GetContent();
+		assertEqualm(2L, content.GetSize(), strCase);
+		assertEqualm("value", content[0L]["body"][0L].AsString(), strCase);
+		t_assertm(!content[1L].IsDefined("body"), strCase);
+		assertEqualm("data.bin", content[1L]["header"][coast::http::constants::contentDispositionSlotname]["FILENAME"].AsString(), strCase);
+		assertEqualm(fileContent.Length(), content[1L]["file"]["Length"].AsLong(-1L), strCase);
+		assertEqualm(1L, sm.GetSpooledFiles().GetSize(), strCase);
+		String path = content[1L]["file"]["Path"].AsString();
+		assertEqualm(sm.GetSpooledFiles()[0L].AsString(), path, strCase);
+		std::iostream *pFile = coast::system::OpenIStream(path, std::ios::binary);
+		t_assertm(pFile != 0, strCase);
+		if (pFile) {
+			String spooled;
+			spooled.Append(*pFile, fileContent.Length() + 10L);
+			assertEqualm(fileContent, spooled, strCase);
+			delete pFile;
+		}
+		assertEqualm("", sm.GetUnparsedContent(), "unparsed content must not be kept once parts are spooled");
+		HTTPPostRequestBodyParser::RemoveSpooledFiles(sm.GetSpooledFiles());
+		t_assertm(!coast::system::IsRegularFile(path), strCase);
+		assertEqualm(0L, HTTPPostRequestBodyParser::GetGloballyBufferedBytes(), strCase);
+	}
+}
+
+void HTTPPostRequestBodyParserTest::PipelinedRequestTest()
+{
+	StartTrace(HTTPPostRequestBodyParserTest.PipelinedRequestTest);
+	String boundary("---------------------------4713");
+	String body = BuildMultiPartBody(boundary, BuildFileContent(boundary, 20000L));
+	String nextRequest("GET /next HTTP/1.1\r\n\r\n");
+	{
+		// without Content-Length the closing delimiter line ends the body
+		String input(body);
+		input << nextRequest;
+		IStringStream is(input);
+		MIMEHeader mh;
+		TestPostRequestBodyParser sm(mh);
+		t_assert(sm.DoParseMultiPart(is, boundary));
+		assertEqual(body, sm.GetUnparsedContent());
+		String rest;
+		rest.Append(is, nextRequest.Length() + 10L);
+		assertEqualm(nextRequest, rest, "next request must stay in the stream");
+	}
+	{
+		// the epilogue within Content-Length is skipped
+		String epilogue("epilogue\r\n");
+		String input;
+		input << "Content-Type: multipart/form-data; boundary=" << boundary << "\r\n"
+			  << "Content-Length: " << body.Length() + epilogue.Length() << "\r\n\r\n"
+			  << body << epilogue << nextRequest;
+		IStringStream is(input);
+		MIMEHeader mh;
+		t_assert(mh.ParseHeaders(is, 4096, 4096));
+		HTTPPostRequestBodyParser sm(mh);
+		t_assert(sm.Parse(is));
+		assertEqual(2L, sm.GetContent().GetSize());
+		assertEqual(body, sm.GetUnparsedContent());
+		String rest;
+		rest.Append(is, nextRequest.Length() + 10L);
+		assertEqualm(nextRequest, rest, "next request must stay in the stream");
+	}
+	assertEqual(0L, HTTPPostRequestBodyParser::GetGloballyBufferedBytes());
+}
+
+void HTTPPostRequestBodyParserTest::NestedSpoolTest()
+{
+	StartTrace(HTTPPostRequestBodyParserTest.NestedSpoolTest);
+	String boundary("---------------------------4714"), innerBoundary("---------------------------4715");
+	String fileContent = BuildFileContent(innerBoundary, 5000L);
+	String inner;
+	inner << "--" << innerBoundary << "\r\n"
+		  << "Content-Disposition: file; filename=\"inner.bin\"\r\n"
+		  << "Content-Type: application/octet-stream\r\n\r\n"
+		  << fileContent << "\r\n"
+		  << "--" << innerBoundary << "--\r\n";
+	String body;
+	body << "--" << boundary << "\r\n"
+		 << "Content-Disposition: form-data; name=\"files\"\r\n"
+		 << "Content-Type: multipart/mixed; boundary=" << innerBoundary << "\r\n\r\n"
+		 << inner << "\r\n"
+		 << "--" << boundary << "--\r\n";
+	// the outer part fits into the global limit, the nested part charged on top of it does not
+	Anything spoolConfig;
+	spoolConfig["GlobalMemoryLimit"] = 14000L;
+	IStringStream is(body);
+	MIMEHeader mh;
+	TestPostRequestBodyParser sm(mh);
+	sm.SetSpoolConfig(spoolConfig);
+	t_assert(sm.DoParseMultiPart(is, boundary));
+	Anything content = sm.GetContent();
+	TraceAny(content, "content");
+	if (t_assertm(content[0L].IsDefined("body"), "outer part should stay in memory")) {
+		ROAnything roaInner = content[0L]["body"][0L];
+		assertEqual("inner.bin", roaInner["header"][coast::http::constants::contentDispositionSlotname]["FILENAME"].AsString());
+		assertEqual(fileContent.Length(), roaInner["file"]["Length"].AsLong(-1L));
+		if (assertEqual(1L, sm.GetSpooledFiles().GetSize())) {
+			assertEqual(sm.GetSpooledFiles()[0L].AsString(), roaInner["file"]["Path"].AsString());
+		}
+	}
+	HTTPPostRequestBodyParser::RemoveSpooledFiles(sm.GetSpooledFiles());
+	assertEqual(0L, HTTPPostRequestBodyParser::GetGloballyBufferedBytes());
+}
+
 Test *HTTPPostRequestBodyParserTest::suite ()
 {
 	StartTrace(HTTPPostRequestBodyParserTest.suite);
@@ -316,5 +485,9 @@ Test *HTTPPostRequestBodyParserTest::suite ()
 	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, ReadToBoundaryTestWithStreamFailure);
 	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, ParseMultiPartTest);
 	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, ReadMultiPartPost);
+	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, ParseLargeMultiPartTest);
+	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, SpoolMultiPartTest);
+	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, PipelinedRequestTest);
+	ADD_CASE(testSuite, HTTPPostRequestBodyParserTest, NestedSpoolTest);
 	return testSuite;
 }
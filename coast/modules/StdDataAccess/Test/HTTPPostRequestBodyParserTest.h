@@ -30,5 +30,13 @@ public:
 	//!describe this testcase
 	void ReadMultiPartPost();
 	void ReadToBoundaryTestWithStreamFailure();
+	//! parts crossing the internal scan window must be split exactly at the boundary
+	void ParseLargeMultiPartTest();
+	//! large parts go to spool files, small ones stay in memory
+	void SpoolMultiPartTest();
+	//! reading the body must not consume a request following it on the same connection
+	void PipelinedRequestTest();
+	//! parts of a nested multipart body are spooled with the configuration of the outer body
+	void NestedSpoolTest();
 };
 #endif
@@ -112,6 +112,10 @@ extern "C" {
 #define SETTLSDATA(key, data)				(TlsSetValue(key, (void*)data) != 0)
 #define GETTLSDATA(key, data, dataType)		((data = (dataType*)TlsGetValue(key)), (GetLastError()!=NO_ERROR?(data=0):data))
 
+//--- atomic counter macros, evaluate to the new value
+#define ATOMICINCREMENT(var)				InterlockedIncrement((LONG volatile *)&var)
+#define ATOMICDECREMENT(var)				InterlockedDecrement((LONG volatile *)&var)
+
 #else
 #if defined(__sun) && !defined(_POSIX_THREADS)
 
@@ -188,6 +192,10 @@ extern "C" {
 #define THRKEYDELETE(key) 					(0)
 #define SETTLSDATA(key, data)				(thr_setspecific(key, (void*)data) == 0)
 #define GETTLSDATA(key, data, dataType)		(thr_getspecific(key, (void**)&data)?(data=0):data)
+
+#include <atomic.h>
+#define ATOMICINCREMENT(var)				(long)atomic_inc_ulong_nv((volatile ulong_t *)&var)
+#define ATOMICDECREMENT(var)				(long)atomic_dec_ulong_nv((volatile ulong_t *)&var)
 #else
 // assume posix api (linux)
 #include <pthread.h>
@@ -321,6 +329,9 @@ extern "C" {
 #define SETTLSDATA(key, data)				(pthread_setspecific(key, (const void*)data) == 0)
 #define GETTLSDATA(key, data, dataType)		(data = (dataType*)pthread_getspecific(key))
 
+#define ATOMICINCREMENT(var)				__sync_add_and_fetch(&var, 1L)
+#define ATOMICDECREMENT(var)				__sync_sub_and_fetch(&var, 1L)
+
 #endif
 
 #endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "TaskGraph.h"
+#include "SystemLog.h"
+#include "Tracer.h"
+
+//! additional thread working on the tasks of a TaskGraph
+class TaskGraphThread: public Thread
+{
+public:
+	TaskGraphThread(TaskGraph &graph, const char *name)
+		: Thread(name)
+		, fGraph(graph) {
+	}
+protected:
+	void Run() {
+		fGraph.Work();
+	}
+private:
+	TaskGraph &fGraph;
+};
+
+TaskGraph::TaskGraph(const char *name, long lThreads)
+	: fName(name, -1, coast::storage::Global())
+	, fThreads(lThreads < 1L ? 1L : lThreads)
+	, fRunning(0L)
+	, fAborted(false)
+	, fMutex(name, coast::storage::Global())
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+}
+
+long TaskGraph::AddTask(Task *pTask, bool bMandatory)
+{
+	fNodes.push_back(Node(pTask, bMandatory));
+	return GetSize() - 1L;
+}
+
+bool TaskGraph::AddPrerequisite(long lTask, long lPrerequisite)
+{
+	if ( lTask < 0L || lTask >= GetSize() || lPrerequisite < 0L || lPrerequisite >= lTask ) {
+		return false;
+	}
+	fNodes[lPrerequisite].fDependents.push_back(lTask);
+	++fNodes[lTask].fPrerequisites;
+	return true;
+}
+
+bool TaskGraph::Succeeded(long lTask) const
+{
+	return lTask >= 0L && lTask < GetSize() && fNodes[lTask].fState == Node::eSucceeded;
+}
+
+bool TaskGraph::Run()
+{
+	StartTrace1(TaskGraph.Run, "[" << fName << "] tasks: " << GetSize() << " threads: " << fThreads);
+	{
+		LockUnlockEntry me(fMutex);
+		fReady.clear();
+		fRunning = 0L;
+		fAborted = false;
+		for (long i = 0, sz = GetSize(); i < sz; ++i) {
+			fNodes[i].fState = Node::eWaiting;
+			if ( ( fNodes[i].fMissing = fNodes[i].fPrerequisites ) == 0L ) {
+				fReady.insert(i);
+			}
+		}
+	}
+	std::vector<TaskGraphThread *> threads;
+	for (long i = 1; i < fThreads && i < GetSize(); ++i) {
+		String strName(fName);
+		strName << '[' << i << ']';
+		TaskGraphThread *pThread = new (coast::storage::Global()) TaskGraphThread(*this, strName);
+		if ( pThread->Start() ) {
+			threads.push_back(pThread);
+		} else {
+			SYSWARNING(String("could not start thread ") << strName << ", continuing with fewer threads");
+			delete pThread;
+		}
+	}
+	Work();
+	for (std::vector<TaskGraphThread *>::iterator aIt = threads.begin(); aIt != threads.end(); ++aIt) {
+		(*aIt)->CheckState(Thread::eTerminated);
+		delete *aIt;
+	}
+	Trace("aborted: " << (fAborted ? "true" : "false"));
+	return !fAborted;
+}
+
+void TaskGraph::Work()
+{
+	LockUnlockEntry me(fMutex);
+	while ( true ) {
+		// only running tasks can make further tasks ready
+		while ( fReady.empty() && fRunning > 0L && !fAborted ) {
+			fCond.Wait(fMutex);
+		}
+		if ( fReady.empty() || fAborted ) {
+			break;
+		}
+		long lTask = *fReady.begin();
+		fReady.erase(fReady.begin());
+		Node &node = fNodes[lTask];
+		node.fState = Node::eRunning;
+		++fRunning;
+		fMutex.Unlock();
+		bool bSucceeded = node.fTask->Run();
+		fMutex.Lock();
+		--fRunning;
+		node.fState = ( bSucceeded ? Node::eSucceeded : Node::eFailed );
+		if ( !bSucceeded && node.fMandatory ) {
+			fAborted = true;
+		}
+		for (std::vector<long>::const_iterator aIt = node.fDependents.begin(); aIt != node.fDependents.end(); ++aIt) {
+			if ( --fNodes[*aIt].fMissing == 0L ) {
+				fReady.insert(*aIt);
+			}
+		}
+		fCond.BroadCast();
+	}
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _TaskGraph_H
+#define _TaskGraph_H
+
+#include "Threads.h"
+#include <set>
+#include <vector>
+
+//! runs a set of tasks on a bounded number of threads, a task starts only after its prerequisites finished
+/*!
+Tasks are numbered in the order they are added and prerequisites have to be added before the task depending on
+them, so the graph cannot contain cycles. Tasks ready to run are started in the order they were added; with one
+thread and every task depending on its predecessor the tasks run one after the other in the calling thread.
+The calling thread of Run() works on the tasks too, at most lThreads - 1 additional threads are started.
+A failing task marked as mandatory stops starting further tasks, tasks already running are waited for.
+Tasks whose prerequisites failed without being mandatory still run, as they would if run one after the other.
+*/
+class TaskGraph
+{
+public:
+	//! unit of work run by TaskGraph
+	class Task
+	{
+	public:
+		virtual ~Task() {}
+		//! do the work
+		/*! \return false if the task failed */
+		virtual bool Run() = 0;
+	};
+
+	//! create an empty graph
+	/*! \param name used to name the mutex and the threads
+		\param lThreads maximum number of tasks running at the same time, including the calling thread of Run() */
+	TaskGraph(const char *name, long lThreads);
+	~TaskGraph();
+
+	//! add a task to the graph, the task is not owned by the graph
+	/*! \param pTask task to run
+		\param bMandatory if true a failure of the task stops the graph
+		\return id of the task used to add prerequisites */
+	long AddTask(Task *pTask, bool bMandatory = false);
+
+	//! let a task wait for another one
+	/*! \param lTask id of the waiting task
+		\param lPrerequisite id of a task added before lTask
+		\return false if lPrerequisite was not added before lTask */
+	bool AddPrerequisite(long lTask, long lPrerequisite);
+
+	//! run all tasks and wait until they are done
+	/*! \return false if a mandatory task failed */
+	bool Run();
+
+	//! number of tasks added
+	long GetSize() const {
+		return (long)fNodes.size();
+	}
+
+	//! result of a task after Run()
+	/*! \return true if the task succeeded, false if it failed or was not started */
+	bool Succeeded(long lTask) const;
+
+private:
+	friend class TaskGraphThread;
+
+	//! take ready tasks and run them until none is left
+	void Work();
+
+	struct Node {
+		Node(Task *pTask, bool bMandatory)
+			: fTask(pTask), fMandatory(bMandatory), fPrerequisites(0L), fMissing(0L), fState(eWaiting) {}
+		Task *fTask;
+		bool fMandatory;
+		long fPrerequisites;
+		//! number of prerequisites not finished yet
+		long fMissing;
+		enum { eWaiting, eRunning, eSucceeded, eFailed } fState;
+		std::vector<long> fDependents;
+	};
+
+	String fName;
+	long fThreads;
+	std::vector<Node> fNodes;
+	//! ids of tasks ready to run, lowest id first
+	std::set<long> fReady;
+	long fRunning;
+	bool fAborted;
+	SimpleMutex fMutex;
+	SimpleCondition fCond;
+
+	TaskGraph();
+	TaskGraph(const TaskGraph &);
+	TaskGraph &operator=(const TaskGraph &);
+};
+
+#endif
@@ -14,6 +14,7 @@
 #include "ThreadPoolTest.h"
 #include "WorkerPoolManagerTest.h"
 #include "WPMStatHandlerTest.h"
+#include "TaskGraphTest.h"
 #include "LeaderFollowerPoolTest.h"
 #include "ObjectList_rTest.h"
 
@@ -26,6 +27,7 @@ void setupRunner(TestRunner &runner)
 	ADD_SUITE(runner, ThreadPoolTest);
 	ADD_SUITE(runner, WorkerPoolManagerTest);
 	ADD_SUITE(runner, WPMStatHandlerTest);
+	ADD_SUITE(runner, TaskGraphTest);
 	ADD_SUITE(runner, LeaderFollowerPoolTest);
 	ADD_SUITE(runner, ObjectList_rTest);
 	// SystemAPITest should be run last because it makes low-level modifications which could influence other tests
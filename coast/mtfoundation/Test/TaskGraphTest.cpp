@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "TaskGraphTest.h"
+#include "TaskGraph.h"
+#include "TestSuite.h"
+#include "FoundationTestTypes.h"
+
+namespace {
+	//! appends its id to a shared log, optionally waits until a number of tasks entered
+	class LoggingTask: public TaskGraph::Task {
+	public:
+		LoggingTask(long lId, Anything &anyLog, SimpleMutex &mutex, SimpleCondition &cond, long lGate = 0L, bool bSucceed = true)
+			: fId(lId), fLog(anyLog), fMutex(mutex), fCond(cond), fGate(lGate), fSucceed(bSucceed), fThreadId(0), fEnteredWhenDone(0L) {}
+		virtual bool Run() {
+			LockUnlockEntry me(fMutex);
+			fThreadId = Thread::MyId();
+			fLog["Entered"].Append(fId);
+			fCond.BroadCast();
+			long lWaits = 0L;
+			while ( fLog["Entered"].GetSize() < fGate && lWaits++ < 50L ) {
+				fCond.TimedWait(fMutex, 0L, 100000000L);
+			}
+			fEnteredWhenDone = fLog["Entered"].GetSize();
+			fLog["Done"].Append(fId);
+			return fSucceed;
+		}
+		long fId;
+		Anything &fLog;
+		SimpleMutex &fMutex;
+		SimpleCondition &fCond;
+		long fGate;
+		bool fSucceed;
+		long fThreadId;
+		long fEnteredWhenDone;
+	};
+}
+
+void TaskGraphTest::SequentialTest()
+{
+	StartTrace(TaskGraphTest.SequentialTest);
+	Anything anyLog;
+	SimpleMutex mutex("SequentialTest", coast::storage::Global());
+	SimpleCondition cond;
+	LoggingTask t0(0L, anyLog, mutex, cond), t1(1L, anyLog, mutex, cond), t2(2L, anyLog, mutex, cond);
+	TaskGraph graph("SequentialTest", 1L);
+	assertEqual(0L, graph.AddTask(&t0));
+	assertEqual(1L, graph.AddTask(&t1));
+	assertEqual(2L, graph.AddTask(&t2));
+	t_assert(graph.Run());
+	Anything anyExpected;
+	anyExpected.Append(0L);
+	anyExpected.Append(1L);
+	anyExpected.Append(2L);
+	assertAnyEqual(anyExpected, anyLog["Done"]);
+	assertEqual(Thread::MyId(), t1.fThreadId);
+	t_assert(graph.Succeeded(2L));
+}
+
+void TaskGraphTest::ParallelTest()
+{
+	StartTrace(TaskGraphTest.ParallelTest);
+	Anything anyLog;
+	SimpleMutex mutex("ParallelTest", coast::storage::Global());
+	SimpleCondition cond;
+	// every task waits until all of them entered, which only works if they run at the same time
+	LoggingTask t0(0L, anyLog, mutex, cond, 3L), t1(1L, anyLog, mutex, cond, 3L), t2(2L, anyLog, mutex, cond, 3L);
+	TaskGraph graph("ParallelTest", 3L);
+	graph.AddTask(&t0);
+	graph.AddTask(&t1);
+	graph.AddTask(&t2);
+	t_assert(graph.Run());
+	assertEqual(3L, anyLog["Entered"].GetSize());
+	assertEqual(3L, anyLog["Done"].GetSize());
+	assertEqualm(3L, t0.fEnteredWhenDone, "all tasks should have entered before the first one left");
+	t_assertm(t0.fThreadId != t1.fThreadId && t1.fThreadId != t2.fThreadId && t0.fThreadId != t2.fThreadId, "expected tasks to run in different threads");
+}
+
+void TaskGraphTest::PrerequisiteTest()
+{
+	StartTrace(TaskGraphTest.PrerequisiteTest);
+	Anything anyLog;
+	SimpleMutex mutex("PrerequisiteTest", coast::storage::Global());
+	SimpleCondition cond;
+	LoggingTask t0(0L, anyLog, mutex, cond), t1(1L, anyLog, mutex, cond), t2(2L, anyLog, mutex, cond), t3(3L, anyLog, mutex, cond);
+	TaskGraph graph("PrerequisiteTest", 4L);
+	graph.AddTask(&t0);
+	graph.AddTask(&t1);
+	graph.AddTask(&t2);
+	graph.AddTask(&t3);
+	t_assert(graph.AddPrerequisite(1L, 0L));
+	t_assert(graph.AddPrerequisite(2L, 0L));
+	t_assert(graph.AddPrerequisite(3L, 1L));
+	t_assert(graph.AddPrerequisite(3L, 2L));
+	t_assertm(!graph.AddPrerequisite(0L, 3L), "prerequisites have to be added first");
+	t_assertm(!graph.AddPrerequisite(1L, 1L), "task cannot wait for itself");
+	t_assert(graph.Run());
+	ROAnything roaDone(anyLog["Done"]);
+	if ( assertEqual(4L, roaDone.GetSize()) ) {
+		assertEqual(0L, roaDone[0L].AsLong(-1L));
+		assertEqual(3L, roaDone[3L].AsLong(-1L));
+	}
+}
+
+void TaskGraphTest::FailureTest()
+{
+	StartTrace(TaskGraphTest.FailureTest);
+	{
+		Anything anyLog;
+		SimpleMutex mutex("FailureTest", coast::storage::Global());
+		SimpleCondition cond;
+		LoggingTask t0(0L, anyLog, mutex, cond, 0L, false), t1(1L, anyLog, mutex, cond);
+		TaskGraph graph("FailureTest", 2L);
+		graph.AddTask(&t0);
+		graph.AddTask(&t1);
+		graph.AddPrerequisite(1L, 0L);
+		t_assertm(graph.Run(), "optional task failing should not stop the graph");
+		t_assert(!graph.Succeeded(0L));
+		t_assert(graph.Succeeded(1L));
+	}
+	{
+		Anything anyLog;
+		SimpleMutex mutex("FailureTest", coast::storage::Global());
+		SimpleCondition cond;
+		LoggingTask t0(0L, anyLog, mutex, cond, 0L, false), t1(1L, anyLog, mutex, cond);
+		TaskGraph graph("FailureTest", 2L);
+		graph.AddTask(&t0, true);
+		graph.AddTask(&t1);
+		graph.AddPrerequisite(1L, 0L);
+		t_assertm(!graph.Run(), "mandatory task failing should stop the graph");
+		t_assert(!graph.Succeeded(1L));
+		assertEqual(1L, anyLog["Done"].GetSize());
+	}
+}
+
+// builds up a suite of testcases, add a line for each testmethod
+Test *TaskGraphTest::suite ()
+{
+	StartTrace(TaskGraphTest.suite);
+	TestSuite *testSuite = new TestSuite;
+
+	ADD_CASE(testSuite, TaskGraphTest, SequentialTest);
+	ADD_CASE(testSuite, TaskGraphTest, ParallelTest);
+	ADD_CASE(testSuite, TaskGraphTest, PrerequisiteTest);
+	ADD_CASE(testSuite, TaskGraphTest, FailureTest);
+
+	return testSuite;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _TaskGraphTest_H
+#define _TaskGraphTest_H
+
+#include "TestCase.h"
+
+class TaskGraphTest: public testframework::TestCase {
+public:
+	TaskGraphTest(TString tname) :
+		TestCaseType(tname) {
+	}
+	//!builds up a suite of testcases for this test
+	static Test *suite();
+
+	//!tasks run one after the other in the calling thread
+	void SequentialTest();
+	//!independent tasks run at the same time
+	void ParallelTest();
+	//!tasks wait for their prerequisites
+	void PrerequisiteTest();
+	//!failing tasks
+	void FailureTest();
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "TestSuite.h"
 #include "FoundationTestTypes.h"
 #include "StringStream.h"
+#include "SystemFile.h"
 #include <iostream>
 
 #define MILISEC 1000000 /* 1 million nanoseconds */
@@ -53,9 +54,22 @@ Test *ThreadsTest::suite() {
 	ADD_CASE(testSuite, ThreadsTest, ThreadStateTransitionTest);
 	ADD_CASE(testSuite, ThreadsTest, ThreadRunningStateTransitionTest);
 	ADD_CASE(testSuite, ThreadsTest, ThreadObjectReuseTest);
+	ADD_CASE(testSuite, ThreadsTest, PathCacheInstalledTest);
 	return testSuite;
 }
 
+void ThreadsTest::PathCacheInstalledTest() {
+	StartTrace(ThreadsTest.PathCacheInstalledTest);
+	coast::system::PathCache *pCache = coast::system::GetPathCache();
+	if ( t_assertm(pCache != 0, "expected the locked path cache to be installed") ) {
+		String strResolved;
+		pCache->Remember("PathCacheInstalledTest.tst", "/somewhere/PathCacheInstalledTest.tst");
+		t_assert(pCache->Lookup("PathCacheInstalledTest.tst", strResolved));
+		assertEqual("/somewhere/PathCacheInstalledTest.tst", strResolved);
+		t_assert(pCache->Forget("PathCacheInstalledTest.tst"));
+	}
+}
+
 void ThreadsTest::ThreadRunningStateTransitionTest() {
 	StartTrace(ThreadsTest.ThreadRunningStateTransitionTest);
 	// "Normal case" goes from Created to Started,Running, toggles between Ready and Working and gets Terminated
@@ -52,6 +52,8 @@ public:
 	void TwoThreadRecursiveTest();
 	//!two thread nested mutexes test with signalling
 	void TwoThreadRecursiveTryLockTest();
+	//!test that loading this library installs a locked path cache
+	void PathCacheInstalledTest();
 
 protected:
 	//--- subclass api
@@ -10,12 +10,12 @@
 #include "WPMStatHandler.h"
 #include "TestSuite.h"
 #include "FoundationTestTypes.h"
-bool WPMStatHandlerTest::AssertState(const WPMStatHandler &wpm, const Anything &state)
+bool WPMStatHandlerTest::AssertState(WPMStatHandler &wpm, const Anything &state)
 {
 	return
 		(assertEqualm(state[0L]["Value"].AsLong(0L), wpm.fPoolSize, state[0L]["Message"].AsCharPtr("failed")) ) 					&&
 		(assertEqualm(state[1L]["Value"].AsLong(0L), wpm.fCurrentParallelRequests, state[1L]["Message"].AsCharPtr("failed")) ) 	&&
-		(assertEqualm(state[2L]["Value"].AsLong(0L), wpm.fTotalRequests, state[2L]["Message"].AsCharPtr("failed")) )				&&
+		(assertEqualm(state[2L]["Value"].AsLong(0L), wpm.GetTotalRequests(), state[2L]["Message"].AsCharPtr("failed")) )				&&
 		(t_assertm(wpm.fTotalTime >= state[3L]["Value"].AsLong(0L), state[3L]["Message"].AsCharPtr("failed")) );
 }
 
@@ -117,6 +117,37 @@ void WPMStatHandlerTest::StatisticTests()
 	assertAnyEqual(expected, value);
 }
 
+void WPMStatHandlerTest::LatencyTests()
+{
+	StartTrace(WPMStatHandlerTest.LatencyTests);
+	WPMStatHandler wpm(10);
+	wpm.HandleStatEvt(WPMStatHandler::eEnter);
+	wpm.RecordPhase(WPMStatHandler::eRead, 100L);
+	wpm.RecordPhase(WPMStatHandler::eProcess, 2000L);
+	wpm.RecordPhase(WPMStatHandler::eProcess, 4000L);
+	wpm.RecordService("WebAppService", 3000L);
+	wpm.RecordService("", 3000L);
+	wpm.RecordPhase(WPMStatHandler::ePhaseCount, 1L);
+	wpm.HandleStatEvt(WPMStatHandler::eLeave);
+
+	Anything value;
+	wpm.Statistic(value);
+	assertEqual(1L, value["TotalRequests"].AsLong(-1L));
+	ROAnything roaPhases = value["Phases [us]"];
+	assertEqual(2L, roaPhases.GetSize());
+	assertEqual(1L, roaPhases["Read"]["Count"].AsLong(-1L));
+	assertEqual(100L, roaPhases["Read"]["Max"].AsLong(-1L));
+	assertEqual(2L, roaPhases["Process"]["Count"].AsLong(-1L));
+	assertEqual(2000L, roaPhases["Process"]["Min"].AsLong(-1L));
+	assertEqual(4000L, roaPhases["Process"]["Max"].AsLong(-1L));
+	t_assertm(!roaPhases.IsDefined("Queue"), "phases without values should not be listed");
+	ROAnything roaServices = value["Services [us]"];
+	assertEqual(1L, roaServices.GetSize());
+	assertEqual(1L, roaServices["WebAppService"]["Count"].AsLong(-1L));
+	assertEqual(3000L, roaServices["WebAppService"]["P50"].AsLong(-1L));
+	assertEqual("Process", WPMStatHandler::PhaseName(WPMStatHandler::eProcess));
+}
+
 // builds up a suite of testcases, add a line for each testmethod
 Test *WPMStatHandlerTest::suite ()
 {
@@ -126,6 +157,7 @@ Test *WPMStatHandlerTest::suite ()
 	ADD_CASE(testSuite, WPMStatHandlerTest, ConstructorTest);
 	ADD_CASE(testSuite, WPMStatHandlerTest, StatEvtTests);
 	ADD_CASE(testSuite, WPMStatHandlerTest, StatisticTests);
+	ADD_CASE(testSuite, WPMStatHandlerTest, LatencyTests);
 
 	return testSuite;
 }
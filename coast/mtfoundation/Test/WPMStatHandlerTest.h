@@ -27,10 +27,12 @@ public:
 	void StatEvtTests();
 	//!test behavior for the statistic call
 	void StatisticTests();
+	//!test latencies of request phases and services
+	void LatencyTests();
 
 protected:
 	//!bottleneck to assert state
-	bool AssertState(const WPMStatHandler &wpm, const Anything &state);
+	bool AssertState(WPMStatHandler &wpm, const Anything &state);
 };
 
 #endif
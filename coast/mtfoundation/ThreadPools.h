@@ -11,6 +11,7 @@
 
 #include "Threads.h"
 #include "StatUtils.h"
+#include "WPMStatHandler.h"
 
 //! abstract class which handles initialization, starting and termination of threads in a pool
 /*!
@@ -366,6 +367,12 @@ public:
 	//! returns the number of max active requests running that could run in parallel
 	long GetPoolSize();
 
+	/*! access the statistic handler to record latencies of the work packages
+		\return handler created by Init(), NULL before */
+	WPMStatHandler *GetStatHandler() {
+		return fpStatEvtHandler.get();
+	}
+
 	//! blocking requests on request of the admin server
 	void BlockRequests();
 
@@ -427,7 +434,7 @@ private:
 	//!termination flag
 	bool fTerminated;
 
-	typedef std::auto_ptr<StatEvtHandler> StatEvtHandlerPtrType;
+	typedef std::auto_ptr<WPMStatHandler> StatEvtHandlerPtrType;
 
 	//! statistic event handler
 	StatEvtHandlerPtrType fpStatEvtHandler;
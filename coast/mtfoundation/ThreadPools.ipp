@@ -14,6 +14,8 @@
 template< class WorkerParamType >
 bool WorkerPoolManager::Enter( WorkerParamType workload, long lFindWorkerHint )
 {
+	// time spent waiting for a worker is accounted as queueing
+	DiffTimer aQueueTimer(DiffTimer::eMicroseconds);
 	// guard the entry to request handling
 	// we're doing flow control on the main thread
 	// causing it to wait for a request thread to
@@ -26,6 +28,9 @@ bool WorkerPoolManager::Enter( WorkerParamType workload, long lFindWorkerHint )
 	if ( hr != NULL ) {
 		bEnterSuccess = hr->SetWorking(workload);
 	}
+	if ( bEnterSuccess && fpStatEvtHandler.get() ) {
+		fpStatEvtHandler->RecordPhase( WPMStatHandler::eQueue, (long)aQueueTimer.Diff() );
+	}
 	return bEnterSuccess;
 }
 
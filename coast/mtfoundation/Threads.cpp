@@ -13,6 +13,7 @@
 #include "StringStream.h"
 #include "TraceLocks.h"
 #include "MT_Storage.h"
+#include "SystemFile.h"
 #include <cstring>
 #if !defined(WIN32)
 #include <errno.h>
@@ -1311,3 +1312,38 @@ long Condition::GetId()
 	StatTrace(Condition.GetId, lId, coast::storage::Current());
 	return lId;
 }
+
+namespace {
+	//! PathCache of coast::system locked by a SimpleMutex
+	class MTPathCache: public coast::system::PathCache {
+		SimpleMutex fMutex;
+	public:
+		MTPathCache() :
+			fMutex("PathCache", coast::storage::Global()) {
+		}
+	protected:
+		virtual void DoLock() {
+			fMutex.Lock();
+		}
+		virtual void DoUnlock() {
+			fMutex.Unlock();
+		}
+	};
+
+	//! installs the MTPathCache as long as this library is loaded, threads can only be started once it is
+	class PathCacheInstaller {
+		MTPathCache fCache;
+	public:
+		PathCacheInstaller() {
+			coast::system::SetPathCache(&fCache);
+			InitFinisManager::IFMTrace("PathCache::Initialized\n");
+		}
+		~PathCacheInstaller() {
+			if ( coast::system::GetPathCache() == &fCache ) {
+				coast::system::SetPathCache(0);
+			}
+			InitFinisManager::IFMTrace("PathCache::Finalized\n");
+		}
+	};
+	PathCacheInstaller fgPathCacheInstaller;
+}
@@ -7,51 +7,173 @@
  */
 
 #include "WPMStatHandler.h"
+#include "SystemLog.h"
+#include "singleton.hpp"
 #include "boost/format.hpp"
+#include <map>
+#include <string>
+#include <vector>
 
 namespace
 {
 	DiffTimer::eResolution ullResolution = DiffTimer::eMicroseconds;
+
+	const char *gcPhaseNames[WPMStatHandler::ePhaseCount] = { "Queue", "Read", "Verify", "Process" };
+
+	//! size of a cache line, counters of different threads are kept at least this far apart
+	const size_t gszCacheLine = 64;
+
+	//! per thread table of statistic blocks, indexed by the handler id
+	typedef std::vector<void *> ThreadStatisticTable;
+
+	class WPMStatHandlerInitializer {
+		THREADKEY fTableKey;
+		SimpleMutex fHandlerIdMutex;
+		long fLastHandlerId;
+	public:
+		WPMStatHandlerInitializer() : fTableKey(0), fHandlerIdMutex("WPMStatHandlerId", coast::storage::Global()), fLastHandlerId(-1L) {
+			if (THRKEYCREATE(fTableKey, 0)) {
+				SystemLog::Error("TlsAlloc of WPMStatHandler fTableKey failed");
+			}
+		}
+		~WPMStatHandlerInitializer() {
+			if (THRKEYDELETE(fTableKey) != 0) {
+				SystemLog::Error("TlsFree of WPMStatHandler fTableKey failed");
+			}
+		}
+		long nextHandlerId() {
+			LockUnlockEntry me(fHandlerIdMutex);
+			return ++fLastHandlerId;
+		}
+		THREADKEY getTableKey() const {
+			return fTableKey;
+		}
+	};
+	typedef coast::utility::singleton_default<WPMStatHandlerInitializer> WPMStatHandlerInitializerSingleton;
+
+	//! deletes the per thread table when the thread terminates, the blocks belong to their handler
+	class ThreadStatisticTableCleaner: public CleanupHandler {
+	public:
+		static ThreadStatisticTableCleaner fgCleaner;
+	protected:
+		virtual bool DoCleanup() {
+			ThreadStatisticTable *pTable = 0;
+			if (GETTLSDATA(WPMStatHandlerInitializerSingleton::instance().getTableKey(), pTable, ThreadStatisticTable)) {
+				delete pTable;
+				pTable = 0;
+				return SETTLSDATA(WPMStatHandlerInitializerSingleton::instance().getTableKey(), pTable);
+			}
+			return false;
+		}
+	};
+	ThreadStatisticTableCleaner ThreadStatisticTableCleaner::fgCleaner;
+}
+
+//! statistic block written by a single thread only
+struct WPMStatHandler::ThreadStatistic {
+	//! std::string keys since copies of String keys would be made in the pool allocator of the request thread
+	typedef std::map<std::string, LatencyHistogram> ServiceMap;
+
+	ThreadStatistic(ThreadStatistic *pNext)
+		: fTotalRequests(0L)
+		, fNext(pNext)
+		, fMutex("WPMThreadStatistic", coast::storage::Global())
+	{}
+
+	char fLeadingPad[gszCacheLine];
+	//! number of requests left by this thread, written without locking
+	long fTotalRequests;
+	char fTrailingPad[gszCacheLine - sizeof(long)];
+	ThreadStatistic *fNext;
+	//! guards the histograms, contended only while the statistics are read
+	SimpleMutex fMutex;
+	LatencyHistogram fPhases[WPMStatHandler::ePhaseCount];
+	ServiceMap fServices;
 };
 
 WPMStatHandler::WPMStatHandler(long poolSize)
 	: StatEvtHandler()
+	, fHandlerId(WPMStatHandlerInitializerSingleton::instance().nextHandlerId())
 	, fPoolSize(poolSize)
 	, fMaxParallelRequests(0)
 	, fCurrentParallelRequests(0)
-	, fTotalRequests(0)
 	, fTotalTime(0.0)
+	, fBusy(false)
 	, fTimer( ullResolution )
 	, fMutex( "WPMStatHandler", coast::storage::Global() )
+	, fThreadStatistics(0)
 {
 	StartTrace(WPMStatHandler.Ctor);
 }
 
+WPMStatHandler::~WPMStatHandler()
+{
+	StartTrace(WPMStatHandler.Dtor);
+	// stale entries in the per thread tables are never used again since handler ids are not reused
+	while ( fThreadStatistics ) {
+		ThreadStatistic *pNext = fThreadStatistics->fNext;
+		delete fThreadStatistics;
+		fThreadStatistics = pNext;
+	}
+}
+
+WPMStatHandler::ThreadStatistic &WPMStatHandler::GetThreadStatistic()
+{
+	THREADKEY tableKey = WPMStatHandlerInitializerSingleton::instance().getTableKey();
+	ThreadStatisticTable *pTable = 0;
+	GETTLSDATA(tableKey, pTable, ThreadStatisticTable);
+	if ( !pTable ) {
+		pTable = new ThreadStatisticTable();
+		Thread::RegisterCleaner(&ThreadStatisticTableCleaner::fgCleaner);
+		if ( !SETTLSDATA(tableKey, pTable) ) {
+			SystemLog::Error("WPMStatHandler: could not store statistic table in TLS!");
+		}
+	}
+	if ( fHandlerId >= (long)pTable->size() ) {
+		pTable->resize(fHandlerId + 1L, 0);
+	}
+	ThreadStatistic *pStatistic = static_cast<ThreadStatistic *>((*pTable)[fHandlerId]);
+	if ( !pStatistic ) {
+		LockUnlockEntry me(fMutex);
+		pStatistic = new ThreadStatistic(fThreadStatistics);
+		fThreadStatistics = pStatistic;
+		(*pTable)[fHandlerId] = pStatistic;
+	}
+	return *pStatistic;
+}
+
 void WPMStatHandler::DoHandleStatEvt(long evt)
 {
 	StartTrace1(WPMStatHandler.DoHandleStatEvt, "Event[" << evt << "]");
-	LockUnlockEntry me(fMutex);
-
 	switch (evt) {
 		case eEnter: {
-			if ( fCurrentParallelRequests == 0 ) {
-				fTimer.Start();
-			}
-			++fCurrentParallelRequests;
-			if (fMaxParallelRequests < fCurrentParallelRequests) {
-				fMaxParallelRequests = fCurrentParallelRequests;
+			long lCurrent = ATOMICINCREMENT(fCurrentParallelRequests);
+			if ( lCurrent == 1L || lCurrent > fMaxParallelRequests ) {
+				LockUnlockEntry me(fMutex);
+				if ( !fBusy ) {
+					fTimer.Start();
+					fBusy = true;
+				}
+				if (fMaxParallelRequests < lCurrent) {
+					fMaxParallelRequests = lCurrent;
+				}
 			}
-			Trace("eEnter: curr: " << fCurrentParallelRequests << " max: " << fMaxParallelRequests);
+			Trace("eEnter: curr: " << lCurrent << " max: " << fMaxParallelRequests);
 		}
 		break;
 
 		case eLeave: {
-			--fCurrentParallelRequests;
-			if ( fCurrentParallelRequests == 0 ) {
-				fTotalTime += fTimer.Reset();
+			++GetThreadStatistic().fTotalRequests;
+			long lCurrent = ATOMICDECREMENT(fCurrentParallelRequests);
+			if ( lCurrent == 0L ) {
+				LockUnlockEntry me(fMutex);
+				// another request might have entered in the meantime
+				if ( fBusy && fCurrentParallelRequests == 0L ) {
+					fTotalTime += fTimer.Reset();
+					fBusy = false;
+				}
 			}
-			++fTotalRequests;
-			Trace("eLeave: curr: " << fCurrentParallelRequests << " max: " << fMaxParallelRequests);
+			Trace("eLeave: curr: " << lCurrent << " max: " << fMaxParallelRequests);
 		}
 		break;
 
@@ -60,22 +182,58 @@ void WPMStatHandler::DoHandleStatEvt(long evt)
 	}
 }
 
+void WPMStatHandler::RecordPhase(EPhase ePhase, long lMicroSeconds)
+{
+	if ( ePhase < eQueue || ePhase >= ePhaseCount ) {
+		return;
+	}
+	ThreadStatistic &statistic = GetThreadStatistic();
+	LockUnlockEntry me(statistic.fMutex);
+	statistic.fPhases[ePhase].Record(lMicroSeconds);
+}
+
+void WPMStatHandler::RecordService(const char *pcService, long lMicroSeconds)
+{
+	if ( !pcService || !*pcService ) {
+		return;
+	}
+	ThreadStatistic &statistic = GetThreadStatistic();
+	LockUnlockEntry me(statistic.fMutex);
+	statistic.fServices[pcService].Record(lMicroSeconds);
+}
+
+const char *WPMStatHandler::PhaseName(EPhase ePhase)
+{
+	return ( ePhase >= eQueue && ePhase < ePhaseCount ) ? gcPhaseNames[ePhase] : "";
+}
+
 void WPMStatHandler::DoStatistic(Anything &statElements)
 {
 	StartTrace(WPMStatHandler.DoStatistic);
 	ul_long ullTotalRequests(0LL);
 	double dTotalTime(0.0);
+	LatencyHistogram phases[ePhaseCount];
+	ThreadStatistic::ServiceMap services;
 	{
 		LockUnlockEntry me(fMutex);
 		statElements["PoolSize"] = fPoolSize;
 		statElements["CurrentParallelRequests"] = fCurrentParallelRequests;
 		statElements["MaxParallelRequests"] = fMaxParallelRequests;
 		dTotalTime = fTotalTime;
-		if ( fCurrentParallelRequests > 0 ) {
+		if ( fBusy ) {
 			// need to account for elapsed time when the pool is currently under load
 			dTotalTime += fTimer.Diff();
 		}
-		ullTotalRequests = fTotalRequests;
+	}
+	for ( ThreadStatistic *pStatistic = fThreadStatistics; pStatistic; pStatistic = pStatistic->fNext ) {
+		ullTotalRequests += pStatistic->fTotalRequests;
+		LockUnlockEntry me(pStatistic->fMutex);
+		for ( long lPhase = 0; lPhase < ePhaseCount; ++lPhase ) {
+			phases[lPhase].Merge(pStatistic->fPhases[lPhase]);
+		}
+		for ( ThreadStatistic::ServiceMap::const_iterator aIt = pStatistic->fServices.begin(); aIt != pStatistic->fServices.end(); ++aIt ) {
+			services[aIt->first].Merge(aIt->second);
+		}
 	}
 	statElements["TotalRequests"] = (long)ullTotalRequests;
 	// scale from microseconds to milliseconds
@@ -88,19 +246,29 @@ void WPMStatHandler::DoStatistic(Anything &statElements)
 	statElements["TotalTime [ms]"] = ( ( dTotalTime * dScaleResolutionToMillisecondsFactor ) > 0.0 ? (totFmt % ( dTotalTime * dScaleResolutionToMillisecondsFactor )).str().c_str() : "0" );
 	statElements["AverageTime [ms]"] = (ullTotalRequests ? ( avgFmt % dAvgTimemsec ).str().c_str() : "0");
 	statElements["TRX/sec"] = (ullTotalRequests ? ( trxFmt % dTrxPSec ).str().c_str() : "0");
+	for ( long lPhase = 0; lPhase < ePhaseCount; ++lPhase ) {
+		if ( phases[lPhase].GetCount() > 0L ) {
+			phases[lPhase].Summarize(statElements["Phases [us]"][gcPhaseNames[lPhase]]);
+		}
+	}
+	for ( ThreadStatistic::ServiceMap::const_iterator aIt = services.begin(); aIt != services.end(); ++aIt ) {
+		aIt->second.Summarize(statElements["Services [us]"][aIt->first.c_str()]);
+	}
 	TraceAny(statElements, "statElements");
 }
 
 long WPMStatHandler::DoGetTotalRequests()
 {
-	LockUnlockEntry me(fMutex);
-	StatTrace(WPMStatHandler.DoGetTotalRequests, "total: " << (l_long)fTotalRequests, coast::storage::Current());
-	return fTotalRequests;
+	long lTotalRequests = 0L;
+	for ( ThreadStatistic *pStatistic = fThreadStatistics; pStatistic; pStatistic = pStatistic->fNext ) {
+		lTotalRequests += pStatistic->fTotalRequests;
+	}
+	StatTrace(WPMStatHandler.DoGetTotalRequests, "total: " << lTotalRequests, coast::storage::Current());
+	return lTotalRequests;
 }
 
 long WPMStatHandler::DoGetCurrentParallelRequests()
 {
-	LockUnlockEntry me(fMutex);
 	StatTrace(WPMStatHandler.DoGetCurrentParallelRequests, "curr: " << fCurrentParallelRequests, coast::storage::Current());
 	return fCurrentParallelRequests;
 }
@@ -11,16 +11,44 @@
 
 #include "StatUtils.h"
 #include "DiffTimer.h"
+#include "LatencyHistogram.h"
 #include "Threads.h"
 
 //!gather statistical information about a worker pool
+/*!
+Request counts are kept per thread in cache line padded blocks and summed up when the statistics are read, so
+request threads do not serialize on a common lock for every event. Only the number of currently active requests
+is shared, it is updated atomically; the guard is taken when the pool changes between idle and busy or a new
+maximum of parallel requests is reached.
+Besides the counters, latencies of the request phases and of the service handlers can be recorded, see RecordPhase()
+and RecordService(). They are kept in per thread LatencyHistogram objects and merged when reading the statistics.
+\par Statistic output, additionally to the counters
+\code
+{
+	/Phases [us] {				only phases with recorded values
+		/Queue		{ /Count /Min /Mean /P50 /P90 /P99 /P999 /Max }	waiting for a thread to process the request
+		/Read		{ ... }		reading and parsing the request
+		/Verify		{ ... }		verifying the request
+		/Process	{ ... }		processing the request and writing the reply, including the service handler
+	}
+	/Services [us] {
+		/<ServiceHandler name>	{ /Count /Min /Mean /P50 /P90 /P99 /P999 /Max }
+		...
+	}
+}
+\endcode
+*/
 class WPMStatHandler: public StatEvtHandler
 {
 public:
 	WPMStatHandler(long poolSize);
+	~WPMStatHandler();
 
 	enum EWPMStatEvt { eEnter, eLeave };
 
+	//! request phases for which latencies are recorded
+	enum EPhase { eQueue, eRead, eVerify, eProcess, ePhaseCount };
+
 	/*! set new PoolSize, currently it is only used when printing statistics
 		\param lNewPoolSize new size of Pool for printing statistics */
 	void setPoolSize(long lNewPoolSize) {
@@ -40,6 +68,19 @@ public:
 		return ++fPoolSize;
 	}
 
+	/*! record the time spent in a request phase
+		\param ePhase phase the time was spent in
+		\param lMicroSeconds duration in microseconds */
+	void RecordPhase(EPhase ePhase, long lMicroSeconds);
+
+	/*! record the time a service handler needed to handle a request
+		\param pcService name of the service handler
+		\param lMicroSeconds duration in microseconds */
+	void RecordService(const char *pcService, long lMicroSeconds);
+
+	//! name of the phase as used in the statistic output
+	static const char *PhaseName(EPhase ePhase);
+
 protected:
 	//!gathering statistics for event evt
 	void DoHandleStatEvt(long evt);
@@ -51,20 +92,29 @@ protected:
 	long DoGetCurrentParallelRequests();
 
 private:
+	struct ThreadStatistic;
+
+	//! find or create the statistic block of the calling thread
+	ThreadStatistic &GetThreadStatistic();
+
+	//! unique number of this handler, used to find the per thread blocks
+	long fHandlerId;
 	//! number of allowed request threads that can run in parallel
 	long fPoolSize;
-	//! number of currently running requests
+	//! maximum number of requests running at the same time
 	long fMaxParallelRequests;
-	//! number of currently running requests
-	long fCurrentParallelRequests;
-	//! number of total requests serviced
-	ul_long fTotalRequests;
-	//! number of ms used to service the fTotalRequests
+	//! number of currently running requests, only changed atomically
+	volatile long fCurrentParallelRequests;
+	//! time used to service the requests, accumulated while the pool is busy
 	double fTotalTime;
+	//! true while the pool has at least one active request
+	bool fBusy;
 	//!timer to measure elapsed time during processing of requests
 	DiffTimer fTimer;
 	//!guard for setting values
 	SimpleMutex fMutex;
+	//! list of per thread blocks, only ever prepended to while the handler exists
+	ThreadStatistic *volatile fThreadStatistics;
 
 	friend class WPMStatHandlerTest;
 };
@@ -8,6 +8,9 @@
 #include "FlowControlDAStresser.h"
 #include "FlowController.h"
 #include "Application.h"
+#include "DiffTimer.h"
+#include "SystemBase.h"
+#include <vector>
 RegisterStresser(FlowControlDAStresser);
 
 Anything FlowControlDAStresser::Run(long id) {
@@ -94,9 +97,22 @@ Anything FlowControlDAStresser::Run(long id) {
 			Diff = 1;
 		}
 
+		// open loop: requests are scheduled at a fixed rate, latency is taken from the scheduled send time
+		// so a stalled request also counts the time the following requests should already have been sent
+		double dArrivalRate = fConfig["ArrivalRate"].AsDouble(0.0);
+		double dTicksPerRequest = (dArrivalRate > 0.0) ? double(DiffTimer::TicksPerSecond()) / dArrivalRate : 0.0;
+		DiffTimer::tTimeType tScheduleStart = DiffTimer::getCurrentRawTime();
+		long lScheduled = 0;
+		long lSignificantBits = fConfig["LatencySignificantBits"].AsLong(7L);
+		LatencyHistogram totalLatency(lSignificantBits);
+		std::vector<LatencyHistogram> stepLatencies;
+		Anything anyStepIndex;
+
 		Trace("id: [" << id << "] IdAndCurrentOffset: [" << idAndCurrentOffset << "] Range: [" <<
 				Range << "] Start: [" << Start << "] End: [" << End << "] Diff: [" << Diff << "]");
 		while (true) {
+			bool bLatencyMeasured = false;
+			long lLatency = 0L;
 			Trace("PrepareRequest" );
 			bool bPrepareRequestSucceeded;
 			noBreakCondition = flowCntrl->PrepareRequest(ctx, bPrepareRequestSucceeded);
@@ -145,9 +161,20 @@ Anything FlowControlDAStresser::Run(long id) {
 
 				TraceAny(ctx.GetTmpStore(), "Tempstore");
 
+				DiffTimer::tTimeType tIntendedSend = DiffTimer::getCurrentRawTime();
+				if (dArrivalRate > 0.0) {
+					DiffTimer::tTimeType tNow = tIntendedSend;
+					tIntendedSend = tScheduleStart + static_cast<DiffTimer::tTimeType>(double(lScheduled++) * dTicksPerRequest);
+					if (tIntendedSend > tNow) {
+						coast::system::MicroSleep(static_cast<long>(DiffTimer::Scale(tIntendedSend - tNow, DiffTimer::eMicroseconds)));
+					}
+				}
 				// connect to server and place request and extract reply...
 				long accessTime;
-				if (!flowCntrl->ExecDataAccess(ctx, accessTime)) {
+				bool bExecSucceeded = flowCntrl->ExecDataAccess(ctx, accessTime);
+				lLatency = static_cast<long>(DiffTimer::Scale(DiffTimer::getCurrentRawTime() - tIntendedSend, DiffTimer::eMicroseconds));
+				bLatencyMeasured = true;
+				if (!bExecSucceeded) {
 					Trace("ExecDataAccess failed!");
 					// check if we wanted da.StdExec(ctx) to fail
 					ROAnything roa;
@@ -194,6 +221,15 @@ Anything FlowControlDAStresser::Run(long id) {
 			} else {
 				tmpStore["result"]["Details"][strStepNr]["Label"] = tmpStore["result"]["ConfigStep"].AsString();
 			}
+			if (bLatencyMeasured) {
+				String strLabel = tmpStore["result"]["Details"][strStepNr]["Label"].AsString();
+				if (!anyStepIndex.IsDefined(strLabel)) {
+					anyStepIndex[strLabel] = static_cast<long>(stepLatencies.size());
+					stepLatencies.push_back(LatencyHistogram(lSignificantBits));
+				}
+				stepLatencies[anyStepIndex[strLabel].AsLong(0L)].Record(lLatency);
+				totalLatency.Record(lLatency);
+			}
 
 			// if there were errors fill them into a separate Any
 			CheckCopyErrorMessage(result, ctx.GetTmpStore(), nrSteps, (lastErrors != nError));
@@ -212,6 +248,14 @@ Anything FlowControlDAStresser::Run(long id) {
 		tmpStore["result"].Remove("StepsWithErrors");
 		TraceAny(tmpStore["result"], "temp store" );
 		result["Details"] = tmpStore["result"]["Details"];
+
+		totalLatency.Export(result["Latency"]["Total"]);
+		for (long i = 0, sz = anyStepIndex.GetSize(); i < sz; ++i) {
+			stepLatencies[anyStepIndex[i].AsLong(0L)].Export(result["Latency"]["Steps"][anyStepIndex.SlotName(i)]);
+		}
+		if (dArrivalRate > 0.0) {
+			result["ArrivalRate"] = dArrivalRate;
+		}
 	}
 
 	result["Nr"] = nrRequests;
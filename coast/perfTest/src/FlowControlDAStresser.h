@@ -10,13 +10,30 @@
 #define _FlowControlDAStresser_h_
 
 #include "Stresser.h"
+#include "LatencyHistogram.h"
 
 /*! stresser that runs a serie of DataAccesses.
  * The Input for each request is provided by an FlowController component
  * \code
  * {
- *		/DataAccess			Name of the DataAccess to use
- *		/FlowController		Name of the FlowController component
+ *		/DataAccess				Name of the DataAccess to use
+ *		/FlowController			Name of the FlowController component
+ *		/ArrivalRate			optional, requests per second, default 0 (closed loop)
+ *								Sends the requests open loop at this rate instead of sending the next request
+ *								as soon as the previous one returned. Latency is then taken from the time a request
+ *								should have been sent, so a stalling server can not hide itself by delaying the requests.
+ *		/LatencySignificantBits	optional, default 7, precision of the latency histograms, see LatencyHistogram
+ * }
+ * \endcode
+ * Besides the figures in milliseconds the result contains the latencies in microseconds as exported LatencyHistogram
+ * \code
+ * {
+ *		/Latency {
+ *			/Total	{ ... }		all requests
+ *			/Steps {
+ *				/<step label>	{ ... }
+ *			}
+ *		}
  * }
  * \endcode
  */
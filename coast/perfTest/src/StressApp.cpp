@@ -11,6 +11,7 @@
 #include "SystemFile.h"
 #include "DiffTimer.h"
 #include "Stresser.h"
+#include "LatencyHistogram.h"
 #include <iostream>
 #include <iomanip>
 
@@ -51,6 +52,8 @@ void StressApp::ShowResult(long lTime) {
 	long totMin = 2000000;
 	long totErr = 0;
 	String buf;
+	Anything anyTotalLatency, anyLatencySummary;
+	String strCSV("Id,Step,Count,Min,Mean,P50,P90,P99,P999,Max\n");
 
 	// get the result from all users
 	{
@@ -123,6 +126,12 @@ void StressApp::ShowResult(long lTime) {
 			if (!printDetails.IsNull()) {
 				strCout << printDetails << std::endl;
 			}
+			if (result.IsDefined("Latency")) {
+				String strId;
+				strId << i;
+				ShowLatencies(strCout, strId, result["Latency"], anyLatencySummary["Results"][strId], strCSV);
+				Stresser::MergeLatencies(anyTotalLatency, result["Latency"]);
+			}
 
 			// add this result to the totals
 			totTr += anzTr;
@@ -143,7 +152,24 @@ void StressApp::ShowResult(long lTime) {
 		if (totErr > 0) {
 			strCout << " Errors: " << totErr;
 		}
-		strCout << std::endl << std::endl;
+		strCout << std::endl;
+		if (!anyTotalLatency.IsNull()) {
+			ShowLatencies(strCout, "Total", anyTotalLatency, anyLatencySummary["Total"], strCSV);
+			fResult["LatencySummary"] = anyLatencySummary;
+		}
+		strCout << std::endl;
+	}
+	if (!anyLatencySummary.IsNull()) {
+		ostream *csv = fConfig.IsDefined("LatencyCSVFile") ? coast::system::OpenOStream(fConfig["LatencyCSVFile"].AsString(), 0, ios::out | ios::trunc) : 0;
+		if (csv) {
+			csv->write(strCSV, strCSV.Length());
+			delete csv;
+		}
+		ostream *summary = fConfig.IsDefined("LatencySummaryFile") ? coast::system::OpenOStream(fConfig["LatencySummaryFile"].AsString(), 0, ios::out | ios::trunc) : 0;
+		if (summary) {
+			anyLatencySummary.PrintOn(*summary) << std::endl;
+			delete summary;
+		}
 	}
 
 	String fn = fConfig["ResultFile"].AsCharPtr("time.txt");
@@ -158,3 +184,52 @@ void StressApp::ShowResult(long lTime) {
 	cout.write(buf, buf.Length());
 	cout.flush();
 }
+
+namespace {
+	String CSVField(const String &strValue) {
+		if ( strValue.StrChr(',') < 0 && strValue.StrChr('"') < 0 ) {
+			return strValue;
+		}
+		String strQuoted("\"");
+		for (long l = 0, sz = strValue.Length(); l < sz; ++l) {
+			if ( strValue[l] == '"' ) {
+				strQuoted << '"';
+			}
+			strQuoted << strValue[l];
+		}
+		return strQuoted << '"';
+	}
+}
+
+void StressApp::ShowLatencies(std::ostream &os, const char *pcId, ROAnything roaLatency, Anything &anySummary, String &strCSV) {
+	StartTrace1(StressApp.ShowLatencies, "Id: " << pcId);
+	using namespace std;
+	ROAnything roaSteps = roaLatency["Steps"];
+	os << " Latency " << pcId << ":" << std::endl;
+	const char *figures[] = { "P50", "P90", "P99", "P999", "Max" };
+	const char *labels[] = { "p50", "p90", "p99", "p99.9", "max" };
+	// all requests first, followed by the steps
+	for (long i = -1L, sz = roaSteps.GetSize(); i < sz; ++i) {
+		String strLabel((i < 0L) ? "Total" : roaSteps.SlotName(i));
+		LatencyHistogram histogram;
+		histogram.Merge((i < 0L) ? roaLatency["Total"] : roaSteps[i]);
+		Anything anyFigures;
+		histogram.Summarize(anyFigures);
+		if (i < 0L) {
+			anySummary["Total"] = anyFigures;
+		} else {
+			anySummary["Steps"][strLabel] = anyFigures;
+		}
+		os << "  " << setw(20) << setiosflags(ios::left) << strLabel.cstr() << resetiosflags(ios::left) << " Count: " << histogram.GetCount();
+		for (long f = 0; f < 5; ++f) {
+			os << " " << labels[f] << ": " << setiosflags(ios::fixed) << setprecision(3) << anyFigures[figures[f]].AsLong(0L) / 1000.0 << "ms";
+		}
+		os << std::endl;
+		strCSV << CSVField(pcId) << ',' << CSVField(strLabel) << ',' << histogram.GetCount() << ',' << histogram.GetMin() << ','
+				<< static_cast<long>(histogram.GetMean() + 0.5);
+		for (long f = 0; f < 5; ++f) {
+			strCSV << ',' << anyFigures[figures[f]].AsLong(0L);
+		}
+		strCSV << '\n';
+	}
+}
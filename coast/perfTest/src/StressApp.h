@@ -10,12 +10,23 @@
 #define _StressApp_h_
 
 #include "Application.h"
+#include <iosfwd>
 
 // -- forward declaration ------------
 class Anything;
 
 //---- StressApp -----------------------------------------------------------
 //! Runs a Stresser and shows the results
+/*! Results containing latency histograms, see FlowControlDAStresser, are additionally summarized per step with
+their percentiles. The summary is kept in fResult["LatencySummary"] and can be exported for regression comparisons:
+\code
+{
+	/ResultFile				optional, default "time.txt", file the report is appended to
+	/LatencyCSVFile			optional, file the latency summary is written to as comma separated values in microseconds
+	/LatencySummaryFile		optional, file the latency summary is written to as Anything
+}
+\endcode
+*/
 class StressApp : public Application
 {
 public:
@@ -35,6 +46,14 @@ protected:
 	//!:!prec: all started StresserThreads have finished
 	virtual void ShowResult(long time);
 
+	//! prints the percentiles of exported latency histograms
+	/*! \param os stream to print the summary to
+		\param pcId identifies the result in the csv output
+		\param roaLatency /Latency slot of a result, see FlowControlDAStresser
+		\param anySummary gets the summary of /Total and every step
+		\param strCSV gets a line per histogram appended */
+	virtual void ShowLatencies(std::ostream &os, const char *pcId, ROAnything roaLatency, Anything &anySummary, String &strCSV);
+
 	Anything fResult;
 	friend class StressAppTest;
 };
@@ -12,6 +12,7 @@
 #include "SystemLog.h"
 #include "Tracer.h"
 #include "Policy.h"
+#include "LatencyHistogram.h"
 
 //---- Stresser -----------------------------------------------------------
 Stresser::Stresser(const char *StresserName)
@@ -42,6 +43,18 @@ Anything Stresser::RunStresser(const String &StresserName, long id)
 	return anyRet;
 }
 
+void Stresser::MergeLatencies(Anything &anyTarget, ROAnything roaLatency)
+{
+	StartTrace(Stresser.MergeLatencies);
+	if ( roaLatency.IsDefined("Total") ) {
+		LatencyHistogram::MergeExported(anyTarget["Total"], roaLatency["Total"]);
+	}
+	ROAnything roaSteps = roaLatency["Steps"];
+	for (long i = 0, sz = roaSteps.GetSize(); i < sz; ++i) {
+		LatencyHistogram::MergeExported(anyTarget["Steps"][roaSteps.SlotName(i)], roaSteps[i]);
+	}
+}
+
 bool Stresser::DoGetConfigName(const char *category, const char *objName, String &configFileName) const
 {
 	configFileName = "StresserMeta";
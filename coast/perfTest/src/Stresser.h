@@ -35,6 +35,11 @@ public:
 
 	static Anything RunStresser(const String &StresserName, long id = 0);
 
+	//! merge the /Latency slot of a stresser result into anyTarget
+	/*! \param anyTarget merged latencies, same form as the /Latency slot, see FlowControlDAStresser
+		\param roaLatency /Latency slot of a single result */
+	static void MergeLatencies(Anything &anyTarget, ROAnything roaLatency);
+
 //---- registry interface
 	RegCacheDef(Stresser);	// FindStresser()
 
@@ -12,6 +12,7 @@
 #include "StringStream.h"
 #include "Stresser.h"
 #include "StressProcessor.h"
+#include "LatencyHistogram.h"
 
 void StressAppTest::AppRunTest() {
 	StressApp stressApp("TestedStressApp");
@@ -87,6 +88,42 @@ void StressAppTest::StressProcessorTest() {
 	CheckSum(result);
 }
 
+void StressAppTest::LatencyReportTest() {
+	StartTrace(StressAppTest.LatencyReportTest);
+	LatencyHistogram first, second;
+	for (long l = 1; l <= 100; ++l) {
+		first.Record(l * 1000L);
+		second.Record(l * 2000L);
+	}
+	Anything anyFirst, anySecond, anyMerged;
+	first.Export(anyFirst["Latency"]["Total"]);
+	first.Export(anyFirst["Latency"]["Steps"]["Login"]);
+	second.Export(anySecond["Latency"]["Total"]);
+	second.Export(anySecond["Latency"]["Steps"]["Logout"]);
+	Stresser::MergeLatencies(anyMerged, anyFirst["Latency"]);
+	Stresser::MergeLatencies(anyMerged, anySecond["Latency"]);
+	assertEqual(200L, anyMerged["Total"]["Count"].AsLong(0L));
+	assertEqual(100L, anyMerged["Steps"]["Login"]["Count"].AsLong(0L));
+	assertEqual(100L, anyMerged["Steps"]["Logout"]["Count"].AsLong(0L));
+
+	StressApp stressApp("TestedStressApp");
+	stressApp.Initialize("Application");
+	stressApp.fResult["Results"].Append(anyFirst);
+	stressApp.fResult["Results"].Append(anySecond);
+	stressApp.ShowResult(0L);
+	ROAnything roaSummary = stressApp.fResult["LatencySummary"];
+	TraceAny(roaSummary, "LatencySummary");
+	assertEqual(100L, roaSummary["Results"]["0"]["Total"]["Count"].AsLong(0L));
+	assertEqual(100000L, roaSummary["Results"]["0"]["Steps"]["Login"]["Max"].AsLong(0L));
+	assertEqual(200L, roaSummary["Total"]["Total"]["Count"].AsLong(0L));
+	assertEqual(1000L, roaSummary["Total"]["Total"]["Min"].AsLong(0L));
+	assertEqual(200000L, roaSummary["Total"]["Total"]["Max"].AsLong(0L));
+	assertEqual(200000L, roaSummary["Total"]["Steps"]["Logout"]["Max"].AsLong(0L));
+	// 100 of the 200 merged values are below or equal 67000
+	long lMedian = roaSummary["Total"]["Total"]["P50"].AsLong(0L);
+	t_assertm(lMedian >= 67000L && lMedian <= 68047L, TString("median: ") << lMedian);
+}
+
 void StressAppTest::CheckSum(ROAnything result) {
 	StartTrace(StressAppTest.CheckSum);
 	long checkSum(0);
@@ -107,6 +144,7 @@ Test *StressAppTest::suite() {
 	ADD_CASE(testSuite, StressAppTest, FlowControlDAStresserTest);
 	ADD_CASE(testSuite, StressAppTest, DataAccessStresserTest);
 	ADD_CASE(testSuite, StressAppTest, StressProcessorTest);
+	ADD_CASE(testSuite, StressAppTest, LatencyReportTest);
 
 	return testSuite;
 }
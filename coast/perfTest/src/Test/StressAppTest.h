@@ -24,6 +24,7 @@ public:
 	void ThreadedStresserRunnerTest();
 	void StressProcessorTest();
 	void FlowControlDAStresserTest();
+	void LatencyReportTest();
 
 protected:
 	//! utility method to check consistency of result
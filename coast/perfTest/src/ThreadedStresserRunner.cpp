@@ -176,6 +176,9 @@ Anything ThreadedStresserRunner::Run(long /* id */)
 			long itopia_min = roaResult["Min"].AsLong(0);
 			totMin > itopia_min ? totMin = itopia_min : totMin = totMin;
 			totErr += roaResult["Error"].AsLong(0);
+			if ( roaResult.IsDefined("Latency") ) {
+				MergeLatencies(results["Total"]["Latency"], roaResult["Latency"]);
+			}
 			results["Results"].Append(result);
 			result = Anything();
 			if ( anyResults.GetSize() ) {
@@ -55,6 +55,7 @@ public:
 	//!				/Max	x	# maximum transaction time of all stressers
 	//!				/Min	x	# minimum transaction time of all stressers
 	//!				/Error	x	# total number of erroneous transactions
+	//!				/Latency {...}	# merged latency histograms of the stressers providing them, see FlowControlDAStresser
 	//!		}
 	//!	}</PRE>
 	virtual Anything Run(long id);
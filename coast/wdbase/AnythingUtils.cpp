@@ -8,6 +8,7 @@
 
 #include "AnythingUtils.h"
 #include "Renderer.h"
+#include <cstring>
 
 void StoreCopier::Operate(Context &c, Anything &dest, const Anything &config, char delim, char indexdelim)
 {
@@ -46,16 +47,17 @@ void StoreFinder::Operate(Context &context, Anything &dest, const ROAnything &co
 	TraceAny(config, "Config");
 
 	String store = config["Store"].AsString("");
-	Anything &anyStore = FindStore(context, store);
-	if ( !dest.SetAllocator(anyStore.GetAllocator()) ) {
-		SYSWARNING("Tried to set allocator on Anything having an Impl already! Keep in mind that you might be operating on a copy!");
-	}
-
 	String destSlotname(40);
 	Renderer::RenderOnString(destSlotname, context, config["Slot"]);
 	Trace("Destination slotname [" << destSlotname << "]");
+	char delim = config["Delim"].AsCharPtr(".")[0L], indexdelim = config["IndexDelim"].AsCharPtr(":")[0L];
+
+	Anything &anyStore = FindStore(context, store, destSlotname, delim, indexdelim);
+	if ( !dest.SetAllocator(anyStore.GetAllocator()) ) {
+		SYSWARNING("Tried to set allocator on Anything having an Impl already! Keep in mind that you might be operating on a copy!");
+	}
 
-	SlotFinder::Operate(anyStore, dest, destSlotname, config["Delim"].AsCharPtr(".")[0L], config["IndexDelim"].AsCharPtr(":")[0L]);
+	SlotFinder::Operate(anyStore, dest, destSlotname, delim, indexdelim);
 }
 
 Anything &StoreFinder::FindStore(Context &c, String &storeName)
@@ -74,6 +76,19 @@ Anything &StoreFinder::FindStore(Context &c, String &storeName)
 	return c.GetTmpStore();
 }
 
+Anything &StoreFinder::FindStore(Context &c, String &storeName, const String &slotName, char delim, char indexdelim)
+{
+	StartTrace1(StoreFinder.FindStore, "slot [" << slotName << "]");
+	if ( storeName == "Session" ) {
+		const char delims[] = { delim, indexdelim, '\0' };
+		String strSlot = slotName.SubString(0L, static_cast<long>(strcspn(slotName, delims)));
+		if ( strSlot.Length() > 0L ) {
+			return c.GetSessionStore(strSlot);
+		}
+	}
+	return FindStore(c, storeName);
+}
+
 void StorePutter::Operate(Anything &source, Context &c, const Anything &config)
 {
 	StartTrace(StorePutter.Operate);
@@ -85,12 +100,13 @@ void StorePutter::Operate(Anything &source, Context &c, const ROAnything &config
 {
 	StartTrace(StorePutter.Operate);
 	TraceAny(config, "Config");
-	String strStoreName = config["Store"].AsString("");
-	SlotPutter::Operate(source, StoreFinder::FindStore(c, strStoreName), Renderer::RenderToString(c, config["Slot"]), config["Append"].AsBool(false), config["Delim"].AsCharPtr(".")[0L], config["IndexDelim"].AsCharPtr(":")[0L]);
+	String strStoreName = config["Store"].AsString(""), strSlotName = Renderer::RenderToString(c, config["Slot"]);
+	char delim = config["Delim"].AsCharPtr(".")[0L], indexdelim = config["IndexDelim"].AsCharPtr(":")[0L];
+	SlotPutter::Operate(source, StoreFinder::FindStore(c, strStoreName, strSlotName, delim, indexdelim), strSlotName, config["Append"].AsBool(false), delim, indexdelim);
 }
 
 void StorePutter::Operate(Anything &source, Context &c, String strStoreName, String destSlotname, bool append, char delim, char indexdelim)
 {
 	StatTrace(StorePutter.Operate, "putting in store [" << (strStoreName.Length() ? (const char *)strStoreName : "TmpStore" ) << "] slot [" << destSlotname << "]", coast::storage::Current());
-	SlotPutter::Operate(source, StoreFinder::FindStore(c, strStoreName), destSlotname, append, delim, indexdelim);
+	SlotPutter::Operate(source, StoreFinder::FindStore(c, strStoreName, destSlotname, delim, indexdelim), destSlotname, append, delim, indexdelim);
 }
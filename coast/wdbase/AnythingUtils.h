@@ -68,6 +68,10 @@ public:
 	//! \param storeName name of the store
 	//! \return a Store from the context according to storeName  (Role -> RoleStore, Session-> SessionStore, Request, everything else ->TmpStore )
 	static Anything &FindStore(Context &c, String &storeName);
+	//! Gets a specific Store by Key for modifying the given slot only
+	//! \param slotName path of the slot that gets modified, the Session store is only copied for its top level slot, see Context::GetSessionStore(const char *)
+	//! \return same as FindStore(Context &, String &)
+	static Anything &FindStore(Context &c, String &storeName, const String &slotName, char delim = '.', char indexdelim = ':');
 
 private:
 	//!deprecated use static API
@@ -28,7 +28,8 @@ Anything SimpleAnyLoader::Load(const char *key) {
 }
 
 CacheHandlerImpl::CacheHandlerImpl() :
-		NotCloned("CacheHandler"), fCache(Anything::ArrayMarker(), coast::storage::Global()), fCacheHandlerMutex("CacheHandlerMutex", coast::storage::Global()) {
+		NotCloned("CacheHandler"), fCache(Anything::ArrayMarker(), coast::storage::Global()), fStageable(Anything::ArrayMarker(), coast::storage::Global()), fStaged(
+				Anything::ArrayMarker(), coast::storage::Global()), fGeneration(0L), fCacheHandlerMutex("CacheHandlerMutex", coast::storage::Global()) {
 	InitFinisManager::IFMTrace("CacheHandler::Initialized\n");
 }
 
@@ -55,6 +56,16 @@ ROAnything CacheHandlerImpl::Reload(const char *group, const char *key, CacheLoa
 ROAnything CacheHandlerImpl::Load(const char *group, const char *key, CacheLoadPolicy *clp) {
 	StartTrace1(CacheHandlerImpl.Load, "group [" << NotNull(group) << "] key [" << NotNull(key) << "]");
 	if (not IsLoaded(group, key)) {
+		if (clp->IsStageable()) {
+			LockUnlockEntry me(fCacheHandlerMutex);
+			fStageable[group][key] = true;
+			if (ROAnything(fStaged)[group].IsDefined(key)) {
+				Trace("taking staged entry");
+				fCache[group][key] = fStaged[group][key];
+				fStaged[group].Remove(key);
+				return Get(group, key);
+			}
+		}
 		Anything toCache(clp->Load(key), fCache.GetAllocator());
 		if (!toCache.IsNull()) {
 			LockUnlockEntry me(fCacheHandlerMutex);
@@ -64,6 +75,52 @@ ROAnything CacheHandlerImpl::Load(const char *group, const char *key, CacheLoadP
 	return Get(group, key);
 }
 
+long CacheHandlerImpl::Stage() {
+	StartTrace(CacheHandlerImpl.Stage);
+	Anything anyToStage;
+	{
+		LockUnlockEntry me(fCacheHandlerMutex);
+		anyToStage = fStageable.DeepClone(coast::storage::Global());
+	}
+	// reading and parsing takes place without holding the lock, cache users are not blocked
+	SimpleAnyLoader sal;
+	Anything anyStaged(Anything::ArrayMarker(), coast::storage::Global());
+	long lStaged = 0L;
+	for (long lGroup = 0, szGroups = anyToStage.GetSize(); lGroup < szGroups; ++lGroup) {
+		const char *group = anyToStage.SlotName(lGroup);
+		for (long lKey = 0, szKeys = anyToStage[lGroup].GetSize(); lKey < szKeys; ++lKey) {
+			const char *key = anyToStage[lGroup].SlotName(lKey);
+			Anything toStage(sal.Load(key), coast::storage::Global());
+			if (!toStage.IsNull()) {
+				anyStaged[group][key] = toStage;
+				++lStaged;
+			}
+		}
+	}
+	LockUnlockEntry me(fCacheHandlerMutex);
+	fStaged = anyStaged;
+	Trace("staged " << lStaged << " entries");
+	return lStaged;
+}
+
+long CacheHandlerImpl::Publish() {
+	StartTrace(CacheHandlerImpl.Publish);
+	LockUnlockEntry me(fCacheHandlerMutex);
+	fStaged = Anything(Anything::ArrayMarker(), coast::storage::Global());
+	return ++fGeneration;
+}
+
+void CacheHandlerImpl::DiscardStaged() {
+	StartTrace(CacheHandlerImpl.DiscardStaged);
+	LockUnlockEntry me(fCacheHandlerMutex);
+	fStaged = Anything(Anything::ArrayMarker(), coast::storage::Global());
+}
+
+long CacheHandlerImpl::GetGeneration() {
+	LockUnlockEntry me(fCacheHandlerMutex);
+	return fGeneration;
+}
+
 bool CacheHandlerImpl::IsLoaded(const char *group, const char *key) {
 	StartTrace1(CacheHandlerImpl.IsLoaded, "group [" << NotNull(group) << "] key [" << NotNull(key) << "]");
 	return ROAnything(fCache).IsDefined(group) && ROAnything(fCache)[group].IsDefined(key);
@@ -95,8 +152,16 @@ bool CacheHandlerImpl::Init(const ROAnything) {
 }
 
 bool CacheHandlerImpl::Finis() {
+	ResetFinis();
+	LockUnlockEntry me(fCacheHandlerMutex);
+	fStaged.clear();
+	return true;
+}
+
+bool CacheHandlerImpl::ResetFinis() {
 	LockUnlockEntry me(fCacheHandlerMutex);
 	fCache.clear();
+	fStageable.clear();
 	return true;
 }
 
@@ -117,3 +182,8 @@ bool CacheHandlerModule::Finis() {
 	StartTrace(CacheHandlerModule.Finis);
 	return CacheHandler::instance().Finis();
 }
+
+bool CacheHandlerModule::ResetFinis(const ROAnything) {
+	StartTrace(CacheHandlerModule.ResetFinis);
+	return CacheHandler::instance().ResetFinis();
+}
@@ -22,6 +22,8 @@ public:
 
 	virtual bool Init(const ROAnything config);
 	virtual bool Finis();
+	//! keeps the entries staged for the reload, see CacheHandlerImpl::ResetFinis
+	virtual bool ResetFinis(const ROAnything config);
 };
 
 //! CacheLoadPolicy builds up a cache.
@@ -44,11 +46,21 @@ public:
 	virtual Anything Load(const char *key) {
 		return Anything(coast::storage::Global());
 	}
+
+	//! entries loaded by a stageable policy can be read again by CacheHandlerImpl::Stage using a SimpleAnyLoader
+	virtual bool IsStageable() const {
+		return false;
+	}
 };
 
 class SimpleAnyLoader: public CacheLoadPolicy {
 public:
 	virtual Anything Load(const char *key);
+
+	//! config files are reread when staging a reload
+	virtual bool IsStageable() const {
+		return true;
+	}
 };
 
 //! Dummy policy wrap an Anything to cache
@@ -80,7 +92,10 @@ private:
 
  The build up of the cache is done before the server is accepting requests. It is distributed through
  ROAnything and installed into clients. There are no MT-Issues during normal operation.
- If the cache has to be reset (not implemented yet), this has to be done while no request is active.
+ If the cache has to be reset, this has to be done while no request is active. To keep that period short,
+ a reload first calls Stage to read and parse all config files again while requests are still processed.
+ Unloaded entries are then taken from the staged generation by Load without touching the file system,
+ Publish finally drops what was staged but not loaded again and switches to the next generation.
 
  Cache is uniquely identified by Group/Key pair
 */
@@ -88,6 +103,12 @@ class CacheHandlerImpl: public NotCloned {
 	typedef SimpleMutex MutexType;
 	// the central cache data structure
 	Anything fCache;
+	// group/key pairs loaded from config files, see CacheLoadPolicy::IsStageable
+	Anything fStageable;
+	// entries read by Stage but not yet loaded
+	Anything fStaged;
+	// number of published reloads
+	long fGeneration;
 
 	// this mutex protects the cache handler from concurrent access
 	MutexType fCacheHandlerMutex;
@@ -115,8 +136,24 @@ public:
 	// get a whole group (used for html templates)
 	ROAnything GetGroup(const char *group);
 
+	//! read all stageable entries again, off to the side of the loaded cache
+	/*! \return number of entries staged */
+	long Stage();
+
+	//! drop staged entries which were not loaded again and start a new generation
+	/*! \return the new generation */
+	long Publish();
+
+	//! drop staged entries, the current generation remains
+	void DiscardStaged();
+
+	//! number of published reloads
+	long GetGeneration();
+
 	bool Init(const ROAnything);
 	bool Finis();
+	//! same as Finis but keeps the staged entries, the modules load them again when they are reset
+	bool ResetFinis();
 };
 typedef coast::utility::singleton_default<CacheHandlerImpl> CacheHandler;
 
@@ -21,23 +21,23 @@ const String Context::DebugStoreSeparator("<!-- separator 54353021345321784456 -
 
 Context::Context() :
 	fSession(0), fSessionStoreGlobal(Anything::ArrayMarker(), coast::storage::Global()), fSessionStoreCurrent(Anything::ArrayMarker(),
-			coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fRequest(Anything::ArrayMarker()), fSocket(0),
-			fCopySessionStore(false) {
+			coast::storage::Current()), fSessionStoreSnapshot(coast::storage::Global()), fSessionStoreWritten(Anything::ArrayMarker(), coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fRequest(Anything::ArrayMarker()), fSocket(0),
+			fCopySessionStore(false), fSessionStoreShared(false) {
 	InitTmpStore();
 }
 
 Context::Context(Anything &request) :
 	fSession(0), fSessionStoreGlobal(Anything::ArrayMarker(), coast::storage::Global()), fSessionStoreCurrent(Anything::ArrayMarker(),
-			coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fRequest(request), fSocket(0),
-			fCopySessionStore(false) {
+			coast::storage::Current()), fSessionStoreSnapshot(coast::storage::Global()), fSessionStoreWritten(Anything::ArrayMarker(), coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fRequest(request), fSocket(0),
+			fCopySessionStore(false), fSessionStoreShared(false) {
 	InitTmpStore();
 	fLanguage = LocalizationUtils::FindLanguageKey(*this, Lookup("Language", "E"));
 }
 
 Context::Context(Socket *socket) :
 	fSession(0), fSessionStoreGlobal(Anything::ArrayMarker(), coast::storage::Global()), fSessionStoreCurrent(Anything::ArrayMarker(),
-			coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fRequest(Anything::ArrayMarker()), fSocket(
-			socket), fCopySessionStore(false) {
+			coast::storage::Current()), fSessionStoreSnapshot(coast::storage::Global()), fSessionStoreWritten(Anything::ArrayMarker(), coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fRequest(Anything::ArrayMarker()), fSocket(
+			socket), fCopySessionStore(false), fSessionStoreShared(false) {
 	// the arguments we get for this request
 	if (fSocket) {
 		fRequest["ClientInfo"] = fSocket->ClientInfo();
@@ -51,8 +51,8 @@ Context::Context(const Anything &env, const Anything &query, Server *server, Ses
 			// session's ref count while the destructor decrements it. Init(s) does the needed intitialization
 			// while InitSession handles the refcounting correctly.
 			fSessionStoreGlobal(Anything::ArrayMarker(), coast::storage::Global()), fSessionStoreCurrent(Anything::ArrayMarker(),
-					coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fSocket(0),
-			fCopySessionStore(false) {
+					coast::storage::Current()), fSessionStoreSnapshot(coast::storage::Global()), fSessionStoreWritten(Anything::ArrayMarker(), coast::storage::Current()), fStackSz(0), fStoreSz(0), fStore(Anything::ArrayMarker()), fSocket(0),
+			fCopySessionStore(false), fSessionStoreShared(false) {
 	InitSession(s);
 	InitTmpStore();
 	fRequest["env"] = env;
@@ -65,6 +65,8 @@ Context::Context(const Anything &env, const Anything &query, Server *server, Ses
 
 Context::~Context() {
 	if (fSession) {
+		MergeSessionStore();
+		ReleaseSessionStoreSnapshot();
 		LockSession();
 		// SOP: should we resynch store again, or should PutInStore take care?
 		fSession->UnRef();
@@ -73,7 +75,7 @@ Context::~Context() {
 }
 
 void Context::InitSession(Session *s) {
-	// Make a copy of the session store if fCopySessionStore is on. Reference the session to
+	// Share the read only copy of the session store if fCopySessionStore is on. Reference the session to
 	// inhibit premature destruction of session object.
 	StartTrace1(Context.InitSession, String() << (long)(void *)this);
 
@@ -88,6 +90,12 @@ void Context::InitSession(Session *s) {
 
 	Session *saveSession = fSession;
 	if (sessionIsDifferent || fCopySessionStore) {
+		// changes made so far must not get lost when the copy is taken again
+		MergeSessionStore();
+		if (sessionIsDifferent) {
+			// the shared copy belongs to the old session, its reference must be dropped under the old lock
+			ReleaseSessionStoreSnapshot();
+		}
 		// first handle pushed session because it might get deleted underway
 		fSession = s;
 		if (fSession) {
@@ -99,13 +107,20 @@ void Context::InitSession(Session *s) {
 						"] refCount: [" << fSession->GetRefCount() << "]");
 			}
 			if (fCopySessionStore) {
-				fSessionStoreCurrent = fSession->GetStoreGlobal().DeepClone(fSessionStoreCurrent.GetAllocator());
+				// share the session wide copy, GetSessionStore() clones the slots written to
+				fSessionStoreSnapshot = fSession->GetStoreSnapshot();
+				fSessionStoreShared = true;
+				fSessionStoreCurrent = Anything(Anything::ArrayMarker(), fSessionStoreCurrent.GetAllocator());
+				fSessionStoreWritten = Anything(Anything::ArrayMarker(), fSessionStoreWritten.GetAllocator());
 				Trace("new s: About to unlock <" << fSession->GetId() << ">");
 			} else {
+				fSessionStoreSnapshot = Anything(fSessionStoreSnapshot.GetAllocator());
+				fSessionStoreShared = false;
 				fSessionStoreGlobal = fSession->GetStoreGlobal();
 			}
 			UnlockSession();
 		} else {
+			fSessionStoreShared = false;
 			if (fCopySessionStore) {
 				fSessionStoreCurrent = Anything(Anything::ArrayMarker(),fSessionStoreCurrent.GetAllocator());
 			} else {
@@ -182,12 +197,73 @@ Anything &Context::GetEnvStore() {
 }
 
 Anything &Context::GetRoleStoreGlobal() {
-	return GetSessionStore()["RoleStore"];
+	return GetSessionStore("RoleStore")["RoleStore"];
 }
 
 Anything &Context::GetSessionStore() {
 	StartTrace1(Context.GetSessionStore, "fCopySessionStore: " << ( fCopySessionStore ? "true" : "false") );
-	return fCopySessionStore ? fSessionStoreCurrent : fSessionStoreGlobal;
+	if (!fCopySessionStore) {
+		return fSessionStoreGlobal;
+	}
+	if (fSessionStoreShared) {
+		// write access to the whole store, copy all slots not written yet into request memory
+		Trace("cloning shared session store");
+		ROAnything roaSnapshot(fSessionStoreSnapshot);
+		for (long i = 0, sz = roaSnapshot.GetSize(); i < sz; ++i) {
+			const char *pSlotName = roaSnapshot.SlotName(i);
+			if (!pSlotName) {
+				fSessionStoreCurrent.Append(roaSnapshot[i].DeepClone(fSessionStoreCurrent.GetAllocator()));
+			} else if (!fSessionStoreWritten.IsDefined(pSlotName)) {
+				fSessionStoreWritten[pSlotName] = true;
+				fSessionStoreCurrent[pSlotName] = roaSnapshot[i].DeepClone(fSessionStoreCurrent.GetAllocator());
+			}
+		}
+		fSessionStoreShared = false;
+	}
+	return fSessionStoreCurrent;
+}
+
+Anything &Context::GetSessionStore(const char *slot) {
+	StartTrace1(Context.GetSessionStore, "slot: <" << NotNull(slot) << ">");
+	if (!fCopySessionStore) {
+		return fSessionStoreGlobal;
+	}
+	if (fSessionStoreShared && !fSessionStoreWritten.IsDefined(slot)) {
+		// first write access to this slot, copy it into request memory
+		Trace("cloning slot of shared session store");
+		fSessionStoreWritten[slot] = true;
+		ROAnything roaSnapshot(fSessionStoreSnapshot);
+		if (roaSnapshot.IsDefined(slot)) {
+			fSessionStoreCurrent[slot] = roaSnapshot[slot].DeepClone(fSessionStoreCurrent.GetAllocator());
+		}
+	}
+	return fSessionStoreCurrent;
+}
+
+ROAnything Context::GetSessionStoreForLookup(const char *slot) const {
+	// the shared copy is immutable and kept alive by our reference, no lock needed
+	if (fSessionStoreShared && !fSessionStoreWritten.IsDefined(slot)) {
+		return fSessionStoreSnapshot;
+	}
+	return fSessionStoreCurrent;
+}
+
+void Context::MergeSessionStore() {
+	if (!fSession || !fCopySessionStore || fSessionStoreWritten.GetSize() == 0L) {
+		return;
+	}
+	StartTrace1(Context.MergeSessionStore, "written slots: " << fSessionStoreWritten.GetSize());
+	LockUnlockEntry me(fSession->fMutex);
+	fSession->MergeStoreSlots(fSessionStoreWritten, fSessionStoreCurrent, fSessionStoreSnapshot);
+	fSessionStoreWritten = Anything(Anything::ArrayMarker(), fSessionStoreWritten.GetAllocator());
+}
+
+void Context::ReleaseSessionStoreSnapshot() {
+	if (fSession && !fSessionStoreSnapshot.IsNull()) {
+		LockUnlockEntry me(fSession->fMutex);
+		fSessionStoreSnapshot = Anything(fSessionStoreSnapshot.GetAllocator());
+	}
+	fSessionStoreShared = false;
 }
 
 Anything &Context::GetTmpStore() {
@@ -488,11 +564,13 @@ bool Context::LookupStack(const char *key, ROAnything &result, char delim, char
 bool Context::LookupStores(const char *key, ROAnything &result, char delim, char indexdelim) const {
 	StartTrace1(Context.LookupStores, "key:<" << NotNull(key) << ">");
 	if (fCopySessionStore) {
-		if (ROAnything(fSessionStoreCurrent)["RoleStore"].LookupPath(result, key, delim, indexdelim)) {
+		if (GetSessionStoreForLookup("RoleStore")["RoleStore"].LookupPath(result, key, delim, indexdelim)) {
 			Trace("found in RoleStore [Current]");
 			return true;
 		}
-		if (ROAnything(fSessionStoreCurrent).LookupPath(result, key, delim, indexdelim)) {
+		const char delims[] = { delim, indexdelim, '\0' };
+		String strSlot(key, key ? static_cast<long>(strcspn(key, delims)) : 0L);
+		if (GetSessionStoreForLookup(strSlot).LookupPath(result, key, delim, indexdelim)) {
 			Trace("found in SessionStore [Current]");
 			return true;
 		}
@@ -184,9 +184,19 @@ public:
 		Be aware that mixing differently allocated Anythings will always lead to the
 		automatic copying into the allocator of the respective target Anything.
 		Do use a globally allocated Anything to store the result of this method, e.g.
-		"TrickyThing roleStore(GetRoleStoreGlobal());". */
+		"TrickyThing roleStore(GetRoleStoreGlobal());".
+		\note With /Context/CopySessionStore set, this copies every slot of the session store into request memory,
+		use GetSessionStore(const char *) if only one slot gets modified */
 	Anything &GetSessionStore();
 
+	/*! Access the session store for modifying the top level slot given only
+		With /Context/CopySessionStore set, only this slot is copied from the shared copy into request memory.
+		Slots modified by the request are written back to the session when the request ends, a slot replaces
+		the one of the session if it differs from the shared copy the request started with.
+		\param slot name of the top level slot that gets modified, modify nothing else in the returned store
+		\return the session store, see GetSessionStore() */
+	Anything &GetSessionStore(const char *slot);
+
 	//!assemble state into a which will be used in link
 	void CollectLinkState(Anything &a);
 
@@ -309,6 +319,15 @@ protected:
 	/*! reacquire session lock if configuration told me to release it */
 	void LockSession();
 
+	/*! drop the reference to the shared session store copy while holding the lock of the session it belongs to */
+	void ReleaseSessionStoreSnapshot();
+
+	/*! write the session store slots modified by this request back to the session, see GetSessionStore(const char *) */
+	void MergeSessionStore();
+
+	/*! the session store lookups below the top level slot go to, either the shared copy or the request copy */
+	ROAnything GetSessionStoreForLookup(const char *slot) const;
+
 private:
 	/*! Push the given Anything on top of the lookup stack. This is a very convenient way to pass arguments to subsequent context based operations.
 		\param key Name of passed object. This name does not have to be unique, it is only used for information purpose. This means a Push with the same name does not overwrite an already existing stack element with the same name.
@@ -335,6 +354,10 @@ private:
 	//! the reference to the session store (coast::storage::Global and coast::storage::Current)
 	Anything fSessionStoreGlobal;
 	Anything fSessionStoreCurrent;
+	//! read only copy of the session store shared with other contexts (coast::storage::Global), see Session::GetStoreSnapshot()
+	Anything fSessionStoreSnapshot;
+	//! names of the top level session store slots copied to fSessionStoreCurrent for writing
+	Anything fSessionStoreWritten;
 
 	//! cached language setting
 	String fLanguage;
@@ -363,9 +386,12 @@ private:
 	//! the requests socket if any
 	Socket *fSocket;
 
-	/*! if set, make a copy of the session store. This allows concurrent requests using the same session because lookups targeting the session store don't need a lock. */
+	/*! if set, work on a copy of the session store. The copy is shared until write access is requested. This allows concurrent requests using the same session because lookups targeting the session store don't need a lock. */
 	bool fCopySessionStore;
 
+	//! true as long as fSessionStoreSnapshot is used for the slots not copied to fSessionStoreCurrent
+	bool fSessionStoreShared;
+
 	Context(const Context &);
 	Context &operator=(const Context &);
 	// due to its changed semantics GetRoleStore() has been
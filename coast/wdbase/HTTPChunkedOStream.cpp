@@ -9,10 +9,33 @@
 #include "HTTPChunkedOStream.h"
 #include "Tracer.h"
 #include <ctype.h>
+#include <cstring>
+
+namespace {
+	//! room for the hexadecimal chunk length and CRLF
+	const long cChunkHeaderSpace = 2 * sizeof(long) + 2;
+	const char cLastChunk[] = "0" ENDL ENDL;
+	//! room for CRLF and the termination chunk
+	const long cChunkTrailerSpace = 2 + sizeof(cLastChunk) - 1;
+
+	//! render the header of a chunk of ulLength bytes ending right before pEnd
+	//! \return start of the header
+	char *PutChunkHeader(char *pEnd, unsigned long ulLength)
+	{
+		static const char cHexDigits[] = "0123456789abcdef";
+		*--pEnd = '\n';
+		*--pEnd = '\r';
+		do {
+			*--pEnd = cHexDigits[ulLength & 0xfUL];
+			ulLength >>= 4;
+		} while (ulLength);
+		return pEnd;
+	}
+}
 
 HTTPChunkedStreamBuf::HTTPChunkedStreamBuf(std::ostream &os, long chunklength, Allocator *alloc)
 	: fAllocator(alloc ? alloc : coast::storage::Current())
-	, fStore(chunklength, fAllocator)
+	, fStore(chunklength + cChunkHeaderSpace + cChunkTrailerSpace, fAllocator)
 	, fOs(&os)
 	, fBufSize(chunklength)
 {
@@ -30,8 +53,7 @@ void HTTPChunkedStreamBuf::close()
 	if (!fOs) {
 		return;
 	}
-	sync();
-	(*fOs) << '0' << ENDL << ENDL;
+	WriteChunk(0, 0L, true);
 	fOs->flush();
 	fOs = 0;
 }
@@ -43,20 +65,32 @@ int HTTPChunkedStreamBuf::sync()
 	if (!fOs) {
 		return EOF;
 	}
-	long len = pptr() - pbase();
+	WriteChunk(0, 0L, false);
+	return 0;
+}
+
+void HTTPChunkedStreamBuf::WriteChunk(const char *pBlock, long lBlock, bool bLast)
+{
+	char *pStart = pbase(), *pEnd = pptr();
+	long len = (pEnd - pStart) + lBlock;
 	if (len > 0) {
-#if defined(WIN32)
-		long old = fOs->flags();
-#else
-		std::ios::fmtflags old = fOs->flags();
-#endif
-		(*fOs) << std::hex << len << ENDL;
-		fOs->flags(old);
-		fOs->write((const char *)fStore, len);
-		(*fOs) << ENDL ;
-		pinit();
+		pStart = PutChunkHeader(pStart, len);
+		if (lBlock > 0) {
+			fOs->write(pStart, pEnd - pStart);
+			fOs->write(pBlock, lBlock);
+			pStart = pEnd;
+		}
+		*pEnd++ = '\r';
+		*pEnd++ = '\n';
 	}
-	return 0;
+	if (bLast) {
+		memcpy(pEnd, cLastChunk, sizeof(cLastChunk) - 1);
+		pEnd += sizeof(cLastChunk) - 1;
+	}
+	if (pEnd > pStart) {
+		fOs->write(pStart, pEnd - pStart);
+	}
+	pinit();
 }
 
 HTTPChunkedStreamBuf::pos_type HTTPChunkedStreamBuf::seekpos(pos_type, openmode mode)
@@ -78,6 +112,21 @@ int HTTPChunkedStreamBuf::overflow(int c)
 	return 0L;  // return 0 if successful
 }
 
+std::streamsize HTTPChunkedStreamBuf::xsputn(const char *s, std::streamsize n)
+{
+	if (!fOs) {
+		return 0;
+	}
+	std::streamsize lDone = 0;
+	// the chunks are the same as if the block was copied into the buffer
+	while (epptr() > pptr() && n - lDone >= epptr() - pptr()) {
+		long lPart = epptr() - pptr();
+		WriteChunk(s + lDone, lPart, false);
+		lDone += lPart;
+	}
+	return lDone + std::streambuf::xsputn(s + lDone, n - lDone);
+}
+
 int HTTPChunkedStreamBuf::underflow()
 {
 	return 0;
@@ -91,7 +140,7 @@ void HTTPChunkedStreamBuf::xinit()
 
 void HTTPChunkedStreamBuf::pinit()
 {
-	char *sc = (char *)(const char *)fStore;
+	char *sc = (char *)(const char *)fStore + cChunkHeaderSpace;
 	char *endptr = sc + fBufSize;
 	setp(sc, endptr);
 }
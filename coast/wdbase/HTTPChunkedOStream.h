@@ -12,6 +12,9 @@
 #include "StringStream.h"
 
 //! Streambuffer for HTTPChunkedOStream.
+/*! The chunk header is rendered into room reserved in front of the buffer and the chunk trailer behind it, so a
+	buffered chunk is passed to the wrapped ostream with a single write. Blocks filling the rest of the buffer are
+	passed on directly in chunks of the same size instead of being copied into the buffer first. */
 class HTTPChunkedStreamBuf : public streambuf
 {
 public:
@@ -44,6 +47,9 @@ protected: // seekxxx are protected in the std..
 	//! consumes chars of the put area
 	virtual int overflow(int c = EOF);
 
+	//! passes full chunks of s on without copying them
+	virtual std::streamsize xsputn(const char *s, std::streamsize n);
+
 	//! produces characters for the get area
 	virtual int underflow();
 
@@ -60,6 +66,10 @@ protected: // seekxxx are protected in the std..
 	std::ostream *fOs;
 
 private:
+	//! writes the buffered bytes followed by lBlock bytes of pBlock as one chunk
+	//! \param bLast append the termination chunk
+	void WriteChunk(const char *pBlock, long lBlock, bool bLast);
+
 	//! size of the internal buffer, is equal to the chunk size
 	long fBufSize;
 };
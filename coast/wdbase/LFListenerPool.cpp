@@ -167,6 +167,7 @@ void RequestReactor::DoProcessEvent(Socket *sock)
 				RequestTimer(Cycle, "Nr: " << fStatHandler->GetTotalRequests(), ctx);
 				fProcessor->ProcessRequest(ctx);
 			}
+			RequestProcessor::RecordPhaseTimes(ctx, *fStatHandler);
 			// log all time related items
 			RequestTimeLogger(ctx);
 
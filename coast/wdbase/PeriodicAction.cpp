@@ -9,10 +9,11 @@
 #include "PeriodicAction.h"
 #include "Context.h"
 
-PeriodicAction::PeriodicAction(const String &action, long waitTime)
+PeriodicAction::PeriodicAction(const String &action, long waitTime, ROAnything roaContent)
 	: Thread((const char *)action, true)
 	, fAction(action)
 	, fWaitTime(waitTime)
+	, fContent(roaContent.DeepClone(coast::storage::Global()))
 {
 }
 
@@ -24,7 +25,7 @@ void PeriodicAction::Run()
 {
 	StartTrace(PeriodicAction.Run);
 	Context ctx;
-	Anything anyConfig;
+	Anything anyConfig = fContent.DeepClone();
 	anyConfig["PeriodicActionTimeout"] = fWaitTime;
 	while ( CheckState( eRunning, 0, 1 ) ) {
 		Trace("Waiting " << fWaitTime << "s for next period");
@@ -20,7 +20,8 @@ public:
 	//!construct thread with action which is executed periodically after waitTime seconds
 	//! \param action the action name which is used to executed a periodic action
 	//! \param waitTime the waitTime between two action executions
-	PeriodicAction(const String &action, long waitTime);
+	//! \param roaContent optional slots the action can look up in its context besides PeriodicActionTimeout
+	PeriodicAction(const String &action, long waitTime, ROAnything roaContent = ROAnything());
 	~PeriodicAction();
 
 protected:
@@ -39,6 +40,8 @@ private:
 	String fAction;
 	//!the wait time between to invocation of the action
 	long fWaitTime;
+	//!lookup content of the context the action is executed with
+	Anything fContent;
 
 	friend class PeriodicActionTest;
 };
@@ -12,12 +12,179 @@
 #include "Policy.h"
 #include "InitFinisManager.h"
 #include "CacheHandler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	//! upper bound of displacements tried per bucket before giving up
+	const unsigned long gulMaxDisplacement = 1UL << 16;
+
+	struct BucketBySize {
+		const std::vector<std::vector<long> > &fBuckets;
+		BucketBySize(const std::vector<std::vector<long> > &buckets) : fBuckets(buckets) {}
+		bool operator()(long lhs, long rhs) const {
+			return fBuckets[lhs].size() > fBuckets[rhs].size();
+		}
+	};
+}
+
+FrozenRegistryTable::FrozenRegistryTable()
+	: fSize(0L)
+	, fMask(0UL)
+{
+}
+
+unsigned long FrozenRegistryTable::Hash(const char *name)
+{
+	// FNV-1a, 32 bit
+	unsigned long ulHash = 2166136261UL;
+	while ( *name ) {
+		ulHash ^= (unsigned char) * name++;
+		ulHash = ( ulHash * 16777619UL ) & 0xffffffffUL;
+	}
+	return ulHash;
+}
+
+unsigned long FrozenRegistryTable::Slot(unsigned long hash, unsigned long displacement, unsigned long mask)
+{
+	// murmur3 finalizer on the displaced hash
+	unsigned long ulSlot = ( hash ^ ( displacement * 0x9e3779b9UL ) ) & 0xffffffffUL;
+	ulSlot ^= ulSlot >> 16;
+	ulSlot = ( ulSlot * 0x85ebca6bUL ) & 0xffffffffUL;
+	ulSlot ^= ulSlot >> 13;
+	ulSlot = ( ulSlot * 0xc2b2ae35UL ) & 0xffffffffUL;
+	ulSlot ^= ulSlot >> 16;
+	return ulSlot & mask;
+}
+
+bool FrozenRegistryTable::Build(const ROAnything roaTable)
+{
+	StartTrace(FrozenRegistryTable.Build);
+	long lSize = roaTable.GetSize();
+	// slots are a power of two with at least 25% headroom, four names per bucket on average
+	unsigned long ulSlots = 1UL;
+	while ( ulSlots < (unsigned long)( lSize + lSize / 4L ) ) {
+		ulSlots <<= 1;
+	}
+	unsigned long ulBuckets = ( lSize + 3L ) / 4L;
+	if ( ulBuckets == 0UL ) {
+		ulBuckets = 1UL;
+	}
+	std::vector<unsigned long> hashes(lSize);
+	std::vector<std::vector<long> > buckets(ulBuckets);
+	for (long i = 0; i < lSize; ++i) {
+		const char *slotName = roaTable.SlotName(i);
+		if ( !slotName ) {
+			return false;
+		}
+		hashes[i] = Hash(slotName);
+		buckets[hashes[i] % ulBuckets].push_back(i);
+	}
+	std::vector<long> order(ulBuckets);
+	for (unsigned long b = 0; b < ulBuckets; ++b) {
+		order[b] = (long)b;
+	}
+	std::sort(order.begin(), order.end(), BucketBySize(buckets));
+
+	std::vector<unsigned long> displacements(ulBuckets, 0UL);
+	std::vector<long> slotOwner(ulSlots, -1L);
+	std::vector<unsigned long> candidate;
+	for (unsigned long o = 0; o < ulBuckets && !buckets[order[o]].empty(); ++o) {
+		const std::vector<long> &bucket = buckets[order[o]];
+		unsigned long d = 0UL;
+		for ( ; d < gulMaxDisplacement; ++d) {
+			candidate.clear();
+			bool bFits = true;
+			for (size_t k = 0; bFits && k < bucket.size(); ++k) {
+				unsigned long ulSlot = Slot(hashes[bucket[k]], d, ulSlots - 1UL);
+				bFits = ( slotOwner[ulSlot] < 0L ) && ( std::find(candidate.begin(), candidate.end(), ulSlot) == candidate.end() );
+				candidate.push_back(ulSlot);
+			}
+			if ( bFits ) {
+				break;
+			}
+		}
+		if ( d == gulMaxDisplacement ) {
+			Trace("no displacement found for bucket " << order[o]);
+			return false;
+		}
+		displacements[order[o]] = d;
+		for (size_t k = 0; k < bucket.size(); ++k) {
+			slotOwner[candidate[k]] = bucket[k];
+		}
+	}
+
+	fEntries.assign(ulSlots, Entry());
+	fNames.clear();
+	for (unsigned long ulSlot = 0; ulSlot < ulSlots; ++ulSlot) {
+		Entry &entry = fEntries[ulSlot];
+		long i = slotOwner[ulSlot];
+		entry.fHash = ( i < 0L ) ? 0UL : hashes[i];
+		entry.fNameOffset = (long)fNames.size();
+		entry.fObject = ( i < 0L ) ? 0 : roaTable[i].AsIFAObject(0);
+		const char *slotName = ( i < 0L ) ? "" : roaTable.SlotName(i);
+		fNames.insert(fNames.end(), slotName, slotName + strlen(slotName) + 1);
+	}
+	fDisplacements.swap(displacements);
+	fMask = ulSlots - 1UL;
+	fSize = lSize;
+	Trace("built table of " << lSize << " names in " << (long)ulSlots << " slots");
+	return true;
+}
+
+IFAObject *FrozenRegistryTable::Find(const char *name) const
+{
+	if ( fEntries.empty() ) {
+		return 0;
+	}
+	unsigned long ulHash = Hash(name);
+	const Entry &entry = fEntries[Slot(ulHash, fDisplacements[ulHash % fDisplacements.size()], fMask)];
+	if ( entry.fObject && entry.fHash == ulHash && strcmp(&fNames[entry.fNameOffset], name) == 0 ) {
+		return entry.fObject;
+	}
+	return 0;
+}
 
 Registry::Registry(const char *category) :
-		NotCloned(category), fTable(Anything::ArrayMarker(), coast::storage::Global()) {
+		NotCloned(category), fTable(Anything::ArrayMarker(), coast::storage::Global()), fFrozen(0) {
 }
 
 Registry::~Registry() {
+	Unfreeze();
+}
+
+bool Registry::Freeze()
+{
+	StartTrace1(Registry.Freeze, "category <" << GetName() << ">");
+	Unfreeze();
+	FrozenRegistryTable *pFrozen = new FrozenRegistryTable();
+	if ( pFrozen->Build(fTable) ) {
+		fFrozen = pFrozen;
+		return true;
+	}
+	SystemLog::Warning(String("Registry <", -1, coast::storage::Global()).Append(GetName()).Append("> could not be frozen, keeping hashed lookups"));
+	delete pFrozen;
+	return false;
+}
+
+void Registry::Unfreeze()
+{
+	StartTrace1(Registry.Unfreeze, "category <" << GetName() << ">");
+	delete fFrozen;
+	fFrozen = 0;
+	for (size_t i = 0; i < fDropped.size(); ++i) {
+		delete fDropped[i];
+	}
+	fDropped.clear();
+}
+
+void Registry::DropFrozen()
+{
+	if ( fFrozen ) {
+		StartTrace1(Registry.DropFrozen, "category <" << GetName() << ">");
+		fDropped.push_back(fFrozen);
+		fFrozen = 0;
+	}
 }
 
 bool Registry::Terminate(TerminationPolicy *terminator)
@@ -48,6 +215,9 @@ RegisterableObject *Registry::Find(const char *name)
 	// try to find object with name
 	Assert(name);
 	RegisterableObject *r = 0;
+	if ( fFrozen ) {
+		return name ? (RegisterableObject *)fFrozen->Find(name) : 0;
+	}
 	// make it robust
 	if ( name && GetTable().IsDefined(name) ) {
 		r = (RegisterableObject *)GetTable()[name].AsIFAObject(0);
@@ -61,6 +231,7 @@ void Registry::RegisterRegisterableObject(const char *name, RegisterableObject *
 	Assert(name && o);
 	// make it robust
 	if ( name && o ) {
+		DropFrozen();
 		GetTable()[name] = Anything(o);
 	}
 }
@@ -71,6 +242,7 @@ void Registry::UnregisterRegisterableObject(const char *name)
 	RegisterableObject *o = Find(name);
 	if ( o ) {
 		Trace("object with name [" << NotNull(name) << "] found, trying to remove aliases");
+		DropFrozen();
 		GetTable().Remove(name);
 		// removing aliases
 		RemoveAliases(o);
@@ -87,6 +259,7 @@ void Registry::RemoveAliases(RegisterableObject *obj)
 			RegisterableObject *alias = ri.Next(strAlias);
 			if (alias && alias == obj) {
 				Trace("removing object alias [" << strAlias << "]");
+				DropFrozen();
 				GetTable().Remove(strAlias);
 			}
 		}
@@ -98,7 +271,7 @@ Anything &Registry::GetTable() {
 }
 
 MetaRegistryImpl::MetaRegistryImpl() :
-		fRegistryArray(Anything::ArrayMarker(), coast::storage::Global()) {
+		fRegistryArray(Anything::ArrayMarker(), coast::storage::Global()), fRegistryMutex("MetaRegistry", coast::storage::Global()) {
 	// force initializing cache handler before us
 	CacheHandler::instance();
 	InitFinisManager::IFMTrace("MetaRegistry::Initialized\n");
@@ -115,14 +288,20 @@ Anything &MetaRegistryImpl::GetRegTable() {
 
 Registry *MetaRegistryImpl::GetRegistry(const char *category) {
 	StatTrace(Registry.GetRegistry, "category <" << NotNull(category) << ">", coast::storage::Current());
+	LockUnlockEntry me(fRegistryMutex);
 	Registry *r = dynamic_cast<Registry *>(ROAnything(fRegistryArray)[category].AsIFAObject(0));
 	if (not r) {
-		r = MakeRegistry(category);
+		r = IntMakeRegistry(category);
 	}
 	return r;
 }
 
 Registry *MetaRegistryImpl::MakeRegistry(const char *category) {
+	LockUnlockEntry me(fRegistryMutex);
+	return IntMakeRegistry(category);
+}
+
+Registry *MetaRegistryImpl::IntMakeRegistry(const char *category) {
 	StatTrace(Registry.MakeRegistry, "category <" << NotNull(category) << ">", coast::storage::Current());
 	String msg("Creating Registry for: <");
 	msg.Append(NotNull(category)).Append('>');
@@ -139,6 +318,7 @@ Registry *MetaRegistryImpl::RemoveRegistry(const char *category) {
 	SystemLog::Info(msg);
 	Registry *r = 0;
 	Anything a;
+	LockUnlockEntry me(fRegistryMutex);
 	if (GetRegTable().LookupPath(a, category)) {
 		r = dynamic_cast<Registry *>(a.AsIFAObject(0));
 		GetRegTable().Remove(category);
@@ -146,6 +326,31 @@ Registry *MetaRegistryImpl::RemoveRegistry(const char *category) {
 	return r;
 }
 
+long MetaRegistryImpl::FreezeAll() {
+	StartTrace(Registry.FreezeAll);
+	LockUnlockEntry me(fRegistryMutex);
+	long lFrozen = 0L;
+	for (long i = 0, sz = fRegistryArray.GetSize(); i < sz; ++i) {
+		Registry *r = dynamic_cast<Registry *>(fRegistryArray[i].AsIFAObject(0));
+		if (r && r->Freeze()) {
+			++lFrozen;
+		}
+	}
+	Trace("froze " << lFrozen << " of " << fRegistryArray.GetSize() << " registries");
+	return lFrozen;
+}
+
+void MetaRegistryImpl::UnfreezeAll() {
+	StartTrace(Registry.UnfreezeAll);
+	LockUnlockEntry me(fRegistryMutex);
+	for (long i = 0, sz = fRegistryArray.GetSize(); i < sz; ++i) {
+		Registry *r = dynamic_cast<Registry *>(fRegistryArray[i].AsIFAObject(0));
+		if (r) {
+			r->Unfreeze();
+		}
+	}
+}
+
 void MetaRegistryImpl::FinalizeRegArray() {
 	StartTrace(Registry.FinalizeRegArray);
 	long sz = fRegistryArray.GetSize();
@@ -239,6 +444,7 @@ RegisterableObject *RegistryIterator::RemoveNext(String &key)
 			if (fForward) {
 				--fStart;
 			}
+			fRegistry->DropFrozen();
 			table.Remove((fForward) ? fStart : fStart + 1);
 		}
 	}
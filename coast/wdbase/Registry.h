@@ -11,6 +11,45 @@
 
 //PS make Registry an IFAObject --> NotCloned to have clean handling of Anything
 #include "IFAConfObject.h"
+#include "Threads.h"
+#include <vector>
+
+//! immutable name to object table using a minimal collision free (perfect) hash, see Registry::Freeze
+/*! Names are hashed once, a per bucket displacement selects the slot, and a single string compare confirms the hit.
+	The names are kept in one contiguous buffer. Building fails if no displacement separates the names of a bucket,
+	the registry then stays with its Anything table. */
+class FrozenRegistryTable
+{
+public:
+	FrozenRegistryTable();
+
+	//! build the table from roaTable, slot names are the keys and slots hold the objects
+	/*! \return false if no perfect hash could be found, the table is empty then */
+	bool Build(const ROAnything roaTable);
+
+	//! find object registered under name, 0 if not found; concurrent readers do not need a lock
+	IFAObject *Find(const char *name) const;
+
+	//! number of names in the table
+	long GetSize() const {
+		return fSize;
+	}
+
+private:
+	struct Entry {
+		unsigned long fHash;
+		long fNameOffset;
+		IFAObject *fObject;
+	};
+	static unsigned long Hash(const char *name);
+	static unsigned long Slot(unsigned long hash, unsigned long displacement, unsigned long mask);
+
+	long fSize;
+	unsigned long fMask;
+	std::vector<unsigned long> fDisplacements;
+	std::vector<Entry> fEntries;
+	std::vector<char> fNames;
+};
 
 //!an infrastructure class to register and retrieve objects by name
 //!objects of given types can be registered according to a specification and a InstallerPolicy object.<br>
@@ -54,6 +93,19 @@ public:
 
 	RegisterableObject *Find(const char *name);
 
+	//! build an immutable lookup table, Find does not touch the Anything table afterwards
+	/*! Registering or removing objects drops the frozen table again. Freeze and Unfreeze must only be called
+		while no other thread uses the registry, eg. during module initialization or reset.
+		\return true if a frozen table is in use */
+	bool Freeze();
+
+	//! go back to lookups through the Anything table
+	void Unfreeze();
+
+	bool IsFrozen() const {
+		return fFrozen != 0;
+	}
+
 protected:
 	//!accessor to the registry's representation
 	Anything &GetTable();
@@ -61,6 +113,12 @@ protected:
 	Anything fTable;
 
 private:
+	//! a frozen table is only replaced with a change, readers might still use it until Freeze or Unfreeze
+	void DropFrozen();
+
+	FrozenRegistryTable *fFrozen;
+	std::vector<FrozenRegistryTable *> fDropped;
+
 	Registry(const Registry &);
 	Registry &operator=(const Registry &);
 };
@@ -69,8 +127,11 @@ private:
 class MetaRegistryImpl {
 	//! Global container holding any registry entries
 	Anything fRegistryArray;
+	//! guards fRegistryArray, modules might get installed concurrently, see WDModule
+	SimpleMutex fRegistryMutex;
 	//!delete global registry
 	void FinalizeRegArray();
+	Registry *IntMakeRegistry(const char *category);
 public:
 	MetaRegistryImpl();
 	~MetaRegistryImpl();
@@ -92,6 +153,13 @@ public:
 
 	//!accessor to the global registry table
 	Anything &GetRegTable();
+
+	//! freeze all registries, see Registry::Freeze
+	/*! \return number of registries frozen */
+	long FreezeAll();
+
+	//! unfreeze all registries before they are changed again
+	void UnfreezeAll();
 };
 typedef coast::utility::singleton_default<MetaRegistryImpl> MetaRegistry;
 
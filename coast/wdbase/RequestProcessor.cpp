@@ -8,9 +8,12 @@
 
 #include "RequestProcessor.h"
 #include "Socket.h"
+#include "SocketStream.h"
 #include "Registry.h"
 #include "Server.h"
 #include "ServerUtils.h"
+#include "WPMStatHandler.h"
+#include "DiffTimer.h"
 
 RegCacheImpl(RequestProcessor)
 ; // FindRequestProcessor()
@@ -38,20 +41,35 @@ void RequestProcessor::ProcessRequest(Context &ctx) {
 		socket->SetTimeout(timeout.AsLong(10 * 1000L));
 		TraceAny(socket->ClientInfo(), "socket client info");
 		Ios = socket->GetStream();
+		ROAnything maxBufSize;
+		SocketStreamBuf *pBuf = Ios ? dynamic_cast<SocketStreamBuf *>(Ios->rdbuf()) : 0;
+		if ( pBuf && ctx.Lookup("SocketStreamMaxBufferSize", maxBufSize) ) {
+			pBuf->SetMaxBufferSize(maxBufSize.AsLong(cSocketStreamMaxBufferSize));
+		}
 	}
 
 	if (Ios && socket->IsReadyForReading()) {
 		// disable nagle algorithm
 		socket->SetNoDelay();
-		if (ReadInput(*Ios, ctx) && !!(*Ios)) {
+		// phase times are measured from the moment data is available, idle time of persistent connections is excluded
+		DiffTimer aPhaseTimer(DiffTimer::eMicroseconds);
+		Anything anyPhases(Anything::ArrayMarker(), ctx.GetTmpStore().GetAllocator());
+		ctx.GetTmpStore()["RequestPhases"] = anyPhases;
+		bool bInputRead = ReadInput(*Ios, ctx) && !!(*Ios);
+		anyPhases["Read"] = (long) aPhaseTimer.Reset();
+		if (bInputRead) {
 
 			KeepConnectionAlive(ctx); //!@FIXME: should not be a feature of a non-HTTP request
 
 			if (socket->IsReadyForWriting()) {
-				if (VerifyRequest(*Ios, ctx)) {
+				aPhaseTimer.Start();
+				bool bVerified = VerifyRequest(*Ios, ctx);
+				anyPhases["Verify"] = (long) aPhaseTimer.Reset();
+				if (bVerified) {
 					// process this arguments and
 					// write the output to the reply
 					IntProcessRequest(*Ios, ctx);
+					anyPhases["Process"] = (long) aPhaseTimer.Reset();
 					//!@FIXME BufferReply mechanism possible
 				}
 			}
@@ -133,6 +151,22 @@ void RequestProcessor::RenderProtocolStatus(std::ostream &os, Context &ctx) {
 	GetCurrentRequestProcessor(ctx)->DoRenderProtocolStatus(os, ctx); //!@FIXME: remove as soon as static members are not required anymore
 }
 
+void RequestProcessor::RecordPhaseTimes(Context &ctx, WPMStatHandler &stat) {
+	StartTrace(RequestProcessor.RecordPhaseTimes);
+	ROAnything roaPhases = ((ROAnything)ctx.GetTmpStore())["RequestPhases"];
+	TraceAny(roaPhases, "phase times");
+	const WPMStatHandler::EPhase phases[] = { WPMStatHandler::eRead, WPMStatHandler::eVerify, WPMStatHandler::eProcess };
+	for (size_t i = 0; i < sizeof(phases) / sizeof(phases[0]); ++i) {
+		ROAnything roaTime;
+		if (roaPhases.LookupPath(roaTime, WPMStatHandler::PhaseName(phases[i]))) {
+			stat.RecordPhase(phases[i], roaTime.AsLong(0L));
+		}
+	}
+	if (roaPhases.IsDefined("Service")) {
+		stat.RecordService(roaPhases["Service"].AsCharPtr(), roaPhases["ServiceTime"].AsLong(0L));
+	}
+}
+
 bool RequestProcessor::ReadInput(std::iostream &Ios, Context &ctx) {
 	StartTrace(RequestProcessor.ReadInput);
 	Anything anyValue = "ReadInput.Error";
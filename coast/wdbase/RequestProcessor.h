@@ -11,6 +11,8 @@
 
 #include "Context.h"
 
+class WPMStatHandler;
+
 //! Policy object shared by all threads to handle a request message;
 class RequestProcessor : public RegisterableObject
 {
@@ -27,6 +29,8 @@ public:
 	virtual void Init(Server *server);
 
 	//!general entry point called by handle request thread
+	/*! looks up /SocketReadTimeout (default 10s) and /SocketStreamMaxBufferSize, the size in bytes the read buffer
+		of the socket stream may grow to, default cSocketStreamMaxBufferSize */
 	virtual void ProcessRequest(Context &ctx);
 
 	//! checks if the connection should keep-alive after the request has been processed
@@ -39,6 +43,13 @@ public:
 	//! render the protocol specific status
 	static void RenderProtocolStatus(std::ostream &os, Context &ctx);
 
+	/*! record the phase and service handler latencies measured while processing the request of ctx
+		ProcessRequest stores them in the TmpStore slot RequestPhases as microseconds: /Read /Verify /Process
+		and /Service /ServiceTime from the ServiceDispatcher
+		\param ctx context of the processed request
+		\param stat statistic handler of the pool which processed the request */
+	static void RecordPhaseTimes(Context &ctx, WPMStatHandler &stat);
+
 	Server* GetServer() {
 		return fServer;
 	}
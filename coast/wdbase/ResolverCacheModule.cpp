@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "ResolverCacheModule.h"
+#include "Resolver.h"
+#include "PeriodicAction.h"
+#include "Action.h"
+#include "Threads.h"
+#include "Tracer.h"
+
+namespace {
+	//! ResolverCache using one SimpleMutex per shard
+	class MTResolverCache: public ResolverCache {
+		SimpleMutex **fMutexes;
+		MTResolverCache(const MTResolverCache &);
+		MTResolverCache &operator=(const MTResolverCache &);
+	public:
+		MTResolverCache(long lTtl, long lNegativeTtl, long lShards, long lMaxEntries) :
+			ResolverCache(lTtl, lNegativeTtl, lShards, lMaxEntries), fMutexes(0) {
+			fMutexes = new SimpleMutex*[GetShards()];
+			for (long lShard = 0; lShard < GetShards(); ++lShard) {
+				fMutexes[lShard] = new SimpleMutex("ResolverCacheShard", coast::storage::Global());
+			}
+		}
+		~MTResolverCache() {
+			for (long lShard = 0; lShard < GetShards(); ++lShard) {
+				delete fMutexes[lShard];
+			}
+			delete[] fMutexes;
+		}
+	protected:
+		virtual void DoLock(long lShard) {
+			fMutexes[lShard]->Lock();
+		}
+		virtual void DoUnlock(long lShard) {
+			fMutexes[lShard]->Unlock();
+		}
+	};
+}
+
+//! refreshes ResolverCache entries about to expire, called from within a PeriodicAction
+class ResolverCacheRefreshAction: public Action {
+public:
+	ResolverCacheRefreshAction(const char *name) :
+		Action(name) {
+	}
+	virtual bool DoExecAction(String &transitionToken, Context &ctx, const ROAnything &config) {
+		StartTrace(ResolverCacheRefreshAction.DoExecAction);
+		ResolverCacheModule *pModule = SafeCast(WDModule::FindWDModule("ResolverCacheModule"), ResolverCacheModule);
+		if ( pModule ) {
+			Resolver::RefreshCache(pModule->GetRefreshInterval());
+			return true;
+		}
+		return false;
+	}
+};
+RegisterAction(ResolverCacheRefreshAction);
+
+RegisterModule(ResolverCacheModule);
+
+ResolverCacheModule::ResolverCacheModule(const char *name) :
+	WDModule(name), fpCache(0), fpRefresher(0), fRefreshInterval(0L)
+{
+}
+
+ResolverCacheModule::~ResolverCacheModule()
+{
+	Finis();
+	for (std::vector<ResolverCache *>::iterator aIt = fRetiredCaches.begin(); aIt != fRetiredCaches.end(); ++aIt) {
+		delete *aIt;
+	}
+}
+
+bool ResolverCacheModule::Init(const ROAnything config)
+{
+	StartTrace(ResolverCacheModule.Init);
+	ROAnything roaModuleConfig;
+	config.LookupPath(roaModuleConfig, fName);
+	TraceAny(roaModuleConfig, "Module config");
+	Finis();
+	fpCache = new (coast::storage::Global()) MTResolverCache(roaModuleConfig["TTL"].AsLong(300L), roaModuleConfig["NegativeTTL"].AsLong(30L), roaModuleConfig["Shards"].AsLong(16L), roaModuleConfig["MaxEntries"].AsLong(1024L));
+	Resolver::SetCache(fpCache);
+	fRefreshInterval = roaModuleConfig["RefreshInterval"].AsLong(0L);
+	if ( fRefreshInterval > 0L ) {
+		fpRefresher = new (coast::storage::Global()) PeriodicAction(roaModuleConfig["RefreshAction"].AsString("ResolverCacheRefreshAction"), fRefreshInterval);
+		fpRefresher->Start();
+	}
+	return true;
+}
+
+bool ResolverCacheModule::Finis()
+{
+	StartTrace(ResolverCacheModule.Finis);
+	if ( fpRefresher ) {
+		fpRefresher->Terminate();
+		delete fpRefresher;
+		fpRefresher = 0;
+	}
+	if ( fpCache ) {
+		if ( Resolver::GetCache() == fpCache ) {
+			Resolver::SetCache(0);
+		}
+		// lookups started before SetCache(0) might still use the cache, keep it until the module goes away
+		fpCache->Clear();
+		fRetiredCaches.push_back(fpCache);
+		fpCache = 0;
+	}
+	return true;
+}
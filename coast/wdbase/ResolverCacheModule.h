@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _ResolverCacheModule_H
+#define _ResolverCacheModule_H
+
+#include "WDModule.h"
+#include <vector>
+
+class ResolverCache;
+class PeriodicAction;
+
+//! Module installing a thread safe cache for Resolver lookups
+/*!
+\par Configuration
+\code
+{
+	/TTL				long	optional, default 300, seconds a resolved name or address is kept
+	/NegativeTTL		long	optional, default 30, seconds a failed lookup is kept, 0 disables caching of failures
+	/Shards				long	optional, default 16, number of independently locked cache partitions
+	/MaxEntries			long	optional, default 1024, maximum number of entries per shard
+	/RefreshInterval	long	optional, default 0 (off), seconds between background refreshes of entries which are about to expire
+	/RefreshAction		String	optional, default ResolverCacheRefreshAction, action called periodically to refresh entries
+}
+\endcode
+The module has to be listed in the /Modules slot of the server config, its configuration is taken from slot /ResolverCacheModule.
+When background refresh is enabled, entries expiring within the next RefreshInterval seconds are re-resolved
+before they expire if they were looked up since the last refresh; failed lookups and unused names simply expire. This keeps resolver latency away from request threads for frequently used names.
+The hit/miss and latency counters of the cache are delivered by the ServerStatisticAction.
+Request threads might still use a cache while the module is reset, therefore Finis only uninstalls and clears it,
+the memory is released when the module is destroyed.
+*/
+class ResolverCacheModule: public WDModule
+{
+public:
+	ResolverCacheModule(const char *name);
+	~ResolverCacheModule();
+
+	virtual bool Init(const ROAnything config);
+	virtual bool Finis();
+
+	//! interval passed to Resolver::RefreshCache by the refresh action
+	long GetRefreshInterval() const {
+		return fRefreshInterval;
+	}
+
+private:
+	ResolverCache *fpCache;
+	//! caches uninstalled by Finis, deleted in the destructor
+	std::vector<ResolverCache *> fRetiredCaches;
+	PeriodicAction *fpRefresher;
+	long fRefreshInterval;
+};
+
+#endif
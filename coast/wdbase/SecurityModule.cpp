@@ -97,6 +97,31 @@ void SecurityItem::Encode(const char *itemtouse, String &encodedText, const Stri
 	Trace("result :<" << encodedText << ">\n");
 }
 
+void SecurityItem::EncodeBatch(const char *itemtouse, Anything &encodedTexts, const Anything &cleartexts) {
+	StartTrace1(SecurityItem.EncodeBatch, "using SecurityItem <" << itemtouse << "> for " << cleartexts.GetSize() << " entries");
+	FindSecurityItemWithDefault(encoder, itemtouse, SecurityItem);
+	String name(itemtouse);
+	Anything encoded(encodedTexts.GetAllocator());
+	if (encoder) {
+		encoder->GetName(name);
+		encoder->DoEncodeBatch(encoded, cleartexts);
+	}
+	for (long i = 0, sz = cleartexts.GetSize(); i < sz; ++i) {
+		String result(name.Length() + 1 + encoded[i].AsString().Length(), encodedTexts.GetAllocator());
+		result << name << '-' << encoded[i].AsString();
+		encodedTexts.Append(result);
+	}
+	TraceAny(encodedTexts, "results");
+}
+
+void SecurityItem::DoEncodeBatch(Anything &scrambledTexts, const Anything &cleartexts) const {
+	for (long i = 0, sz = cleartexts.GetSize(); i < sz; ++i) {
+		String encoded;
+		DoEncode(encoded, cleartexts[i].AsString());
+		scrambledTexts.Append(encoded);
+	}
+}
+
 bool SecurityItem::Decode(String &cleartext, const String &encodedText) {
 	StartTrace(SecurityItem.Decode);
 	String encodername;
@@ -276,6 +301,24 @@ void SecurityModule::ScrambleState(String &result, const Anything &state) {
 	Trace("resulting text <" << result << ">");
 } // DoScrambleState
 
+void SecurityModule::ScrambleStates(Anything &results, const Anything &states) {
+	StartTrace(SecurityModule.ScrambleStates);
+	Anything compressedTexts, signedTexts, cryptTexts, encodedTexts;
+	for (long i = 0, sz = states.GetSize(); i < sz; ++i) {
+		String compressedText;
+		Compressor::Compress(fgCompressor, compressedText, states[i]);
+		compressedTexts.Append(compressedText);
+	}
+	Signer::SignBatch(fgSigner, signedTexts, compressedTexts);
+	Scrambler::ScrambleBatch(fgScrambler, cryptTexts, signedTexts);
+	Encoder::EncodeBatch(fgEncoder, encodedTexts, cryptTexts);
+	for (long i = 0, sz = states.GetSize(); i < sz; ++i) {
+		// keep ScrambleState semantics: nothing is appended for states the compressor rejected
+		results.Append(compressedTexts[i].AsString().Length() > 0 ? encodedTexts[i].AsString() : String());
+	}
+	TraceAny(results, "resulting texts");
+}
+
 bool SecurityModule::UnscrambleState(Anything &state, const String &s) {
 	StartTrace(SecurityModule.UnscrambleState);
 	Trace("StateString: " << s);
@@ -324,6 +367,11 @@ bool Scrambler::Unscramble(String &cleartext, const String &encodedText) {
 	Trace("Scrambled Text: " << encodedText);
 	return SecurityItem::Decode(cleartext, encodedText);
 }
+
+void Scrambler::ScrambleBatch(const char *scramblername, Anything &scrambledTexts, const Anything &cleartexts) {
+	StartTrace(Scrambler.ScrambleBatch);
+	SecurityItem::EncodeBatch(scramblername, scrambledTexts, cleartexts);
+}
 RegisterEncoder(Encoder);
 RegisterAliasSecurityItem(asce, Encoder);
 RegisterCompressor(Compressor);
@@ -381,3 +429,8 @@ bool Signer::Check(String &cleartext, const String &scrambledText) {
 	StartTrace(Signer.Check);
 	return SecurityItem::Decode(cleartext, scrambledText);
 }
+
+void Signer::SignBatch(const char *signername, Anything &encodedTexts, const Anything &cleartexts) {
+	StartTrace(Signer.SignBatch);
+	SecurityItem::EncodeBatch(signername, encodedTexts, cleartexts);
+}
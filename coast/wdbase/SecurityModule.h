@@ -43,10 +43,17 @@ public:
 		cleartext = scrambledText;
 		return true;
 	}
+	//! encode a whole list of cleartexts in one go, default calls DoEncode for each entry
+	/*! items with a costly per call setup (key schedule, cipher context) override this to share it
+	 * \param scrambledTexts receives one encoded String per entry of cleartexts, same order
+	 * \param cleartexts array of Strings to encode */
+	virtual void DoEncodeBatch(Anything &scrambledTexts, const Anything &cleartexts) const;
 
 	// generic hooks for any item except Compressors
 	static void Encode(const char *itemtouse, String &encodedText, const String &cleartext);
 	static bool Decode(String &cleartext, const String &encodedText);
+	//! batch variant of Encode, the item is looked up once for all entries of cleartexts
+	static void EncodeBatch(const char *itemtouse, Anything &encodedTexts, const Anything &cleartexts);
 
 	// factor common code to retrieve the name of a security item from the encoded text
 	// returns position in encodedText to continue from. if 0 this means no name was found
@@ -85,6 +92,7 @@ public:
 
 	static void Scramble(const char *scramblername, String &scrambledText, const String &cleartext);
 	static bool Unscramble(String &cleartext, const String &encodedText);
+	static void ScrambleBatch(const char *scramblername, Anything &scrambledTexts, const Anything &cleartexts);
 
 	static Scrambler *FindScrambler(const char *name) {
 		return SafeCast(FindSecurityItem(name), Scrambler);
@@ -108,6 +116,7 @@ public:
 
 	static void Sign(const char *encodername, String &encodedText, const String &cleartext);
 	static bool Check(String &cleartext, const String &scrambledText);
+	static void SignBatch(const char *signername, Anything &encodedTexts, const Anything &cleartexts);
 	static Signer *FindSigner(const char *name) {
 		return SafeCast(FindSecurityItem(name), Signer);
 	}
@@ -188,6 +197,12 @@ public:
 	 what: Standard URLUtils decryption, does not decrypt serious URL's
 	 */
 	static bool UnscrambleState(Anything &state, const String &s);
+	/* in: states: array of link states, e.g. all links of a page rendered at once
+	 out: results: array of scrambled states, same order as states
+	 what: same as ScrambleState for each entry but every SecurityItem is looked up once
+	 and may share its per call setup over the whole batch (see SecurityItem::DoEncodeBatch)
+	 */
+	static void ScrambleStates(Anything &results, const Anything &states);
 
 protected:
 	static String fgScrambler;
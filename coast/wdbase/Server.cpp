@@ -18,6 +18,8 @@
 #include "AnyIterators.h"
 #include "Policy.h"
 #include "MT_Storage.h"
+#include "ServerStatistic.h"
+#include "CacheHandler.h"
 
 using namespace coast;
 
@@ -162,6 +164,7 @@ Server::Server(const char *name)
 	, fStoreMutex("Store")
 	, fStore(coast::storage::Global())
 	, fStatisticObserver(0)
+	, fOwnStatisticObserver(0)
 {
 	StartTrace1(Server.Server, "<" << GetName() << ">");
 }
@@ -173,6 +176,8 @@ Server::~Server()
 	if ( fPoolManager ) {
 		delete fPoolManager;
 	}
+	// the gatherers are gone with the pools
+	delete fOwnStatisticObserver;
 }
 
 // intialization of the Server and its modules
@@ -206,10 +211,40 @@ int Server::GlobalReinit()
 {
 	StartTrace(Server.GlobalReinit);
 	LockUnlockEntry me(fgReInitMutex);
+	Anything config(coast::storage::Global());
+	String strRootDir(coast::storage::Global()), strPathList(coast::storage::Global());
+	bool bSameLocation = true;
+	{
+		coast::storage::ForceGlobalStorageEntry onlyUseGlobalMemoryHere;
+		// files might have been added or moved since they were searched for last
+		system::FlushPathCache();
+		// shadow build, reading and parsing happens while requests are still processed
+		if ( !DoReadGlobalConfig(config) ) {
+			SYSERROR("Global reinit: reading configuration failed, keeping current one");
+			return -1;
+		}
+		// running requests still search files below the current root directory and path list, switch them only
+		// while requests are blocked. Staged files would come from the old location when the new config moves them.
+		ROAnything roaConfig(config);
+		strRootDir = roaConfig["Root"].AsString(Lookup("Root", system::GetRootDir()));
+		if ( strRootDir != "." ) {
+			system::ResolvePath(strRootDir);
+		}
+		strPathList = roaConfig["PathList"].AsString(Lookup("PathList", system::GetPathList()));
+		bSameLocation = ( strRootDir == system::GetRootDir() && strPathList == system::GetPathList() );
+		if ( bSameLocation ) {
+			CacheHandler::instance().Stage();
+		}
+	}
 	if ( BlockRequests() != 0 ) {
 		UnblockRequests();
+		CacheHandler::instance().DiscardStaged();
 		return -1;
 	}
+	if ( !bSameLocation ) {
+		system::SetRootDir(strRootDir, true);
+		system::SetPathList(strPathList, true);
+	}
 	fgInReInit = true;
 	ServersModule::SetServerForReInit(this);
 	int globalReinitReturnCode = 0;
@@ -220,42 +255,40 @@ int Server::GlobalReinit()
 		coast::storage::ForceGlobalStorageEntry onlyUseGlobalMemoryHere;
 		// block cleaner thread since CheckTimeout of Session
 		// makes Lookup calls to shared configurations
-		globalReinitReturnCode = DoGlobalReinit();
+		globalReinitReturnCode = DoGlobalReinit(config);
 	}
 	ServersModule::SetServerForReInit(0);
+	long lGeneration = CacheHandler::instance().Publish();
 	if ( globalReinitReturnCode == 0 ) {
 		globalReinitReturnCode = UnblockRequests();
 	}
 	fgInReInit = false;
 	String msg;
-	msg << "Global reinit: " << (globalReinitReturnCode == 0 ? "succeeded" : "failed");
+	msg << "Global reinit: " << (globalReinitReturnCode == 0 ? "succeeded" : "failed") << ", config generation " << lGeneration;
 	Trace(msg);
 	SYSINFO(msg);
 	return globalReinitReturnCode;
 }
 
+bool Server::DoReadGlobalConfig(Anything &config)
+{
+	StartTrace(Server.DoReadGlobalConfig);
+	const char *bootfilename = GetConfig()["COAST_BOOTFILE"].AsCharPtr("Config");
+	return AppBooter().ReadFromFile(config, bootfilename);
+}
+
 // reintialization of the Server and its modules
-int Server::DoGlobalReinit()
+int Server::DoGlobalReinit(Anything &config)
 {
 	StartTrace(Server.DoGlobalReinit);
+	SystemLog::WriteToStderr("Resetting Components\n");
 
-	Anything config;
-	const char *bootfilename = GetConfig()["COAST_BOOTFILE"].AsCharPtr("Config");
-	if (AppBooter().ReadFromFile(config, bootfilename)) {
-		// config file may redefine root directory
-		system::SetRootDir( Lookup("Root", system::GetRootDir()), true);
-		// fgConfig file may redefine path list
-		system::SetPathList( Lookup("PathList", system::GetPathList()), true);
-		SystemLog::WriteToStderr("Environment set\nResetting Components\n");
-
-		TraceAny(GetConfig(), "Old Config");
-		TraceAny(config, "New Config");
+	TraceAny(GetConfig(), "Old Config");
+	TraceAny(config, "New Config");
 
-		int retCode = WDModule::Reset(GetConfig(), config);
-		InitializeGlobalConfig(config);
-		return retCode;
-	}
-	return -1;
+	int retCode = WDModule::Reset(GetConfig(), config);
+	InitializeGlobalConfig(config);
+	return retCode;
 }
 
 // intialization of the Server and its modules
@@ -618,6 +651,10 @@ void Server::RegisterServerStatObserver(StatObserver *observer)
 
 void Server::AddStatGatherer2Observe(StatGatherer *sg)
 {
+	if (!fStatisticObserver) {
+		fOwnStatisticObserver = new ServerStatisticObserver();
+		fStatisticObserver = fOwnStatisticObserver;
+	}
 	if (fStatisticObserver) {
 		String myServerName;
 		GetName(myServerName);
@@ -625,6 +662,16 @@ void Server::AddStatGatherer2Observe(StatGatherer *sg)
 	}
 }
 
+bool Server::GetStatistic(Anything &statistic)
+{
+	StartTrace(Server.GetStatistic);
+	if ( fOwnStatisticObserver && fStatisticObserver == fOwnStatisticObserver ) {
+		fOwnStatisticObserver->Collect(statistic);
+		return true;
+	}
+	return false;
+}
+
 RegisterServer(MasterServer);
 
 int MasterServer::DoInit()
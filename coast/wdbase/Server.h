@@ -21,6 +21,7 @@ class Context;
 class ServiceDispatcher;
 class StatObserver;
 class StatGatherer;
+class ServerStatisticObserver;
 class ServerPoolsManagerInterface;
 
 class ServersModule: public WDModule {
@@ -60,7 +61,11 @@ public:
 		return new (a) Server(fName);
 	}
 
-	//!setup blocking and calls DoGlobalReinit
+	//!reads the new configuration, setup blocking and calls DoGlobalReinit
+	/*! Reading and parsing of the boot configuration and of the already loaded config files takes place before
+		requests get blocked, see CacheHandlerImpl::Stage. Requests are only blocked while the modules are reset,
+		a configuration which can not be read keeps the current one without blocking requests at all.
+		A new /Root or /PathList is switched to only while requests are blocked, files are not staged in this case. */
 	int GlobalReinit();
 
 	//!reintialization of the servers Thread Pool for request processing (RequestThreadsManager) and Acceptors (ListenerPool)
@@ -84,8 +89,14 @@ public:
 	void RegisterServerStatObserver(StatObserver *observer);
 
 	//! Register a StatObserver on the WorkerPoolManager of this server
+	/*! if no StatObserver was registered before, the gatherer is kept by a ServerStatisticObserver of this server */
 	void AddStatGatherer2Observe(StatGatherer *sg);
 
+	/*! collect the statistics of the gatherers kept by the servers own ServerStatisticObserver
+		\param statistic gets the statistics, see ServerStatisticObserver::Collect()
+		\return false if an external StatObserver was registered or nothing was registered yet */
+	bool GetStatistic(Anything &statistic);
+
 	//! factory method to create a custom request processor that processes events
 	RequestProcessor *MakeProcessor();
 
@@ -118,8 +129,12 @@ protected:
 	//!initialization of the Server and its modules
 	virtual int DoGlobalInit(int argc, const char *argv[], const ROAnything config);
 
+	//!reads the boot configuration used by DoGlobalReinit, called while requests are still processed
+	virtual bool DoReadGlobalConfig(Anything &config);
+
 	//!inner method doing the reinit
-	virtual int DoGlobalReinit();
+	/*! \param config boot configuration read by DoReadGlobalConfig, its /Root and /PathList are already in effect */
+	virtual int DoGlobalReinit(Anything &config);
 
 	//!starts up the server; an InterruptHandler is set up to catch signals for shutdown, reset etc.
 	virtual int DoGlobalRun();
@@ -187,6 +202,9 @@ protected:
 
 	//!statistic observer
 	StatObserver *fStatisticObserver;
+
+	//!statistic observer used when no other was registered, owned by the server
+	ServerStatisticObserver *fOwnStatisticObserver;
 };
 
 #define RegisterServer(name) RegisterApplication(name)
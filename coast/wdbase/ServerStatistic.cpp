@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "ServerStatistic.h"
+#include "Server.h"
+#include "Context.h"
+#include "AnythingUtils.h"
+#include "Resolver.h"
+
+ServerStatisticObserver::ServerStatisticObserver()
+	: StatObserver()
+	, fMutex("ServerStatisticObserver", coast::storage::Global())
+{
+	StartTrace(ServerStatisticObserver.ServerStatisticObserver);
+}
+
+void ServerStatisticObserver::DoRegisterGatherer(const String &name, StatGatherer *pGatherer)
+{
+	StartTrace1(ServerStatisticObserver.DoRegisterGatherer, "name [" << name << "]");
+	if ( pGatherer ) {
+		LockUnlockEntry me(fMutex);
+		fGatherers.push_back(std::make_pair(String(name, coast::storage::Global()), pGatherer));
+	}
+}
+
+void ServerStatisticObserver::Collect(Anything &statistic)
+{
+	StartTrace(ServerStatisticObserver.Collect);
+	LockUnlockEntry me(fMutex);
+	for ( GathererList::const_iterator aIt = fGatherers.begin(); aIt != fGatherers.end(); ++aIt ) {
+		Anything anyGatherer(Anything::ArrayMarker(), statistic.GetAllocator());
+		aIt->second->Statistic(anyGatherer);
+		statistic[aIt->first].Append(anyGatherer);
+	}
+	TraceAny(statistic, "collected statistic");
+}
+
+RegisterAction(ServerStatisticAction);
+
+bool ServerStatisticAction::DoExecAction(String &transitionToken, Context &ctx, const ROAnything &config)
+{
+	StartTrace(ServerStatisticAction.DoExecAction);
+	Server *pServer = ctx.GetServer();
+	Anything anyStatistic;
+	if ( !pServer || !pServer->GetStatistic(anyStatistic) ) {
+		Trace("no statistic available");
+		return false;
+	}
+	ResolverCache *pResolverCache = Resolver::GetCache();
+	if ( pResolverCache ) {
+		pResolverCache->Statistic(anyStatistic["ResolverCache"]);
+	}
+	ROAnything roaDestination;
+	if ( config.LookupPath(roaDestination, "Destination") ) {
+		StorePutter::Operate(anyStatistic, ctx, roaDestination);
+	} else {
+		StorePutter::Operate(anyStatistic, ctx, "TmpStore", "ServerStatistic");
+	}
+	return true;
+}
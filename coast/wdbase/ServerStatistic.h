@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _ServerStatistic_H
+#define _ServerStatistic_H
+
+#include "StatUtils.h"
+#include "Action.h"
+#include "Threads.h"
+#include <vector>
+
+//! StatObserver used by a Server when no other observer was registered
+/*! Keeps the StatGatherer objects registered by the thread pools and modules of the server and collects their
+statistics on demand. The gatherers must live as long as the observer, the Server deletes it after its pools. */
+class ServerStatisticObserver: public StatObserver
+{
+public:
+	ServerStatisticObserver();
+
+	/*! collect the statistics of all registered gatherers
+		\param statistic gets one slot per registration name, containing a list of the gatherers statistics */
+	void Collect(Anything &statistic);
+
+protected:
+	//! remember pGatherer under name
+	virtual void DoRegisterGatherer(const String &name, StatGatherer *pGatherer);
+
+private:
+	typedef std::vector<std::pair<String, StatGatherer *> > GathererList;
+	SimpleMutex fMutex;
+	GathererList fGatherers;
+};
+
+//! Admin action delivering the statistics of the current server
+/*!
+Collects the counters and latency percentiles of the request thread pool and all other registered StatGatherer
+objects, e.g. to show queueing and service time per request phase without attaching a profiler.
+\par Configuration
+\code
+{
+	/Destination {				optional, default { /Store TmpStore /Slot ServerStatistic }
+		/Store	...				see StorePutter
+		/Slot	...
+	}
+}
+\endcode
+The result looks like { /<server name> { { /PoolSize .. /TotalRequests .. /"Phases [us]" {..} /"Services [us]" {..} } } }
+When a ResolverCache is installed, e.g. by the ResolverCacheModule, its counters are added in slot /ResolverCache.
+*/
+class ServerStatisticAction: public Action
+{
+public:
+	ServerStatisticAction(const char *name) :
+		Action(name) {
+	}
+	//! put the server statistics into the configured destination
+	virtual bool DoExecAction(String &transitionToken, Context &ctx, const ROAnything &config);
+};
+
+#endif
@@ -213,6 +213,7 @@ HandleRequest::HandleRequest(const char *name)
 	, fClientSocket(0)
 	, fProcessor(0)
 	, fRequestNumber(0)
+	, fPoolManager(0)
 {
 }
 
@@ -249,6 +250,9 @@ void HandleRequest::DoProcessWorkload()
 					fProcessor->ProcessRequest(ctx);
 				}
 			}
+			if ( fPoolManager && fPoolManager->GetStatHandler() ) {
+				RequestProcessor::RecordPhaseTimes(ctx, *fPoolManager->GetStatHandler());
+			}
 			// log all time related items
 			RequestTimeLogger(ctx);
 		}
@@ -312,6 +316,9 @@ void RequestThreadsManager::DoAllocPool(ROAnything args)
 		SYSERROR(msg);
 	}
 	fRequests = new HandleRequest[GetPoolSize()];
+	for (long i = 0; i < GetPoolSize(); ++i) {
+		fRequests[i].SetPoolManager(this);
+	}
 }
 
 WorkerThread *RequestThreadsManager::DoGetWorker(long i)
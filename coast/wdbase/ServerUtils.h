@@ -63,6 +63,11 @@ public:
 	//! default constructor used for array allocation
 	HandleRequest(const char *name = "HandleRequest");
 
+	//! set the pool whose statistic handler gets the phase times of processed requests
+	void SetPoolManager(WorkerPoolManager *poolManager) {
+		fPoolManager = poolManager;
+	}
+
 protected:
 	//!setup request processor as callback object
 	virtual void DoInit(ROAnything workerInit);
@@ -83,6 +88,7 @@ protected:
 	Socket *fClientSocket;	// the socket file descriptor for this request
 	RequestProcessor *fProcessor;		// the processor i'm working with
 	long fRequestNumber;	// the sequence number of this request
+	WorkerPoolManager *fPoolManager;	// the pool this worker belongs to
 };
 
 class RequestThreadsManager : public WorkerPoolManager
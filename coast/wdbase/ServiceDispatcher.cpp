@@ -9,6 +9,7 @@
 #include "ServiceHandler.h"
 #include "Renderer.h"
 #include "Policy.h"
+#include "DiffTimer.h"
 
 RegCacheImpl(ServiceDispatcher);
 RegisterModule(ServiceDispatchersModule);
@@ -44,7 +45,13 @@ bool ServiceDispatcher::Dispatch2Service(std::ostream &reply, Context &ctx) {
 	}
 	bool status = false;
 	if (sh) {
+		DiffTimer aTimer(DiffTimer::eMicroseconds);
 		status = sh->HandleService(reply, ctx);
+		// picked up by RequestProcessor::RecordPhaseTimes
+		long lServiceTime = (long) aTimer.Diff();
+		Anything &anyTmpStore = ctx.GetTmpStore();
+		anyTmpStore["RequestPhases"]["Service"] = sh->GetName();
+		anyTmpStore["RequestPhases"]["ServiceTime"] = lServiceTime;
 	}
 	ctx.Pop(strKey); //!@FIXME: use PushPopEntry for LookupInterfaces too
 	return status;
@@ -15,6 +15,40 @@
 #include "Renderer.h"
 #include "LocalizationUtils.h"
 #include "AnythingUtils.h"
+#include <cstring>
+
+namespace {
+	//! exact recursive comparison, unlike ROAnything::IsEqual it also compares arrays and binary buffers by content
+	bool IsSameContent(const ROAnything &roaFirst, const ROAnything &roaSecond) {
+		if (roaFirst.GetType() != roaSecond.GetType() || roaFirst.GetSize() != roaSecond.GetSize()) {
+			return false;
+		}
+		switch (roaFirst.GetType()) {
+			case AnyArrayType:
+				for (long i = 0, sz = roaFirst.GetSize(); i < sz; ++i) {
+					const char *pFirstName = roaFirst.SlotName(i), *pSecondName = roaSecond.SlotName(i);
+					if ((pFirstName || pSecondName) && (!pFirstName || !pSecondName || strcmp(pFirstName, pSecondName) != 0)) {
+						return false;
+					}
+					if (!IsSameContent(roaFirst[i], roaSecond[i])) {
+						return false;
+					}
+				}
+				return true;
+			case AnyObjectType:
+				return roaFirst.AsIFAObject(0) == roaSecond.AsIFAObject(0);
+			case AnyVoidBufType: {
+				long lFirstLen = 0, lSecondLen = 0;
+				const char *pFirst = roaFirst.AsCharPtr(0, lFirstLen), *pSecond = roaSecond.AsCharPtr(0, lSecondLen);
+				return lFirstLen == lSecondLen && memcmp(pFirst, pSecond, lFirstLen) == 0;
+			}
+			case AnyNullType:
+				return true;
+			default:
+				return roaFirst.IsEqual(roaSecond);
+		}
+	}
+}
 
 class AccessTimer {
 	Session *fSession;
@@ -28,7 +62,7 @@ public:
 };
 
 Session::Session(const char *name) :
-	NotCloned(name), fMutex("Session"), fTerminated(false), fStore(coast::storage::Global()), fId(coast::storage::Global()),
+	NotCloned(name), fMutex("Session"), fTerminated(false), fStore(coast::storage::Global()), fStoreSnapshot(coast::storage::Global()), fChangedSlots(Anything::ArrayMarker(), coast::storage::Global()), fId(coast::storage::Global()),
 			fAddress(coast::storage::Global()), fAccessCounter(1), fAccessTime(time(NULL)), fRemoteAddr(coast::storage::Global()),
 			fBrowser(coast::storage::Global()), fRefCount(0L) {
 	StartTrace(Session.Session);
@@ -159,7 +193,7 @@ void Session::SetRole(Role *newRole, Context &ctx) {
 		SystemLog::Info(msg);
 		PutInStore("RoleName", newRoleName);
 		// Needed only when context used with copy of session store
-		ctx.GetSessionStore()["RoleName"] = newRoleName;
+		ctx.GetSessionStore("RoleName")["RoleName"] = newRoleName;
 	}
 }
 
@@ -213,14 +247,74 @@ bool Session::DoLookup(const char *key, ROAnything &result, char delim, char ind
 }
 
 TrickyThing &Session::GetRoleStoreGlobal() {
+	StoreChanged("RoleStore");
 	return (TrickyThing &) fStore["RoleStore"];
 }
 
 TrickyThing &Session::GetStoreGlobal() {
+	// the caller gets write access, we can not tell what will be modified
+	StoreChanged();
 	return fStore;
 }
 
+const Anything &Session::GetStoreSnapshot() {
+	if (!fStoreSnapshot.IsNull() && fChangedSlots.GetSize() > 0L) {
+		StartTrace1(Session.GetStoreSnapshot, "copying " << fChangedSlots.GetSize() << " changed slots of <" << fId << ">");
+		// unchanged slots are shared with the previous copy, it is never modified
+		ROAnything roaStore(fStore);
+		Anything anySnapshot(Anything::ArrayMarker(), fStoreSnapshot.GetAllocator());
+		for (long i = 0, sz = roaStore.GetSize(); i < sz; ++i) {
+			const char *pSlotName = roaStore.SlotName(i);
+			if (!pSlotName) {
+				anySnapshot.Append(roaStore[i].DeepClone(anySnapshot.GetAllocator()));
+			} else if (!fChangedSlots.IsDefined(pSlotName) && fStoreSnapshot.IsDefined(pSlotName)) {
+				anySnapshot[pSlotName] = fStoreSnapshot[pSlotName];
+			} else {
+				anySnapshot[pSlotName] = roaStore[i].DeepClone(anySnapshot.GetAllocator());
+			}
+		}
+		fStoreSnapshot = anySnapshot;
+		fChangedSlots = Anything(Anything::ArrayMarker(), fChangedSlots.GetAllocator());
+	}
+	if (fStoreSnapshot.IsNull()) {
+		StartTrace1(Session.GetStoreSnapshot, "rebuilding snapshot of <" << fId << ">");
+		fStoreSnapshot = ROAnything(fStore).DeepClone(fStoreSnapshot.GetAllocator());
+	}
+	return fStoreSnapshot;
+}
+
+void Session::StoreChanged() {
+	// contexts still using the old copy keep it alive through their own reference
+	fStoreSnapshot = Anything(fStoreSnapshot.GetAllocator());
+	fChangedSlots = Anything(Anything::ArrayMarker(), fChangedSlots.GetAllocator());
+}
+
+void Session::StoreChanged(const char *slot) {
+	if (!fStoreSnapshot.IsNull()) {
+		fChangedSlots[slot] = true;
+	}
+}
+
+void Session::MergeStoreSlots(const Anything &slots, const ROAnything &roaStore, const ROAnything &roaBase) {
+	StartTrace1(Session.MergeStoreSlots, "merging " << slots.GetSize() << " slots into <" << fId << ">");
+	for (long i = 0, sz = slots.GetSize(); i < sz; ++i) {
+		const char *pSlotName = slots.SlotName(i);
+		bool bDefined = roaStore.IsDefined(pSlotName);
+		if (bDefined == roaBase.IsDefined(pSlotName) && (!bDefined || IsSameContent(roaStore[pSlotName], roaBase[pSlotName]))) {
+			// not modified by the request, keep what other requests might have put meanwhile
+			continue;
+		}
+		Trace("merging slot <" << pSlotName << ">");
+		if (bDefined) {
+			PutInStore(pSlotName, roaStore[pSlotName].DeepClone(fStore.GetAllocator()));
+		} else {
+			RemoveFromStore(pSlotName);
+		}
+	}
+}
+
 void Session::PutInStore(const char *key, const Anything &a) {
+	StoreChanged(key);
 	fStore[key] = a;
 }
 
@@ -231,6 +325,7 @@ void Session::HTMLDebugStore(std::ostream &reply, bool printAny) {
 }
 
 void Session::RemoveFromStore(const char *key) {
+	StoreChanged(key);
 	fStore.Remove(key);
 }
 
@@ -574,6 +669,7 @@ void Session::SaveToDelayed(Context &context, String &transition, String &pagena
 			delayed["delayedEnv"] = delayedEnv;
 		}
 		//!@FIXME allow only one delayed query, quick fix for no logon of frontdoor stresser
+		StoreChanged("delayed");
 		fStore["delayed"][0L] = delayed;
 		query["delayedIndex"] = 0L;
 		tmpStore["delayed"] = delayed; // to make it accessible by Lookups for delayed
@@ -673,6 +769,7 @@ bool Session::RetrieveFromDelayed(Context &context, String &action, String &curr
 				TraceAny(env, "modified env");
 			}
 			context.SetQuery(fStore["delayed"][index]);
+			StoreChanged("delayed");
 			fStore["delayed"].Remove(index);
 			if (fStore["delayed"].GetSize() == 0) {
 				fStore.Remove("delayed"); // clean up
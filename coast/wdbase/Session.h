@@ -176,6 +176,20 @@ protected:
 	//! "TrickyThing store(GetStoreGlobal());"
 	virtual TrickyThing &GetStoreGlobal();
 
+	//! read only copy of the session store shared by all contexts configured with /Context/CopySessionStore
+	//! only the top level slots changed since the copy was taken are copied again, caller must hold fMutex
+	//! \return globally allocated Anything, assign it to a globally allocated Anything to share it without copying
+	const Anything &GetStoreSnapshot();
+	//! drop the shared copy of the whole session store, needed after modifying fStore through a reference to the whole store; caller must hold fMutex
+	void StoreChanged();
+	//! the top level slot of fStore is about to be modified directly, GetStoreSnapshot() copies it again; caller must hold fMutex
+	void StoreChanged(const char *slot);
+	//! write the top level slots of a request copy back which differ from the copy the request started with; caller must hold fMutex
+	/*! \param slots names of the slots the request had write access to
+		\param roaStore the request copy of the session store
+		\param roaBase the copy of the session store the request copy was taken from */
+	void MergeStoreSlots(const Anything &slots, const ROAnything &roaStore, const ROAnything &roaBase);
+
 	//!access and insert into session store without mutex lock; beware of mt issues
 	virtual void PutInStore(const char *key, const Anything &a);
 	//!access and remove key from session store without mutex lock: beware of mt issues
@@ -214,6 +228,10 @@ protected:
 
 	//! the session store
 	TrickyThing fStore;
+	//! copy of fStore handed out by GetStoreSnapshot(), never modified once built
+	Anything fStoreSnapshot;
+	//! names of the top level slots of fStore changed after fStoreSnapshot was built
+	Anything fChangedSlots;
 	//! internal session id
 	String	 fId;
 	//! the port we use to identify our server
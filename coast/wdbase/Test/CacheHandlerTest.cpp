@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#include "CacheHandlerTest.h"
+#include "CacheHandler.h"
+#include "SystemFile.h"
+#include "TestSuite.h"
+
+namespace {
+	const char *gpcGroup = "CacheHandlerTest";
+	const char *gpcFile = "CacheHandlerStageTest";
+
+	bool WriteConfig(long lValue) {
+		std::iostream *pStream = coast::system::OpenOStream(gpcFile, "any");
+		if ( pStream ) {
+			Anything anyConfig;
+			anyConfig["Value"] = lValue;
+			anyConfig.PrintOn(*pStream);
+			delete pStream;
+			return true;
+		}
+		return false;
+	}
+
+	void RemoveConfig() {
+		CacheHandler::instance().Unload(gpcGroup, gpcFile);
+		coast::system::io::unlink(String(gpcFile).Append(".any"));
+	}
+}
+
+void CacheHandlerTest::StageTest() {
+	StartTrace(CacheHandlerTest.StageTest);
+	if ( !t_assertm(WriteConfig(1L), "expected config file to be written") ) {
+		return;
+	}
+	SimpleAnyLoader sal;
+	CacheHandlerImpl &cache = CacheHandler::instance();
+	assertEqual(1L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	t_assert(cache.Stage() >= 1L);
+	WriteConfig(2L);
+	// the reload takes what was read by Stage, without touching the file again
+	cache.Unload(gpcGroup, gpcFile);
+	assertEqual(1L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	long lGeneration = cache.GetGeneration();
+	assertEqual(lGeneration + 1L, cache.Publish());
+	assertEqual(lGeneration + 1L, cache.GetGeneration());
+	// once published, the file is read again
+	cache.Unload(gpcGroup, gpcFile);
+	assertEqual(2L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	RemoveConfig();
+}
+
+void CacheHandlerTest::DiscardStagedTest() {
+	StartTrace(CacheHandlerTest.DiscardStagedTest);
+	if ( !t_assertm(WriteConfig(1L), "expected config file to be written") ) {
+		return;
+	}
+	SimpleAnyLoader sal;
+	CacheHandlerImpl &cache = CacheHandler::instance();
+	assertEqual(1L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	long lGeneration = cache.GetGeneration();
+	cache.Stage();
+	WriteConfig(3L);
+	cache.DiscardStaged();
+	assertEqual(lGeneration, cache.GetGeneration());
+	cache.Unload(gpcGroup, gpcFile);
+	assertEqual(3L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	RemoveConfig();
+}
+
+void CacheHandlerTest::ModuleResetTest() {
+	StartTrace(CacheHandlerTest.ModuleResetTest);
+	if ( !t_assertm(WriteConfig(1L), "expected config file to be written") ) {
+		return;
+	}
+	SimpleAnyLoader sal;
+	CacheHandlerImpl &cache = CacheHandler::instance();
+	assertEqual(1L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	t_assert(cache.Stage() >= 1L);
+	WriteConfig(4L);
+	Anything config;
+	config["Modules"].Append("CacheHandlerModule");
+	t_assert(WDModule::Reset(config, config) == 0);
+	// modules loading their config during the reset get the staged entry
+	assertEqual(1L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	cache.Publish();
+	cache.Unload(gpcGroup, gpcFile);
+	assertEqual(4L, cache.Load(gpcGroup, gpcFile, &sal)["Value"].AsLong(0L));
+	RemoveConfig();
+}
+
+// builds up a suite of testcases, add a line for each testmethod
+Test *CacheHandlerTest::suite() {
+	StartTrace(CacheHandlerTest.suite);
+	TestSuite *testSuite = new TestSuite;
+	ADD_CASE(testSuite, CacheHandlerTest, StageTest);
+	ADD_CASE(testSuite, CacheHandlerTest, DiscardStagedTest);
+	ADD_CASE(testSuite, CacheHandlerTest, ModuleResetTest);
+	return testSuite;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2005, Peter Sommerlad and IFS Institute for Software at HSR Rapperswil, Switzerland
+ * All rights reserved.
+ *
+ * This library/application is free software; you can redistribute and/or modify it under the terms of
+ * the license that is included with this library/application in the file license.txt.
+ */
+
+#ifndef _CacheHandlerTest_H
+#define _CacheHandlerTest_H
+
+#include "TestCase.h"
+
+//! tests staging of config files for a reload
+class CacheHandlerTest: public testframework::TestCase {
+public:
+	CacheHandlerTest(TString tstrName) :
+		TestCaseType(tstrName) {
+	}
+	static Test *suite();
+	void StageTest();
+	void DiscardStagedTest();
+	void ModuleResetTest();
+};
+
+#endif
@@ -1130,6 +1130,151 @@ void ContextTest::SessionUnlockingTest() {
 	}
 }
 
+void ContextTest::SharedSessionStoreCopyTest() {
+	StartTrace(ContextTest.SharedSessionStoreCopyTest);
+	Context sessionsCtx;
+	Session s("SharedSessionStoreCopyTest");
+	s.PutInStore("testKey", "one");
+	{
+		Anything env;
+		env["Context"]["CopySessionStore"] = true;
+		Context c1, c2;
+		c1.Push("test", env);
+		c2.Push("test", env);
+		c1.Push(&s);
+		c2.Push(&s);
+		// session and both contexts reference the same copy
+		assertEqual(3L, s.fStoreSnapshot.RefCount());
+		assertEqual("one", c1.Lookup("testKey", "none"));
+		assertEqual("one", c2.Lookup("testKey", "none"));
+
+		// write access gives c1 its private copy of the slot
+		c1.GetSessionStore("testKey")["testKey"] = "changed";
+		assertEqual("changed", c1.Lookup("testKey", "none"));
+		assertEqual("one", c2.Lookup("testKey", "none"));
+		assertEqual("one", ((ROAnything)s.fStore)["testKey"].AsString());
+
+		// modifying the session gives new contexts a new copy, c2 keeps its own reference
+		Anything anyFirstSnapshot(coast::storage::Global());
+		anyFirstSnapshot = s.fStoreSnapshot;
+		{
+			LockUnlockEntry me(s.fMutex);
+			s.PutInStore("testKey", "two");
+		}
+		assertEqual("one", c2.Lookup("testKey", "none"));
+		Context c3;
+		c3.Push("test", env);
+		c3.Push(&s);
+		assertEqual("two", c3.Lookup("testKey", "none"));
+		assertEqual(2L, s.fStoreSnapshot.RefCount());
+		assertEqual(3L, anyFirstSnapshot.RefCount());
+		LockUnlockEntry me(s.fMutex);
+		anyFirstSnapshot = Anything(coast::storage::Global());
+	}
+	assertEqual(1L, s.fStoreSnapshot.RefCount());
+	assertEqual(0L, s.GetRefCount());
+	// the slot written by c1 was merged back when c1 ended
+	assertEqual("changed", ((ROAnything)s.fStore)["testKey"].AsString());
+}
+
+void ContextTest::SessionStoreSlotCopyTest() {
+	StartTrace(ContextTest.SessionStoreSlotCopyTest);
+	Session s("SessionStoreSlotCopyTest");
+	Anything anyBig;
+	for (long i = 0; i < 100; ++i) {
+		anyBig.Append(i);
+	}
+	s.PutInStore("big", anyBig);
+	s.PutInStore("testKey", "one");
+	s.GetRoleStoreGlobal()["roleKey"] = "one";
+	Anything env;
+	env["Context"]["CopySessionStore"] = true;
+	Anything anyFirstSnapshot(coast::storage::Global());
+	{
+		Context ctx;
+		ctx.Push("test", env);
+		ctx.Push(&s);
+		anyFirstSnapshot = ctx.fSessionStoreSnapshot;
+		ctx.GetSessionStore("testKey")["testKey"] = "changed";
+		// handed out for writing but left as it is
+		ctx.GetRoleStoreGlobal();
+		assertEqualm(2L, ctx.fSessionStoreCurrent.GetSize(), "only the slots written to must be copied");
+		t_assert(!ctx.fSessionStoreCurrent.IsDefined("big"));
+		assertEqual(99L, ctx.Lookup("big:99", -1L));
+		assertEqual("changed", ctx.Lookup("testKey", "none"));
+		{
+			// another request changed the role store meanwhile
+			LockUnlockEntry me(s.fMutex);
+			s.GetRoleStoreGlobal()["roleKey"] = "two";
+		}
+	}
+	assertEqual("changed", ((ROAnything)s.fStore)["testKey"].AsString());
+	assertEqualm("two", ((ROAnything)s.fStore)["RoleStore"]["roleKey"].AsString(), "unmodified slots must not be merged back");
+	{
+		Context ctx;
+		ctx.Push("test", env);
+		ctx.Push(&s);
+		assertEqual("changed", ctx.Lookup("testKey", "none"));
+		assertEqual("two", ctx.Lookup("roleKey", "none"));
+		// unchanged slots are shared with the previous copy
+		t_assert(ctx.fSessionStoreSnapshot.RefCount() > 1L);
+		assertEqual(2L, anyFirstSnapshot["big"].RefCount());
+		t_assert(anyFirstSnapshot["testKey"].AsString() != ctx.fSessionStoreSnapshot["testKey"].AsString());
+	}
+	LockUnlockEntry me(s.fMutex);
+	anyFirstSnapshot = Anything(coast::storage::Global());
+}
+
+namespace {
+	//! request processing without any page, only reads the session store
+	class ReadOnlyRequestSession: public Session {
+	public:
+		ReadOnlyRequestSession(const char *name) :
+			Session(name) {
+		}
+	protected:
+		virtual bool DoRenderNextPage(std::ostream &reply, Context &ctx) {
+			reply << ctx.Lookup("testKey", "none");
+			return true;
+		}
+	};
+}
+
+void ContextTest::SessionStoreSnapshotReuseTest() {
+	StartTrace(ContextTest.SessionStoreSnapshotReuseTest);
+	ReadOnlyRequestSession s("SessionStoreSnapshotReuseTest");
+	s.PutInStore("testKey", "one");
+	Anything env, firstSnapshot(coast::storage::Global());
+	env["Context"]["CopySessionStore"] = true;
+	for (long i = 0; i < 2; ++i) {
+		Context ctx;
+		ctx.Push("test", env);
+		ctx.Push(&s);
+		if (i == 0) {
+			firstSnapshot = ctx.fSessionStoreSnapshot;
+		}
+		OStringStream reply;
+		t_assert(s.RenderNextPage(reply, ctx, Anything()));
+		assertEqual("one", reply.str());
+	}
+	{
+		Context ctx;
+		ctx.Push("test", env);
+		ctx.Push(&s);
+		// firstSnapshot, session and ctx reference the same copy
+		assertEqualm(3L, firstSnapshot.RefCount(), "read only requests must reuse the snapshot");
+	}
+	{
+		LockUnlockEntry me(s.fMutex);
+		s.GetStoreGlobal()["testKey"] = "two";
+	}
+	Context ctx;
+	ctx.Push("test", env);
+	ctx.Push(&s);
+	assertEqual("two", ctx.Lookup("testKey", "none"));
+	assertEqualm(1L, firstSnapshot.RefCount(), "a modified store must be copied again");
+}
+
 Test *ContextTest::suite() {
 	TestSuite *testSuite = new TestSuite;
 	ADD_CASE(testSuite, ContextTest, VerySimplePush);
@@ -1149,5 +1294,8 @@ Test *ContextTest::suite() {
 	ADD_CASE(testSuite, ContextTest, SetNGetRole);
 	ADD_CASE(testSuite, ContextTest, RefCountTest);
 	ADD_CASE(testSuite, ContextTest, SessionUnlockingTest);
+	ADD_CASE(testSuite, ContextTest, SharedSessionStoreCopyTest);
+	ADD_CASE(testSuite, ContextTest, SessionStoreSnapshotReuseTest);
+	ADD_CASE(testSuite, ContextTest, SessionStoreSlotCopyTest);
 	return testSuite;
 }
@@ -72,6 +72,12 @@ public:
 	void RefCountTest();
 	//!Test the Session unlocking mechanism within Page Rendering
 	void SessionUnlockingTest();
+	//!Test sharing of the session store copy between contexts using CopySessionStore
+	void SharedSessionStoreCopyTest();
+	//!Test reuse of the session store copy by read only requests
+	void SessionStoreSnapshotReuseTest();
+	//!Test copying and merging back only the session store slots written by a request
+	void SessionStoreSlotCopyTest();
 };
 
 #endif
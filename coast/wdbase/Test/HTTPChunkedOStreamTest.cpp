@@ -81,6 +81,31 @@ void HTTPChunkedOStreamTest::HexManipulator()
 	assertCharPtrEqual("3\r\nfoo\r\n0\r\n\r\n10", s.str());
 }
 
+void HTTPChunkedOStreamTest::LargeBlockTest()
+{
+	StartTrace(HTTPChunkedOStreamTest.LargeBlockTest);
+	StringStream s;
+	HTTPChunkedOStream os(s, 4);
+	os << "ab";
+	os.write("cdefghijk", 9);
+	s << std::flush;
+	assertCharPtrEqual("4\r\nabcd\r\n4\r\nefgh\r\n", s.str());
+	os.write("lmnopqrs", 8);
+	s << std::flush;
+	assertCharPtrEqual("4\r\nabcd\r\n4\r\nefgh\r\n4\r\nijkl\r\n4\r\nmnop\r\n", s.str());
+	os.close();
+	assertCharPtrEqual("4\r\nabcd\r\n4\r\nefgh\r\n4\r\nijkl\r\n4\r\nmnop\r\n3\r\nqrs\r\n0\r\n\r\n", s.str());
+	StringStream s2;
+	HTTPChunkedOStream os2(s2, 0x1000);
+	String strBlock(0x2345L);
+	for (long i = 0; i < 0x2345L; ++i) {
+		strBlock.Append('x');
+	}
+	os2.write(strBlock, strBlock.Length());
+	os2.close();
+	assertCharPtrEqual(String("1000\r\n").Append(strBlock.SubString(0, 0x1000)).Append("\r\n1000\r\n").Append(strBlock.SubString(0, 0x1000)).Append("\r\n345\r\n").Append(strBlock.SubString(0, 0x345)).Append("\r\n0\r\n\r\n"), s2.str());
+}
+
 // builds up a suite of testcases, add a line for each testmethod
 Test *HTTPChunkedOStreamTest::suite ()
 {
@@ -92,6 +117,7 @@ Test *HTTPChunkedOStreamTest::suite ()
 	ADD_CASE(testSuite, HTTPChunkedOStreamTest, SimpleCloseNoFlush);
 	ADD_CASE(testSuite, HTTPChunkedOStreamTest, OverflowTest);
 	ADD_CASE(testSuite, HTTPChunkedOStreamTest, HexManipulator);
+	ADD_CASE(testSuite, HTTPChunkedOStreamTest, LargeBlockTest);
 
 	return testSuite;
 }
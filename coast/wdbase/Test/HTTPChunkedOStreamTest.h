@@ -38,6 +38,8 @@ public:
 	void SimpleFlush();
 	//! test if the hex manipulator is switched off after chunk header
 	void HexManipulator();
+	//! write blocks larger than a chunk after some buffered bytes
+	void LargeBlockTest();
 };
 
 #endif
@@ -112,10 +112,69 @@ void LogTimerTest::MethodTimerTest() {
 	}
 }
 
+namespace {
+	const char *CountedMessage(long &lCalls) {
+		++lCalls;
+		return "counted";
+	}
+	ROAnything FindTimer(ROAnything roaSummary, const char *pcKey) {
+		for (long l = 0, sz = roaSummary.GetSize(); l < sz; ++l) {
+			if ( roaSummary[l]["Key"].AsString().IsEqual(pcKey) ) {
+				return roaSummary[l];
+			}
+		}
+		return ROAnything();
+	}
+}
+
+void LogTimerTest::PhaseTimingTest() {
+	StartTrace(LogTimerTest.PhaseTimingTest);
+	long lId = PhaseTiming::RegisterTimer("Method", "PhaseTimingTest.Registered");
+	t_assert(lId >= 0L);
+	assertEqual(lId, PhaseTiming::RegisterTimer("Method", "PhaseTimingTest.Registered"));
+	t_assert(lId != PhaseTiming::RegisterTimer("Request", "PhaseTimingTest.Registered"));
+
+	Anything anySummary;
+	// forget what earlier tests recorded
+	PhaseTiming::Summarize(anySummary);
+	Context ctx;
+	TimeLoggingModule::fgDoTiming = false;
+	long lMessageCalls = 0L;
+	for (long l = 0; l < 3L; ++l) {
+		MethodTimer(PhaseTimingTest.Method, CountedMessage(lMessageCalls), ctx);
+		PhaseTimer(Method, PhaseTimingTest.Scope);
+	}
+	assertEqualm(0L, lMessageCalls, "message must not be rendered with timing disabled");
+	PhaseTiming::Record(lId, 1500L);
+	PhaseTiming::Record(lId, 500L);
+	PhaseTiming::Record(-1L, 100L);
+	PhaseTiming::Summarize(anySummary);
+	TraceAny(anySummary, "summary");
+	assertEqual(3L, FindTimer(anySummary, "PhaseTimingTest.Method")["Count"].AsLong(0L));
+	assertEqual("Method", FindTimer(anySummary, "PhaseTimingTest.Scope")["Section"].AsString());
+	assertEqual(3L, FindTimer(anySummary, "PhaseTimingTest.Scope")["Count"].AsLong(0L));
+	ROAnything roaRegistered = FindTimer(anySummary, "PhaseTimingTest.Registered");
+	assertEqual(2L, roaRegistered["Count"].AsLong(0L));
+	assertEqual(2000L, roaRegistered["Total"].AsLong(0L));
+	assertEqual(1000.0, roaRegistered["Mean"].AsDouble(0.0));
+	assertEqual(1500L, roaRegistered["Max"].AsLong(0L));
+
+	// only what was recorded since the last summary is reported
+	PhaseTiming::Record(lId, 200L);
+	PhaseTiming::Summarize(anySummary);
+	roaRegistered = FindTimer(anySummary, "PhaseTimingTest.Registered");
+	assertEqual(1L, roaRegistered["Count"].AsLong(0L));
+	assertEqual(200L, roaRegistered["Max"].AsLong(0L));
+	t_assert(FindTimer(anySummary, "PhaseTimingTest.Method").IsNull());
+	PhaseTiming::Summarize(anySummary);
+	t_assert(FindTimer(anySummary, "PhaseTimingTest.Registered").IsNull());
+}
+
 // builds up a suite of testcases, add a line for each testmethod
 Test *LogTimerTest::suite() {
 	StartTrace(LogTimerTest.suite);
 	TestSuite *testSuite = new TestSuite;
 	ADD_CASE(testSuite, LogTimerTest, MethodTimerTest);
+	ADD_CASE(testSuite, LogTimerTest, PhaseTimingTest);
 	return testSuite;
 }
@@ -18,6 +18,7 @@ public:
 	}
 	static Test *suite();
 	void MethodTimerTest();
+	void PhaseTimingTest();
 };
 
 #endif
@@ -232,6 +232,49 @@ void RegistryTest::TerminateTest() {
 	}
 }
 
+void RegistryTest::FreezeTest() {
+	StartTrace(RegistryTest.FreezeTest);
+	const long lObjects = 300L;
+	std::vector<NotCloned *> objects;
+	for (long i = 0; i < lObjects; ++i) {
+		String strName("Object");
+		strName << i;
+		objects.push_back(new (coast::storage::Global()) NotCloned(strName));
+		fRegistry->RegisterRegisterableObject(strName, objects.back());
+	}
+	fRegistry->RegisterRegisterableObject("Alias", objects[0]);
+	if (t_assertm(fRegistry->Freeze(), "expected registry to be frozen")) {
+		t_assert(fRegistry->IsFrozen());
+		for (long i = 0; i < lObjects; ++i) {
+			String strName("Object");
+			strName << i;
+			assertEqualm((long)objects[i], (long)fRegistry->Find(strName), (const char *)strName);
+		}
+		assertEqual((long)objects[0], (long)fRegistry->Find("Alias"));
+		t_assert(fRegistry->Find("Object") == 0);
+		t_assert(fRegistry->Find("") == 0);
+		t_assert(fRegistry->Find("Object300") == 0);
+	}
+	// changes drop the frozen table
+	NotCloned *pLate = new (coast::storage::Global()) NotCloned("Late");
+	fRegistry->RegisterRegisterableObject("Late", pLate);
+	t_assert(!fRegistry->IsFrozen());
+	assertEqual((long)pLate, (long)fRegistry->Find("Late"));
+	t_assert(fRegistry->Freeze());
+	fRegistry->UnregisterRegisterableObject("Late");
+	t_assert(!fRegistry->IsFrozen());
+	t_assert(fRegistry->Find("Late") == 0);
+	delete pLate;
+	t_assert(fRegistry->Freeze());
+	fRegistry->Unfreeze();
+	t_assert(!fRegistry->IsFrozen());
+	assertEqual((long)objects[1], (long)fRegistry->Find("Object1"));
+
+	AliasTerminator terminator("FreezeTest");
+	t_assertm(fRegistry->Terminate(&terminator), "expected successful termination");
+	t_assert(fRegistry->Find("Object1") == 0);
+}
+
 class TestPage: public Page {
 public:
 	TestPage(const char *name) :
@@ -295,6 +338,7 @@ Test *RegistryTest::suite() {
 	ADD_CASE(testSuite, RegistryTest, InstallHierarchy);
 	ADD_CASE(testSuite, RegistryTest, InstallHierarchyConfig);
 	ADD_CASE(testSuite, RegistryTest, TerminateTest);
+	ADD_CASE(testSuite, RegistryTest, FreezeTest);
 
 	return testSuite;
 
@@ -42,6 +42,7 @@ protected:
 	void	InstallHierarchy ();
 	void	InstallHierarchyConfig ();
 	void	TerminateTest ();
+	void	FreezeTest ();
 
 	Registry *fRegistry;
 };
@@ -12,6 +12,9 @@
 #include "StringStreamSocket.h"
 #include "Server.h"
 #include "AnythingUtils.h"
+#include "WPMStatHandler.h"
+#include "ServerStatistic.h"
+#include "LFListenerPool.h"
 
 void RequestProcessorTest::InitTest() {
 	StartTrace(RequestProcessorTest.InitTest);
@@ -69,6 +72,36 @@ void RequestProcessorTest::ProcessRequestTest() {
 	assertEqual("{\n  1\n}", str);
 }
 
+void RequestProcessorTest::RecordPhaseTimesTest() {
+	StartTrace(RequestProcessorTest.RecordPhaseTimesTest);
+	String str("{ 1 }");
+	LoopbackProcessor *pProcessor = new (coast::storage::Global()) LoopbackProcessor("test");
+	pProcessor->Init(Server::FindServer("Server"));
+	WPMStatHandler *pStat = new WPMStatHandler(2);
+	RequestReactor aReactor(pProcessor, pStat);
+	{
+		StringStreamSocket sss(str);
+		Context ctx(&sss);
+		pProcessor->ProcessRequest(ctx);
+		ROAnything roaPhases = ((ROAnything)ctx.GetTmpStore())["RequestPhases"];
+		t_assertm(roaPhases.IsDefined("Read"), "expected read time");
+		t_assertm(roaPhases.IsDefined("Verify"), "expected verify time");
+		t_assertm(roaPhases.IsDefined("Process"), "expected process time");
+		ctx.GetTmpStore()["RequestPhases"]["Service"] = "TestService";
+		ctx.GetTmpStore()["RequestPhases"]["ServiceTime"] = 1500L;
+		RequestProcessor::RecordPhaseTimes(ctx, *pStat);
+	}
+	ServerStatisticObserver aObserver;
+	aObserver.Register("TestServer", &aReactor);
+	Anything anyStatistic;
+	aObserver.Collect(anyStatistic);
+	ROAnything roaStatistic = anyStatistic["TestServer"][0L];
+	assertEqual(1L, roaStatistic["Phases [us]"]["Read"]["Count"].AsLong(-1L));
+	assertEqual(1L, roaStatistic["Phases [us]"]["Process"]["Count"].AsLong(-1L));
+	t_assertm(!roaStatistic["Phases [us]"].IsDefined("Queue"), "leader follower pool does not queue");
+	assertEqual(1500L, roaStatistic["Services [us]"]["TestService"]["Max"].AsLong(-1L));
+}
+
 void RequestProcessorTest::tearDown() {
 	StartTrace(RequestProcessorTest.tearDown);
 	WDModule::Terminate(ROAnything());
@@ -81,6 +114,7 @@ Test *RequestProcessorTest::suite() {
 
 	ADD_CASE(testSuite, RequestProcessorTest, InitTest);
 	ADD_CASE(testSuite, RequestProcessorTest, ProcessRequestTest);
+	ADD_CASE(testSuite, RequestProcessorTest, RecordPhaseTimesTest);
 
 	return testSuite;
 }
@@ -22,6 +22,9 @@ public:
 
 	//!test processing of request with stub objects
 	void ProcessRequestTest();
+
+	//!test recording of the request phase times into the pool statistics
+	void RecordPhaseTimesTest();
 	void tearDown();
 };
 
@@ -47,6 +47,7 @@
 #include "WebAppServiceTest.h"
 #include "ThreadedTimeStampTest.h"
 #include "ConfiguredLookupAdapterTest.h"
+#include "CacheHandlerTest.h"
 
 void setupRunner(TestRunner &runner)
 {
@@ -68,6 +69,7 @@ void setupRunner(TestRunner &runner)
 	ADD_SUITE(runner, SimpleListenerPoolTest);
 	ADD_SUITE(runner, AppBooterTest);
 	ADD_SUITE(runner, BasicRendererTest);
+	ADD_SUITE(runner, CacheHandlerTest);
 	ADD_SUITE(runner, ContextLookupRendererTest);
 	ADD_SUITE(runner, HTTPChunkedOStreamTest);
 	ADD_SUITE(runner, HTTPStreamStackTest);
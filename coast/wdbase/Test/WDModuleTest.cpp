@@ -11,6 +11,7 @@
 #include "Registry.h"
 #include "Policy.h"
 #include "TestSuite.h"
+#include "Threads.h"
 
 class TestModuleTrue: public WDModule
 {
@@ -49,6 +50,23 @@ public:
 	}
 };
 
+//! appends its name to a log shared by all instances when initialized
+class TestModuleRecording: public WDModule
+{
+	Anything &fLog;
+	SimpleMutex &fMutex;
+public:
+	TestModuleRecording(const char *name, Anything &anyLog, SimpleMutex &mutex) : WDModule(name), fLog(anyLog), fMutex(mutex) {}
+	virtual bool Init(const ROAnything config) {
+		LockUnlockEntry me(fMutex);
+		fLog.Append(GetName());
+		return true;
+	}
+	virtual bool Finis() {
+		return true;
+	}
+};
+
 WDModuleTest::WDModuleTest(TString tname) : TestCaseType(tname)
 {
 }
@@ -202,6 +220,39 @@ void WDModuleTest::ResetWithDiffConfigsTest()
 	testmodulnew->fStaticallyInitialized = false; // so it is deleted in terminate
 }
 
+void WDModuleTest::ParallelInstallTest()
+{
+	StartTrace(WDModuleTest.ParallelInstallTest);
+	Registry *wdmoduleTestRegistry = MetaRegistry::instance().GetRegistry("WDModule");
+	Anything anyLog(Anything::ArrayMarker(), coast::storage::Global());
+	SimpleMutex mutex("ParallelInstallTest", coast::storage::Global());
+	const char *names[] = { "First", "SecondA", "SecondB", "Last" };
+	Anything config;
+	for (long i = 0; i < 4L; ++i) {
+		wdmoduleTestRegistry->RegisterRegisterableObject(names[i], new (coast::storage::Global()) TestModuleRecording(names[i], anyLog, mutex));
+		config["Modules"][names[i]] = names[i];
+	}
+	config["ModuleInitThreads"] = 3L;
+	config["ModulePrerequisites"]["SecondA"].Append("First");
+	config["ModulePrerequisites"]["SecondB"].Append("First");
+	// Last has no prerequisites configured and waits for all modules listed before it
+	t_assertm(WDModule::Install(config) == 0, "expected parallel installation to succeed");
+	if ( assertEqual(4L, anyLog.GetSize()) ) {
+		assertEqual("First", anyLog[0L].AsString());
+		assertEqual("Last", anyLog[3L].AsString());
+	}
+	ROAnything roaTimes = WDModule::GetStartupTimes();
+	assertEqual(4L, roaTimes["Modules"].GetSize());
+	t_assert(roaTimes["Modules"].IsDefined("SecondB"));
+	assertEqual(3L, roaTimes["Threads"].AsLong(0L));
+
+	wdmoduleTestRegistry->RegisterRegisterableObject("TestModuleFalse", new (coast::storage::Global()) TestModuleFalse);
+	config["Modules"]["TestModuleFalse"] = "TestModuleFalse";
+	config["Modules"]["TestModuleFalse"]["Mandatory"] = true;
+	config["ModulePrerequisites"]["TestModuleFalse"].Append("First");
+	t_assertm(WDModule::Install(config) == -1, "expected installation to fail, since it is mandatory");
+}
+
 Test *WDModuleTest::suite ()
 {
 	TestSuite *testSuite = new TestSuite;
@@ -211,6 +262,7 @@ Test *WDModuleTest::suite ()
 	ADD_CASE(testSuite, WDModuleTest, TerminateTest);
 	ADD_CASE(testSuite, WDModuleTest, ResetTest);
 	ADD_CASE(testSuite, WDModuleTest, ResetWithDiffConfigsTest);
+	ADD_CASE(testSuite, WDModuleTest, ParallelInstallTest);
 
 	return testSuite;
 
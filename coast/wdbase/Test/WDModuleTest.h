@@ -39,6 +39,7 @@ public:
 	void ResetTest ();
 	void TerminateTest ();
 	void ResetWithDiffConfigsTest ();
+	void ParallelInstallTest ();
 
 protected:
 	Registry *fOrigWDModuleRegistry;
@@ -8,6 +8,11 @@
 
 #include "Timers.h"
 #include "AnythingUtils.h"
+#include "PeriodicAction.h"
+#include "SystemLog.h"
+#include "singleton.hpp"
+#include <cstring>
+#include <time.h>
 
 RegisterModule(TimeLoggingModule);
 
@@ -33,11 +38,195 @@ namespace {
 			return false;
 		}
 	} fgTSNLCleaner;
+
+	//! durations of one thread, written by this thread only
+	struct PhaseTimes {
+		PhaseTimes(PhaseTimes *pNext) : fNext(pNext) {
+			memset(fCount, 0, sizeof(fCount));
+			memset(fTotal, 0, sizeof(fTotal));
+			memset(fMax, 0, sizeof(fMax));
+			memset(fMaxEpoch, 0, sizeof(fMaxEpoch));
+		}
+		void Add(long lTimerId, l_long llMicros, long lEpoch) {
+			++fCount[lTimerId];
+			fTotal[lTimerId] += llMicros;
+			if ( fMaxEpoch[lTimerId] != lEpoch || llMicros > fMax[lTimerId] ) {
+				fMax[lTimerId] = llMicros;
+				fMaxEpoch[lTimerId] = lEpoch;
+			}
+		}
+		PhaseTimes *fNext;
+		l_long fCount[PhaseTiming::eMaxTimers];
+		l_long fTotal[PhaseTiming::eMaxTimers];
+		//! longest duration within summary period fMaxEpoch
+		l_long fMax[PhaseTiming::eMaxTimers];
+		long fMaxEpoch[PhaseTiming::eMaxTimers];
+	};
+
+	//! timer table and list of all thread records
+	class PhaseTimingRegistry {
+		THREADKEY fTimesKey;
+		SimpleMutex fMutex;
+		const char *fSection[PhaseTiming::eMaxTimers];
+		const char *fKey[PhaseTiming::eMaxTimers];
+		long fTimers;
+		PhaseTimes *fThreads;
+		//! records of terminated threads
+		PhaseTimes fRetired;
+		//! sums reported by the previous summary
+		PhaseTimes fReported;
+	public:
+		//! increased by every summary, plain reads by the recording threads are good enough to reset their maxima
+		volatile long fEpoch;
+
+		PhaseTimingRegistry() : fTimesKey(0), fMutex("PhaseTiming", coast::storage::Global()), fTimers(0L), fThreads(0), fRetired(0), fReported(0), fEpoch(1L) {
+			if (THRKEYCREATE(fTimesKey, 0)) {
+				SystemLog::Error("TlsAlloc of PhaseTiming fTimesKey failed");
+			}
+		}
+		~PhaseTimingRegistry() {
+			if (THRKEYDELETE(fTimesKey) != 0) {
+				SystemLog::Error("TlsFree of PhaseTiming fTimesKey failed");
+			}
+		}
+		long Register(const char *pcSection, const char *pcKey) {
+			LockUnlockEntry me(fMutex);
+			for (long l = 0; l < fTimers; ++l) {
+				if ( strcmp(fSection[l], pcSection) == 0 && strcmp(fKey[l], pcKey) == 0 ) {
+					return l;
+				}
+			}
+			if ( fTimers >= PhaseTiming::eMaxTimers ) {
+				String strMsg("PhaseTiming: no more timer ids left for ", -1, coast::storage::Global());
+				strMsg.Append(pcSection).Append('.').Append(pcKey);
+				SystemLog::Warning(strMsg);
+				return -1L;
+			}
+			fSection[fTimers] = pcSection;
+			fKey[fTimers] = pcKey;
+			return fTimers++;
+		}
+		PhaseTimes *GetTimes();
+		void Retire(PhaseTimes *pTimes) {
+			LockUnlockEntry me(fMutex);
+			for (PhaseTimes **ppTimes = &fThreads; *ppTimes; ppTimes = &(*ppTimes)->fNext) {
+				if ( *ppTimes == pTimes ) {
+					*ppTimes = pTimes->fNext;
+					break;
+				}
+			}
+			for (long l = 0; l < fTimers; ++l) {
+				fRetired.fCount[l] += pTimes->fCount[l];
+				fRetired.fTotal[l] += pTimes->fTotal[l];
+				if ( pTimes->fMaxEpoch[l] == fEpoch && ( fRetired.fMaxEpoch[l] != fEpoch || pTimes->fMax[l] > fRetired.fMax[l] ) ) {
+					fRetired.fMax[l] = pTimes->fMax[l];
+					fRetired.fMaxEpoch[l] = fEpoch;
+				}
+			}
+			delete pTimes;
+		}
+		void Summarize(Anything &anySummary);
+		THREADKEY getTimesKey() const {
+			return fTimesKey;
+		}
+	};
+	typedef coast::utility::singleton_default<PhaseTimingRegistry> PhaseTimingRegistrySingleton;
+
+	//! hands the record of a terminating thread over to the registry
+	class PhaseTimesCleaner: public CleanupHandler {
+	public:
+		static PhaseTimesCleaner fgCleaner;
+	protected:
+		virtual bool DoCleanup() {
+			PhaseTimes *pTimes = 0;
+			if (GETTLSDATA(PhaseTimingRegistrySingleton::instance().getTimesKey(), pTimes, PhaseTimes)) {
+				PhaseTimingRegistrySingleton::instance().Retire(pTimes);
+				pTimes = 0;
+				return SETTLSDATA(PhaseTimingRegistrySingleton::instance().getTimesKey(), pTimes);
+			}
+			return false;
+		}
+	};
+	PhaseTimesCleaner PhaseTimesCleaner::fgCleaner;
+
+	PhaseTimes *PhaseTimingRegistry::GetTimes() {
+		PhaseTimes *pTimes = 0;
+		if ( !GETTLSDATA(fTimesKey, pTimes, PhaseTimes) ) {
+			Thread::RegisterCleaner(&PhaseTimesCleaner::fgCleaner);
+			LockUnlockEntry me(fMutex);
+			pTimes = fThreads = new PhaseTimes(fThreads);
+			SETTLSDATA(fTimesKey, pTimes);
+		}
+		return pTimes;
+	}
+
+	void PhaseTimingRegistry::Summarize(Anything &anySummary) {
+		LockUnlockEntry me(fMutex);
+		long lEpoch = fEpoch;
+		for (long l = 0; l < fTimers; ++l) {
+			l_long llCount = fRetired.fCount[l], llTotal = fRetired.fTotal[l];
+			l_long llMax = ( fRetired.fMaxEpoch[l] == lEpoch ) ? fRetired.fMax[l] : 0LL;
+			for (PhaseTimes *pTimes = fThreads; pTimes; pTimes = pTimes->fNext) {
+				llCount += pTimes->fCount[l];
+				llTotal += pTimes->fTotal[l];
+				if ( pTimes->fMaxEpoch[l] == lEpoch && pTimes->fMax[l] > llMax ) {
+					llMax = pTimes->fMax[l];
+				}
+			}
+			l_long llDeltaCount = llCount - fReported.fCount[l], llDeltaTotal = llTotal - fReported.fTotal[l];
+			fReported.fCount[l] = llCount;
+			fReported.fTotal[l] = llTotal;
+			if ( llDeltaCount > 0 ) {
+				Anything anyTimer(anySummary.GetAllocator());
+				anyTimer["Section"] = fSection[l];
+				anyTimer["Key"] = fKey[l];
+				anyTimer["Count"] = (long)llDeltaCount;
+				anyTimer["Total"] = (long)llDeltaTotal;
+				anyTimer["Mean"] = double(llDeltaTotal) / double(llDeltaCount);
+				anyTimer["Max"] = (long)llMax;
+				anySummary.Append(anyTimer);
+			}
+		}
+		fEpoch = lEpoch + 1L;
+	}
+}
+
+long PhaseTiming::RegisterTimer(const char *pcSection, const char *pcKey)
+{
+	return PhaseTimingRegistrySingleton::instance().Register(pcSection, pcKey);
+}
+
+l_long PhaseTiming::Now()
+{
+#if defined(CLOCK_MONOTONIC_COARSE)
+	timespec ts;
+	if ( clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0 ) {
+		return (l_long)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000L;
+	}
+#endif
+	return DiffTimer::Scale(DiffTimer::getCurrentRawTime(), DiffTimer::eMicroseconds);
+}
+
+void PhaseTiming::Record(long lTimerId, l_long llMicros)
+{
+	if ( lTimerId >= 0L ) {
+		PhaseTimingRegistry &registry = PhaseTimingRegistrySingleton::instance();
+		registry.GetTimes()->Add(lTimerId, llMicros, registry.fEpoch);
+	}
+}
+
+void PhaseTiming::Summarize(Anything &anySummary)
+{
+	StartTrace(PhaseTiming.Summarize);
+	anySummary = Anything(Anything::ArrayMarker(), anySummary.GetAllocator());
+	PhaseTimingRegistrySingleton::instance().Summarize(anySummary);
+	TraceAny(anySummary, "summary");
 }
 
 
 TimeLoggingModule::TimeLoggingModule(const char *name)
 	: WDModule(name)
+	, fpSummaryThread(0)
 {
 	StartTrace(TimeLoggingModule.TimeLoggingModule);
 }
@@ -59,14 +248,39 @@ bool TimeLoggingModule::Init(const ROAnything config)
 		} else {
 			fgTLSUsable = true;
 		}
+		StartSummary(roaModuleConfig);
 		return true;
 	}
 	return false;
 }
 
+void TimeLoggingModule::StartSummary(const ROAnything roaModuleConfig)
+{
+	StartTrace(TimeLoggingModule.StartSummary);
+	ROAnything roaSummary = roaModuleConfig["Summary"];
+	long lInterval = roaSummary["Interval"].AsLong(0L);
+	if ( lInterval > 0L && !fpSummaryThread ) {
+		String strAction = roaSummary["Action"].AsString("PhaseTimingLoggingAction");
+		Trace("executing [" << strAction << "] every " << lInterval << "s");
+		fpSummaryThread = new (coast::storage::Global()) PeriodicAction(strAction, lInterval, roaSummary);
+		fpSummaryThread->Start();
+	}
+}
+
+void TimeLoggingModule::StopSummary()
+{
+	StartTrace(TimeLoggingModule.StopSummary);
+	if ( fpSummaryThread ) {
+		fpSummaryThread->Terminate();
+		delete fpSummaryThread;
+		fpSummaryThread = 0;
+	}
+}
+
 bool TimeLoggingModule::Finis()
 {
 	StartTrace(TimeLoggingModule.Finis);
+	StopSummary();
 	fgDoTiming = fgDoLogging = false;
 	if ( fgTLSUsable ) {
 		if (THRKEYDELETE(fgNestingLevelKey) != 0) {
@@ -29,7 +29,21 @@ The timing information will be stored in the TmpStore of the given context for l
 To enable logging, the RequestTimeLogger macro has to be put before destroying the context.
 Currently, this call is already present in RequestProcessor to gather Request time informations by default.
 
-But unless you declare the TimeLoggingModule, and configure it to DoTiming and DoLogging nothing will be done - except allocation and destruction of the message String.
+But unless you declare the TimeLoggingModule, and configure it to DoTiming and DoLogging nothing will be done besides the phase timing below.
+
+Independently of /DoTiming, every MethodTimer, DAAccessTimer and RequestTimer also feeds the always-on PhaseTiming record of its thread.
+With /Summary configured, a PeriodicAction executes /Summary.Action every /Summary.Interval seconds to report what was collected
+since the previous run, see PhaseTimingLoggingAction of the AppLog module.
+\par Phase timing configuration
+\code
+{
+	/Summary {				optional, no summaries without
+		/Interval	long	mandatory, seconds between two summaries, 0 disables summaries
+		/Action		String	optional, default "PhaseTimingLoggingAction", action executed every interval
+		...					all slots of /Summary can be looked up in the context of the action, eg. /Channel
+	}
+}
+\endcode
 */
 class TimeLoggingModule : public WDModule
 {
@@ -48,6 +62,14 @@ public:
 	static bool fgDoTiming;
 	static bool fgDoLogging;
 	static const char *fgpLogEntryBasePath;
+
+private:
+	//! start the thread executing the summary action, if configured
+	void StartSummary(const ROAnything roaModuleConfig);
+	//! terminate the thread executing the summary action
+	void StopSummary();
+
+	Thread *fpSummaryThread;
 };
 
 //!helper class to log timing information
@@ -107,33 +129,96 @@ public:
 	TimeLoggerEntry(const char *pSection, const char *pKey, String &msg, Context &ctx, TimeLogger::eResolution aResolution);
 };
 
+//! Always-on timing of program phases with fixed per thread records
+/*!
+Every timer site registers its section and key once and gets an id, see PhaseTimer. Durations are added to a fixed array
+per thread which is only written by its own thread, recording neither locks nor allocates.
+The clock is CLOCK_MONOTONIC_COARSE where available, resolution is the kernel tick (typically 1-4ms). Single short phases
+therefore often measure 0, but counts, sums and means over many requests stay meaningful at the cost of two clock reads
+served from the vDSO. Values are in microseconds.
+*/
+class PhaseTiming
+{
+public:
+	//! number of distinct timer sites, further sites are not timed
+	enum { eMaxTimers = 256 };
+
+	//! register a timer site, registering the same section and key again returns the same id
+	/*! \param pcSection section name, must stay valid for the process lifetime, eg. a literal
+		\param pcKey key name, must stay valid for the process lifetime, eg. a literal
+		\return id to pass to Record, -1 if all eMaxTimers ids are taken */
+	static long RegisterTimer(const char *pcSection, const char *pcKey);
+
+	//! current value of the timing clock in microseconds
+	static l_long Now();
+
+	//! add a measured duration to the record of the calling thread
+	static void Record(long lTimerId, l_long llMicros);
+
+	//! sum up the records of all threads since the last call
+	/*! Counts and totals are differences to the previous summary, /Max is the longest duration recorded in between.
+		Timers without calls since the last summary are not listed.
+		\param anySummary gets an array of { /Section /Key /Count /Total /Mean /Max } */
+	static void Summarize(Anything &anySummary);
+};
+
+//! times the scope it lives in, use PhaseTimer to create it
+class PhaseTimerEntry
+{
+	long fTimerId;
+	l_long fStart;
+public:
+	PhaseTimerEntry(long lTimerId)
+		: fTimerId(lTimerId)
+		, fStart(PhaseTiming::Now()) {
+	}
+	~PhaseTimerEntry() {
+		PhaseTiming::Record(fTimerId, PhaseTiming::Now() - fStart);
+	}
+};
+
+#define PhaseTimer(section, key)	\
+	PhaseTimerName(section, key, __LINE__)
+
+#define PhaseTimerName(section, key, name)	\
+	static const long _NAME2_(dIremiTesahP,name) = PhaseTiming::RegisterTimer(_QUOTE_(section), _QUOTE_(key));	\
+	PhaseTimerEntry _NAME2_(yrtnEremiTesahP,name)(_NAME2_(dIremiTesahP,name))
+
+//! message is only rendered when TimeLoggingModule::fgDoTiming is set
+#define TimeLoggerMessage(msg, name)	\
+	( TimeLoggingModule::fgDoTiming ? ( _NAME2_(gsMreggoLemiT,name) << msg ) : _NAME2_(gsMreggoLemiT,name) )
+
 #define MethodTimer(key, msg, ctx)	\
 	MethodTimerName(key, msg, ctx, __LINE__)
 
 #define MethodTimerName(key, msg, ctx, name)	\
 	String _NAME2_(gsMreggoLemiT,name);			\
-	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("Method", _QUOTE_(key), _NAME2_(gsMreggoLemiT,name) << msg, ctx, TimeLogger::eMilliseconds)
+	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("Method", _QUOTE_(key), TimeLoggerMessage(msg, name), ctx, TimeLogger::eMilliseconds);	\
+	PhaseTimerName(Method, key, name)
 
 #define MethodTimerUnit(key, msg, ctx, res)	\
 	MethodTimerUnitName(key, msg, ctx, res, __LINE__)
 
 #define MethodTimerUnitName(key, msg, ctx, res, name)	\
 	String _NAME2_(gsMreggoLemiT,name);			\
-	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("Method", _QUOTE_(key), _NAME2_(gsMreggoLemiT,name) << msg, ctx, res)
+	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("Method", _QUOTE_(key), TimeLoggerMessage(msg, name), ctx, res);	\
+	PhaseTimerName(Method, key, name)
 
 #define DAAccessTimer(key,msg,ctx)	\
 	DAAccessTimerName(key, msg, ctx, __LINE__)
 
 #define DAAccessTimerName(key,msg,ctx,name)	\
 	String _NAME2_(gsMreggoLemiT,name);			\
-	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("DataAccess", _QUOTE_(key), _NAME2_(gsMreggoLemiT,name) << msg, ctx, TimeLogger::eMilliseconds)
+	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("DataAccess", _QUOTE_(key), TimeLoggerMessage(msg, name), ctx, TimeLogger::eMilliseconds);	\
+	PhaseTimerName(DataAccess, key, name)
 
 #define RequestTimer(key,msg,ctx)	\
 	RequestTimerName(key, msg, ctx, __LINE__)
 
 #define RequestTimerName(key,msg,ctx,name)	\
 	String _NAME2_(gsMreggoLemiT,name);			\
-	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("Request", _QUOTE_(key), _NAME2_(gsMreggoLemiT,name) << msg, ctx, TimeLogger::eMilliseconds)
+	TimeLoggerEntry _NAME2_(yrtnEreggoLemiT,name)("Request", _QUOTE_(key), TimeLoggerMessage(msg, name), ctx, TimeLogger::eMilliseconds);	\
+	PhaseTimerName(Request, key, name)
 
 #define RequestTimeLogger(ctx)						\
 	if ( TimeLoggingModule::fgDoLogging ) {			\
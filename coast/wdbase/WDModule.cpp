@@ -11,6 +11,8 @@
 #include "Registry.h"
 #include "Tracer.h"
 #include "Policy.h"
+#include "TaskGraph.h"
+#include "DiffTimer.h"
 
 class WDModuleCaller;
 
@@ -66,6 +68,10 @@ public:
 	virtual void SetModules(const ROAnything roaModules) {
 		fModules = roaModules;
 	}
+	//! milliseconds spent per called module
+	ROAnything GetTimes() const {
+		return fTimes;
+	}
 
 protected:
 	virtual void HandleError(WDModule *wdm);
@@ -78,6 +84,7 @@ protected:
 	ROAnything fModules;
 	ROAnything fConfig;
 	String fModuleName; // only set temporary
+	Anything fTimes;
 };
 
 class WDInit: public WDModuleCaller {
@@ -130,22 +137,140 @@ public:
 	}
 };
 
+namespace {
+	Anything &StartupTimes() {
+		static Anything anyTimes(Anything::ArrayMarker(), coast::storage::Global());
+		return anyTimes;
+	}
+
+	//! calls one module from a thread of the TaskGraph, every task has its own caller
+	template <typename CallerType>
+	class WDModuleTask: public TaskGraph::Task {
+	public:
+		WDModuleTask(const ROAnything roaConfig, const ROAnything roaModules, WDModule *wdm)
+			: fCaller(roaConfig), fModule(wdm) {
+			fCaller.SetModules(roaModules);
+		}
+		virtual bool Run() {
+			return fCaller.Call(fModule);
+		}
+		CallerType fCaller;
+		WDModule *fModule;
+	};
+
+	//! call the configured modules on lThreads threads respecting /ModulePrerequisites
+	/*! modules without prerequisites configured wait for all modules listed before them */
+	template <typename CallerType>
+	int ParallelInstall(const ROAnything roaConfig, const ROAnything roaModules, long lThreads, Anything &anyTimes)
+	{
+		StartTrace1(WDModule.ParallelInstall, "threads: " << lThreads);
+		typedef WDModuleTask<CallerType> TaskType;
+		ROAnything roaPrerequisites(roaConfig["ModulePrerequisites"]);
+		TaskGraph graph("WDModuleInstall", lThreads);
+		std::vector<TaskType *> tasks;
+		Anything anyIds;
+		for (long i = 0, sz = roaModules.GetSize(); i < sz; ++i) {
+			String moduleName(roaModules[i][0L].AsCharPtr("NoModule"));
+			WDModule *wdm = WDModule::FindWDModule(moduleName);
+			if ( !wdm ) {
+				SystemLog::WriteToStderr(moduleName << " not found.\n");
+			}
+			tasks.push_back(new TaskType(roaConfig, roaModules, wdm));
+			// optional failures are handled by the caller already, a failing call has to stop the installation
+			long lId = graph.AddTask(tasks.back(), true);
+			ROAnything roaRequired;
+			if ( roaPrerequisites.LookupPath(roaRequired, moduleName, '\000') ) {
+				for (long j = 0, szr = roaRequired.GetSize(); j < szr; ++j) {
+					const char *pcRequired = roaRequired[j].AsCharPtr("");
+					if ( !graph.AddPrerequisite(lId, ROAnything(anyIds)[pcRequired].AsLong(-1L)) ) {
+						SystemLog::WriteToStderr(String("\tprerequisite ") << pcRequired << " of " << moduleName << " is not listed before it, ignored\n");
+					}
+				}
+			} else {
+				for (long k = 0; k < lId; ++k) {
+					graph.AddPrerequisite(lId, k);
+				}
+			}
+			anyIds[moduleName] = lId;
+		}
+		int result = ( graph.Run() ? 0 : -1 );
+		for (typename std::vector<TaskType *>::iterator aIt = tasks.begin(); aIt != tasks.end(); ++aIt) {
+			ROAnything roaTimes = (*aIt)->fCaller.GetTimes();
+			for (long i = 0, sz = roaTimes.GetSize(); i < sz; ++i) {
+				anyTimes[roaTimes.SlotName(i)] = roaTimes[i].AsLong(0L);
+			}
+			delete *aIt;
+		}
+		return result;
+	}
+
+	void ReportStartupTimes(const char *pcWhat, ROAnything roaTimes, long lTotal, long lThreads)
+	{
+		StartTrace(WDModule.ReportStartupTimes);
+		Anything &anyReport = StartupTimes();
+		anyReport = Anything(Anything::ArrayMarker(), coast::storage::Global());
+		anyReport["Modules"] = roaTimes.DeepClone(coast::storage::Global());
+		anyReport["Total"] = lTotal;
+		anyReport["Threads"] = lThreads;
+		String strReport("\t");
+		strReport << pcWhat << " times [ms]:\n";
+		for (long i = 0, sz = roaTimes.GetSize(); i < sz; ++i) {
+			strReport << "\t\t" << roaTimes.SlotName(i) << ": " << roaTimes[i].AsLong(0L) << "\n";
+		}
+		strReport << "\t\ttotal: " << lTotal << " using " << lThreads << ( lThreads > 1L ? " threads" : " thread" ) << "\n";
+		SystemLog::WriteToStderr(strReport);
+		String strMsg(pcWhat);
+		strMsg << " of " << roaTimes.GetSize() << " modules took " << lTotal << "ms";
+		SYSINFO(strMsg);
+	}
+
+	//! installs the configured or all registered modules, see WDModule::Install
+	template <typename CallerType>
+	int InstallModules(const ROAnything roaConfig, const char *pcWhat, const char *pcAllModulesMessage)
+	{
+		DiffTimer aTimer;
+		ROAnything roaModules;
+		CallerType caller(roaConfig);
+		Anything anyTimes(Anything::ArrayMarker(), coast::storage::Global());
+		long lThreads = roaConfig["ModuleInitThreads"].AsLong(1L);
+		int result = 0;
+		if ( roaConfig.LookupPath(roaModules, "Modules") ) {
+			if ( lThreads > 1L ) {
+				result = ParallelInstall<CallerType>(roaConfig, roaModules, lThreads, anyTimes);
+			} else {
+				result = ConfiguredWDMIterator(&caller, roaModules).DoForEach();
+				anyTimes = caller.GetTimes().DeepClone(coast::storage::Global());
+			}
+		} else {
+			if ( pcAllModulesMessage ) {
+				SystemLog::WriteToStderr(pcAllModulesMessage);
+			}
+			lThreads = 1L;
+			result = RegistryWDMIterator(&caller).DoForEach();
+			anyTimes = caller.GetTimes().DeepClone(coast::storage::Global());
+		}
+		ReportStartupTimes(pcWhat, anyTimes, aTimer.Diff(), lThreads);
+		return result;
+	}
+}
+
 RegCacheImpl(WDModule);	// FindWDModule()
 int WDModule::Install(const ROAnything roaConfig)
 {
 	StartTrace(WDModule.Install);
-	ROAnything roaModules;
-	WDInit wdi(roaConfig);
-	if ( roaConfig.LookupPath(roaModules, "Modules") ) {
-		return ConfiguredWDMIterator(&wdi, roaModules).DoForEach();
+	int result = InstallModules<WDInit>(roaConfig, "Initialization", 0);
+	if ( result == 0 ) {
+		// registries stay unchanged until the next reset or termination
+		MetaRegistry::instance().FreezeAll();
 	}
-	return RegistryWDMIterator(&wdi).DoForEach();
+	return result;
 }
 
 int WDModule::Terminate(const ROAnything roaConfig)
 {
 	StartTrace(WDModule.Terminate);
 	SystemLog::WriteToStderr("\tTerminating modules:\n");
+	MetaRegistry::instance().UnfreezeAll();
 	ROAnything roaModules;
 	WDTerminate wdt(roaConfig);
 
@@ -160,16 +285,11 @@ int WDModule::ResetInstall(const ROAnything roaConfig)
 {
 	StartTrace(WDModule.ResetInstall);
 	SystemLog::WriteToStderr("\tInstalling modules after reset:\n");
-	ROAnything roaModules;
-	WDResetInstall wdt(roaConfig);
-	int result = 0;
-	if ( roaConfig.LookupPath(roaModules, "Modules") ) {
-		result = ConfiguredWDMIterator(&wdt, roaModules).DoForEach();
-	} else {
-		SystemLog::WriteToStderr("\t\tNO /Modules configured: ResetInstal all registered modules\n");
-		result = RegistryWDMIterator(&wdt).DoForEach();
-	}
+	int result = InstallModules<WDResetInstall>(roaConfig, "ResetInitialization", "\t\tNO /Modules configured: ResetInstal all registered modules\n");
 	SystemLog::WriteToStderr("\tInstallation of modules after reset: DONE\n");
+	if ( result == 0 ) {
+		MetaRegistry::instance().FreezeAll();
+	}
 	return result;
 }
 
@@ -177,6 +297,7 @@ int WDModule::ResetTerminate(const ROAnything roaConfig)
 {
 	StartTrace(WDModule.ResetTerminate);
 	SystemLog::WriteToStderr("\tTerminating modules for reset:\n");
+	MetaRegistry::instance().UnfreezeAll();
 	ROAnything roaModules;
 	WDResetTerminate wdt(roaConfig);
 
@@ -196,6 +317,11 @@ int WDModule::Reset(const ROAnything roaOldconfig, const ROAnything roaConfig)
 	return -1;
 }
 
+ROAnything WDModule::GetStartupTimes()
+{
+	return StartupTimes();
+}
+
 WDModule::WDModule() : NotCloned("WDModule")
 {
 }
@@ -285,11 +411,17 @@ WDModule *RegistryWDMIterator::Next()
 
 WDModuleCaller::WDModuleCaller(const ROAnything roaConfig)
 	: fConfig(roaConfig)
+	, fTimes(Anything::ArrayMarker(), coast::storage::Global())
 {}
 
 bool WDModuleCaller::Call(WDModule *wdm)
 {
-	if (wdm && SetModuleName(wdm) && DoCall(wdm)) {
+	DiffTimer aTimer;
+	bool bCalled = ( wdm && SetModuleName(wdm) && DoCall(wdm) );
+	if ( wdm && fModuleName.Length() > 0L ) {
+		fTimes[fModuleName] = (long)aTimer.Diff();
+	}
+	if ( bCalled ) {
 		return true;
 	}
 
@@ -19,6 +19,24 @@ class Server;
  * extension api that supports installation, termination and resets of components<br>
  * static api supports installation, termination and resets of configured extensions
  * WDModule components are singletons since they are not cloned
+ * \par Configuration of the installation
+ * \code
+ * {
+ * 	/Modules {					modules to install in the given order
+ * 		SomeModule
+ * 		...
+ * 	}
+ * 	/ModuleInitThreads	long	optional, default 1, number of modules initialized at the same time
+ * 	/ModulePrerequisites {		optional, only used with /ModuleInitThreads > 1
+ * 		/SomeModule { OtherModule ... }	modules listed before SomeModule it has to wait for
+ * 	}
+ * }
+ * \endcode
+ * A module without /ModulePrerequisites entry waits for all modules listed before it, so the list is initialized
+ * one after the other as long as no prerequisites are given. Modules initialized at the same time must not
+ * install objects into the same registry category, and a module reading registries (e.g. templates referring to
+ * renderers) has to list the modules filling them as prerequisites.
+ * The time spent per module is written to stderr after the installation, see GetStartupTimes().
  */
 class WDModule: public NotCloned
 {
@@ -43,6 +61,9 @@ public:
 	static int Terminate( const ROAnything roaConfig );
 	//!resets all modules terminating with oldconfig and reinitialising with config
 	static int Reset( const ROAnything roaOldconfig, const ROAnything roaConfig );
+	//!timing of the last installation
+	/*! \return { /Modules { /<module> <ms> ... } /Total <ms> /Threads <number of threads> } */
+	static ROAnything GetStartupTimes();
 
 	RegCacheDef(WDModule); // FindWDModule()
 